@@ -0,0 +1,39 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      Inet Layer project configuration for standalone builds on Linux and OS X.
+ *
+ */
+#ifndef INETPROJECTCONFIG_H
+#define INETPROJECTCONFIG_H
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+// Leave room for the 1000 listening endpoints of TestInetLayerWakeup.
+#define INET_CONFIG_NUM_UDP_ENDPOINTS 1024
+
+// Let UDP endpoints receive, and queue for sending, several datagrams per system call.
+#define INET_CONFIG_ENABLE_UDP_BATCHING 1
+
+#if defined(__linux__)
+// Let TCP endpoints send large writes with MSG_ZEROCOPY, once enabled with TCPEndPoint::EnableZeroCopy().
+#define INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY 1
+#endif
+#endif
+
+#endif /* INETPROJECTCONFIG_H */
@@ -25,6 +25,15 @@
 #define SYSTEMPROJECTCONFIG_H
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if defined(__linux__)
+// Dispatch socket events through epoll rather than select.
+#define WEAVE_SYSTEM_CONFIG_USE_EPOLL 1
+#endif
+
+// Schedule timers on a timing wheel, with a pool large enough for the 10000 pending timers of TestSystemTimer.
+#define WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL 1
+#define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 10240
+
 // Uncomment this for larger buffers (e.g. to support a bigger WEAVE_CONFIG_TUNNEL_INTERFACE_MTU).
 //#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX 9050
 #endif
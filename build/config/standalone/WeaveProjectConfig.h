@@ -39,6 +39,21 @@
 
 #define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 1
 
+// Keep checkpoints into each event buffer so that fetches don't scan from the oldest event.
+#define WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE 8
+
+// Let events be staged outside the logging critical section and drained in batches.
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE 8
+
+// Store events with a reference to a shared schema entry instead of their profile, type and source.
+#define WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE 16
+
+// Spill events dropped from memory to a small segmented store backed by the test persisted storage.
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT 8
+
+// Encode log upload blocks two at a time, ahead of the receiver's acknowledgements.
+#define WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW 2
+
 #define WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE 300
 
 // Uncomment this for a large Tunnel MTU.
@@ -57,8 +72,26 @@
 
 #define WEAVE_CONFIG_SECURITY_TEST_MODE 1
 
+// Cache expanded message encryption keys, so that TestMsgEnc exercises the cached key schedules.
+#define WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES 1
+
 #define WDM_ENFORCE_EXPIRY_TIME 1
 
+// Index the schema tree of each trait schema engine, so that TestTraitSchemaIndex covers the indexed queries.
+#define TDM_SCHEMA_INDEX_SUPPORT 1
+
+// Track dirty properties of published traits in a bitmap per data source, rather than in the shared dirty store.
+#define WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP 32
+
+// Remember the encoded size of published trait data.
+#define WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE 1
+
+// Share data elements encoded for one subscriber with the others evaluated in the same notification engine run.
+#define WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE 4096
+
+// Keep a histogram of how long dirty subscriptions wait for their notify.
+#define WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS 1
+
 // Increase session idle timeout in stand-alone builds for the convenience of developers.
 #define WEAVE_CONFIG_DEFAULT_SECURITY_SESSION_IDLE_TIMEOUT           120000
 
@@ -66,11 +99,26 @@
 
 #define WEAVE_CONFIG_ENABLE_WDM_CUSTOM_COMMAND_SENDER 1
 
+#define WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX 1
+
+#define WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX 1
+
+#define WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE 1
+
 #define WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE 0
 
 #define WEAVE_CONFIG_LEGACY_KEY_EXPORT_DELEGATE 0
 
-#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC 300
+// The WRMP retransmission table is sized to match, which leaves room for the 1000 outstanding messages of TestWRMP.
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC 2048
+
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 64
+
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 64
+
+#if defined(__LP64__)
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE 1
+#endif
 
 #define WEAVE_CONFIG_ENABLE_FUNCT_ERROR_LOGGING 1
 
@@ -176,6 +176,23 @@ WEAVE_ERROR Write(const char *aKey, uint32_t aValue)
     return WEAVE_NO_ERROR;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+WEAVE_ERROR ReadSegment(uint8_t aSegment, uint32_t aOffset, uint8_t *aBuffer, uint32_t aLength)
+{
+    return WEAVE_ERROR_PERSISTED_STORAGE_FAIL;
+}
+
+WEAVE_ERROR WriteSegment(uint8_t aSegment, uint32_t aOffset, const uint8_t *aBuffer, uint32_t aLength)
+{
+    return WEAVE_ERROR_PERSISTED_STORAGE_FAIL;
+}
+
+WEAVE_ERROR EraseSegment(uint8_t aSegment)
+{
+    return WEAVE_ERROR_PERSISTED_STORAGE_FAIL;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
 } // PersistentStorage
 } // Platform
 } // Weave
@@ -27,6 +27,10 @@
 
 #include <InetLayer/InetLayer.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <Weave/Support/logging/WeaveLogging.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 namespace nl {
 namespace Inet {
 
@@ -42,7 +46,65 @@ void EndPointBasis::InitEndPointBasis(InetLayer& aInetLayer, void* aAppState)
     mSocket = INET_INVALID_SOCKET_FD;
     mPendingIO.Clear();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketsEndPointType = kSocketsEndPointType_Unknown;
+    mWatchedIO.Clear();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+}
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Bring the registration of the endpoint socket with the system layer epoll instance in line with the requested I/O events.
+ *
+ *  The socket is added when it first requests an event, modified when the requested events change and removed when it no longer
+ *  requests any. Sockets requesting nothing are kept out of the epoll instance entirely because hang-up and error conditions
+ *  are always reported for registered descriptors.
+ *
+ *  @note
+ *    Endpoints call this after every change that can affect the result of their \c PrepareIO method, and the InetLayer calls it
+ *    after dispatching pending I/O to an endpoint.
+ *
+ *  @param[in]  aRequestedIO    The events the endpoint is now interested in, typically the result of \c PrepareIO.
+ */
+void EndPointBasis::UpdateSocketWatch(SocketEvents aRequestedIO)
+{
+    Weave::System::Layer& lSystemLayer = SystemLayer();
+    Weave::System::Error lError;
+
+    if (mSocket == INET_INVALID_SOCKET_FD || aRequestedIO.Value == mWatchedIO.Value)
+        return;
+
+    if (!aRequestedIO.IsSet())
+        lError = lSystemLayer.RemoveSocketWatch(mSocket);
+    else if (!mWatchedIO.IsSet())
+        lError = lSystemLayer.AddSocketWatch(mSocket, aRequestedIO.ToEpollEvents(), this);
+    else
+        lError = lSystemLayer.UpdateSocketWatch(mSocket, aRequestedIO.ToEpollEvents(), this);
+
+    if (lError != WEAVE_SYSTEM_NO_ERROR)
+    {
+        WeaveLogError(Inet, "Socket %d watch update failed: %ld", mSocket, static_cast<long>(lError));
+        return;
+    }
+
+    mWatchedIO = aRequestedIO;
+}
+
+/**
+ *  Remove the endpoint socket from the system layer epoll instance, if registered. This must be called before the socket is
+ *  closed so that a descriptor number reused by a new endpoint does not inherit a stale registration.
+ */
+void EndPointBasis::RemoveSocketWatch(void)
+{
+    if (mSocket != INET_INVALID_SOCKET_FD && mWatchedIO.IsSet())
+    {
+        SystemLayer().RemoveSocketWatch(mSocket);
+    }
+
+    mWatchedIO.Clear();
 }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
 } // namespace Inet
 } // namespace nl
@@ -86,6 +86,26 @@ protected:
     SocketEvents mPendingIO;        /**< Socket event masks */
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    enum
+    {
+        kSocketsEndPointType_Unknown = 0,
+
+        kSocketsEndPointType_Raw     = 1,
+        kSocketsEndPointType_UDP     = 2,
+        kSocketsEndPointType_TCP     = 3,
+        kSocketsEndPointType_Tun     = 4
+    };
+
+    uint8_t mSocketsEndPointType;   /**< Concrete endpoint class, used to dispatch epoll events. */
+    SocketEvents mWatchedIO;        /**< Socket events currently registered with the system layer epoll instance. */
+
+    void UpdateSocketWatch(SocketEvents aRequestedIO);
+    void RemoveSocketWatch(void);
+
+    friend class InetLayer;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     /** Encapsulated LwIP protocol control block */
     union
@@ -96,6 +96,22 @@ union PeerSockAddr
     sockaddr_in  in;
     sockaddr_in6 in6;
 };
+
+// Storage for the header of a message sent or received on a socket.
+struct SocketMsgHeader
+{
+    struct msghdr   Header;
+    struct iovec    IOV[INET_CONFIG_UDP_SEND_MAX_IOVECS];
+    size_t          Length;
+    PeerSockAddr    PeerAddr;
+    uint8_t         ControlData[256];
+};
+
+static INET_ERROR EncodeSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo *aPktInfo,
+    PacketBuffer *aBuffer, SocketMsgHeader &aMsgHeader);
+static void EncodeReceiveMsgHeader(PacketBuffer *aBuffer, SocketMsgHeader &aMsgHeader);
+static INET_ERROR DecodeReceivedMsgHeader(const SocketMsgHeader &aMsgHeader, ssize_t aRcvLen, PacketBuffer *aBuffer,
+    IPPacketInfo &aPacketInfo);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -762,127 +778,106 @@ INET_ERROR IPEndPointBasis::BindInterface(IPAddressType aAddressType, InterfaceI
 
 INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System::PacketBuffer *aBuffer, uint16_t aSendFlags)
 {
-    INET_ERROR     res = INET_NO_ERROR;
-    PeerSockAddr   peerSockAddr;
-    struct iovec   msgIOV;
-    uint8_t        controlData[256];
-    struct msghdr  msgHeader;
-    InterfaceId    intfId = aPktInfo->Interface;
-
-    // Ensure the destination address type is compatible with the endpoint address type.
-    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
-
-    // For now the entire message must fit within a single buffer.
-    VerifyOrExit(aBuffer->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
-
-    memset(&msgHeader, 0, sizeof (msgHeader));
+    INET_ERROR      res = INET_NO_ERROR;
+    SocketMsgHeader msgHeader;
 
-    msgIOV.iov_base      = aBuffer->Start();
-    msgIOV.iov_len       = aBuffer->DataLength();
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+    res = EncodeSendMsgHeader(mAddrType, mBoundIntfId, aPktInfo, aBuffer, msgHeader);
+    SuccessOrExit(res);
 
-    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    memset(&peerSockAddr, 0, sizeof (peerSockAddr));
-    msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
-    {
-        peerSockAddr.in6.sin6_family    = AF_INET6;
-        peerSockAddr.in6.sin6_port      = htons(aPktInfo->DestPort);
-        peerSockAddr.in6.sin6_flowinfo  = 0;
-        peerSockAddr.in6.sin6_addr      = aPktInfo->DestAddress.ToIPv6();
-        peerSockAddr.in6.sin6_scope_id  = aPktInfo->Interface;
-        msgHeader.msg_namelen           = sizeof(sockaddr_in6);
-    }
-#if INET_CONFIG_ENABLE_IPV4
-    else
+    // Send IP packet.
     {
-        peerSockAddr.in.sin_family      = AF_INET;
-        peerSockAddr.in.sin_port        = htons(aPktInfo->DestPort);
-        peerSockAddr.in.sin_addr        = aPktInfo->DestAddress.ToIPv4();
-        msgHeader.msg_namelen           = sizeof(sockaddr_in);
+        const ssize_t lenSent = sendmsg(mSocket, &msgHeader.Header, 0);
+        if (lenSent == -1)
+            res = Weave::System::MapErrorPOSIX(errno);
+        else if (static_cast<size_t>(lenSent) != msgHeader.Length)
+            res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
     }
-#endif // INET_CONFIG_ENABLE_IPV4
 
-    // If the endpoint has been bound to a particular interface,
-    // and the caller didn't supply a specific interface to send
-    // on, use the bound interface. This appears to be necessary
-    // for messages to multicast addresses, which under Linux
-    // don't seem to get sent out the correct interface, despite
-    // the socket being bound.
-    if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+exit:
+    return (res);
+}
 
-    // If the packet should be sent over a specific interface, or with a specific source
-    // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
-    // add add it to the message header.  If the local OS doesn't support IP_PKTINFO/IPV6_PKTINFO
-    // fail with an error.
-    if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
-    {
-#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        memset(controlData, 0, sizeof(controlData));
-        msgHeader.msg_control = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+/**
+ *  Send a batch of messages, with a single system call where the system provides sendmmsg().
+ *
+ *  @param[in]   aPktInfos      The source and destination information of each message.
+ *  @param[in]   aBuffers       The message buffers; each message must fit within a single buffer.
+ *  @param[in]   aCount         The number of messages, at most #INET_CONFIG_UDP_BATCH_SIZE.
+ *  @param[out]  aNumSent       The number of messages, from the start of the batch, that were sent.
+ *
+ *  @return  #INET_NO_ERROR if all of the messages were sent, otherwise the error that stopped the
+ *           message following the last one sent.
+ */
+INET_ERROR IPEndPointBasis::SendMsgs(const IPPacketInfo *aPktInfos, Weave::System::PacketBuffer *const *aBuffers, uint8_t aCount,
+    uint8_t &aNumSent)
+{
+    INET_ERROR      res = INET_NO_ERROR;
+    SocketMsgHeader msgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
 
-        struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
+    aNumSent = 0;
 
-#if INET_CONFIG_ENABLE_IPV4
+    VerifyOrExit(aCount <= INET_CONFIG_UDP_BATCH_SIZE, res = INET_ERROR_BAD_ARGS);
 
-        if (mAddrType == kIPAddressType_IPv4)
+    while (aNumSent < aCount)
+    {
+        uint8_t numEncoded = 0;
+
+        // Encode the headers of the messages up to the first one that cannot be sent.
+        while (aNumSent + numEncoded < aCount)
         {
-#if defined(IP_PKTINFO)
-            controlHdr->cmsg_level = IPPROTO_IP;
-            controlHdr->cmsg_type  = IP_PKTINFO;
-            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in_pktinfo));
+            const uint8_t i = aNumSent + numEncoded;
 
-            struct in_pktinfo *pktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
-            pktInfo->ipi_ifindex = intfId;
-            pktInfo->ipi_spec_dst = aPktInfo->SrcAddress.ToIPv4();
+            res = EncodeSendMsgHeader(mAddrType, mBoundIntfId, &aPktInfos[i], aBuffers[i], msgHeaders[numEncoded]);
+            if (res != INET_NO_ERROR)
+                break;
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
-#else // !defined(IP_PKTINFO)
-            ExitNow(res = INET_ERROR_NOT_SUPPORTED);
-#endif // !defined(IP_PKTINFO)
+            numEncoded++;
         }
 
-#endif // INET_CONFIG_ENABLE_IPV4
+        VerifyOrExit(numEncoded > 0, );
 
-        if (mAddrType == kIPAddressType_IPv6)
+#if HAVE_SENDMMSG
         {
-#if defined(IPV6_PKTINFO)
-            controlHdr->cmsg_level = IPPROTO_IPV6;
-            controlHdr->cmsg_type  = IPV6_PKTINFO;
-            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in6_pktinfo));
+            struct mmsghdr msgVec[INET_CONFIG_UDP_BATCH_SIZE];
+            int numSent;
 
-            struct in6_pktinfo *pktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
-            pktInfo->ipi6_ifindex = intfId;
-            pktInfo->ipi6_addr = aPktInfo->SrcAddress.ToIPv6();
+            for (uint8_t i = 0; i < numEncoded; i++)
+            {
+                msgVec[i].msg_hdr = msgHeaders[i].Header;
+                msgVec[i].msg_len = 0;
+            }
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
-#else // !defined(IPV6_PKTINFO)
-            ExitNow(res = INET_ERROR_NOT_SUPPORTED);
-#endif // !defined(IPV6_PKTINFO)
-        }
+            numSent = sendmmsg(mSocket, msgVec, numEncoded, 0);
+            VerifyOrExit(numSent >= 0, res = Weave::System::MapErrorPOSIX(errno));
 
-#else // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+            for (int i = 0; i < numSent; i++, aNumSent++)
+                VerifyOrExit(msgVec[i].msg_len == msgHeaders[i].Length, res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
 
-        ExitNow(res = INET_ERROR_NOT_SUPPORTED);
+            // If the system stopped short of the encoded messages, the next call reports why.
+            if (numSent < numEncoded)
+            {
+                res = INET_NO_ERROR;
+                continue;
+            }
+        }
+#else // !HAVE_SENDMMSG
+        for (uint8_t i = 0; i < numEncoded; i++, aNumSent++)
+        {
+            const ssize_t lenSent = sendmsg(mSocket, &msgHeaders[i].Header, 0);
 
-#endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
-    }
+            VerifyOrExit(lenSent != -1, res = Weave::System::MapErrorPOSIX(errno));
+            VerifyOrExit(static_cast<size_t>(lenSent) == msgHeaders[i].Length, res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
+        }
+#endif // !HAVE_SENDMMSG
 
-    // Send IP packet.
-    {
-        const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
-        if (lenSent == -1)
-            res = Weave::System::MapErrorPOSIX(errno);
-        else if (lenSent != aBuffer->DataLength())
-            res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
+        SuccessOrExit(res);
     }
 
 exit:
     return (res);
 }
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
 
 INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
@@ -1020,85 +1015,19 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     if (lBuffer != NULL)
     {
-        struct iovec msgIOV;
-        PeerSockAddr lPeerSockAddr;
-        uint8_t controlData[256];
-        struct msghdr msgHeader;
+        SocketMsgHeader msgHeader;
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len = lBuffer->AvailableDataLength();
+        EncodeReceiveMsgHeader(lBuffer, msgHeader);
 
-        memset(&lPeerSockAddr, 0, sizeof (lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof (msgHeader));
-
-        msgHeader.msg_name = &lPeerSockAddr;
-        msgHeader.msg_namelen = sizeof (lPeerSockAddr);
-        msgHeader.msg_iov = &msgIOV;
-        msgHeader.msg_iovlen = 1;
-        msgHeader.msg_control = controlData;
-        msgHeader.msg_controllen = sizeof (controlData);
-
-        ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
+        ssize_t rcvLen = recvmsg(mSocket, &msgHeader.Header, MSG_DONTWAIT);
 
         if (rcvLen < 0)
         {
             lStatus = Weave::System::MapErrorPOSIX(errno);
         }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength((uint16_t) rcvLen);
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
-                 controlHdr != NULL;
-                 controlHdr = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = inPktInfo->ipi_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = DecodeReceivedMsgHeader(msgHeader, rcvLen, lBuffer, lPacketInfo);
         }
     }
     else
@@ -1119,6 +1048,326 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     return;
 }
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+/**
+ *  Receive up to a batch of pending messages, with a single system call where the system provides
+ *  recvmmsg(), and deliver each one, with its own packet information, to the message reception
+ *  handler.
+ *
+ *  Delivery stops early if a handler closes the endpoint; the remaining messages are discarded.
+ *
+ *  @param[in]   aPort          The port the endpoint is bound to.
+ *  @param[in]   aBatchSize     The maximum number of messages to receive, at most #INET_CONFIG_UDP_BATCH_SIZE.
+ */
+void IPEndPointBasis::HandlePendingIO(uint16_t aPort, uint8_t aBatchSize)
+{
+    INET_ERROR      lStatus = INET_NO_ERROR;
+    PacketBuffer *  lBuffers[INET_CONFIG_UDP_BATCH_SIZE];
+    SocketMsgHeader lMsgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
+    ssize_t         lRcvLens[INET_CONFIG_UDP_BATCH_SIZE];
+    uint8_t         lNumBuffers = 0;
+    int             lNumReceived = 0;
+
+    if (aBatchSize > INET_CONFIG_UDP_BATCH_SIZE)
+        aBatchSize = INET_CONFIG_UDP_BATCH_SIZE;
+
+    // Receive into as many buffers as can be had, up to the batch size.
+    while (lNumBuffers < aBatchSize)
+    {
+        PacketBuffer *lBuffer = PacketBuffer::New(0);
+
+        if (lBuffer == NULL)
+            break;
+
+        EncodeReceiveMsgHeader(lBuffer, lMsgHeaders[lNumBuffers]);
+        lBuffers[lNumBuffers++] = lBuffer;
+    }
+
+    VerifyOrExit(lNumBuffers > 0, lStatus = INET_ERROR_NO_MEMORY);
+
+#if HAVE_RECVMMSG
+    {
+        struct mmsghdr lMsgVec[INET_CONFIG_UDP_BATCH_SIZE];
+
+        for (uint8_t i = 0; i < lNumBuffers; i++)
+        {
+            lMsgVec[i].msg_hdr = lMsgHeaders[i].Header;
+            lMsgVec[i].msg_len = 0;
+        }
+
+        lNumReceived = recvmmsg(mSocket, lMsgVec, lNumBuffers, MSG_DONTWAIT, NULL);
+        VerifyOrExit(lNumReceived >= 0, lStatus = Weave::System::MapErrorPOSIX(errno));
+
+        for (int i = 0; i < lNumReceived; i++)
+        {
+            // The system updates the lengths of the peer address and control data in its own copy of each header.
+            lMsgHeaders[i].Header = lMsgVec[i].msg_hdr;
+            lRcvLens[i] = lMsgVec[i].msg_len;
+        }
+    }
+#else // !HAVE_RECVMMSG
+    while (lNumReceived < lNumBuffers)
+    {
+        const ssize_t lRcvLen = recvmsg(mSocket, &lMsgHeaders[lNumReceived].Header, MSG_DONTWAIT);
+
+        if (lRcvLen < 0)
+        {
+            // Report the error only if nothing was received.
+            if (lNumReceived == 0)
+                lStatus = Weave::System::MapErrorPOSIX(errno);
+            break;
+        }
+
+        lRcvLens[lNumReceived++] = lRcvLen;
+    }
+    SuccessOrExit(lStatus);
+#endif // !HAVE_RECVMMSG
+
+    for (int i = 0; i < lNumReceived; i++)
+    {
+        IPPacketInfo    lPacketInfo;
+        INET_ERROR      lErr;
+
+        // A handler may have closed the endpoint.
+        if (mState != kState_Listening || OnMessageReceived == NULL)
+            break;
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        lErr = DecodeReceivedMsgHeader(lMsgHeaders[i], lRcvLens[i], lBuffers[i], lPacketInfo);
+
+        if (lErr == INET_NO_ERROR)
+        {
+            PacketBuffer *lBuffer = lBuffers[i];
+
+            lBuffers[i] = NULL;
+            OnMessageReceived(this, lBuffer, &lPacketInfo);
+        }
+        else if (OnReceiveError != NULL)
+        {
+            OnReceiveError(this, lErr, NULL);
+        }
+    }
+
+exit:
+    for (uint8_t i = 0; i < lNumBuffers; i++)
+        PacketBuffer::Free(lBuffers[i]);
+
+    if (lStatus != INET_NO_ERROR && OnReceiveError != NULL
+        && lStatus != Weave::System::MapErrorPOSIX(EAGAIN)
+       )
+        OnReceiveError(this, lStatus, NULL);
+
+    return;
+}
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
+// Encode the header of a message to be sent on an endpoint with the given address type and bound interface.
+static INET_ERROR EncodeSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo *aPktInfo,
+    PacketBuffer *aBuffer, SocketMsgHeader &aMsgHeader)
+{
+    INET_ERROR     res = INET_NO_ERROR;
+    PeerSockAddr & peerSockAddr = aMsgHeader.PeerAddr;
+    struct msghdr &msgHeader = aMsgHeader.Header;
+    InterfaceId    intfId = aPktInfo->Interface;
+
+    // Ensure the destination address type is compatible with the endpoint address type.
+    VerifyOrExit(aAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+
+    memset(&msgHeader, 0, sizeof (msgHeader));
+
+    // Gather the buffers of the message, which may be chained, into a single datagram.
+    msgHeader.msg_iov       = aMsgHeader.IOV;
+    aMsgHeader.Length       = 0;
+    for (PacketBuffer *lBuffer = aBuffer; lBuffer != NULL; lBuffer = lBuffer->Next())
+    {
+        VerifyOrExit(msgHeader.msg_iovlen < INET_CONFIG_UDP_SEND_MAX_IOVECS, res = INET_ERROR_MESSAGE_TOO_LONG);
+
+        aMsgHeader.IOV[msgHeader.msg_iovlen].iov_base = lBuffer->Start();
+        aMsgHeader.IOV[msgHeader.msg_iovlen].iov_len  = lBuffer->DataLength();
+        aMsgHeader.Length += lBuffer->DataLength();
+        msgHeader.msg_iovlen++;
+    }
+
+    // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
+    memset(&peerSockAddr, 0, sizeof (peerSockAddr));
+    msgHeader.msg_name = &peerSockAddr;
+    if (aAddrType == kIPAddressType_IPv6)
+    {
+        peerSockAddr.in6.sin6_family    = AF_INET6;
+        peerSockAddr.in6.sin6_port      = htons(aPktInfo->DestPort);
+        peerSockAddr.in6.sin6_flowinfo  = 0;
+        peerSockAddr.in6.sin6_addr      = aPktInfo->DestAddress.ToIPv6();
+        peerSockAddr.in6.sin6_scope_id  = aPktInfo->Interface;
+        msgHeader.msg_namelen           = sizeof(sockaddr_in6);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        peerSockAddr.in.sin_family      = AF_INET;
+        peerSockAddr.in.sin_port        = htons(aPktInfo->DestPort);
+        peerSockAddr.in.sin_addr        = aPktInfo->DestAddress.ToIPv4();
+        msgHeader.msg_namelen           = sizeof(sockaddr_in);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+
+    // If the endpoint has been bound to a particular interface,
+    // and the caller didn't supply a specific interface to send
+    // on, use the bound interface. This appears to be necessary
+    // for messages to multicast addresses, which under Linux
+    // don't seem to get sent out the correct interface, despite
+    // the socket being bound.
+    if (intfId == INET_NULL_INTERFACEID)
+        intfId = aBoundIntfId;
+
+    // If the packet should be sent over a specific interface, or with a specific source
+    // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
+    // add add it to the message header.  If the local OS doesn't support IP_PKTINFO/IPV6_PKTINFO
+    // fail with an error.
+    if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
+    {
+#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+        memset(aMsgHeader.ControlData, 0, sizeof(aMsgHeader.ControlData));
+        msgHeader.msg_control = aMsgHeader.ControlData;
+        msgHeader.msg_controllen = sizeof(aMsgHeader.ControlData);
+
+        struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
+
+#if INET_CONFIG_ENABLE_IPV4
+
+        if (aAddrType == kIPAddressType_IPv4)
+        {
+#if defined(IP_PKTINFO)
+            controlHdr->cmsg_level = IPPROTO_IP;
+            controlHdr->cmsg_type  = IP_PKTINFO;
+            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in_pktinfo));
+
+            struct in_pktinfo *pktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
+            pktInfo->ipi_ifindex = intfId;
+            pktInfo->ipi_spec_dst = aPktInfo->SrcAddress.ToIPv4();
+
+            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+#else // !defined(IP_PKTINFO)
+            ExitNow(res = INET_ERROR_NOT_SUPPORTED);
+#endif // !defined(IP_PKTINFO)
+        }
+
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        if (aAddrType == kIPAddressType_IPv6)
+        {
+#if defined(IPV6_PKTINFO)
+            controlHdr->cmsg_level = IPPROTO_IPV6;
+            controlHdr->cmsg_type  = IPV6_PKTINFO;
+            controlHdr->cmsg_len   = CMSG_LEN(sizeof(in6_pktinfo));
+
+            struct in6_pktinfo *pktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
+            pktInfo->ipi6_ifindex = intfId;
+            pktInfo->ipi6_addr = aPktInfo->SrcAddress.ToIPv6();
+
+            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+#else // !defined(IPV6_PKTINFO)
+            ExitNow(res = INET_ERROR_NOT_SUPPORTED);
+#endif // !defined(IPV6_PKTINFO)
+        }
+
+#else // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+
+        ExitNow(res = INET_ERROR_NOT_SUPPORTED);
+
+#endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
+    }
+
+exit:
+    return (res);
+}
+
+// Encode the header of a message to be received into a buffer.
+static void EncodeReceiveMsgHeader(PacketBuffer *aBuffer, SocketMsgHeader &aMsgHeader)
+{
+    aMsgHeader.IOV[0].iov_base = aBuffer->Start();
+    aMsgHeader.IOV[0].iov_len = aBuffer->AvailableDataLength();
+
+    memset(&aMsgHeader.PeerAddr, 0, sizeof (aMsgHeader.PeerAddr));
+
+    memset(&aMsgHeader.Header, 0, sizeof (aMsgHeader.Header));
+
+    aMsgHeader.Header.msg_name = &aMsgHeader.PeerAddr;
+    aMsgHeader.Header.msg_namelen = sizeof (aMsgHeader.PeerAddr);
+    aMsgHeader.Header.msg_iov = aMsgHeader.IOV;
+    aMsgHeader.Header.msg_iovlen = 1;
+    aMsgHeader.Header.msg_control = aMsgHeader.ControlData;
+    aMsgHeader.Header.msg_controllen = sizeof (aMsgHeader.ControlData);
+}
+
+// Set the length of a received message and decode its source and destination information.
+static INET_ERROR DecodeReceivedMsgHeader(const SocketMsgHeader &aMsgHeader, ssize_t aRcvLen, PacketBuffer *aBuffer,
+    IPPacketInfo &aPacketInfo)
+{
+    INET_ERROR lStatus = INET_NO_ERROR;
+    const PeerSockAddr &lPeerSockAddr = aMsgHeader.PeerAddr;
+    struct msghdr msgHeader = aMsgHeader.Header;
+
+    if (aRcvLen > aBuffer->AvailableDataLength())
+    {
+        lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
+    }
+    else
+    {
+        aBuffer->SetDataLength((uint16_t) aRcvLen);
+
+        if (lPeerSockAddr.any.sa_family == AF_INET6)
+        {
+            aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+            aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
+        }
+#if INET_CONFIG_ENABLE_IPV4
+        else if (lPeerSockAddr.any.sa_family == AF_INET)
+        {
+            aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+            aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
+        }
+#endif // INET_CONFIG_ENABLE_IPV4
+        else
+        {
+            lStatus = INET_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    if (lStatus == INET_NO_ERROR)
+    {
+        for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
+             controlHdr != NULL;
+             controlHdr = CMSG_NXTHDR(&msgHeader, controlHdr))
+        {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+            if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+            {
+                struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
+                aPacketInfo.Interface = inPktInfo->ipi_ifindex;
+                aPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+                continue;
+            }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+            if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+            {
+                struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
+                aPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
+                aPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+                continue;
+            }
+#endif // defined(IPV6_PKTINFO)
+        }
+    }
+
+    return lStatus;
+}
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
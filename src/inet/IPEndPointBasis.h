@@ -146,6 +146,12 @@ protected:
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(uint16_t aPort);
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    INET_ERROR SendMsgs(const IPPacketInfo *aPktInfos, Weave::System::PacketBuffer *const *aBuffers, uint8_t aCount,
+        uint8_t &aNumSent);
+    void HandlePendingIO(uint16_t aPort, uint8_t aBatchSize);
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 private:
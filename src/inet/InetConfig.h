@@ -387,6 +387,70 @@
 #define INET_CONFIG_ENABLE_UDP_ENDPOINT                     0
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
+/**
+ *  @def INET_CONFIG_ENABLE_UDP_BATCHING
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) UDP endpoints on BSD sockets
+ *    support receiving several datagrams per readiness event and
+ *    queuing datagrams to be sent together at the end of an event
+ *    loop pass.
+ *
+ *    Where the system provides recvmmsg(2) and sendmmsg(2), as Linux
+ *    does, each batch costs a single system call; elsewhere, batches
+ *    are received and sent with one system call per datagram.
+ *
+ */
+#ifndef INET_CONFIG_ENABLE_UDP_BATCHING
+#define INET_CONFIG_ENABLE_UDP_BATCHING                     0
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
+/**
+ *  @def INET_CONFIG_UDP_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams received per readiness event,
+ *    and queued for sending, by a UDP endpoint, when
+ *    #INET_CONFIG_ENABLE_UDP_BATCHING is asserted.
+ *
+ *    Each UDP endpoint reserves room for this many queued datagrams,
+ *    and receiving or sending a batch uses about 400 bytes of stack
+ *    per datagram.
+ *
+ */
+#ifndef INET_CONFIG_UDP_BATCH_SIZE
+#define INET_CONFIG_UDP_BATCH_SIZE                          8
+#endif // INET_CONFIG_UDP_BATCH_SIZE
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#error "FORBIDDEN: INET_CONFIG_ENABLE_UDP_BATCHING && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+/**
+ *  @def INET_CONFIG_UDP_SEND_MAX_IOVECS
+ *
+ *  @brief
+ *    The maximum number of packet buffers in the chain holding a
+ *    datagram sent by a UDP endpoint on BSD sockets. The buffers are
+ *    gathered into the datagram by a single sendmsg(2) call.
+ *
+ *    Each buffer costs one struct iovec in each socket message header,
+ *    including those of received batches. Datagrams held in longer
+ *    chains are rejected with #INET_ERROR_MESSAGE_TOO_LONG.
+ *
+ */
+#ifndef INET_CONFIG_UDP_SEND_MAX_IOVECS
+#define INET_CONFIG_UDP_SEND_MAX_IOVECS                     4
+#endif // INET_CONFIG_UDP_SEND_MAX_IOVECS
+
+#if INET_CONFIG_UDP_SEND_MAX_IOVECS < 1
+#error "FORBIDDEN: INET_CONFIG_UDP_SEND_MAX_IOVECS must be at least 1"
+#endif // INET_CONFIG_UDP_SEND_MAX_IOVECS < 1
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING && (INET_CONFIG_UDP_BATCH_SIZE < 1 || INET_CONFIG_UDP_BATCH_SIZE > 255)
+#error "FORBIDDEN: INET_CONFIG_UDP_BATCH_SIZE must be between 1 and 255"
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING && ...
+
 /**
  *  @def INET_CONFIG_EVENT_RESERVED
  *
@@ -708,6 +772,79 @@
 #define INET_CONFIG_DEFAULT_TCP_USER_TIMEOUT_MSEC          (5 * 60 * 1000)
 #endif // INET_CONFIG_DEFAULT_TCP_USER_TIMEOUT_MSEC
 
+/**
+ *  @def INET_CONFIG_TCP_SEND_MAX_IOVECS
+ *
+ *  @brief
+ *    The maximum number of packet buffers of the send queue of a
+ *    TCP endpoint on BSD sockets that are gathered into a single
+ *    sendmsg(2) call.
+ *
+ *    Each buffer costs one struct iovec of stack while sending. A
+ *    value of 1 sends each buffer of the send queue with its own
+ *    system call.
+ *
+ */
+#ifndef INET_CONFIG_TCP_SEND_MAX_IOVECS
+#define INET_CONFIG_TCP_SEND_MAX_IOVECS                    16
+#endif // INET_CONFIG_TCP_SEND_MAX_IOVECS
+
+#if INET_CONFIG_TCP_SEND_MAX_IOVECS < 1
+#error "FORBIDDEN: INET_CONFIG_TCP_SEND_MAX_IOVECS must be at least 1"
+#endif // INET_CONFIG_TCP_SEND_MAX_IOVECS < 1
+
+/**
+ *  @def INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) TCP endpoints on BSD sockets
+ *    support sending large writes with the Linux MSG_ZEROCOPY flag,
+ *    once enabled on an endpoint with TCPEndPoint::EnableZeroCopy().
+ *
+ *    The packet buffers of a zero-copy send are held by the endpoint
+ *    until the kernel reports, on the socket error queue, that it no
+ *    longer needs them.
+ *
+ */
+#ifndef INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+#define INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY               0
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+/**
+ *  @def INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH
+ *
+ *  @brief
+ *    The smallest number of bytes gathered into a single send for
+ *    which a TCP endpoint uses MSG_ZEROCOPY. Below about 10KB,
+ *    pinning the pages and handling the completion costs more than
+ *    copying the data.
+ *
+ */
+#ifndef INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH
+#define INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH           10240
+#endif // INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH
+
+/**
+ *  @def INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING
+ *
+ *  @brief
+ *    The maximum number of zero-copy sends of a TCP endpoint that may
+ *    await completion. Further sends are copied until completions
+ *    arrive.
+ *
+ */
+#ifndef INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING
+#define INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING               8
+#endif // INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#error "FORBIDDEN: INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY && (INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING < 1 || INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING > 255)
+#error "FORBIDDEN: INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING must be between 1 and 255"
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY && ...
+
 /**
  *  @def INET_CONFIG_IP_MULTICAST_HOP_LIMIT
  *
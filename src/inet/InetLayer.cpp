@@ -296,6 +296,10 @@ INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext)
     mSystemLayer = &aSystemLayer;
     mContext = aContext;
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    mUDPEndPointsWithQueuedSends = NULL;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     err = InitQueueLimiter();
     SuccessOrExit(err);
@@ -381,6 +385,12 @@ INET_ERROR InetLayer::Shutdown(void)
             if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
             {
                 lEndPoint->Abort();
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+                // Stop waiting for the kernel to finish with the data of any zero-copy sends.
+                if (lEndPoint->State == TCPEndPoint::kState_Closed && lEndPoint->HasPendingZeroCopySends())
+                    lEndPoint->CloseZeroCopySocket();
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
             }
         }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
@@ -1429,6 +1439,11 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     if (State != kState_Initialized)
         return;
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    // Send any datagrams queued since the end of the previous pass before sleeping.
+    FlushUDPSendQueues();
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
     for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
     {
@@ -1601,6 +1616,11 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
     }
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    // Send the datagrams queued by the handlers.
+    FlushUDPSendQueues();
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
     if (mSystemLayer == &mImplicitSystemLayer)
     {
@@ -1611,6 +1631,170 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Prepare to wait on the epoll instance of the underlying system layer.
+ *
+ *  Endpoint sockets are registered with the epoll instance as their
+ *  interest changes, so there is no per-endpoint work to do here. This
+ *  method only exists to forward to the implicit system layer, if any.
+ *
+ *  @param[in]     sleepTime  A reference to the maximum sleep time.
+ *
+ */
+void InetLayer::PrepareEpoll(struct timeval& sleepTime)
+{
+    if (State != kState_Initialized)
+        return;
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    // Send any datagrams queued since the end of the previous pass before sleeping.
+    FlushUDPSendQueues();
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
+#if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
+    if (mSystemLayer == &mImplicitSystemLayer)
+    {
+        mSystemLayer->PrepareEpoll(sleepTime);
+    }
+#endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
+}
+
+/**
+ *  Handle I/O from an epoll_wait call on the epoll instance of the
+ *  underlying system layer. Only the endpoints reported ready are
+ *  visited; the cost is independent of the number of open endpoints.
+ *
+ *  @note
+ *    As with HandleSelectResult(), the pending I/O fields of all ready
+ *    endpoints are set *before* any callbacks are made, so that an
+ *    endpoint closed and re-opened by another endpoint's callback does
+ *    not act on I/O that belonged to its previous incarnation.
+ *
+ *  @param[in]    numEvents    The return value of the epoll_wait call.
+ *
+ *  @param[in]    events       A pointer to the array of ready events.
+ *
+ */
+void InetLayer::HandleEpollResult(int numEvents, const struct epoll_event *events)
+{
+    if (State != kState_Initialized)
+        return;
+
+    if (numEvents < 0)
+        return;
+
+    // Set the pending I/O field for each ready endpoint, limited to the events it registered for.
+    for (int i = 0; i < numEvents; i++)
+    {
+        EndPointBasis* lEndPoint = static_cast<EndPointBasis*>(events[i].data.ptr);
+
+        // Events with a NULL data pointer belong to the system layer wake descriptor.
+        if ((lEndPoint != NULL) && lEndPoint->IsRetained(*mSystemLayer) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+            lEndPoint->mPendingIO = SocketEvents::FromEpollEvents(events[i].events);
+            lEndPoint->mPendingIO.Value &= lEndPoint->mWatchedIO.Value;
+        }
+    }
+
+    // Now call each ready endpoint to handle its pending I/O, then refresh its registration.
+    for (int i = 0; i < numEvents; i++)
+    {
+        EndPointBasis* lEndPoint = static_cast<EndPointBasis*>(events[i].data.ptr);
+
+        if ((lEndPoint == NULL) || !lEndPoint->IsRetained(*mSystemLayer) || !lEndPoint->IsCreatedByInetLayer(*this) ||
+            !lEndPoint->mPendingIO.IsSet())
+            continue;
+
+        // Prevent the end point from being freed while in the middle of a callback.
+        lEndPoint->Retain();
+
+        switch (lEndPoint->mSocketsEndPointType)
+        {
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+        case EndPointBasis::kSocketsEndPointType_Raw:
+        {
+            RawEndPoint* lRawEndPoint = static_cast<RawEndPoint*>(lEndPoint);
+            lRawEndPoint->HandlePendingIO();
+            lRawEndPoint->UpdateSocketWatch(lRawEndPoint->PrepareIO());
+            break;
+        }
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+        case EndPointBasis::kSocketsEndPointType_TCP:
+        {
+            TCPEndPoint* lTCPEndPoint = static_cast<TCPEndPoint*>(lEndPoint);
+            lTCPEndPoint->HandlePendingIO();
+            lTCPEndPoint->UpdateSocketWatch(lTCPEndPoint->PrepareIO());
+            break;
+        }
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+        case EndPointBasis::kSocketsEndPointType_UDP:
+        {
+            UDPEndPoint* lUDPEndPoint = static_cast<UDPEndPoint*>(lEndPoint);
+            lUDPEndPoint->HandlePendingIO();
+            lUDPEndPoint->UpdateSocketWatch(lUDPEndPoint->PrepareIO());
+            break;
+        }
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+        case EndPointBasis::kSocketsEndPointType_Tun:
+        {
+            TunEndPoint* lTunEndPoint = static_cast<TunEndPoint*>(lEndPoint);
+            lTunEndPoint->HandlePendingIO();
+            lTunEndPoint->UpdateSocketWatch(lTunEndPoint->PrepareIO());
+            break;
+        }
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+        default:
+            lEndPoint->mPendingIO.Clear();
+            break;
+        }
+
+        lEndPoint->Release();
+    }
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    // Send the datagrams queued by the handlers.
+    FlushUDPSendQueues();
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
+#if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
+    if (mSystemLayer == &mImplicitSystemLayer)
+    {
+        mSystemLayer->HandleEpollResult(numEvents, events);
+    }
+#endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+/**
+ *  Send the datagrams queued on all UDP endpoints with UDPEndPoint::QueueSendMsg().
+ *
+ *  The event loop calls this before sleeping and after dispatching I/O, so applications only need to
+ *  call it when they drive the InetLayer without PrepareSelect() and HandleSelectResult(), or their
+ *  epoll counterparts. Datagrams that cannot be sent are dropped, and the error logged.
+ *
+ */
+void InetLayer::FlushUDPSendQueues(void)
+{
+    // Each endpoint removes itself from the list as it flushes its queue.
+    while (mUDPEndPointsWithQueuedSends != NULL)
+    {
+        const INET_ERROR lErr = mUDPEndPointsWithQueuedSends->FlushSendQueue();
+
+        if (lErr != INET_NO_ERROR)
+            WeaveLogError(Inet, "Failed to send queued UDP datagrams: %s", ErrorStr(lErr));
+    }
+}
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
 /**
  *  Reset the members of the IPPacketInfo object.
  *
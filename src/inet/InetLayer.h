@@ -288,6 +288,15 @@ class NL_DLL_EXPORT InetLayer
     void HandleSelectResult(int selectRes, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    void PrepareEpoll(struct timeval& sleepTime);
+    void HandleEpollResult(int numEvents, const struct epoll_event *events);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    void FlushUDPSendQueues(void);
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
     static void UpdateSnapshot(nl::Weave::System::Stats::Snapshot &aSnapshot);
 
     void *GetPlatformData(void);
@@ -367,6 +376,10 @@ private:
     void*                   mPlatformData;
     Weave::System::Layer*   mSystemLayer;
 
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+    UDPEndPoint*            mUDPEndPointsWithQueuedSends;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     AsyncDNSResolverSockets mAsyncDNSResolver;
@@ -87,6 +87,52 @@ SocketEvents SocketEvents::FromFDs(int socket, fd_set *readfds, fd_set *writefds
 
     return res;
 }
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Convert the bit flags into the equivalent epoll event mask.
+ *
+ *  @return The epoll event mask to register for the socket.
+ *
+ */
+uint32_t SocketEvents::ToEpollEvents(void) const
+{
+    uint32_t events = 0;
+
+    if (IsReadable())
+        events |= EPOLLIN;
+    if (IsWriteable())
+        events |= EPOLLOUT;
+    if (IsError())
+        events |= EPOLLPRI;
+
+    return events;
+}
+
+/**
+ *  Set the read, write or exception bit flags based on the event mask reported by epoll for a socket.
+ *
+ *  @note
+ *    As with select(), a socket with a pending error or hang-up is reported as both readable and writable so that the
+ *    subsequent read or write surfaces the error. Callers should mask the result with the events actually registered.
+ *
+ *  @param[in]    events    The ready event mask reported by epoll_wait().
+ *
+ */
+SocketEvents SocketEvents::FromEpollEvents(uint32_t events)
+{
+    SocketEvents res;
+
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+        res.SetRead();
+    if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+        res.SetWrite();
+    if (events & EPOLLPRI)
+        res.SetError();
+
+    return res;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
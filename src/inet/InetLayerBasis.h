@@ -36,6 +36,10 @@
 #include <sys/select.h>
 #endif
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 namespace nl {
 namespace Inet {
 
@@ -206,6 +210,11 @@ public:
 
     void SetFDs(int socket, int& nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
     static SocketEvents FromFDs(int socket, fd_set *readfds, fd_set *writefds, fd_set *exceptfds);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    uint32_t ToEpollEvents(void) const;
+    static SocketEvents FromEpollEvents(uint32_t events);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 };
 
 /**
@@ -431,6 +431,10 @@ INET_ERROR RawEndPoint::Listen(void)
     if (res == INET_NO_ERROR)
     {
         mState = kState_Listening;
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
  exit:
@@ -479,6 +483,10 @@ void RawEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            RemoveSocketWatch();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -867,6 +875,10 @@ void RawEndPoint::Init(InetLayer *inetLayer, IPVersion ipVer, IPProtocol ipProto
 {
     IPEndPointBasis::Init(inetLayer);
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketsEndPointType = kSocketsEndPointType_Raw;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     IPVer = ipVer;
     IPProto = ipProto;
 }
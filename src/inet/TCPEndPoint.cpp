@@ -52,14 +52,24 @@
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 #include <sys/socket.h>
 #include <sys/select.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <netinet/in.h>
 #include <netinet/tcp.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+#include <linux/errqueue.h>
+
+#if !defined(MSG_ZEROCOPY) || !defined(SO_ZEROCOPY) || !defined(SO_EE_ORIGIN_ZEROCOPY)
+#error "INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY requires MSG_ZEROCOPY support (Linux 4.14 or later)"
+#endif
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
 #include "arpa-inet-compatibility.h"
 
 // SOCK_CLOEXEC not defined on all platforms, e.g. iOS/MacOS:
@@ -291,6 +301,10 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
         // [or on LwIP, DeferredRelease()] will happen in DoClose().
         Retain();
         State = kState_Listening;
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
     return res;
@@ -504,6 +518,10 @@ INET_ERROR TCPEndPoint::Connect(IPAddress addr, uint16_t port, InterfaceId intf)
     // Wake the thread calling select so that it recognizes the new socket.
     lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     StartConnectTimerIfSet();
@@ -722,6 +740,10 @@ INET_ERROR TCPEndPoint::Send(PacketBuffer *data, bool push)
 
     if (push)
         res = DriveSending();
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    else
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 
     return res;
 }
@@ -747,6 +769,10 @@ void TCPEndPoint::EnableReceive()
     // in the select read fd_set.
     lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 }
 
@@ -1010,6 +1036,38 @@ INET_ERROR TCPEndPoint::SetUserTimeout(uint32_t userTimeoutMillis)
     return res;
 }
 
+/**
+ *  TCPEndPoint::EnableZeroCopy
+ *
+ *  @brief
+ *    Send writes of at least INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH bytes with MSG_ZEROCOPY.
+ *
+ *  @note
+ *    This method can only be called when the endpoint is in one of the connected states.
+ */
+INET_ERROR TCPEndPoint::EnableZeroCopy(void)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+    if (!IsConnected())
+        return INET_ERROR_INCORRECT_STATE;
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    {
+        int val = 1;
+
+        if (setsockopt(mSocket, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val)) != 0)
+            return Weave::System::MapErrorPOSIX(errno);
+
+        mZeroCopyEnabled = true;
+    }
+#else // !INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    res = INET_ERROR_NOT_IMPLEMENTED;
+#endif // !INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+    return res;
+}
+
 INET_ERROR TCPEndPoint::AckReceive(uint16_t len)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -1165,6 +1223,9 @@ bool TCPEndPoint::IsConnected(int state)
 void TCPEndPoint::Init(InetLayer *inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketsEndPointType = kSocketsEndPointType_TCP;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     ReceiveEnabled = true;
 
     // Initialize to zero for using system defaults.
@@ -1194,6 +1255,16 @@ void TCPEndPoint::Init(InetLayer *inetLayer)
 
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    memset(&mSendStats, 0, sizeof(mSendStats));
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    mNextZeroCopyId = 0;
+    mNumZeroCopySends = 0;
+    mZeroCopyEnabled = false;
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     mUnackedLength = 0;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -1321,14 +1392,53 @@ INET_ERROR TCPEndPoint::DriveSending()
                           return err;
                       });
 
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    bool zeroCopyAllowed = mZeroCopyEnabled;
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
     while (mSendQueue != NULL)
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        struct iovec iov[INET_CONFIG_TCP_SEND_MAX_IOVECS];
+        struct msghdr msgHeader;
+        size_t sendLen = 0;
+        int flags = sendFlags;
+
+        // Gather as many buffers of the send queue as possible into a single send.
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov = iov;
+
+        for (PacketBuffer *buf = mSendQueue; buf != NULL && msgHeader.msg_iovlen < INET_CONFIG_TCP_SEND_MAX_IOVECS; buf = buf->Next())
+        {
+            iov[msgHeader.msg_iovlen].iov_base = buf->Start();
+            iov[msgHeader.msg_iovlen].iov_len = buf->DataLength();
+            sendLen += buf->DataLength();
+            msgHeader.msg_iovlen++;
+        }
 
-        ssize_t lenSent = send(mSocket, mSendQueue->Start(), (size_t) bufLen, sendFlags);
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+        // Send large writes without copying them, as long as there is room to track their completion.
+        const bool zeroCopy = zeroCopyAllowed && sendLen >= INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH &&
+            mNumZeroCopySends < INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING;
+        PacketBuffer *zeroCopySentBuffers = NULL;
+        PacketBuffer *zeroCopyPartialBuffer = NULL;
+
+        if (zeroCopy)
+            flags |= MSG_ZEROCOPY;
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+        ssize_t lenSent = sendmsg(mSocket, &msgHeader, flags);
 
         if (lenSent == -1)
         {
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+            // If the kernel is out of memory to pin the pages of a zero-copy send, copy instead.
+            if (zeroCopy && errno == ENOBUFS)
+            {
+                zeroCopyAllowed = false;
+                continue;
+            }
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
             if (errno != EAGAIN && errno != EWOULDBLOCK)
                 err = (errno == EPIPE) ? INET_ERROR_PEER_DISCONNECTED : Weave::System::MapErrorPOSIX(errno);
             break;
@@ -1337,13 +1447,86 @@ INET_ERROR TCPEndPoint::DriveSending()
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
-            mSendQueue->ConsumeHead(lenSent);
-        else
-            mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+        mSendStats.SendCalls++;
+        mSendStats.BytesSent += lenSent;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+        // Remove the sent data from the send queue, releasing the buffers that were completely sent.
+        for (size_t lenRemaining = lenSent; mSendQueue != NULL; )
+        {
+            const uint16_t bufLen = mSendQueue->DataLength();
+
+            if (lenRemaining < bufLen)
+            {
+                if (lenRemaining == 0)
+                    break;
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+                // The kernel may still read the sent part of the buffer, so hold a reference to it until the
+                // send completes.
+                if (zeroCopy)
+                {
+                    mSendQueue->AddRef();
+                    zeroCopyPartialBuffer = mSendQueue;
+                }
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+                mSendQueue->ConsumeHead((uint16_t) lenRemaining);
+                break;
+            }
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+            if (zeroCopy)
+            {
+                PacketBuffer *sentBuf = mSendQueue;
 
+                mSendQueue = sentBuf->Next();
+                if (mSendQueue != NULL)
+                    sentBuf->DetachTail();
+
+                if (zeroCopySentBuffers == NULL)
+                    zeroCopySentBuffers = sentBuf;
+                else
+                    zeroCopySentBuffers->AddToEnd(sentBuf);
+            }
+            else
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+                mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+            mSendStats.BuffersSent++;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+            lenRemaining -= bufLen;
+        }
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+        if (zeroCopy)
+        {
+            ZeroCopySend &zeroCopySend = mZeroCopySends[mNumZeroCopySends++];
+
+            zeroCopySend.SentBuffers = zeroCopySentBuffers;
+            zeroCopySend.PartialBuffer = zeroCopyPartialBuffer;
+            zeroCopySend.Id = mNextZeroCopyId++;
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+            mSendStats.ZeroCopySends++;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+        }
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+        // Report the sent data, in pieces that fit the callback's length argument.
         if (OnDataSent != NULL)
-            OnDataSent(this, (uint16_t) lenSent);
+        {
+            for (size_t lenToReport = lenSent; lenToReport > 0; )
+            {
+                const uint16_t len = (lenToReport > UINT16_MAX) ? UINT16_MAX : (uint16_t) lenToReport;
+
+                OnDataSent(this, len);
+                lenToReport -= len;
+            }
+        }
 
 #if INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
         // TCP Send is not Idle; Set state and notify if needed
@@ -1378,7 +1561,7 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        if ((size_t) lenSent < sendLen)
             break;
     }
 
@@ -1390,6 +1573,10 @@ INET_ERROR TCPEndPoint::DriveSending()
             if (shutdown(mSocket, SHUT_WR) != 0)
                 err = Weave::System::MapErrorPOSIX(errno);
         }
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -1453,7 +1640,7 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
     // AND there is data waiting to be processed on either the send or receive queues
     // ... THEN enter the Closing state, allowing the queued data to drain,
     // ... OTHERWISE go straight to the Closed state.
-    if (IsConnected() && err == INET_NO_ERROR && (mSendQueue != NULL || mRcvQueue != NULL))
+    if (IsConnected() && err == INET_NO_ERROR && (mSendQueue != NULL || mRcvQueue != NULL || HasPendingZeroCopySends()))
         State = kState_Closing;
     else
         State = kState_Closed;
@@ -1541,10 +1728,11 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
     if (mSocket != INET_INVALID_SOCKET_FD)
     {
         // If entering the Closed state
-        // OR if entering the Closing state, and there's no unsent data in the send queue
+        // OR if entering the Closing state, and there's no unsent data in the send queue, nor any sent data
+        // the kernel may still be reading from the send buffers,
         // THEN close the socket.
         if (State == kState_Closed ||
-            (State == kState_Closing && mSendQueue == NULL))
+            (State == kState_Closing && mSendQueue == NULL && !HasPendingZeroCopySends()))
         {
             Weave::System::Layer& lSystemLayer = SystemLayer();
 
@@ -1558,13 +1746,51 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     WeaveLogError(Inet, "SO_LINGER: %d", errno);
             }
 
-            if (close(mSocket) != 0 && err == INET_NO_ERROR)
-                err = Weave::System::MapErrorPOSIX(errno);
-            mSocket = INET_INVALID_SOCKET_FD;
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+            // The kernel may still be reading from the buffers of zero-copy sends, and only reports when it has finished on the
+            // error queue of the open socket. So keep the socket, and a reference to the end point, until it has; see
+            // HandleZeroCopyCompletions(). An abortive close still resets the connection at once, by disconnecting the socket.
+            if (HasPendingZeroCopySends())
+            {
+                if (IsConnected(oldState) && err != INET_NO_ERROR)
+                {
+                    struct sockaddr unspecAddr;
+
+                    memset(&unspecAddr, 0, sizeof(unspecAddr));
+                    unspecAddr.sa_family = AF_UNSPEC;
 
-            // Wake the thread calling select so that it recognizes the socket is closed.
-            lSystemLayer.WakeSelect();
+                    if (connect(mSocket, &unspecAddr, sizeof(unspecAddr)) != 0)
+                        WeaveLogError(Inet, "Disconnect: %d", errno);
+                }
+
+                Retain();
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+                UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            }
+            else
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+            {
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+                RemoveSocketWatch();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+                if (close(mSocket) != 0 && err == INET_NO_ERROR)
+                    err = Weave::System::MapErrorPOSIX(errno);
+                mSocket = INET_INVALID_SOCKET_FD;
+
+                // Wake the thread calling select so that it recognizes the socket is closed.
+                lSystemLayer.WakeSelect();
+            }
         }
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        else
+        {
+            // Still draining the send queue; stop watching for anything but writability.
+            UpdateSocketWatch(PrepareIO());
+        }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
     // Clear any results from select() that indicate pending I/O for the socket.
@@ -2375,6 +2601,13 @@ SocketEvents TCPEndPoint::PrepareIO()
         ((State == kState_Connected || State == kState_SendShutdown) && ReceiveEnabled && OnDataReceived != NULL))
         ioType.SetRead();
 
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    // If zero-copy sends await completion, arrange to be alerted when the kernel reports their completion
+    // on the socket error queue, which makes the socket readable.
+    if (mNumZeroCopySends != 0)
+        ioType.SetRead();
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
     return ioType;
 }
 
@@ -2411,6 +2644,20 @@ void TCPEndPoint::HandlePendingIO()
 
     else
     {
+        bool isReceivable = mPendingIO.IsReadable();
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+        // Release the buffers of any completed zero-copy sends. As the completions alone make the socket
+        // readable, check for inbound data before attempting to receive it.
+        if (mNumZeroCopySends != 0 && isReceivable && HandleZeroCopyCompletions() && mSocket != INET_INVALID_SOCKET_FD)
+        {
+            uint8_t peekByte;
+            ssize_t peekLen = recv(mSocket, &peekByte, sizeof(peekByte), MSG_PEEK | MSG_DONTWAIT);
+
+            isReceivable = (peekLen >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK));
+        }
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
         // If in a state where sending is allowed, and there is data to be sent, and the socket is ready for
         // writing, drive outbound data into the connection.
         if (IsConnected() && mSendQueue != NULL && mPendingIO.IsWriteable())
@@ -2418,7 +2665,7 @@ void TCPEndPoint::HandlePendingIO()
 
         // If in a state were receiving is allowed, and the app is ready to receive data, and data is ready
         // on the socket, receive inbound data from the connection.
-        if ((State == kState_Connected || State == kState_SendShutdown) && ReceiveEnabled && OnDataReceived != NULL && mPendingIO.IsReadable())
+        if ((State == kState_Connected || State == kState_SendShutdown) && ReceiveEnabled && OnDataReceived != NULL && isReceivable)
             ReceiveData();
     }
 
@@ -2560,6 +2807,109 @@ void TCPEndPoint::ReceiveData()
     DriveReceiving();
 }
 
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+/**
+ *  Release the buffers of the zero-copy sends whose completion the kernel has reported on the socket error queue.
+ *
+ *  @return true if any completion was reported, false otherwise.
+ */
+bool TCPEndPoint::HandleZeroCopyCompletions(void)
+{
+    bool completed = false;
+
+    while (mNumZeroCopySends != 0)
+    {
+        uint8_t controlData[256];
+        struct msghdr msgHeader;
+
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_control = controlData;
+        msgHeader.msg_controllen = sizeof(controlData);
+
+        if (recvmsg(mSocket, &msgHeader, MSG_ERRQUEUE) < 0)
+            break;
+
+        for (struct cmsghdr *controlMsg = CMSG_FIRSTHDR(&msgHeader); controlMsg != NULL; controlMsg = CMSG_NXTHDR(&msgHeader, controlMsg))
+        {
+            const struct sock_extended_err *extErr;
+
+            if (!(controlMsg->cmsg_level == IPPROTO_IP && controlMsg->cmsg_type == IP_RECVERR) &&
+                !(controlMsg->cmsg_level == IPPROTO_IPV6 && controlMsg->cmsg_type == IPV6_RECVERR))
+                continue;
+
+            extErr = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(controlMsg));
+            if (extErr->ee_errno != 0 || extErr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+
+            // Each completion reports the range of sequence numbers of the sends it covers.
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+            if (extErr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                mSendStats.ZeroCopyCopied += extErr->ee_data - extErr->ee_info + 1;
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+            ReleaseZeroCopySends(extErr->ee_info, extErr->ee_data);
+            completed = true;
+        }
+    }
+
+    if (completed && mNumZeroCopySends == 0)
+    {
+        // If the connection is closing, and was only waiting for the kernel to finish with the sent data, close it.
+        if (State == kState_Closing && mSendQueue == NULL && mRcvQueue == NULL)
+            DoClose(INET_NO_ERROR, false);
+
+        // If the end point is closed, and only kept its socket to hear of these completions, close it.
+        else if (State == kState_Closed)
+            CloseZeroCopySocket();
+    }
+
+    return completed;
+}
+
+/**
+ *  Close the socket a closed end point kept open to hear of the completion of its zero-copy sends, release the buffers of any
+ *  sends still pending, and drop the reference DoClose() kept to the end point.
+ */
+void TCPEndPoint::CloseZeroCopySocket(void)
+{
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    RemoveSocketWatch();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+    close(mSocket);
+    mSocket = INET_INVALID_SOCKET_FD;
+
+    // With the socket gone, the kernel no longer holds any of the buffers: the range from the next sequence number around to
+    // the last one covers every sequence number.
+    ReleaseZeroCopySends(mNextZeroCopyId, mNextZeroCopyId - 1);
+
+    SystemLayer().WakeSelect();
+
+    Release();
+}
+
+/**
+ *  Release the buffers of the zero-copy sends with sequence numbers from aFirstId to aLastId, inclusive.
+ */
+void TCPEndPoint::ReleaseZeroCopySends(uint32_t aFirstId, uint32_t aLastId)
+{
+    for (uint8_t i = 0; i < mNumZeroCopySends; )
+    {
+        ZeroCopySend &zeroCopySend = mZeroCopySends[i];
+
+        // Sequence numbers wrap, so compare their distances from the start of the range.
+        if (zeroCopySend.Id - aFirstId <= aLastId - aFirstId)
+        {
+            PacketBuffer::Free(zeroCopySend.SentBuffers);
+            PacketBuffer::Free(zeroCopySend.PartialBuffer);
+            zeroCopySend = mZeroCopySends[--mNumZeroCopySends];
+        }
+        else
+            i++;
+    }
+}
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
 void TCPEndPoint::HandleIncomingConnection()
 {
     INET_ERROR err = INET_NO_ERROR;
@@ -2625,8 +2975,18 @@ void TCPEndPoint::HandleIncomingConnection()
 #endif // !INET_CONFIG_ENABLE_IPV4
         conEP->Retain();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        // Hold the new end point across the callback so that its socket can be watched for whatever I/O the app enables.
+        conEP->Retain();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
         // Call the app's callback function.
         OnConnectionReceived(this, conEP, peerAddr, peerPort);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        conEP->UpdateSocketWatch(conEP->PrepareIO());
+        conEP->Release();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
     // Otherwise immediately close the connection, clean up and call the app's error callback.
@@ -277,6 +277,24 @@ public:
      */
     INET_ERROR SetUserTimeout(uint32_t userTimeoutMillis);
 
+    /**
+     * @brief   Send large writes without copying them into the kernel.
+     *
+     * @retval  INET_NO_ERROR           success: zero-copy sends enabled.
+     * @retval  INET_ERROR_INCORRECT_STATE  TCP connection not established.
+     * @retval  INET_ERROR_NOT_IMPLEMENTED  system implementation not complete.
+     *
+     * @retval  other                   another system or platform error
+     *
+     * @details
+     *  Set the SO_ZEROCOPY socket option, so that sends of at least
+     *  #INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH bytes use MSG_ZEROCOPY.
+     *  The packet buffers of such sends are released when the kernel
+     *  reports their transmission complete, rather than when they are sent.
+     *  Requires #INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY.
+     */
+    INET_ERROR EnableZeroCopy(void);
+
     /**
      * @brief   Acknowledge receipt of message text.
      *
@@ -327,6 +345,31 @@ public:
      */
     uint32_t PendingReceiveLength(void);
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    /**
+     * @brief   Counts of the send system calls made by the endpoint.
+     *
+     * @details
+     *  BuffersSent / SendCalls is the average number of packet buffers
+     *  gathered into each system call.
+     */
+    struct SendStats
+    {
+        uint32_t SendCalls;                             /**< System calls that sent data. */
+        uint32_t BuffersSent;                           /**< Packet buffers whose data was completely sent. */
+        uint32_t BytesSent;                             /**< Bytes sent. */
+        uint32_t ZeroCopySends;                         /**< System calls that sent data with MSG_ZEROCOPY. */
+        uint32_t ZeroCopyCopied;                        /**< Zero-copy sends the kernel completed by copying the data anyway. */
+    };
+
+    /**
+     * @brief   Extract the send statistics of the endpoint.
+     *
+     * @return  The counts accumulated since the endpoint was allocated.
+     */
+    const SendStats &GetSendStats(void) const;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
     /**
      * @brief   Initiate TCP half close, in other words, finished with sending.
      *
@@ -603,6 +646,28 @@ private:
 
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    SendStats mSendStats;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    struct ZeroCopySend
+    {
+        Weave::System::PacketBuffer *SentBuffers;       // The buffers completely sent by the zero-copy send.
+        Weave::System::PacketBuffer *PartialBuffer;     // A reference to the buffer partially sent by it, if any.
+        uint32_t Id;                                    // The kernel's sequence number for the send.
+    };
+
+    ZeroCopySend mZeroCopySends[INET_CONFIG_TCP_ZEROCOPY_MAX_PENDING];
+    uint32_t mNextZeroCopyId;                           // The sequence number the kernel assigns to the next zero-copy send.
+    uint8_t mNumZeroCopySends;                          // The number of zero-copy sends awaiting completion.
+    bool mZeroCopyEnabled;
+
+    bool HandleZeroCopyCompletions(void);
+    void ReleaseZeroCopySends(uint32_t aFirstId, uint32_t aLastId);
+    void CloseZeroCopySocket(void);
+#endif // INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
     TCPEndPoint(void);                                  // not defined
     TCPEndPoint(const TCPEndPoint&);                    // not defined
     ~TCPEndPoint(void);                                 // not defined
@@ -613,6 +678,7 @@ private:
     void HandleConnectComplete(INET_ERROR err);
     void HandleAcceptError(INET_ERROR err);
     INET_ERROR DoClose(INET_ERROR err, bool suppressCallback);
+    bool HasPendingZeroCopySends(void) const;
     static bool IsConnected(int state);
 
     static void TCPConnectTimeoutHandler(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError);
@@ -684,6 +750,22 @@ inline void TCPEndPoint::MarkActive(void)
 #endif // INET_TCP_IDLE_CHECK_INTERVAL > 0
 }
 
+inline bool TCPEndPoint::HasPendingZeroCopySends(void) const
+{
+#if INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    return mNumZeroCopySends != 0;
+#else // !INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+    return false;
+#endif // !INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+}
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+inline const TCPEndPoint::SendStats &TCPEndPoint::GetSendStats(void) const
+{
+    return mSendStats;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
 } // namespace Inet
 } // namespace nl
 
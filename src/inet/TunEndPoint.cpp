@@ -62,6 +62,9 @@ using namespace nl::Weave::Encoding;
 void TunEndPoint::Init(InetLayer *inetLayer)
 {
     InitEndPointBasis(*inetLayer);
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketsEndPointType = kSocketsEndPointType_Tun;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
@@ -110,8 +113,14 @@ INET_ERROR TunEndPoint::Open (const char *intfName)
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     if (err == INET_NO_ERROR)
+    {
         mState = kState_Open;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    }
+
 exit:
 
     return err;
@@ -137,6 +146,11 @@ void TunEndPoint::Close (void)
 
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            RemoveSocketWatch();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
             TunDevClose();
         }
 
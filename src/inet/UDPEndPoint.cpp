@@ -322,6 +322,10 @@ INET_ERROR UDPEndPoint::Listen(void)
     if (res == INET_NO_ERROR)
     {
         mState = kState_Listening;
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        UpdateSocketWatch(PrepareIO());
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
     }
 
  exit:
@@ -363,6 +367,11 @@ void UDPEndPoint::Close(void)
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+        // Send any queued datagrams while the socket is still open.
+        FlushSendQueue();
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
         if (mSocket != INET_INVALID_SOCKET_FD)
         {
             Weave::System::Layer& lSystemLayer = SystemLayer();
@@ -370,6 +379,10 @@ void UDPEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            RemoveSocketWatch();
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -736,6 +749,16 @@ exit:
 void UDPEndPoint::Init(InetLayer *inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    mSocketsEndPointType = kSocketsEndPointType_UDP;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    mNextWithQueuedSends = NULL;
+    mSendQueueLength = 0;
+    mReceiveBatchSize = 1;
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
 }
 
 /**
@@ -924,12 +947,178 @@ void UDPEndPoint::HandlePendingIO(void)
     {
         const uint16_t lPort = mBoundPort;
 
-        IPEndPointBasis::HandlePendingIO(lPort);
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+        if (mReceiveBatchSize > 1)
+            IPEndPointBasis::HandlePendingIO(lPort, mReceiveBatchSize);
+        else
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+            IPEndPointBasis::HandlePendingIO(lPort);
     }
 
     mPendingIO.Clear();
 }
 
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+/**
+ * @brief   Set the maximum number of datagrams received per readiness event.
+ *
+ * @param[in]   aBatchSize  the maximum number of datagrams, between 1, the default, and
+ *                          #INET_CONFIG_UDP_BATCH_SIZE.
+ *
+ * @retval  INET_NO_ERROR           success: the batch size is set.
+ * @retval  INET_ERROR_BAD_ARGS     \c aBatchSize is out of range.
+ *
+ * @details
+ *  When the batch size is greater than one, each readiness event drains up to that many
+ *  datagrams from the socket, with a single system call where the system provides
+ *  recvmmsg(). Each datagram is delivered to \c OnMessageReceived in its own packet
+ *  buffer, with its own packet information, as with a batch size of one.
+ */
+INET_ERROR UDPEndPoint::SetReceiveBatchSize(uint8_t aBatchSize)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+    VerifyOrExit(aBatchSize >= 1 && aBatchSize <= INET_CONFIG_UDP_BATCH_SIZE, res = INET_ERROR_BAD_ARGS);
+
+    mReceiveBatchSize = aBatchSize;
+
+exit:
+    return res;
+}
+
+/**
+ * @brief   Queue a UDP message to be sent at the end of the current event loop pass.
+ *
+ * @param[in]   pktInfo     source and destination information for the UDP message
+ * @param[in]   msg         a packet buffer containing the UDP message
+ * @param[in]   sendFlags   optional transmit option flags
+ *
+ * @retval  INET_NO_ERROR
+ *      success: \c msg is queued for transmit.
+ *
+ * @retval  INET_ERROR_BAD_ARGS
+ *      the destination address and the socket address type do not match.
+ *
+ * @retval  INET_ERROR_MESSAGE_TOO_LONG
+ *      \c msg does not contain the whole UDP message.
+ *
+ * @retval  other
+ *      another system or platform error, including those of sending the
+ *      queue when it is full.
+ *
+ * @details
+ *  Queued messages are sent together, with a single system call where the system provides
+ *  sendmmsg(), when the queue fills, when the InetLayer event loop completes a pass, or when
+ *  FlushSendQueue() is called. Errors encountered while sending queued messages outside of
+ *  this call are logged, and the messages dropped, as UDP allows.
+ *
+ *  Where <tt>(sendFlags & kSendFlag_RetainBuffer) != 0</tt>, the caller keeps its
+ *  reference to \c msg, and must not modify it until the queue is sent; otherwise, this
+ *  method takes ownership of \c msg.
+ */
+INET_ERROR UDPEndPoint::QueueSendMsg(const IPPacketInfo *pktInfo, PacketBuffer *msg, uint16_t sendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    const IPAddress & destAddr = pktInfo->DestAddress;
+    InetLayer & lInetLayer = Layer();
+    QueuedMsg * lQueuedMsg;
+
+    res = GetSocket(destAddr.Type());
+    SuccessOrExit(res);
+
+    // Check what can be checked now, so that sending the queue only fails for reasons beyond the caller's control.
+    VerifyOrExit(mAddrType == destAddr.Type(), res = INET_ERROR_BAD_ARGS);
+    {
+        size_t lNumBuffers = 0;
+
+        for (PacketBuffer *lBuffer = msg; lBuffer != NULL; lBuffer = lBuffer->Next())
+            lNumBuffers++;
+
+        VerifyOrExit(lNumBuffers <= INET_CONFIG_UDP_SEND_MAX_IOVECS, res = INET_ERROR_MESSAGE_TOO_LONG);
+    }
+
+    if (mSendQueueLength == 0)
+    {
+        mNextWithQueuedSends = lInetLayer.mUDPEndPointsWithQueuedSends;
+        lInetLayer.mUDPEndPointsWithQueuedSends = this;
+    }
+
+    if ((sendFlags & kSendFlag_RetainBuffer) != 0)
+        msg->AddRef();
+
+    lQueuedMsg = &mSendQueue[mSendQueueLength++];
+    lQueuedMsg->Buffer = msg;
+    lQueuedMsg->SrcAddress = pktInfo->SrcAddress;
+    lQueuedMsg->DestAddress = destAddr;
+    lQueuedMsg->Interface = pktInfo->Interface;
+    lQueuedMsg->DestPort = pktInfo->DestPort;
+    msg = NULL;
+
+    if (mSendQueueLength == INET_CONFIG_UDP_BATCH_SIZE)
+        res = FlushSendQueue();
+
+exit:
+    if (msg != NULL && (sendFlags & kSendFlag_RetainBuffer) == 0)
+        PacketBuffer::Free(msg);
+
+    return res;
+}
+
+/**
+ * @brief   Send the UDP messages queued with QueueSendMsg().
+ *
+ * @retval  INET_NO_ERROR   success: all of the queued messages were sent.
+ * @retval  other           the error that stopped the first message not sent; it and the
+ *                          following messages are dropped.
+ */
+INET_ERROR UDPEndPoint::FlushSendQueue(void)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    IPPacketInfo lPktInfos[INET_CONFIG_UDP_BATCH_SIZE];
+    PacketBuffer * lBuffers[INET_CONFIG_UDP_BATCH_SIZE];
+    const uint8_t lCount = mSendQueueLength;
+    uint8_t lNumSent;
+
+    VerifyOrExit(lCount > 0, );
+
+    // Empty the queue first, so that it may be refilled if the send fails.
+    UnlinkSendQueue();
+    mSendQueueLength = 0;
+
+    for (uint8_t i = 0; i < lCount; i++)
+    {
+        lPktInfos[i].Clear();
+        lPktInfos[i].SrcAddress = mSendQueue[i].SrcAddress;
+        lPktInfos[i].DestAddress = mSendQueue[i].DestAddress;
+        lPktInfos[i].Interface = mSendQueue[i].Interface;
+        lPktInfos[i].DestPort = mSendQueue[i].DestPort;
+        lBuffers[i] = mSendQueue[i].Buffer;
+    }
+
+    res = SendMsgs(lPktInfos, lBuffers, lCount, lNumSent);
+
+    for (uint8_t i = 0; i < lCount; i++)
+        PacketBuffer::Free(lBuffers[i]);
+
+exit:
+    return res;
+}
+
+// Remove the endpoint from the InetLayer list of those with queued datagrams.
+void UDPEndPoint::UnlinkSendQueue(void)
+{
+    UDPEndPoint ** lLink = &Layer().mUDPEndPointsWithQueuedSends;
+
+    while (*lLink != NULL && *lLink != this)
+        lLink = &(*lLink)->mNextWithQueuedSends;
+
+    if (*lLink == this)
+        *lLink = mNextWithQueuedSends;
+
+    mNextWithQueuedSends = NULL;
+}
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
@@ -64,6 +64,12 @@ public:
     void Close(void);
     void Free(void);
 
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    INET_ERROR SetReceiveBatchSize(uint8_t aBatchSize);
+    INET_ERROR QueueSendMsg(const IPPacketInfo *pktInfo, Weave::System::PacketBuffer *msg, uint16_t sendFlags = 0);
+    INET_ERROR FlushSendQueue(void);
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
 private:
     UDPEndPoint(void);                                  // not defined
     UDPEndPoint(const UDPEndPoint&);                    // not defined
@@ -89,6 +95,25 @@ private:
     INET_ERROR GetSocket(IPAddressType addrType);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(void);
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    // A datagram queued for sending, with the packet information needed to send it.
+    struct QueuedMsg
+    {
+        Weave::System::PacketBuffer *Buffer;
+        IPAddress SrcAddress;
+        IPAddress DestAddress;
+        InterfaceId Interface;
+        uint16_t DestPort;
+    };
+
+    QueuedMsg mSendQueue[INET_CONFIG_UDP_BATCH_SIZE];
+    UDPEndPoint *mNextWithQueuedSends;                  // The next endpoint in the InetLayer list of those with queued datagrams.
+    uint8_t mSendQueueLength;
+    uint8_t mReceiveBatchSize;
+
+    void UnlinkSendQueue(void);
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 };
 
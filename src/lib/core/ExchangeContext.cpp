@@ -599,7 +599,7 @@ WEAVE_ERROR ExchangeContext::SendMessage(uint32_t profileId, uint8_t msgType, Pa
             SuccessOrExit(err);
 
             WEAVE_FAULT_INJECT(FaultInjection::kFault_WRMDoubleTx,
-                               entry->nextRetransTime = 0;
+                               ExchangeMgr->SetRetransTime(*entry, 0);
                                ExchangeMgr->WRMPStartTimer()
                                );
 
@@ -906,6 +906,9 @@ void ExchangeContext::Release(void)
         mRefCount = 0;
         ExchangeMgr = NULL;
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        em->FreeContext(this);
+#endif
         em->mContextsInUse--;
         em->MessageLayer->SignalMessageLayerActivityChanged();
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
@@ -1164,29 +1167,21 @@ void ExchangeContext::HandleResponseTimeout(System::Layer* aSystemLayer, void* a
 bool ExchangeContext::WRMPCheckAndRemRetransTable(uint32_t ackMsgId, void **rCtxt)
 {
     bool res = false;
+    WeaveExchangeManager::RetransTableEntry *entry = ExchangeMgr->FindRetransEntry(this, ackMsgId);
 
-    for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    if (entry != NULL)
     {
-        if ((ExchangeMgr->RetransTable[i].exchContext == this) &&
-            (ExchangeMgr->RetransTable[i].msgId == ackMsgId))
-        {
-            //Return context value
-            *rCtxt = ExchangeMgr->RetransTable[i].msgCtxt;
+        //Return context value
+        *rCtxt = entry->msgCtxt;
 
-            //Clear the entry from the retransmision table.
-            ExchangeMgr->ClearRetransmitTable(ExchangeMgr->RetransTable[i]);
+        //Clear the entry from the retransmision table.
+        ExchangeMgr->ClearRetransmitTable(*entry);
 
 #if defined(DEBUG)
-            WeaveLogProgress(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table",
-                             ackMsgId);
+        WeaveLogProgress(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table",
+                         ackMsgId);
 #endif
-            res = true;
-            break;
-        }
-        else
-        {
-            continue;
-        }
+        res = true;
     }
 
     return res;
@@ -1469,23 +1464,35 @@ WEAVE_ERROR ExchangeContext::HandleThrottleFlow(uint32_t PauseTimeMillis)
 
     // Go through the retrans table entries for that node and adjust the timer.
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    // The first entry found by a scan of the table is adjusted; with the table
+    // indexed, that is the oldest entry of this context.
+    if (mWRMPRetransHead != 0)
+    {
+        WeaveExchangeManager::RetransTableEntry &entry = ExchangeMgr->RetransTable[mWRMPRetransHead - 1];
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
+        WeaveExchangeManager::RetransTableEntry &entry = ExchangeMgr->RetransTable[i];
+
         // Check if ExchangeContext matches
 
-        if (ExchangeMgr->RetransTable[i].exchContext == this)
+        if (entry.exchContext == this)
+#endif
         {
             // Adjust the retrans timer value to account for throttling.
             if (0 != PauseTimeMillis)
             {
-                ExchangeMgr->RetransTable[i].nextRetransTime += PauseTimeMillis / ExchangeMgr->mWRMPTimerInterval;
+                ExchangeMgr->SetRetransTime(entry, ExchangeMgr->GetRetransTime(entry) + PauseTimeMillis / ExchangeMgr->mWRMPTimerInterval);
             }
             // UnThrottle when PauseTimeMillis is set to 0
             else
             {
-                ExchangeMgr->RetransTable[i].nextRetransTime = 0;
+                ExchangeMgr->SetRetransTime(entry, 0);
             }
+#if !WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
             break;
+#endif
         }
     }
     // Call OnThrottleRcvd application callback
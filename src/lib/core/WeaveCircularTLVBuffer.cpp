@@ -425,6 +425,7 @@ void CircularTLVWriter::Init(WeaveCircularTLVBuffer *buf)
     mContainerType = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(false);
+    SetSizeOnly(false);
 
     ImplicitProfileId = kProfileIdNotSpecified;
     GetNewBuffer = WeaveCircularTLVBuffer::GetNewBufferFunct;
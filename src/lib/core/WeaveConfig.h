@@ -1077,6 +1077,53 @@
 #define WEAVE_CONFIG_MAX_SESSION_KEYS                       WEAVE_CONFIG_MAX_CONNECTIONS
 #endif // WEAVE_CONFIG_MAX_SESSION_KEYS
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+ *
+ *  @brief
+ *    Enable (1) or disable (0) hash indexes over the peer state and
+ *    session key tables of the fabric state.
+ *
+ *    When enabled, the fabric state looks up peer states by node id
+ *    and session keys by key id through open-addressed hash tables,
+ *    and keeps the peer states in a linked list ordered by recency of
+ *    use, so that the per-message cost of duplicate detection and key
+ *    lookup does not grow with #WEAVE_CONFIG_MAX_PEER_NODES or
+ *    #WEAVE_CONFIG_MAX_SESSION_KEYS. This costs about 17 bytes per
+ *    peer node and 18 bytes per session key, and is worthwhile for
+ *    nodes, such as border routers, that are configured to track
+ *    thousands of peers.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+#define WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX              0
+#endif // WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX && (WEAVE_CONFIG_MAX_PEER_NODES > 65535 || WEAVE_CONFIG_MAX_SESSION_KEYS > 65535)
+#error "FORBIDDEN: WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX supports at most 65535 peer nodes and session keys"
+#endif // WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX && ...
+
+/**
+ *  @def WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+ *
+ *  @brief
+ *    Enable (1) or disable (0) caching of expanded message encryption
+ *    keys.
+ *
+ *    When enabled, the fabric state expands the AES key schedule and
+ *    precomputes the HMAC-SHA-1 inner and outer hash states of each
+ *    message encryption key when the key is installed, and wipes them
+ *    along with the key, so that encoding and decoding a message does
+ *    not repeat that setup. This costs, depending on the AES and SHA-1
+ *    implementations, a few hundred bytes per session key and per
+ *    application key cache entry, and is worthwhile for nodes that
+ *    exchange many small encrypted messages.
+ *
+ */
+#ifndef WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+#define WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES            0
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  *  @def WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS
  *
@@ -1267,6 +1314,31 @@
 #define WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS                  16
 #endif // WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+ *
+ *  @brief
+ *    Enable (1) or disable (0) hash indexes over the exchange context
+ *    and unsolicited message handler pools.
+ *
+ *    When enabled, the exchange manager matches inbound messages to
+ *    exchange contexts and unsolicited message handlers through
+ *    open-addressed hash tables, and allocates exchange contexts from
+ *    a free list, so that the cost of dispatching a message does not
+ *    grow with #WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS. This costs about
+ *    18 bytes per exchange context and 16 bytes per unsolicited
+ *    message handler, and is worthwhile for nodes configured with
+ *    hundreds or thousands of exchange contexts.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+#define WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX                  0
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX && (WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS > 65535 || WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS > 65535)
+#error "FORBIDDEN: WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX supports at most 65535 exchange contexts and unsolicited message handlers"
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX && ...
+
 /**
  *  @def WEAVE_CONFIG_MAX_BINDINGS
  *
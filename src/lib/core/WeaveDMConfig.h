@@ -403,6 +403,22 @@
 #define WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE  10
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+ *
+ *  @brief
+ *    Determines the number of schema handles that can be tracked in the per trait instance dirty bitmap used by the
+ *    intermediate graph solver. Properties that are not part of a dictionary element and whose schema handle falls below
+ *    this bound are marked dirty in constant time and never degrade the trait instance to being entirely dirty. Dictionary
+ *    elements and any handles beyond this bound continue to be tracked in the granular dirty store.
+ *
+ *    Each trait data source grows by this many bits (rounded up to a 32-bit word). Set to 0 to disable the bitmap and track
+ *    all dirty handles in the granular dirty store.
+ */
+#ifndef WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+#define WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP 0
+#endif
+
 /**
  *  @def WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET
  *
@@ -441,6 +457,47 @@
 #define WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT 4
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN
+ *
+ *  @brief
+ *    Controls the maximum number of notifies the notification engine will send out in a single invocation of its run loop. Once
+ *    the budget is spent, the engine reschedules itself on the Weave thread and resumes with the next subscription, allowing other
+ *    work on the event loop to proceed in between. Set to 0 to not limit the number of notifies per run. This is the default
+ *    budget; it can be changed at runtime with NotificationEngine::SetMaxNotifiesPerRun().
+ *
+ */
+#ifndef WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN
+#define WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN 0
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_MAX_RUN_TIME_MS
+ *
+ *  @brief
+ *    Controls the maximum amount of time, in milliseconds, that a single invocation of the notification engine's run loop will
+ *    spend evaluating subscriptions before rescheduling itself on the Weave thread. The budget is also checked after each trait
+ *    instance written into a notify, so a subscription with many dirty trait instances is sent what has been written so far and
+ *    resumed from the next trait instance in a later run. Set to 0 to not limit the time spent per run.
+ *
+ */
+#ifndef WDM_PUBLISHER_MAX_RUN_TIME_MS
+#define WDM_PUBLISHER_MAX_RUN_TIME_MS 0
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+ *
+ *  @brief
+ *    Enable (1) or disable (0) tracking of the latency between a trait instance being marked dirty and the notify carrying the
+ *    change being sent to each subscriber. Latencies are recorded in a histogram of power-of-two millisecond buckets that can be
+ *    retrieved from the notification engine.
+ *
+ */
+#ifndef WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+#define WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS 0
+#endif
+
 /**
  * The auto-generated schema tables key off this define to enable/disable certain fields in the tables. Enable this for now, but remove this define
  * once it has been similarly removed from the auto-generated code since all products are expected to need dictionary support, so the savings in flash/ram
@@ -478,6 +535,30 @@
 #define TDM_VERSIONING_SUPPORT 1
 #endif
 
+/**
+ * @def TDM_SCHEMA_INDEX_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) a first-child/next-sibling index
+ *   of the schema tree, built by each trait schema engine the first
+ *   time it is queried. With the index, child iteration, leaf tests
+ *   and depth queries no longer scan the schema handle table.
+ */
+#ifndef TDM_SCHEMA_INDEX_SUPPORT
+#define TDM_SCHEMA_INDEX_SUPPORT 0
+#endif
+
+/**
+ * @def TDM_SCHEMA_INDEX_POOL_SIZE
+ *
+ * @brief The total number of schema index entries shared by all
+ *   trait schema engines. An engine needs one entry per schema
+ *   handle, plus one for the root; engines that do not fit in the
+ *   pool keep scanning their schema handle table.
+ */
+#ifndef TDM_SCHEMA_INDEX_POOL_SIZE
+#define TDM_SCHEMA_INDEX_POOL_SIZE 512
+#endif
+
 /**
  *  @def WDM_PUBLISHER_ENABLE_CUSTOM_COMMAND_HANDLER
  *
@@ -712,6 +793,60 @@
 #define WDM_RESUBSCRIBE_WAIT_TIME_MULTIPLIER_MS 10000
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+ *
+ *  @brief
+ *    Enable (1) or disable (0) caching of the encoded size of
+ *    published trait data.  When enabled, each TraitDataSource
+ *    remembers the size of its most recent encoding, keyed on the
+ *    property path handle, tag and data version, and the
+ *    notification engine uses a size still valid from an earlier
+ *    encoding to skip data elements that will not fit in the
+ *    current notify request instead of encoding and rolling them
+ *    back.
+ *
+ */
+#ifndef WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+#define WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE 0
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+ *
+ *  @brief
+ *    Size, in bytes, of the buffer the notification engine uses to
+ *    share encoded data elements across subscribers during a single
+ *    evaluation pass.  When non-zero, a data element destined for
+ *    several subscribers of the same trait instance is encoded once,
+ *    keyed on the trait data handle, property path handle, data and
+ *    schema versions, and copied into each subscriber's notify.
+ *    An element is only encoded into the cache while the cache has
+ *    at least as much free space as is left in the notify being
+ *    built, so this should be comfortably larger than
+ *    #WDM_MAX_NOTIFICATION_SIZE.  Set to 0 to disable the cache.
+ *
+ */
+#ifndef WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+#define WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE 0
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES
+ *
+ *  @brief
+ *    Maximum number of encoded data elements held in the notify
+ *    encoding cache (see #WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE).
+ *
+ */
+#ifndef WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES
+#define WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES 8
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE > 65535
+#error "FORBIDDEN: WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE cannot exceed 65535"
+#endif
+
 /**
  *  @def WEAVE_CONFIG_DATAMANAGEMENT_CLIENT_EXPERIMENTAL
  *
@@ -176,4 +176,202 @@
 #define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 0
 #endif
 
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+ *
+ * @brief
+ *   The number of seek checkpoints kept for each event buffer.  The
+ *   checkpoints let FetchEventsSince() start reading close to the
+ *   requested event rather than at the oldest event in the buffer;
+ *   they are spread evenly over the size of the buffer.  Each
+ *   checkpoint holds an event ID and timestamps for every importance
+ *   level, so this grows each CircularEventBuffer by roughly 40 (or,
+ *   with UTC timestamps, 70) bytes per checkpoint.  Since the
+ *   CircularEventBuffer lives at the start of the storage passed to
+ *   LoggingManagement::CreateLoggingManagement(), that space comes
+ *   out of the event storage unless the buffers are grown to match.
+ *   When 0, no index is kept and every fetch scans from the oldest
+ *   event.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+ *
+ * @brief
+ *   The number of slots in the staging queue used by
+ *   LoggingManagement::StageEvent().  Staged events are encoded by
+ *   the logging thread without entering the event logging critical
+ *   section, and are moved into the event buffers in batches by
+ *   LoggingManagement::DrainStagedEvents() on the Weave thread; event
+ *   IDs are assigned at that point.  Must be a power of two.  When 0,
+ *   the staging queue is not compiled in.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE 0
+#endif
+
+#if (WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE & (WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1)) != 0
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE must be a power of two"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE
+ *
+ * @brief
+ *   The largest encoded event data, in bytes, that fits in one slot
+ *   of the staging queue.  Events whose data does not fit are
+ *   rejected by LoggingManagement::StageEvent() and must be logged
+ *   with LoggingManagement::LogEvent() instead.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE 256
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE > 65535
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE cannot exceed 65535"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+ *
+ * @brief
+ *   The number of entries in the event schema dictionary.  When
+ *   nonzero, events are stored with a one byte reference to a
+ *   dictionary entry holding their trait profile ID, schema versions,
+ *   event type and event source, instead of those fields themselves;
+ *   the fields are restored when the events are fetched.  Entries are
+ *   reference counted and reused once the last event referring to
+ *   them is dropped from the log.  Events that find the dictionary
+ *   full are stored in the standard format.  Each entry takes roughly
+ *   40 bytes.  When 0, events are always stored in the standard format.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE 0
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 255
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE cannot exceed 255"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+ *
+ * @brief
+ *   The number of segments of the persistent event spill store.  When
+ *   nonzero, events are appended to a segmented, append-only store in
+ *   persistent storage as the in-memory event log nears eviction, at
+ *   the latest before they are dropped from the in-memory event
+ *   buffers, and on demand through LoggingManagement::SpillEvents().
+ *   The oldest segment is erased when the store fills up.  Fetching
+ *   events older than the ones held in memory reads them back from
+ *   the store.  The platform provides the segment storage through
+ *   nl::Weave::Platform::PersistedStorage::ReadSegment(),
+ *   WriteSegment() and EraseSegment(); if the store cannot be read
+ *   when event logging is initialized, spilling is disabled.  When 0,
+ *   events dropped from the in-memory event buffers are lost.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT 0
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT == 1 || WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT > 255
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT must be 0, or between 2 and 255"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE
+ *
+ * @brief
+ *   The size, in bytes, of a segment of the persistent event spill
+ *   store; typically the erase block size of the underlying flash.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE 4096
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE
+ *
+ * @brief
+ *   The largest event, in bytes of its TLV encoding, that may be
+ *   spilled to the persistent event spill store.  Larger events are
+ *   dropped from memory without being spilled.  A buffer of this size
+ *   is used on the stack when spilling and fetching events.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE 256
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT && (WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE + 24 > WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE)
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE must leave room for a segment and a record header in a segment"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SPILL_WATERMARK
+ *
+ * @brief
+ *   When the free space in the least important event buffer falls
+ *   below this many bytes after an event is logged, events not yet in
+ *   the persistent event spill store are spilled to it, up to
+ *   WEAVE_CONFIG_EVENT_LOGGING_SPILL_BATCH_SIZE of them at a time.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SPILL_WATERMARK
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_WATERMARK 256
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SPILL_BATCH_SIZE
+ *
+ * @brief
+ *   The largest number of events of each importance spilled to the
+ *   persistent event spill store when an event is logged past
+ *   WEAVE_CONFIG_EVENT_LOGGING_SPILL_WATERMARK.  Spilling resumes after
+ *   the last event spilled, so this bounds the work done while logging
+ *   an event.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SPILL_BATCH_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SPILL_BATCH_SIZE 4
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE
+ *
+ * @brief
+ *   The block size, in bytes, that LogBDXUpload proposes for a log
+ *   upload.  The blocks actually sent are no larger than this, than
+ *   the size accepted by the receiver, nor than what fits in the
+ *   outgoing message.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE 1024
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE > 65535
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE cannot exceed 65535"
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+ *
+ * @brief
+ *   The number of blocks LogBDXUpload keeps encoded ahead of the
+ *   receiver's acknowledgements, including the block in flight.
+ *   Events are copied out of the event buffers as soon as a block is
+ *   encoded, so the window keeps the upload from losing events that
+ *   are evicted while the transfer waits on the network.  Each block
+ *   takes WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE bytes in the
+ *   uploader.  When 0, each block is encoded straight into the
+ *   outgoing message when the previous one is acknowledged.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+#define WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW 0
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW > 255
+#error "FORBIDDEN: WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW cannot exceed 255"
+#endif
+
 #endif /* WEAVEEVENTLOGGINGCONFIG_H */
@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the ExchangeIndex class.
+ *
+ */
+
+#include <string.h>
+
+#include <Weave/Core/WeaveExchangeIndex.h>
+
+namespace nl {
+namespace Weave {
+
+/**
+ *  Initialize the index with an empty table.
+ *
+ *  @param[in]    entries       The table storage.
+ *
+ *  @param[in]    numEntries    The number of entries in the table. This must be a power of
+ *                              two, at least two, and greater than the number of slots that
+ *                              will ever be indexed at once.
+ *
+ */
+void ExchangeIndex::Init(Entry *entries, size_t numEntries)
+{
+    mEntries = entries;
+    mMask = numEntries - 1;
+    mShift = 32;
+
+    while (numEntries > 1)
+    {
+        numEntries >>= 1;
+        mShift--;
+    }
+
+    memset(mEntries, 0, (mMask + 1) * sizeof(Entry));
+}
+
+/**
+ *  Index a pool slot under a key.
+ *
+ *  @param[in]    key           The key.
+ *
+ *  @param[in]    slot          The pool slot.
+ *
+ */
+void ExchangeIndex::Add(uint32_t key, uint16_t slot)
+{
+    size_t pos = Home(key);
+
+    while (mEntries[pos].Slot != 0)
+        pos = (pos + 1) & mMask;
+
+    mEntries[pos].Key = key;
+    mEntries[pos].Slot = slot + 1;
+}
+
+/**
+ *  Remove a pool slot from the index.
+ *
+ *  @param[in]    key           The key the slot was indexed under.
+ *
+ *  @param[in]    slot          The pool slot.
+ *
+ *  @return   true if the slot was found and removed, false otherwise.
+ *
+ */
+bool ExchangeIndex::Remove(uint32_t key, uint16_t slot)
+{
+    size_t hole = Home(key);
+
+    for (;; hole = (hole + 1) & mMask)
+    {
+        if (mEntries[hole].Slot == 0)
+            return false;
+
+        if (mEntries[hole].Key == key && mEntries[hole].Slot == slot + 1)
+            break;
+    }
+
+    // Close the gap by moving back every later entry of the probe run whose home position does
+    // not lie between the gap and its current position.
+    for (size_t pos = (hole + 1) & mMask; mEntries[pos].Slot != 0; pos = (pos + 1) & mMask)
+    {
+        const size_t home = Home(mEntries[pos].Key);
+
+        if (((pos - home) & mMask) >= ((pos - hole) & mMask))
+        {
+            mEntries[hole] = mEntries[pos];
+            hole = pos;
+        }
+    }
+
+    mEntries[hole].Slot = 0;
+
+    return true;
+}
+
+/**
+ *  Get the next pool slot indexed under a key.
+ *
+ *  @param[in]    key           The key to look up.
+ *
+ *  @param[inout] pos           The table position to resume the lookup from, as
+ *                              returned by Begin() or updated by a previous call.
+ *
+ *  @param[out]   slot          The pool slot, if one was found.
+ *
+ *  @return   true if a slot was found, false if there are no more slots for the key.
+ *
+ */
+bool ExchangeIndex::Next(uint32_t key, size_t &pos, uint16_t &slot) const
+{
+    while (mEntries[pos].Slot != 0)
+    {
+        const Entry &entry = mEntries[pos];
+
+        pos = (pos + 1) & mMask;
+
+        if (entry.Key == key)
+        {
+            slot = entry.Slot - 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace Weave
+} // namespace nl
@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the ExchangeIndex class, an open-addressed hash
+ *      index used by the WeaveExchangeManager to locate exchange contexts
+ *      and unsolicited message handlers without scanning their pools, and
+ *      by the WeaveFabricState to locate peer states and session keys.
+ *
+ */
+
+#ifndef WEAVE_EXCHANGE_INDEX_H
+#define WEAVE_EXCHANGE_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Weave/Support/NLDLLUtil.h>
+
+namespace nl {
+namespace Weave {
+
+/**
+ *  @class ExchangeIndex
+ *
+ *  @brief
+ *    A multimap from 32-bit keys to the slots of a fixed-size object pool, stored
+ *    in a caller-provided, power-of-two sized table with linear probing.
+ *
+ *    Several slots may be indexed under the same key, and distinct keys may hash
+ *    alike, so callers must verify each slot returned by Next() against the object
+ *    it refers to. Entries are removed by backward shifting, so the table never
+ *    accumulates tombstones and lookups stay short as long as the table is at most
+ *    half full.
+ *
+ */
+class NL_DLL_EXPORT ExchangeIndex
+{
+public:
+    /**
+     *  @brief
+     *    An entry of the index table.
+     */
+    struct Entry
+    {
+        uint32_t Key;                           /**< The key the slot is indexed under. */
+        uint16_t Slot;                          /**< The pool slot plus one, or zero if the entry is empty. */
+    };
+
+    /**
+     *  @brief
+     *    The number of table entries needed to index a pool of @a kPoolSize objects: the
+     *    smallest power of two that is at least twice the pool size.
+     */
+    template <size_t kPoolSize, size_t kEntries = 2, bool kDone = (kEntries >= 2 * kPoolSize)>
+    struct TableSize
+    {
+        static const size_t kValue = TableSize<kPoolSize, 2 * kEntries>::kValue;
+    };
+
+    template <size_t kPoolSize, size_t kEntries>
+    struct TableSize<kPoolSize, kEntries, true>
+    {
+        static const size_t kValue = kEntries;
+    };
+
+    void Init(Entry *entries, size_t numEntries);
+
+    void Add(uint32_t key, uint16_t slot);
+    bool Remove(uint32_t key, uint16_t slot);
+
+    size_t Begin(uint32_t key) const;
+    bool Next(uint32_t key, size_t &pos, uint16_t &slot) const;
+
+private:
+    Entry *mEntries;
+    size_t mMask;
+    uint8_t mShift;
+
+    size_t Home(uint32_t key) const;
+};
+
+/**
+ *  Get the table position at which a lookup for the given key starts.
+ *
+ *  @param[in]    key           The key to look up.
+ *
+ *  @return   The starting position, to be passed to Next().
+ *
+ */
+inline size_t ExchangeIndex::Begin(uint32_t key) const
+{
+    return Home(key);
+}
+
+inline size_t ExchangeIndex::Home(uint32_t key) const
+{
+    // Fibonacci hashing spreads sequentially assigned keys, such as exchange identifiers, across the table.
+    return static_cast<uint32_t>(key * 2654435769U) >> mShift;
+}
+
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_EXCHANGE_INDEX_H
@@ -61,6 +61,13 @@ using namespace nl::Weave::Encoding;
 WeaveExchangeManager::WeaveExchangeManager()
 {
     State = kState_NotInitialized;
+
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    // Give the indexes their storage up front, so that an exchange manager that has not been initialized looks up and
+    // registers handlers as it did before it was indexed.
+    mContextIndex.Init(mContextIndexEntries, sizeof(mContextIndexEntries) / sizeof(mContextIndexEntries[0]));
+    mUMHIndex.Init(mUMHIndexEntries, sizeof(mUMHIndexEntries) / sizeof(mUMHIndexEntries[0]));
+#endif
 }
 
 /**
@@ -89,9 +96,20 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
     memset(ContextPool, 0, sizeof(ContextPool));
     mContextsInUse = 0;
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    mContextIndex.Init(mContextIndexEntries, sizeof(mContextIndexEntries) / sizeof(mContextIndexEntries[0]));
+
+    // Stack the free contexts so that they are handed out in pool order.
+    for (mNumFreeContexts = 0; mNumFreeContexts < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; mNumFreeContexts++)
+        mFreeContexts[mNumFreeContexts] = WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS - 1 - mNumFreeContexts;
+#endif
+
     InitBindingPool();
 
     memset(UMHandlerPool, 0, sizeof(UMHandlerPool));
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    mUMHIndex.Init(mUMHIndexEntries, sizeof(mUMHIndexEntries) / sizeof(mUMHIndexEntries[0]));
+#endif
     OnExchangeContextChanged = NULL;
 
     msgLayer->ExchangeMgr = this;
@@ -103,6 +121,17 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
 
     memset(RetransTable, 0, sizeof(RetransTable));
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    mRetransIndex.Init(mRetransIndexEntries, sizeof(mRetransIndexEntries) / sizeof(mRetransIndexEntries[0]));
+
+    // All entries start out free, in table order, past the end of the (empty) heap.
+    for (uint16_t i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+        mRetransQueue[i] = i;
+    mRetransQueueLen = 0;
+
+    mWRMPTickCount = 0;
+#endif
+
     mWRMPTimeStampBase = System::Timer::GetCurrentEpoch();
 
     mWRMPCurrentTimerExpiry = 0;
@@ -216,6 +245,9 @@ ExchangeContext *WeaveExchangeManager::NewContext(const uint64_t &peerNodeId, co
     if (ec != NULL)
     {
         ec->ExchangeId = NextExchangeId++;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        IndexContext(ec);
+#endif
         ec->PeerNodeId = peerNodeId;
         ec->PeerAddr = peerAddr;
         ec->PeerPort = (peerPort != 0) ? peerPort : WEAVE_PORT;
@@ -231,6 +263,9 @@ ExchangeContext *WeaveExchangeManager::NewContext(const uint64_t &peerNodeId, co
         ec->SetMsgRcvdFromPeer(false);
         ec->mWRMPConfig = gDefaultWRMPConfig;
         ec->mWRMPThrottleTimeout = 0;
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        ec->mWRMPRetransHead = 0;
+#endif
         //Internal and for Debug Only; When set, Exchange Layer does not send Ack.
         ec->SetDropAck(false);
         //Initialize the App callbacks to NULL
@@ -516,6 +551,9 @@ void WeaveExchangeManager::HandleConnectionClosed(WeaveConnection *con, WEAVE_ER
         {
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
             umh->Handler = NULL;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+            mUMHIndex.Remove(GetUMHKey(umh->ProfileId, umh->MessageType), i);
+#endif
         }
 }
 
@@ -549,28 +587,155 @@ size_t WeaveExchangeManager::ExpireExchangeTimers(void)
 
 ExchangeContext *WeaveExchangeManager::AllocContext()
 {
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
+    ExchangeContext *ec = NULL;
 
     WEAVE_FAULT_INJECT(FaultInjection::kFault_AllocExchangeContext,
                        return NULL);
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
-        if (ec->ExchangeMgr == NULL)
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    if (mNumFreeContexts > 0)
+        ec = &ContextPool[mFreeContexts[--mNumFreeContexts]];
+#else
+    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++)
+        if (ContextPool[i].ExchangeMgr == NULL)
         {
-            *ec = ExchangeContext();
-            ec->ExchangeMgr = this;
-            ec->mRefCount = 1;
-            mContextsInUse++;
-            MessageLayer->SignalMessageLayerActivityChanged();
+            ec = &ContextPool[i];
+            break;
+        }
+#endif
+
+    if (ec == NULL)
+    {
+        WeaveLogError(ExchangeManager, "Alloc ctxt FAILED");
+        return NULL;
+    }
+
+    *ec = ExchangeContext();
+    ec->ExchangeMgr = this;
+    ec->mRefCount = 1;
+    mContextsInUse++;
+    MessageLayer->SignalMessageLayerActivityChanged();
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-            WeaveLogProgress(ExchangeManager, "ec++ id: %d, inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(ec - ContextPool), mContextsInUse, ec);
+    WeaveLogProgress(ExchangeManager, "ec++ id: %d, inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(ec - ContextPool), mContextsInUse, ec);
 #endif
-            SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumContexts);
+    SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumContexts);
+
+    return ec;
+}
+
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
+/**
+ *  Add a newly allocated exchange context to the exchange index. This must be called once
+ *  the exchange identifier of the context has been assigned.
+ */
+void WeaveExchangeManager::IndexContext(ExchangeContext *ec)
+{
+    mContextIndex.Add(ec->ExchangeId, static_cast<uint16_t>(ec - ContextPool));
+}
+
+/**
+ *  Remove a released exchange context from the exchange index and return it to the free list.
+ */
+void WeaveExchangeManager::FreeContext(ExchangeContext *ec)
+{
+    const uint16_t slot = static_cast<uint16_t>(ec - ContextPool);
+
+    mContextIndex.Remove(ec->ExchangeId, slot);
+    mFreeContexts[mNumFreeContexts++] = slot;
+}
 
+uint32_t WeaveExchangeManager::GetUMHKey(uint32_t profileId, int16_t msgType)
+{
+    return profileId ^ (static_cast<uint32_t>(static_cast<uint16_t>(msgType)) << 16);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+
+/**
+ *  Find the exchange context that an inbound message belongs to.
+ *
+ *  @return   The first matching context in pool order, or NULL if there is none.
+ */
+ExchangeContext *WeaveExchangeManager::FindMatchingContext(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+        const WeaveExchangeHeader *exchangeHeader)
+{
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    ExchangeContext *matchingEC = NULL;
+    size_t pos = mContextIndex.Begin(exchangeHeader->ExchangeId);
+    uint16_t slot;
+
+    while (mContextIndex.Next(exchangeHeader->ExchangeId, pos, slot))
+    {
+        ExchangeContext *ec = &ContextPool[slot];
+
+        if ((matchingEC == NULL || ec < matchingEC) && ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
+            matchingEC = ec;
+    }
+
+    return matchingEC;
+#else
+    ExchangeContext *ec = (ExchangeContext *) ContextPool;
+    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
             return ec;
-        }
-    WeaveLogError(ExchangeManager, "Alloc ctxt FAILED");
     return NULL;
+#endif
+}
+
+/**
+ *  Find the unsolicited message handler for an inbound message. Handlers registered for the
+ *  message type are preferred over handlers registered for all messages of the profile.
+ *
+ *  @return   The first eligible handler for the message type in pool order or, failing
+ *            that, the last eligible handler for the profile in pool order, or NULL.
+ */
+WeaveExchangeManager::UnsolicitedMessageHandler *WeaveExchangeManager::FindMatchingUMH(uint32_t profileId, uint8_t msgType,
+        WeaveConnection *msgCon, bool isDuplicate)
+{
+    UnsolicitedMessageHandler *matchingUMH = NULL;
+
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    const int16_t msgTypes[] = { msgType, -1 };
+
+    for (size_t i = 0; i < sizeof(msgTypes) / sizeof(msgTypes[0]) && matchingUMH == NULL; i++)
+    {
+        const uint32_t key = GetUMHKey(profileId, msgTypes[i]);
+        size_t pos = mUMHIndex.Begin(key);
+        uint16_t slot;
+
+        while (mUMHIndex.Next(key, pos, slot))
+        {
+            UnsolicitedMessageHandler *umh = &UMHandlerPool[slot];
+
+            if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgTypes[i]
+                && (umh->Con == NULL || umh->Con == msgCon)
+                && (!isDuplicate || umh->AllowDuplicateMsgs))
+            {
+                if (matchingUMH == NULL || (msgTypes[i] == -1 ? umh > matchingUMH : umh < matchingUMH))
+                    matchingUMH = umh;
+            }
+        }
+    }
+#else
+    UnsolicitedMessageHandler *umh = (UnsolicitedMessageHandler *) UMHandlerPool;
+
+    for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
+        if (umh->Handler != NULL && umh->ProfileId == profileId && (umh->Con == NULL || umh->Con == msgCon)
+            && (!isDuplicate || umh->AllowDuplicateMsgs))
+        {
+            if (umh->MessageType == msgType)
+            {
+                matchingUMH = umh;
+                break;
+            }
+
+            if (umh->MessageType == -1)
+                matchingUMH = umh;
+        }
+#endif
+
+    return matchingUMH;
 }
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -590,7 +755,7 @@ void WeaveExchangeManager::WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64
             {
 
                 //Paustime is specified in milliseconds; Update retrans values
-                RetransTable[i].nextRetransTime += (PauseTimeMillis / mWRMPTimerInterval);
+                SetRetransTime(RetransTable[i], GetRetransTime(RetransTable[i]) + (PauseTimeMillis / mWRMPTimerInterval));
 
                 //Call the application callback
                 if (RetransTable[i].exchContext->OnDDRcvd)
@@ -627,7 +792,6 @@ static void DefaultOnMessageReceived(ExchangeContext *ec, const IPPacketInfo *pk
 void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
 {
     WeaveExchangeHeader exchangeHeader;
-    UnsolicitedMessageHandler *umh         = NULL;
     UnsolicitedMessageHandler *matchingUMH = NULL;
     ExchangeContext *ec                    = NULL;
     WeaveConnection *msgCon                = NULL;
@@ -726,27 +890,24 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 #endif
 
     // Search for an existing exchange that the message applies to. If a match is found...
-    ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    ec = FindMatchingContext(msgCon, msgInfo, &exchangeHeader);
+    if (ec != NULL)
     {
-        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, &exchangeHeader))
-        {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            // Found a matching exchange. Set flag for correct subsequent WRM
-            // retransmission timeout selection.
-            if (!ec->HasRcvdMsgFromPeer())
-            {
-                ec->SetMsgRcvdFromPeer(true);
-            }
+        // Found a matching exchange. Set flag for correct subsequent WRM
+        // retransmission timeout selection.
+        if (!ec->HasRcvdMsgFromPeer())
+        {
+            ec->SetMsgRcvdFromPeer(true);
+        }
 #endif
 
-            //Matched ExchangeContext; send to message handler.
-            ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
+        //Matched ExchangeContext; send to message handler.
+        ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
 
-            msgBuf = NULL;
+        msgBuf = NULL;
 
-            ExitNow(err = WEAVE_NO_ERROR);
-        }
+        ExitNow(err = WEAVE_NO_ERROR);
     }
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -762,23 +923,8 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-
-        matchingUMH = NULL;
-
-        for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
-            if (umh->Handler != NULL && umh->ProfileId == exchangeHeader.ProfileId && (umh->Con == NULL || umh->Con == msgCon)
-                && (!(msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) || umh->AllowDuplicateMsgs))
-            {
-                if (umh->MessageType == exchangeHeader.MessageType)
-                {
-                    matchingUMH = umh;
-                    break;
-                }
-
-                if (umh->MessageType == -1)
-                    matchingUMH = umh;
-            }
+        matchingUMH = FindMatchingUMH(exchangeHeader.ProfileId, exchangeHeader.MessageType, msgCon,
+                                      (msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) != 0);
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message is not a duplicate
     // that needs to send ack to the peer.
@@ -827,6 +973,9 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 
         ec->Con = msgCon;
         ec->ExchangeId = exchangeHeader.ExchangeId;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+        IndexContext(ec);
+#endif
         ec->PeerNodeId = msgInfo->SourceNodeId;
         if (msgInfo->InPacketInfo != NULL)
         {
@@ -855,6 +1004,9 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
         ec->SetMsgRcvdFromPeer(true);
         ec->mWRMPConfig = gDefaultWRMPConfig;
         ec->mWRMPThrottleTimeout = 0;
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        ec->mWRMPRetransHead = 0;
+#endif
         //Internal and for Debug Only; When set, Exchange Layer does not send Ack.
         ec->SetDropAck(false);
 #endif
@@ -951,6 +1103,9 @@ WEAVE_ERROR WeaveExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgTyp
     selected->Con = con;
     selected->MessageType = msgType;
     selected->AllowDuplicateMsgs = allowDups;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    mUMHIndex.Add(GetUMHKey(profileId, msgType), static_cast<uint16_t>(selected - UMHandlerPool));
+#endif
 
     SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -965,6 +1120,9 @@ WEAVE_ERROR WeaveExchangeManager::UnregisterUMH(uint32_t profileId, int16_t msgT
         if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
         {
             umh->Handler = NULL;
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+            mUMHIndex.Remove(GetUMHKey(profileId, msgType), i);
+#endif
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
             return WEAVE_NO_ERROR;
         }
@@ -1258,7 +1416,7 @@ void WeaveExchangeManager::TicklessDebugDumpRetransTable(const char *log)
              WeaveLogProgress(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX16,
                               RetransTable[i].exchContext,
                               RetransTable[i].msgId,
-                              RetransTable[i].nextRetransTime);
+                              GetRetransTime(RetransTable[i]));
          }
      }
 }
@@ -1303,57 +1461,87 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout
     // has expired
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    // The entry at the head of the queue is the one due soonest. Every entry
+    // handled here either leaves the queue or is rescheduled at least one tick
+    // ahead, so the loop only visits the entries that are due.
+    while (mRetransQueueLen > 0 && GetRetransTime(RetransTable[mRetransQueue[0]]) == 0)
+    {
+        WRMPRetransmitEntry(RetransTable[mRetransQueue[0]]);
+    }
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        if (RetransTable[i].exchContext && 0 == RetransTable[i].nextRetransTime)
         {
-            WEAVE_ERROR err = WEAVE_NO_ERROR;
+            WRMPRetransmitEntry(RetransTable[i]);
+        }
+    }
+#endif
 
-            if (0 == RetransTable[i].nextRetransTime)
-            {
-                uint8_t sendCount = RetransTable[i].sendCount;
-                void * msgCtxt = RetransTable[i].msgCtxt;
+    TicklessDebugDumpRetransTable("WRMPExecuteActions Dumping RetransTable entries after processing");
+}
 
-                if (sendCount > ec->mWRMPConfig.mMaxRetrans)
-                {
-                    err = WEAVE_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
+/**
+ *  Retransmit an entry of the retransmission table whose retransmission
+ *  timeout has expired, or fail it if it has been sent the maximum number
+ *  of times.
+ *
+ *  @param[in]    entry    A reference to the RetransTableEntry object.
+ *
+ */
+void WeaveExchangeManager::WRMPRetransmitEntry(RetransTableEntry &entry)
+{
+    WEAVE_ERROR err       = WEAVE_NO_ERROR;
+    ExchangeContext *ec   = entry.exchContext;
+    uint8_t sendCount     = entry.sendCount;
+    void * msgCtxt        = entry.msgCtxt;
 
-                    WeaveLogError(ExchangeManager, "Failed to Send Weave MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
-                                  RetransTable[i].msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
+    if (sendCount > ec->mWRMPConfig.mMaxRetrans)
+    {
+        err = WEAVE_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
 
-                    // Remove from Table
-                    ClearRetransmitTable(RetransTable[i]);
-                }
+        WeaveLogError(ExchangeManager, "Failed to Send Weave MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
+                      entry.msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
 
-                if (err == WEAVE_NO_ERROR)
-                {
-                    // Resend from Table (if the operation fails, the entry is cleared)
-                    err = SendFromRetransTable(&(RetransTable[i]));
-                }
+        // Remove from Table
+        ClearRetransmitTable(entry);
+    }
 
-                if (err == WEAVE_NO_ERROR)
-                {
-                    // If the retransmission was successful, update the passive timer
-                    RetransTable[i].nextRetransTime = ec->GetCurrentRetransmitTimeout() / mWRMPTimerInterval;
+    if (err == WEAVE_NO_ERROR)
+    {
+        // Resend from Table (if the operation fails, the entry is cleared)
+        err = SendFromRetransTable(&entry);
+    }
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        uint32_t retransTime = ec->GetCurrentRetransmitTimeout() / mWRMPTimerInterval;
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        // Retransmit no sooner than the next tick, so that WRMPExecuteActions
+        // does not keep retransmitting an entry whose timeout is below a tick.
+        if (retransTime == 0)
+        {
+            retransTime = 1;
+        }
+#endif
+
+        // If the retransmission was successful, update the passive timer
+        SetRetransTime(entry, retransTime);
 #if defined(DEBUG)
-                    WeaveLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d",
-                            RetransTable[i].msgId, RetransTable[i].sendCount);
+        WeaveLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d",
+                entry.msgId, entry.sendCount);
 #endif
-                }
+    }
 
-                if (err != WEAVE_NO_ERROR)
-                {
-                    if (ec->OnSendError)
-                    {
-                        ec->OnSendError(ec, err, msgCtxt);
-                    }
-                }
-            } //nextRetransTime = 0
+    if (err != WEAVE_NO_ERROR)
+    {
+        if (ec->OnSendError)
+        {
+            ec->OnSendError(ec, err, msgCtxt);
         }
     }
-
-    TicklessDebugDumpRetransTable("WRMPExecuteActions Dumping RetransTable entries after processing");
 }
 
 /**
@@ -1409,8 +1597,29 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
             WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPNextAckTime to %u", ec->mWRMPNextAckTime);
 #endif
         }
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        //Process Throttle Time
+        //Decrement Throttle timeout of contexts with entries in the retrans table by elapsed timeticks
+        if (ec->ExchangeMgr != NULL && ec->mWRMPRetransHead != 0)
+        {
+            if (ec->mWRMPThrottleTimeout >= deltaTicks)
+            {
+                ec->mWRMPThrottleTimeout -= deltaTicks;
+            }
+            else
+            {
+                ec->mWRMPThrottleTimeout = 0;
+            }
+        }
+#endif
     }
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    // Retransmit times are kept as absolute tick counts, so advancing the
+    // tick count expires them all at once.
+    mWRMPTickCount += deltaTicks;
+#else
     //Process Throttle Time
     //Check Throttle timeout stored in EC to set/unset Throttle flag
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
@@ -1446,6 +1655,7 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
 #endif
         } //ec entry is allocated
     }
+#endif // WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
 
     // Re-Adjust the base time stamp to the most recent tick boundary
 
@@ -1510,29 +1720,43 @@ WEAVE_ERROR WeaveExchangeManager::AddToRetransTable(ExchangeContext *ec, PacketB
     bool added      = false;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    //The free entries follow the in-use entries in the retransmission queue
+    if (mRetransQueueLen < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE)
+    {
+        RetransTableEntry &entry = RetransTable[mRetransQueue[mRetransQueueLen]];
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
+        RetransTableEntry &entry = RetransTable[i];
+
         //Check the exchContext pointer for finding an empty slot in Table
-        if (!RetransTable[i].exchContext)
+        if (!entry.exchContext)
+#endif
         {
             // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
             WRMPExpireTicks();
 
-            RetransTable[i].exchContext = ec;
-            RetransTable[i].msgId = messageId;
-            RetransTable[i].msgBuf = msgBuf;
-            RetransTable[i].sendCount = 0;
-            RetransTable[i].nextRetransTime = GetTickCounterFromTimeDelta(ec->GetCurrentRetransmitTimeout() + System::Timer::GetCurrentEpoch(), mWRMPTimeStampBase);
+            entry.exchContext = ec;
+            entry.msgId = messageId;
+            entry.msgBuf = msgBuf;
+            entry.sendCount = 0;
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+            LinkRetransEntry(entry);
+#endif
+            SetRetransTime(entry, GetTickCounterFromTimeDelta(ec->GetCurrentRetransmitTimeout() + System::Timer::GetCurrentEpoch(), mWRMPTimeStampBase));
 
-            RetransTable[i].msgCtxt = msgCtxt;
-            *rEntry = &RetransTable[i];
+            entry.msgCtxt = msgCtxt;
+            *rEntry = &entry;
             //Increment the reference count
             ec->AddRef();
             added = true;
 
             //Check if the timer needs to be started and start it.
             WRMPStartTimer();
+#if !WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
             break;
+#endif
         }
     }
 
@@ -1567,7 +1791,7 @@ WEAVE_ERROR WeaveExchangeManager::SendFromRetransTable(RetransTableEntry *entry)
 
     WEAVE_FAULT_INJECT(FaultInjection::kFault_WRMSendError,
                        entry->sendCount = (ec->mWRMPConfig.mMaxRetrans + 1);
-                       entry->nextRetransTime = 0;
+                       SetRetransTime(*entry, 0);
                        WRMPStartTimer();
                        ExitNow());
 
@@ -1631,6 +1855,13 @@ exit:
  */
 void WeaveExchangeManager::ClearRetransmitTable(ExchangeContext *ec)
 {
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    while (ec->mWRMPRetransHead != 0)
+    {
+        //Clear the retransmit table entry.
+        ClearRetransmitTable(RetransTable[ec->mWRMPRetransHead - 1]);
+    }
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
         if (RetransTable[i].exchContext == ec)
@@ -1639,6 +1870,7 @@ void WeaveExchangeManager::ClearRetransmitTable(ExchangeContext *ec)
             ClearRetransmitTable(RetransTable[i]);
         }
     }
+#endif
 }
 
 /**
@@ -1654,6 +1886,10 @@ void WeaveExchangeManager::ClearRetransmitTable(RetransTableEntry &rEntry)
         // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
         WRMPExpireTicks();
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        UnlinkRetransEntry(rEntry);
+#endif
+
         rEntry.exchContext->Release();
         rEntry.exchContext = NULL;
 
@@ -1682,14 +1918,37 @@ void WeaveExchangeManager::ClearRetransmitTable(RetransTableEntry &rEntry)
  */
 void WeaveExchangeManager::FailRetransmitTableEntries(ExchangeContext *ec, WEAVE_ERROR err)
 {
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    size_t numEntries = 0;
+
+    // Count the entries up front, so that entries added by OnSendError, which
+    // go to the end of the context's list, are not failed as well.
+    if (ec->mWRMPRetransHead != 0)
+    {
+        uint16_t i = ec->mWRMPRetransHead - 1;
+
+        do
+        {
+            numEntries++;
+            i = RetransTable[i].nextInContext;
+        } while (i != ec->mWRMPRetransHead - 1);
+    }
+
+    for (; numEntries > 0 && ec->mWRMPRetransHead != 0; numEntries--)
+    {
+        RetransTableEntry &entry = RetransTable[ec->mWRMPRetransHead - 1];
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
-        if (RetransTable[i].exchContext == ec)
+        RetransTableEntry &entry = RetransTable[i];
+
+        if (entry.exchContext == ec)
+#endif
         {
-            void *msgCtxt = RetransTable[i].msgCtxt;
+            void *msgCtxt = entry.msgCtxt;
 
             // Remove the entry from the retransmission table.
-            ClearRetransmitTable(RetransTable[i]);
+            ClearRetransmitTable(entry);
 
             // Application callback OnSendError.
             if (ec->OnSendError)
@@ -1724,8 +1983,30 @@ void WeaveExchangeManager::WRMPStartTimer()
             WeaveLogProgress(ExchangeManager, "WRMPStartTimer next ACK time %u", nextWakeTime);
 #endif
         }
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+        // When do we need to next wake up for throttle retransmission?
+        if (ec->ExchangeMgr != NULL && ec->mWRMPRetransHead != 0 &&
+            ec->mWRMPThrottleTimeout != 0 && ec->mWRMPThrottleTimeout < nextWakeTime) {
+            nextWakeTime = ec->mWRMPThrottleTimeout;
+            foundWake = true;
+#if defined(WRMP_TICKLESS_DEBUG)
+            WeaveLogProgress(ExchangeManager, "WRMPStartTimer throttle timeout %u", nextWakeTime);
+#endif
+        }
+#endif
     }
 
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    // When do we need to next wake up for WRMP retransmit?
+    if (mRetransQueueLen > 0 && GetRetransTime(RetransTable[mRetransQueue[0]]) < nextWakeTime) {
+        nextWakeTime = GetRetransTime(RetransTable[mRetransQueue[0]]);
+        foundWake = true;
+#if defined(WRMP_TICKLESS_DEBUG)
+        WeaveLogProgress(ExchangeManager, "WRMPStartTimer RetransTime %u", nextWakeTime);
+#endif
+    }
+#else
     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
     {
         ec = RetransTable[i].exchContext;
@@ -1750,6 +2031,7 @@ void WeaveExchangeManager::WRMPStartTimer()
             }
         }
     }
+#endif // WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
 
     if (foundWake) {
         // Set timer for next tick boundary - subtract the elapsed time from the current tick
@@ -1797,6 +2079,202 @@ void WeaveExchangeManager::WRMPStopTimer()
 {
     MessageLayer->SystemLayer->CancelTimer(WRMPTimeout, this);
 }
+
+/**
+ *  Find the retransmission table entry of a message awaiting acknowledgment.
+ *
+ *  @param[in]    ec        A pointer to the ExchangeContext object the message was sent on.
+ *
+ *  @param[in]    msgId     The message identifier of the message.
+ *
+ *  @return  A pointer to the entry, or NULL if there is none.
+ *
+ */
+WeaveExchangeManager::RetransTableEntry *WeaveExchangeManager::FindRetransEntry(ExchangeContext *ec, uint32_t msgId)
+{
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    size_t pos = mRetransIndex.Begin(msgId);
+    uint16_t i;
+
+    while (mRetransIndex.Next(msgId, pos, i))
+#else
+    for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+#endif
+    {
+        if (RetransTable[i].exchContext == ec && RetransTable[i].msgId == msgId)
+        {
+            return &RetransTable[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ *  Get the number of WRMP ticks, counted from the current tick boundary,
+ *  until an entry of the retransmission table is due for retransmission.
+ *
+ *  @param[in]    entry    A reference to the RetransTableEntry object.
+ *
+ *  @return  The number of ticks, or zero if the entry is due.
+ *
+ */
+uint32_t WeaveExchangeManager::GetRetransTime(const RetransTableEntry &entry) const
+{
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    int32_t ticks = static_cast<int32_t>(entry.retransTick - mWRMPTickCount);
+
+    return (ticks > 0) ? static_cast<uint32_t>(ticks) : 0;
+#else
+    return entry.nextRetransTime;
+#endif
+}
+
+/**
+ *  Set the number of WRMP ticks, counted from the current tick boundary,
+ *  until an entry of the retransmission table is due for retransmission.
+ *
+ *  @param[in]    entry    A reference to the RetransTableEntry object.
+ *
+ *  @param[in]    ticks    The number of ticks.
+ *
+ */
+void WeaveExchangeManager::SetRetransTime(RetransTableEntry &entry, uint32_t ticks)
+{
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    entry.retransTick = mWRMPTickCount + ticks;
+    SiftRetransQueue(entry.queuePos);
+#else
+    entry.nextRetransTime = ticks;
+#endif
+}
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+/**
+ *  Add a newly filled-in entry of the retransmission table to the message id
+ *  index, the list of entries of its ExchangeContext, and the retransmission
+ *  queue. The entry must be the first free entry of the queue, and its
+ *  retransmission time must be set with SetRetransTime() right after.
+ *
+ *  @param[in]    entry    A reference to the RetransTableEntry object.
+ *
+ */
+void WeaveExchangeManager::LinkRetransEntry(RetransTableEntry &entry)
+{
+    const uint16_t i = static_cast<uint16_t>(&entry - RetransTable);
+    ExchangeContext *ec = entry.exchContext;
+
+    mRetransIndex.Add(entry.msgId, i);
+
+    // Append to the circular list of entries of the context.
+    if (ec->mWRMPRetransHead == 0)
+    {
+        entry.prevInContext = i;
+        entry.nextInContext = i;
+        ec->mWRMPRetransHead = i + 1;
+    }
+    else
+    {
+        RetransTableEntry &head = RetransTable[ec->mWRMPRetransHead - 1];
+
+        entry.prevInContext = head.prevInContext;
+        entry.nextInContext = ec->mWRMPRetransHead - 1;
+        RetransTable[head.prevInContext].nextInContext = i;
+        head.prevInContext = i;
+    }
+
+    entry.queuePos = mRetransQueueLen++;
+}
+
+/**
+ *  Remove an in-use entry of the retransmission table from the message id
+ *  index, the list of entries of its ExchangeContext, and the retransmission
+ *  queue.
+ *
+ *  @param[in]    entry    A reference to the RetransTableEntry object.
+ *
+ */
+void WeaveExchangeManager::UnlinkRetransEntry(RetransTableEntry &entry)
+{
+    const uint16_t i = static_cast<uint16_t>(&entry - RetransTable);
+    ExchangeContext *ec = entry.exchContext;
+    const size_t pos = entry.queuePos;
+
+    mRetransIndex.Remove(entry.msgId, i);
+
+    if (entry.nextInContext == i)
+    {
+        ec->mWRMPRetransHead = 0;
+    }
+    else
+    {
+        RetransTable[entry.prevInContext].nextInContext = entry.nextInContext;
+        RetransTable[entry.nextInContext].prevInContext = entry.prevInContext;
+
+        if (ec->mWRMPRetransHead == i + 1)
+        {
+            ec->mWRMPRetransHead = entry.nextInContext + 1;
+        }
+    }
+
+    // Swap the entry with the last in-use entry of the queue, which leaves it
+    // first among the free entries, and restore the heap order.
+    SwapRetransQueue(pos, --mRetransQueueLen);
+    if (pos < mRetransQueueLen)
+    {
+        SiftRetransQueue(pos);
+    }
+}
+
+/**
+ *  Move the entry at a given position of the retransmission queue up or down
+ *  until the queue is ordered by retransmission time again.
+ *
+ *  @param[in]    pos      The position of the entry in the queue.
+ *
+ */
+void WeaveExchangeManager::SiftRetransQueue(size_t pos)
+{
+    while (pos > 0 && IsRetransDueBefore(pos, (pos - 1) / 2))
+    {
+        SwapRetransQueue(pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+
+    for (;;)
+    {
+        size_t child = 2 * pos + 1;
+
+        if (child >= mRetransQueueLen)
+            break;
+
+        if (child + 1 < mRetransQueueLen && IsRetransDueBefore(child + 1, child))
+            child++;
+
+        if (!IsRetransDueBefore(child, pos))
+            break;
+
+        SwapRetransQueue(pos, child);
+        pos = child;
+    }
+}
+
+bool WeaveExchangeManager::IsRetransDueBefore(size_t pos1, size_t pos2) const
+{
+    // Compare the tick counts modulo 2^32, so that the order survives the tick count wrapping around.
+    return static_cast<int32_t>(RetransTable[mRetransQueue[pos1]].retransTick - RetransTable[mRetransQueue[pos2]].retransTick) < 0;
+}
+
+void WeaveExchangeManager::SwapRetransQueue(size_t pos1, size_t pos2)
+{
+    const uint16_t i = mRetransQueue[pos1];
+
+    mRetransQueue[pos1] = mRetransQueue[pos2];
+    mRetransQueue[pos2] = i;
+    RetransTable[mRetransQueue[pos1]].queuePos = static_cast<uint16_t>(pos1);
+    RetransTable[mRetransQueue[pos2]].queuePos = static_cast<uint16_t>(pos2);
+}
+#endif // WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
 /**
@@ -32,6 +32,7 @@
 
 #include <Weave/Support/NLDLLUtil.h>
 #include <Weave/Core/WeaveWRMPConfig.h>
+#include <Weave/Core/WeaveExchangeIndex.h>
 #include <SystemLayer/SystemTimer.h>
 
  #define EXCHANGE_CONTEXT_ID(x)     ((x)+1)
@@ -368,6 +369,9 @@ private:
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     uint16_t mWRMPNextAckTime;                  //Next time for triggering Solo Ack
     uint16_t mWRMPThrottleTimeout;              //Timeout until when Throttle is On when WRMPThrottleEnabled is set
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    uint16_t mWRMPRetransHead;                  //Oldest retrans table entry of this context plus one, or zero if none
+#endif
 #endif
     void DoClose(bool clearRetransTable);
     WEAVE_ERROR HandleMessage(WeaveMessageInfo *msgInfo, const WeaveExchangeHeader *exchHeader, PacketBuffer *msgBuf);
@@ -382,7 +386,7 @@ private:
     WEAVE_ERROR HandleThrottleFlow(uint32_t PauseTimeMillis);
 #endif
 
-    uint8_t mRefCount;
+    uint16_t mRefCount;                         // Each outstanding reliable message holds a reference, so this may well exceed 255.
 };
 
 /**
@@ -460,6 +464,9 @@ private:
     uint64_t mWRMPTimeStampBase;    //WRMP timer base value to add offsets to evaluate timeouts
     System::Timer::Epoch mWRMPCurrentTimerExpiry; //Tracks when the WRM timer will next expire
     uint16_t mWRMPTimerInterval;    //WRMP Timer tick period
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    uint32_t mWRMPTickCount;        //WRMP Timer ticks elapsed up to mWRMPTimeStampBase
+#endif
     /**
      *  @class RetransTableEntry
      *
@@ -477,7 +484,14 @@ private:
        ExchangeContext      *exchContext;       /**< The ExchangeContext for the stored Weave message. */
        PacketBuffer         *msgBuf;            /**< A pointer to the PacketBuffer object holding the Weave message. */
        void                 *msgCtxt;           /**< A pointer to an application level context object associated with the message. */
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+       uint32_t             retransTick;        /**< The WRMP tick count at which the message is next due for retransmission. */
+       uint16_t             queuePos;           /**< The position of the entry in the retransmission queue. */
+       uint16_t             prevInContext;      /**< The previous entry for the same ExchangeContext, in order of addition. */
+       uint16_t             nextInContext;      /**< The next entry for the same ExchangeContext, in order of addition. */
+#else
        uint16_t             nextRetransTime;    /**< A counter representing the next retransmission time for the message. */
+#endif
        uint8_t              sendCount;          /**< A counter representing the number of times the message has been sent. */
     };
     void     WRMPExecuteActions(void);
@@ -496,11 +510,28 @@ private:
     void ClearRetransmitTable(RetransTableEntry &rEntry);
     void FailRetransmitTableEntries(ExchangeContext *ec, WEAVE_ERROR err);
     void RetransPendingAppGroupMsgs(uint64_t peerNodeId);
+    void WRMPRetransmitEntry(RetransTableEntry &entry);
+    RetransTableEntry *FindRetransEntry(ExchangeContext *ec, uint32_t msgId);
+    uint32_t GetRetransTime(const RetransTableEntry &entry) const;
+    void SetRetransTime(RetransTableEntry &entry, uint32_t ticks);
 
     void TicklessDebugDumpRetransTable(const char *log);
 
     //WRMP Global tables for timer context
     RetransTableEntry RetransTable[WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+    ExchangeIndex mRetransIndex;    //Indexes in-use retrans table entries by message id
+    ExchangeIndex::Entry mRetransIndexEntries[ExchangeIndex::TableSize<WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE>::kValue];
+    uint16_t mRetransQueue[WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE]; //Min-heap of in-use entries by retransTick, followed by the free entries
+    uint16_t mRetransQueueLen;      //Number of in-use entries
+
+    void LinkRetransEntry(RetransTableEntry &entry);
+    void UnlinkRetransEntry(RetransTableEntry &entry);
+    void SiftRetransQueue(size_t pos);
+    bool IsRetransDueBefore(size_t pos1, size_t pos2) const;
+    void SwapRetransQueue(size_t pos1, size_t pos2);
+#endif
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
     class UnsolicitedMessageHandler
@@ -518,13 +549,32 @@ private:
     ExchangeContext ContextPool[WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS];
     size_t mContextsInUse;
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    ExchangeIndex mContextIndex;                // Indexes in-use contexts by exchange id
+    ExchangeIndex::Entry mContextIndexEntries[ExchangeIndex::TableSize<WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS>::kValue];
+    uint16_t mFreeContexts[WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS];
+    uint16_t mNumFreeContexts;
+#endif
+
     Binding BindingPool[WEAVE_CONFIG_MAX_BINDINGS];
     size_t mBindingsInUse;
 
     UnsolicitedMessageHandler UMHandlerPool[WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
     void (*OnExchangeContextChanged)(size_t numContextsInUse);
 
+#if WEAVE_CONFIG_ENABLE_EXCHANGE_INDEX
+    ExchangeIndex mUMHIndex;                    // Indexes registered handlers by profile id and message type
+    ExchangeIndex::Entry mUMHIndexEntries[ExchangeIndex::TableSize<WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS>::kValue];
+
+    void IndexContext(ExchangeContext *ec);
+    void FreeContext(ExchangeContext *ec);
+    static uint32_t GetUMHKey(uint32_t profileId, int16_t msgType);
+#endif
+
     ExchangeContext *AllocContext(void);
+    ExchangeContext *FindMatchingContext(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+            const WeaveExchangeHeader *exchangeHeader);
+    UnsolicitedMessageHandler *FindMatchingUMH(uint32_t profileId, uint8_t msgType, WeaveConnection *msgCon, bool isDuplicate);
 
     void HandleConnectionReceived(WeaveConnection *con);
     void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
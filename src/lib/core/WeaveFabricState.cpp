@@ -105,6 +105,40 @@ enum
 // Key diversifier used for Weave message encryption key derivation.
 const uint8_t kWeaveMsgEncAppKeyDiversifier[] = { 0xB1, 0x1D, 0xAE, 0x5B };
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+/**
+ * Expand the key material for the encryption type of the key, so that messages can be encrypted
+ * and decrypted without repeating the key setup.
+ *
+ * This must be called whenever the key material or the encryption type of the key changes.
+ */
+void WeaveMsgEncryptionKey::ComputeKeySchedule(void)
+{
+    switch (EncType)
+    {
+    case kWeaveEncryptionType_AES128CTRSHA1:
+        KeySchedule.DataKey.SetKey(EncKey.AES128CTRSHA1.DataKey);
+        HMACSHA1::PrecomputeKey(EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize,
+                                KeySchedule.IntegrityKey);
+        break;
+    default:
+        ClearKeySchedule();
+        break;
+    }
+}
+
+/**
+ * Wipe the expanded key material.
+ */
+void WeaveMsgEncryptionKey::ClearKeySchedule(void)
+{
+    KeySchedule.DataKey.Reset();
+    KeySchedule.IntegrityKey.Reset();
+}
+
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  * Initialize a WeaveSessionKey object.
  */
@@ -132,6 +166,9 @@ void WeaveSessionKey::Clear(void)
 {
     Init();
     ClearSecretData((uint8_t *)&MsgEncKey.EncKey, sizeof(MsgEncKey.EncKey));
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    MsgEncKey.ClearKeySchedule();
+#endif
 }
 
 void WeaveSessionKey::ComputeNextResumptionMsgIds(void)
@@ -260,6 +297,13 @@ WEAVE_ERROR WeaveFabricState::Init(GroupKeyStoreBase *groupKeyStore)
     NextUnencTCPMsgId.Init(0);
     for (int i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
         SessionKeys[i].Init();
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    SessionKeyIndex.Init(SessionKeyIndexEntries, sizeof(SessionKeyIndexEntries) / sizeof(SessionKeyIndexEntries[0]));
+
+    // Stack the free session keys so that they are handed out in table order.
+    for (NumFreeSessionKeys = 0; NumFreeSessionKeys < WEAVE_CONFIG_MAX_SESSION_KEYS; NumFreeSessionKeys++)
+        FreeSessionKeys[NumFreeSessionKeys] = WEAVE_CONFIG_MAX_SESSION_KEYS - 1 - NumFreeSessionKeys;
+#endif
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     WEAVE_ERROR err = NextGroupKeyMsgId.Init(WEAVE_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_ID, WEAVE_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_EPOCH);
     if (err != WEAVE_NO_ERROR)
@@ -270,6 +314,9 @@ WEAVE_ERROR WeaveFabricState::Init(GroupKeyStoreBase *groupKeyStore)
     AppKeyCache.Init();
 #endif
     memset(&PeerStates, 0, sizeof(PeerStates));
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    PeerStateIndex.Init(PeerStateIndexEntries, sizeof(PeerStateIndexEntries) / sizeof(PeerStateIndexEntries[0]));
+#endif
     Delegate = NULL;
     memset(SharedSessionsNodes, 0, sizeof(SharedSessionsNodes));
 
@@ -338,6 +385,9 @@ WEAVE_ERROR WeaveFabricState::AllocSessionKey(uint64_t peerNodeId, uint16_t keyI
 
     sessionKey->MsgEncKey.KeyId = keyId;
     sessionKey->NodeId = peerNodeId;
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    IndexSessionKey(sessionKey);
+#endif
     sessionKey->MsgEncKey.EncType = kWeaveEncryptionType_None;
     sessionKey->NextMsgId.Init(UINT32_MAX);
     sessionKey->MaxRcvdMsgId = UINT32_MAX;
@@ -382,6 +432,9 @@ WEAVE_ERROR WeaveFabricState::SetSessionKey(WeaveSessionKey *sessionKey, uint8_t
 
     sessionKey->MsgEncKey.EncType = encType;
     sessionKey->MsgEncKey.EncKey = *encKey;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ComputeKeySchedule();
+#endif
     sessionKey->NextMsgId.Init(msgId);
     sessionKey->InitialSendMsgId = msgId;
     sessionKey->InitialRcvdMsgId = 0;
@@ -425,6 +478,15 @@ void WeaveFabricState::RemoveSessionKey(WeaveSessionKey *sessionKey, bool wasIdl
             (wasIdle) ? "idle " : "", sessionKey->MsgEncKey.KeyId, sessionKey->NodeId);
 
     RemoveSharedSessionEndNodes(sessionKey);
+
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    if (sessionKey->IsAllocated() &&
+        SessionKeyIndex.Remove(sessionKey->MsgEncKey.KeyId, static_cast<uint16_t>(sessionKey - SessionKeys)))
+    {
+        FreeSessionKeys[NumFreeSessionKeys++] = static_cast<uint16_t>(sessionKey - SessionKeys);
+    }
+#endif
+
     sessionKey->Clear();
 }
 
@@ -774,6 +836,9 @@ WEAVE_ERROR WeaveFabricState::SuspendSession(uint16_t keyId, uint64_t peerNodeId
     // Wipe the key.
     sessionKey->MsgEncKey.EncType = kWeaveEncryptionType_None;
     ClearSecretData((uint8_t *)&sessionKey->MsgEncKey.EncKey, sizeof(sessionKey->MsgEncKey.EncKey));
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ClearKeySchedule();
+#endif
 
 exit:
     // If something goes wrong, make sure we don't leave any key material behind.
@@ -823,6 +888,9 @@ WEAVE_ERROR WeaveFabricState::RestoreSession(uint8_t * serializedSession, uint16
     {
         sessionKey->MsgEncKey.KeyId = keyId;
         sessionKey->NodeId = peerNodeId;
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+        IndexSessionKey(sessionKey);
+#endif
         sessionKey->BoundCon = NULL;
         sessionKey->ReserveCount = 0;
         sessionKey->Flags = 0;
@@ -931,6 +999,9 @@ WEAVE_ERROR WeaveFabricState::RestoreSession(uint8_t * serializedSession, uint16
         VerifyOrExit(reader.GetLength() == WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize, err = WEAVE_ERROR_INVALID_ARGUMENT);
         err = reader.GetBytes(sessionKey->MsgEncKey.EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
         SuccessOrExit(err);
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+        sessionKey->MsgEncKey.ComputeKeySchedule();
+#endif
         break;
     default:
         ExitNow(err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
@@ -1348,9 +1419,153 @@ exit:
  */
 bool WeaveFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType& retPeerIndex)
 {
-    uint16_t i;
     bool retVal = false;
 
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    const uint32_t key = GetPeerStateKey(peerNodeId);
+    size_t pos = PeerStateIndex.Begin(key);
+    uint16_t slot;
+
+    // Find peer entry in the peer state table.
+    while (PeerStateIndex.Next(key, pos, slot))
+    {
+        if (PeerStates.NodeId[slot] == peerNodeId)
+        {
+            retPeerIndex = static_cast<PeerIndexType>(slot);
+            retVal = true;
+            break;
+        }
+    }
+
+    // If peer entry is not found in the peer state table and allocation was requested.
+    if (!retVal && allocEntry)
+    {
+        // If PeerStates table is full then the least recently used entry is discarded
+        // and allocated for the new peer node, preferring, as below, the least recently
+        // used entry that didn't use encryption.
+        if (PeerCount == WEAVE_CONFIG_MAX_PEER_NODES)
+        {
+            const PeerIndexType leastRecentlyUsedIndex = PeerStates.MoreRecentlyUsed[PeerStates.MostRecentlyUsedIndex];
+
+            // Choose the least recently used peer entry by default.
+            retPeerIndex = leastRecentlyUsedIndex;
+
+#if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
+            // Try to find the least recently used peer entry that didn't use encryption.
+            PeerIndexType peerInd = leastRecentlyUsedIndex;
+            do
+            {
+                if ((PeerStates.GroupKeyRcvFlags[peerInd] & WeaveSessionState::kReceiveFlags_MessageIdSynchronized) == 0)
+                {
+                    retPeerIndex = peerInd;
+                    break;
+                }
+                peerInd = PeerStates.MoreRecentlyUsed[peerInd];
+            } while (peerInd != leastRecentlyUsedIndex);
+#endif
+
+            PeerStateIndex.Remove(GetPeerStateKey(PeerStates.NodeId[retPeerIndex]), retPeerIndex);
+        }
+
+        // If PeerStates table is not full then the next available entry is allocated
+        // and linked in as the most recently used one.
+        else
+        {
+            retPeerIndex = static_cast<PeerIndexType>(PeerCount);
+
+            if (PeerCount == 0)
+            {
+                PeerStates.MoreRecentlyUsed[retPeerIndex] = retPeerIndex;
+                PeerStates.LessRecentlyUsed[retPeerIndex] = retPeerIndex;
+            }
+            else
+            {
+                const PeerIndexType mostRecentlyUsedIndex = PeerStates.MostRecentlyUsedIndex;
+                const PeerIndexType leastRecentlyUsedIndex = PeerStates.MoreRecentlyUsed[mostRecentlyUsedIndex];
+
+                PeerStates.MoreRecentlyUsed[retPeerIndex] = leastRecentlyUsedIndex;
+                PeerStates.LessRecentlyUsed[retPeerIndex] = mostRecentlyUsedIndex;
+                PeerStates.LessRecentlyUsed[leastRecentlyUsedIndex] = retPeerIndex;
+                PeerStates.MoreRecentlyUsed[mostRecentlyUsedIndex] = retPeerIndex;
+            }
+
+            PeerStates.MostRecentlyUsedIndex = retPeerIndex;
+            PeerCount++;
+        }
+
+        PeerStateIndex.Add(key, retPeerIndex);
+
+        PeerStates.NodeId[retPeerIndex] = peerNodeId;
+        PeerStates.MaxUnencUDPMsgIdRcvd[retPeerIndex] = 0;
+#if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
+        PeerStates.MaxGroupKeyMsgIdRcvd[retPeerIndex] = 0;
+        PeerStates.GroupKeyRcvFlags[retPeerIndex] = 0;
+#endif
+        PeerStates.UnencRcvFlags[retPeerIndex] = 0;
+        retVal = true;
+    }
+
+    // Move the requested entry to the head of the most recently used list.
+    if (retVal)
+    {
+        MarkPeerEntryMostRecentlyUsed(retPeerIndex);
+    }
+
+    return retVal;
+}
+
+/**
+ * This method moves a peer entry to the head of the list of peer entries
+ * ordered from most- to least- recently used.
+ *
+ * @param[in]  peerIndex        Index to the peer entry in the peer state table.
+ *
+ */
+void WeaveFabricState::MarkPeerEntryMostRecentlyUsed(PeerIndexType peerIndex)
+{
+    const PeerIndexType mostRecentlyUsedIndex = PeerStates.MostRecentlyUsedIndex;
+
+    if (peerIndex == mostRecentlyUsedIndex)
+        return;
+
+    // Unlink the entry. The list has at least two entries, since the entry is not at its head.
+    PeerStates.LessRecentlyUsed[PeerStates.MoreRecentlyUsed[peerIndex]] = PeerStates.LessRecentlyUsed[peerIndex];
+    PeerStates.MoreRecentlyUsed[PeerStates.LessRecentlyUsed[peerIndex]] = PeerStates.MoreRecentlyUsed[peerIndex];
+
+    // Link it back in between the least and the most recently used entries, and make it the head.
+    PeerStates.MoreRecentlyUsed[peerIndex] = PeerStates.MoreRecentlyUsed[mostRecentlyUsedIndex];
+    PeerStates.LessRecentlyUsed[peerIndex] = mostRecentlyUsedIndex;
+    PeerStates.LessRecentlyUsed[PeerStates.MoreRecentlyUsed[mostRecentlyUsedIndex]] = peerIndex;
+    PeerStates.MoreRecentlyUsed[mostRecentlyUsedIndex] = peerIndex;
+
+    PeerStates.MostRecentlyUsedIndex = peerIndex;
+}
+
+/**
+ * This method adds a newly allocated session key, which must be the one last offered
+ * as a free entry by FindSessionKey(), to the session key index.
+ *
+ * @param[in]  sessionKey       A pointer to the session key object.
+ *
+ */
+void WeaveFabricState::IndexSessionKey(WeaveSessionKey *sessionKey)
+{
+    const uint16_t i = static_cast<uint16_t>(sessionKey - SessionKeys);
+
+    VerifyOrDie(NumFreeSessionKeys > 0 && FreeSessionKeys[NumFreeSessionKeys - 1] == i);
+
+    NumFreeSessionKeys--;
+    SessionKeyIndex.Add(sessionKey->MsgEncKey.KeyId, i);
+}
+
+uint32_t WeaveFabricState::GetPeerStateKey(uint64_t peerNodeId)
+{
+    // Fold the node id so that both its fabric-assigned low half and its vendor-assigned high half contribute.
+    return static_cast<uint32_t>(peerNodeId ^ (peerNodeId >> 32));
+}
+#else // WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    uint16_t i;
+
     // Find peer entry in the peer state table.
     for (i = 0; i < PeerCount; i++)
     {
@@ -1422,6 +1637,7 @@ bool WeaveFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry
 
     return retVal;
 }
+#endif // WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
 
 /*
  * This method is used by provisioning servers to register callbacks with the
@@ -1979,6 +2195,27 @@ WEAVE_ERROR WeaveFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId
     if (peerNodeId == kNodeIdNotSpecified || peerNodeId == kAnyNodeId)
         return WEAVE_ERROR_INVALID_ARGUMENT;
 
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    size_t pos = SessionKeyIndex.Begin(keyId);
+    uint16_t i;
+
+    while (SessionKeyIndex.Next(keyId, pos, i))
+    {
+        curRec = &SessionKeys[i];
+
+        if (curRec->MsgEncKey.KeyId == keyId &&
+            (curRec->NodeId == peerNodeId ||
+             (curRec->IsSharedSession() && FindSharedSessionEndNode(peerNodeId, curRec))))
+        {
+            retRec = curRec;
+            return WEAVE_NO_ERROR;
+        }
+    }
+
+    // Offer the key at the top of the free stack; IndexSessionKey() takes it off the stack once it is allocated.
+    if (NumFreeSessionKeys > 0)
+        freeRec = &SessionKeys[FreeSessionKeys[NumFreeSessionKeys - 1]];
+#else
     for (int i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++, curRec++)
     {
         if (!curRec->IsAllocated())
@@ -1994,6 +2231,7 @@ WEAVE_ERROR WeaveFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId
             return WEAVE_NO_ERROR;
         }
     }
+#endif
 
     if (!create)
         return WEAVE_ERROR_KEY_NOT_FOUND;
@@ -2091,6 +2329,9 @@ WEAVE_ERROR WeaveFabricState::DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType
     // Set key parameters.
     appKey.KeyId = keyId;
     appKey.EncType = encType;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    appKey.ComputeKeySchedule();
+#endif
 
 exit:
     ClearSecretData(keyData, sizeof(keyData));
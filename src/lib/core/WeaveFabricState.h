@@ -46,8 +46,13 @@
 #include <Weave/Support/PersistedCounter.h>
 #include <Weave/Support/FlagUtils.hpp>
 #include <Weave/Core/WeaveKeyIds.h>
+#include <Weave/Core/WeaveExchangeIndex.h>
 #include <Weave/Profiles/security/WeaveSecurity.h>
 #include <Weave/Profiles/security/WeaveApplicationKeys.h>
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+#include <Weave/Support/crypto/AESBlockCipher.h>
+#include <Weave/Support/crypto/HMAC.h>
+#endif
 
 namespace nl {
 namespace Weave {
@@ -287,6 +292,18 @@ typedef union WeaveEncryptionKey
     WeaveEncryptionKey_AES128CTRSHA1 AES128CTRSHA1;
 } WeaveEncryptionKey;
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+// Expanded form of an encryption key for the AES-128-CTR-SHA-1 message encryption type
+class WeaveEncryptionKeySchedule_AES128CTRSHA1
+{
+public:
+    Platform::Security::AES128BlockCipherEnc DataKey;   /**< The block cipher, keyed with the data key. */
+    Crypto::HMACSHA1::PrecomputedKey IntegrityKey;      /**< The HMAC hash states for the integrity key. */
+};
+
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 // AES128CTRSHA1 encryption and integrity test keys, which should only be used for testing purposes.
 enum
 {
@@ -307,6 +324,13 @@ public:
     uint16_t KeyId;                                     /**< The key ID. */
     uint8_t EncType;                                    /**< The encryption type supported by the key. */
     WeaveEncryptionKey EncKey;                          /**< The secret key material. */
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    WeaveEncryptionKeySchedule_AES128CTRSHA1 KeySchedule; /**< The expanded secret key material, valid while EncType is
+                                                             #kWeaveEncryptionType_AES128CTRSHA1. */
+
+    void ComputeKeySchedule(void);
+    void ClearKeySchedule(void);
+#endif
 };
 
 /**
@@ -605,6 +629,12 @@ private:
     MonotonicallyIncreasingCounter NextUnencUDPMsgId;
     MonotonicallyIncreasingCounter NextUnencTCPMsgId;
     WeaveSessionKey SessionKeys[WEAVE_CONFIG_MAX_SESSION_KEYS];
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    ExchangeIndex SessionKeyIndex;                      // Indexes allocated session keys by key id
+    ExchangeIndex::Entry SessionKeyIndexEntries[ExchangeIndex::TableSize<WEAVE_CONFIG_MAX_SESSION_KEYS>::kValue];
+    uint16_t FreeSessionKeys[WEAVE_CONFIG_MAX_SESSION_KEYS];
+    uint16_t NumFreeSessionKeys;
+#endif
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     PersistedCounter NextGroupKeyMsgId;
 
@@ -637,9 +667,20 @@ private:
         WeaveSessionState::ReceiveFlagsType GroupKeyRcvFlags[WEAVE_CONFIG_MAX_PEER_NODES];
 #endif
         WeaveSessionState::ReceiveFlagsType UnencRcvFlags[WEAVE_CONFIG_MAX_PEER_NODES];
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+        // Circular list of peer indexes in order from most- to least- recently used.
+        PeerIndexType MoreRecentlyUsed[WEAVE_CONFIG_MAX_PEER_NODES];
+        PeerIndexType LessRecentlyUsed[WEAVE_CONFIG_MAX_PEER_NODES];
+        PeerIndexType MostRecentlyUsedIndex;
+#else
         // Array of peer indexes in sorted order from most- to least- recently used.
         PeerIndexType MostRecentlyUsedIndexes[WEAVE_CONFIG_MAX_PEER_NODES];
+#endif
     } PeerStates;
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    ExchangeIndex PeerStateIndex;                       // Indexes allocated peer states by node id
+    ExchangeIndex::Entry PeerStateIndexEntries[ExchangeIndex::TableSize<WEAVE_CONFIG_MAX_PEER_NODES>::kValue];
+#endif
     FabricStateDelegate *Delegate;
 
     // This structure contains information about shared session end node.
@@ -664,6 +705,11 @@ private:
 #endif
 
     bool FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType& retPeerIndex);
+#if WEAVE_CONFIG_ENABLE_FABRIC_STATE_INDEX
+    void MarkPeerEntryMostRecentlyUsed(PeerIndexType peerIndex);
+    void IndexSessionKey(WeaveSessionKey *sessionKey);
+    static uint32_t GetPeerStateKey(uint64_t peerNodeId);
+#endif
     WEAVE_ERROR FindMsgEncAppKey(uint16_t keyId, uint8_t encType, WeaveMsgEncryptionKey *& retRec);
     WEAVE_ERROR DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType, WeaveMsgEncryptionKey & appKey, uint32_t& appGroupGlobalId);
 };
@@ -1248,9 +1248,20 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
 
             // Re-encrypt the payload.
             AES128CTRMode aes128CTR;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+            aes128CTR.SetKey(sessionState.MsgEncKey->KeySchedule.DataKey);
+#else
             aes128CTR.SetKey(sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey);
+#endif
             aes128CTR.SetWeaveMessageCounter(msgInfo.SourceNodeId, msgInfo.MessageId);
             aes128CTR.EncryptData(p, encryptionLen, p);
+
+            // The payload and the integrity check value may continue through a chain of buffers; the
+            // cipher carries its state across the buffer boundaries.
+            for (PacketBuffer *buf = msgBuf->Next(); buf != NULL; buf = buf->Next())
+            {
+                aes128CTR.EncryptData(buf->Start(), buf->DataLength(), buf->Start());
+            }
         }
         break;
     default:
@@ -1314,10 +1325,17 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
     }
 
     // Compute the number of bytes that will appear before and after the message payload
-    // in the final encoded message.
+    // in the final encoded message.  The payload may span a chain of buffers, in which case
+    // the header is placed in the first buffer and the integrity check value in the last.
     uint16_t headLen = 6;
     uint16_t tailLen = 0;
-    uint16_t payloadLen = msgBuf->DataLength();
+    uint32_t payloadLen = msgBuf->DataLength();
+    PacketBuffer *lastBuf = msgBuf;
+    for (PacketBuffer *buf = msgBuf->Next(); buf != NULL; buf = buf->Next())
+    {
+        payloadLen += buf->DataLength();
+        lastBuf = buf;
+    }
     if (msgInfo->Flags & kWeaveMessageFlag_SourceNodeId)
         headLen += 8;
     if (msgInfo->Flags & kWeaveMessageFlag_DestNodeId)
@@ -1338,7 +1356,7 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
     }
 
     // Error if the encoded message would be longer than the requested maximum.
-    if ((headLen + msgBuf->DataLength() + tailLen) > maxLen)
+    if ((headLen + payloadLen + tailLen) > maxLen)
         return WEAVE_ERROR_MESSAGE_TOO_LONG;
 
     // Ensure there's enough room before the payload to hold the message header.
@@ -1347,7 +1365,7 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         return WEAVE_ERROR_BUFFER_TOO_SMALL;
 
     // Error if not enough space after the message payload.
-    if ((msgBuf->DataLength() + tailLen) > msgBuf->MaxDataLength())
+    if ((lastBuf->DataLength() + tailLen) > lastBuf->MaxDataLength())
         return WEAVE_ERROR_BUFFER_TOO_SMALL;
 
     uint8_t *payloadStart = msgBuf->Start();
@@ -1426,25 +1444,37 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         // Encode the key id.
         LittleEndian::Write16(p, msgInfo->KeyId);
 
-        // At this point we've completed encoding the head of the message (and therefore p == payloadStart),
-        // so skip over the payload data.
-        p += payloadLen;
+        // At this point we've completed encoding the head of the message (and therefore p == payloadStart).
+        // Compute the integrity check value, store it immediately after the payload data, and encrypt the
+        // message payload and the integrity check value, in place, in the message buffer.
+        Encrypt_AES128CTRSHA1(msgInfo, *sessionState.MsgEncKey, msgBuf, payloadStart);
 
-        // Compute the integrity check value and store it immediately after the payload data.
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
-                                            payloadStart, payloadLen, p);
-        p += HMACSHA1::kDigestLength;
-
-        // Encrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
-                              payloadStart, payloadLen + HMACSHA1::kDigestLength, payloadStart);
+        // Skip over the payload data and the integrity check value.
+        p += payloadLen + HMACSHA1::kDigestLength;
 
         break;
     }
 
     msgInfo->Flags |= kWeaveMessageFlag_MessageEncoded;
     // Update the buffer length to reflect the entire encoded message.
-    msgBuf->SetDataLength(headLen + payloadLen + tailLen);
+    if (lastBuf == msgBuf)
+    {
+        msgBuf->SetDataLength(headLen + payloadLen + tailLen);
+    }
+    else
+    {
+        lastBuf->SetDataLength(lastBuf->DataLength() + tailLen);
+
+        // Relink the chain so that the total length recorded in each buffer is accurate; chains
+        // built by a TLVWriter do not maintain it.
+        PacketBuffer *tail = msgBuf->DetachTail();
+        while (tail != NULL)
+        {
+            PacketBuffer *next = (tail->Next() != NULL) ? tail->DetachTail() : NULL;
+            msgBuf->AddToEnd(tail);
+            tail = next;
+        }
+    }
 
     // We update the cursor (p) out of good hygiene,
     // such that if the code is extended in the future such that the cursor is used,
@@ -1498,17 +1528,11 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
         *rPayloadLen = payloadLen;
         *rPayload = p;
 
-        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
-                              p, payloadLen + HMACSHA1::kDigestLength, p);
-
-        // Compute the expected integrity check value from the decrypted payload.
-        uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
-                                            p, payloadLen, expectedIntegrityCheck);
-        // Error if the expected integrity check doesn't match the integrity check in the message.
-        if (!ConstantTimeCompare(p + payloadLen, expectedIntegrityCheck, HMACSHA1::kDigestLength))
+        // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer,
+        // and compare the integrity check value to the one expected from the decrypted payload.
+        if (!Decrypt_AES128CTRSHA1(msgInfo, *sessionState.MsgEncKey, p, payloadLen))
             return WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
+
         // Skip past the payload and the integrity check value.
         p += payloadLen + HMACSHA1::kDigestLength;
 
@@ -1547,7 +1571,7 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessageWithLength(WeaveMessageInfo *msgInfo
 
     // Prepend the message length to the beginning of the message.
     uint8_t * newMsgStart = msgBuf->Start() - 2;
-    uint16_t msgLen = msgBuf->DataLength();
+    uint16_t msgLen = msgBuf->TotalLength();
     msgBuf->SetStart(newMsgStart);
     LittleEndian::Put16(newMsgStart, msgLen);
 
@@ -2201,24 +2225,28 @@ exit:
     return err;
 }
 
-void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                              const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
-{
-    AES128CTRMode aes128CTR;
-    aes128CTR.SetKey(key);
-    aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
-    aes128CTR.EncryptData(inData, inLen, outBuf);
-}
+// The number of payload bytes hashed and encrypted at a time when protecting an AES128CTRSHA1 message.
+// This is a multiple of both the SHA-1 and the AES block sizes.
+static const uint16_t kAES128CTRSHA1ChunkLength = 256;
 
-void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                                            const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
+// Key the HMAC and the CTR mode cipher used to protect an AES128CTRSHA1 message, set the initial counter, and
+// begin computing the integrity check value by hashing the header fields it covers.
+static void BeginProtection_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey &msgEncKey, HMACSHA1 &hmacSHA1,
+                                          AES128CTRMode &aes128CTR)
 {
-    HMACSHA1 hmacSHA1;
     uint8_t encodedBuf[2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)];
     uint8_t *p = encodedBuf;
 
-    // Initialize HMAC Key.
-    hmacSHA1.Begin(key, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+    // Initialize HMAC and AES keys, from their expanded forms if those are cached with the key.
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    hmacSHA1.Begin(msgEncKey.KeySchedule.IntegrityKey);
+    aes128CTR.SetKey(msgEncKey.KeySchedule.DataKey);
+#else
+    hmacSHA1.Begin(msgEncKey.EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+    aes128CTR.SetKey(msgEncKey.EncKey.AES128CTRSHA1.DataKey);
+#endif
+
+    aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
 
     // Encode the source and destination node identifiers in a little-endian format.
     Encoding::LittleEndian::Write64(p, msgInfo->SourceNodeId);
@@ -2240,12 +2268,110 @@ void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageIn
 
     // Hash encoded message header fields.
     hmacSHA1.AddData(encodedBuf, p - encodedBuf);
+}
+
+/**
+ *  Compute the integrity check value of a message payload, store it immediately after the payload,
+ *  and encrypt the payload and the integrity check value, in place.
+ *
+ *  The payload is processed in a single pass, in chunks small enough to stay in the L1 cache between
+ *  being hashed and being encrypted.
+ *
+ *  @param[in]    msgInfo       A pointer to the WeaveMessageInfo object for the message.
+ *
+ *  @param[in]    msgEncKey     The message encryption key.
+ *
+ *  @param[inout] payloadBuf    The buffer containing the start of the payload.  The payload extends to
+ *                              the end of the data in this buffer and through any buffers chained to it.
+ *                              The last buffer must have room for the integrity check value.
+ *
+ *  @param[inout] payload       A pointer to the start of the payload within @a payloadBuf.
+ *
+ */
+void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey &msgEncKey,
+                                              PacketBuffer *payloadBuf, uint8_t *payload)
+{
+    HMACSHA1 hmacSHA1;
+    AES128CTRMode aes128CTR;
+    uint8_t *p = payload;
+
+    BeginProtection_AES128CTRSHA1(msgInfo, msgEncKey, hmacSHA1, aes128CTR);
+
+    while (true)
+    {
+        uint16_t remainingLen = static_cast<uint16_t>(payloadBuf->Start() + payloadBuf->DataLength() - p);
+
+        while (remainingLen > 0)
+        {
+            const uint16_t chunkLen = (remainingLen < kAES128CTRSHA1ChunkLength) ? remainingLen : kAES128CTRSHA1ChunkLength;
+
+            hmacSHA1.AddData(p, chunkLen);
+            aes128CTR.EncryptData(p, chunkLen, p);
+
+            p += chunkLen;
+            remainingLen -= chunkLen;
+        }
+
+        // Continue with the next buffer in the chain, if any.  The cipher and the hash both carry
+        // their state across the buffer boundary.
+        if (payloadBuf->Next() == NULL)
+            break;
+
+        payloadBuf = payloadBuf->Next();
+        p = payloadBuf->Start();
+    }
+
+    // Generate the MAC, then encrypt it in place.
+    hmacSHA1.Finish(p);
+    aes128CTR.EncryptData(p, HMACSHA1::kDigestLength, p);
+}
+
+/**
+ *  Decrypt a message payload and the integrity check value that follows it, in place, and verify
+ *  the integrity check value.
+ *
+ *  The payload is processed in a single pass, in chunks small enough to stay in the L1 cache between
+ *  being decrypted and being hashed.
+ *
+ *  @param[in]    msgInfo       A pointer to the WeaveMessageInfo object for the message.
+ *
+ *  @param[in]    msgEncKey     The message encryption key.
+ *
+ *  @param[inout] payload       A pointer to the encrypted payload, which is followed by the encrypted
+ *                              integrity check value.
+ *
+ *  @param[in]    payloadLen    The length of the payload, excluding the integrity check value.
+ *
+ *  @return   true if the integrity check value matches the decrypted payload, false otherwise.
+ *
+ */
+bool WeaveMessageLayer::Decrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey &msgEncKey, uint8_t *payload,
+                                              uint16_t payloadLen)
+{
+    HMACSHA1 hmacSHA1;
+    AES128CTRMode aes128CTR;
+    uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
+    uint8_t *p = payload;
+    uint16_t remainingLen = payloadLen;
+
+    BeginProtection_AES128CTRSHA1(msgInfo, msgEncKey, hmacSHA1, aes128CTR);
+
+    while (remainingLen > 0)
+    {
+        const uint16_t chunkLen = (remainingLen < kAES128CTRSHA1ChunkLength) ? remainingLen : kAES128CTRSHA1ChunkLength;
+
+        aes128CTR.EncryptData(p, chunkLen, p);
+        hmacSHA1.AddData(p, chunkLen);
+
+        p += chunkLen;
+        remainingLen -= chunkLen;
+    }
 
-    // Handle payload data.
-    hmacSHA1.AddData(inData, inLen);
+    // Decrypt the integrity check value in the message and compare it to the expected one.
+    aes128CTR.EncryptData(p, HMACSHA1::kDigestLength, p);
+    hmacSHA1.Finish(expectedIntegrityCheck);
 
-    // Generate the MAC.
-    hmacSHA1.Finish(outBuf);
+    return ConstantTimeCompare(p, expectedIntegrityCheck, HMACSHA1::kDigestLength);
 }
 
 /**
@@ -788,10 +788,10 @@ private:
     static void HandleIncomingTcpConnection(TCPEndPoint *listeningEndPoint, TCPEndPoint *conEndPoint, const IPAddress &peerAddr,
             uint16_t peerPort);
     static void HandleAcceptError(TCPEndPoint *endPoint, INET_ERROR err);
-    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                      const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
-    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
-                                                    const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
+    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey &msgEncKey, PacketBuffer *payloadBuf,
+                                      uint8_t *payload);
+    static bool Decrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey &msgEncKey, uint8_t *payload,
+                                      uint16_t payloadLen);
     static WEAVE_ERROR FilterUDPSendError(WEAVE_ERROR err, bool isMulticast);
     static bool IsIgnoredMulticastSendError(WEAVE_ERROR err);
 
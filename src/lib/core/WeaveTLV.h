@@ -250,6 +250,7 @@ public:
     WEAVE_ERROR PutBytes(uint64_t tag, const uint8_t *buf, uint32_t len);
     WEAVE_ERROR StartPutBytes(uint64_t tag, uint32_t totalLen);
     WEAVE_ERROR ContinuePutBytes(const uint8_t *buf, uint32_t len);
+    WEAVE_ERROR PutBytesRef(uint64_t tag, PacketBuffer *data);
     WEAVE_ERROR PutString(uint64_t tag, const char *buf);
     WEAVE_ERROR PutString(uint64_t tag, const char *buf, uint32_t len);
     WEAVE_ERROR PutStringF(uint64_t tag, const char *fmt, ...);
@@ -269,6 +270,7 @@ public:
     TLVType GetContainerType(void) const;
 
     uint32_t GetLengthWritten(void);
+    uint32_t GetRemainingLength(void) const;
 
     uint32_t ImplicitProfileId;
     void *AppData;
@@ -306,11 +308,20 @@ protected:
 private:
     bool mContainerOpen;
     bool mCloseContainerReserved;
+    bool mSizeOnly;
 
 protected:
     bool IsContainerOpen(void) const { return mContainerOpen; }
     void SetContainerOpen(bool aContainerOpen) { mContainerOpen = aContainerOpen; }
 
+    /**
+     * @brief
+     *   Determine whether the writer only accounts for the length of the
+     *   encoding, without storing it (see TLVSizer).
+     */
+    bool IsSizeOnly(void) const { return mSizeOnly; }
+    void SetSizeOnly(bool aSizeOnly) { mSizeOnly = aSizeOnly; }
+
     enum {
         kEndOfContainerMarkerSize = 1, /**< Size of the EndOfContainer marker, used in reserving space. */
     };
@@ -339,6 +350,25 @@ protected:
     WEAVE_ERROR WriteData(const uint8_t *p, uint32_t len);
 };
 
+/**
+ * Computes the length of a TLV encoding without storing it.
+ *
+ * TLVSizer is a TLVWriter that has no output buffer.  Applications write elements to it exactly
+ * as they would to any other TLVWriter, including via container writers obtained from
+ * OpenContainer(), and then call GetLengthWritten() to learn the number of bytes the same sequence
+ * of calls would produce.  This allows an application to decide whether an encoding will fit in the
+ * space available before actually writing it.
+ *
+ * Because a TLVSizer copies no data, sizing an encoding is considerably cheaper than writing it.
+ * If a maximum length is given, writes that would exceed it fail with WEAVE_ERROR_BUFFER_TOO_SMALL,
+ * just as they would for a writer with that much space.
+ */
+class NL_DLL_EXPORT TLVSizer : public TLVWriter
+{
+public:
+    void Init(uint32_t maxLen = 0xFFFFFFFFUL);
+};
+
 #if WEAVE_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 inline WEAVE_ERROR TLVWriter::GetNewInetBuffer(TLVWriter& writer, uintptr_t& bufHandle, uint8_t *& bufStart, uint32_t& bufLen)
 {
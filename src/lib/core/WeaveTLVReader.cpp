@@ -37,6 +37,32 @@ using namespace nl::Weave::Encoding;
 
 static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
 
+enum
+{
+    kInvalidElementType                         = 0xFF
+};
+
+/**
+ * Number of bytes in the length/value field of an element, indexed by TLVElementType.  Values
+ * in the reserved range (0x19 - 0x1F) map to kInvalidElementType.  This folds the
+ * IsValidTLVType(), GetTLVFieldSize() and TLVFieldSizeToBytes() computations into a single
+ * lookup on the element decode path.
+ */
+static const uint8_t sValOrLenSizes[] =
+{
+    1, 2, 4, 8,                             // Signed Integer (Int8 - Int64)
+    1, 2, 4, 8,                             // Unsigned Integer (UInt8 - UInt64)
+    0, 0,                                   // Boolean (False, True)
+    4, 8,                                   // Floating Point Number (32, 64)
+    1, 2, 4, 8,                             // UTF8 String (1 - 8 byte length)
+    1, 2, 4, 8,                             // Byte String (1 - 8 byte length)
+    0,                                      // Null
+    0, 0, 0,                                // Structure, Array, Path
+    0,                                      // End of Container
+    kInvalidElementType, kInvalidElementType, kInvalidElementType, kInvalidElementType,
+    kInvalidElementType, kInvalidElementType, kInvalidElementType
+};
+
 /**
  * @fn uint32_t TLVReader::GetLengthRead() const
  *
@@ -1286,19 +1312,23 @@ WEAVE_ERROR TLVReader::ReadElement()
     WEAVE_ERROR err;
     uint8_t stagingBuf[17]; // 17 = 1 control byte + 8 tag bytes + 8 length/value bytes
     const uint8_t *p;
-    TLVElementType elemType;
 
-    // Make sure we have input data. Return WEAVE_END_OF_TLV if no more data is available.
-    err = EnsureData(WEAVE_END_OF_TLV);
-    if (err != WEAVE_NO_ERROR)
-        return err;
+    // Make sure we have input data. Return WEAVE_END_OF_TLV if no more data is available.  The buffer
+    // callback machinery is only consulted when the current input buffer has been exhausted.
+    if (mReadPoint == mBufEnd)
+    {
+        err = EnsureData(WEAVE_END_OF_TLV);
+        if (err != WEAVE_NO_ERROR)
+            return err;
+    }
 
     // Get the element's control byte.
     mControlByte = *mReadPoint;
 
-    // Extract the element type from the control byte. Fail if it's invalid.
-    elemType = ElementType();
-    if (!IsValidTLVType(elemType))
+    // Determine the number of bytes in the length/value field from the element type. Fail if the
+    // type is invalid.
+    uint8_t valOrLenBytes = sValOrLenSizes[mControlByte & kTLVTypeMask];
+    if (valOrLenBytes == kInvalidElementType)
         return WEAVE_ERROR_INVALID_TLV_ELEMENT;
 
     // Extract the tag control from the control byte.
@@ -1307,12 +1337,6 @@ WEAVE_ERROR TLVReader::ReadElement()
     // Determine the number of bytes in the element's tag, if any.
     uint8_t tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
 
-    // Extract the size of length/value field from the control byte.
-    TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
-
-    // Determine the number of bytes in the length/value field.
-    uint8_t valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
-
     // Determine the number of bytes in the element's 'head'. This includes: the control byte, the tag bytes (if present), the
     // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes.
     uint8_t elemHeadBytes = 1 + tagBytes + valOrLenBytes;
@@ -1336,25 +1360,29 @@ WEAVE_ERROR TLVReader::ReadElement()
     // Skip over the control byte.
     p++;
 
-    // Read the tag field, if present.
-    mElemTag = ReadTag(tagControl, p);
+    // Read the tag field, if present.  Context tags are by far the most common form in practice, so
+    // decode them inline.
+    if (tagControl == kTLVTagControl_ContextSpecific)
+        mElemTag = ContextTag(Read8(p));
+    else
+        mElemTag = ReadTag(tagControl, p);
 
     // Read the length/value field, if present.
-    switch (lenOrValFieldSize)
+    switch (valOrLenBytes)
     {
-    case kTLVFieldSize_0Byte:
+    case 0:
         mElemLenOrVal = 0;
         break;
-    case kTLVFieldSize_1Byte:
+    case 1:
         mElemLenOrVal = Read8(p);
         break;
-    case kTLVFieldSize_2Byte:
+    case 2:
         mElemLenOrVal = LittleEndian::Read16(p);
         break;
-    case kTLVFieldSize_4Byte:
+    case 4:
         mElemLenOrVal = LittleEndian::Read32(p);
         break;
-    case kTLVFieldSize_8Byte:
+    default:
         mElemLenOrVal = LittleEndian::Read64(p);
         break;
     }
@@ -1456,9 +1484,12 @@ WEAVE_ERROR TLVReader::ReadData(uint8_t *buf, uint32_t len)
 
     while (len > 0)
     {
-        err = EnsureData(WEAVE_ERROR_TLV_UNDERRUN);
-        if (err != WEAVE_NO_ERROR)
-            return err;
+        if (mReadPoint == mBufEnd)
+        {
+            err = EnsureData(WEAVE_ERROR_TLV_UNDERRUN);
+            if (err != WEAVE_NO_ERROR)
+                return err;
+        }
 
         uint32_t remainingLen = mBufEnd - mReadPoint;
 
@@ -1519,7 +1550,6 @@ WEAVE_ERROR TLVReader::GetElementHeadLength(uint8_t& elemHeadBytes) const
     uint8_t tagBytes;
     uint8_t valOrLenBytes;
     TLVTagControl tagControl;
-    TLVFieldSize lenOrValFieldSize;
     TLVElementType elemType = ElementType();
 
     // Verify element is of valid TLVType.
@@ -1531,11 +1561,8 @@ WEAVE_ERROR TLVReader::GetElementHeadLength(uint8_t& elemHeadBytes) const
     // Determine the number of bytes in the element's tag, if any.
     tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
 
-    // Extract the size of length/value field from the control byte.
-    lenOrValFieldSize = GetTLVFieldSize(elemType);
-
     // Determine the number of bytes in the length/value field.
-    valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
+    valOrLenBytes = sValOrLenSizes[elemType];
 
     // Determine the number of bytes in the element's 'head'. This includes: the
     // control byte, the tag bytes (if present), the length bytes (if present),
@@ -163,6 +163,7 @@ WEAVE_ERROR TLVUpdater::Init(TLVReader& aReader, uint32_t freeLen)
     mUpdaterWriter.mContainerType = aReader.mContainerType;
     mUpdaterWriter.SetContainerOpen(false);
     mUpdaterWriter.SetCloseContainerReserved(false);
+    mUpdaterWriter.SetSizeOnly(false);
 
     mUpdaterWriter.ImplicitProfileId = aReader.ImplicitProfileId;
     mUpdaterWriter.GetNewBuffer = NULL;
@@ -443,6 +443,538 @@ WEAVE_ERROR Find(const TLVReader &aReader, IterateHandler aPredicate, void *aCon
     return retval;
 }
 
+/**
+ *  A TLV reader through which a TLVStructuralIndex records, and later restores,
+ *  the decoded state of an indexed element.
+ */
+class IndexTLVReader : public TLVReader
+{
+public:
+    uint64_t GetLenOrVal(void) const { return mElemLenOrVal; }
+
+    void Position(const TLVReader &aStart, const TLVIndexEntry &aEntry, TLVType aContainerType);
+};
+
+void IndexTLVReader::Position(const TLVReader &aStart, const TLVIndexEntry &aEntry, TLVType aContainerType)
+{
+    Init(aStart);
+
+    mReadPoint += aEntry.mDataOffset;
+    mLenRead += aEntry.mDataOffset;
+    mControlByte = aEntry.mControlByte;
+    mElemTag = aEntry.mTag;
+    mElemLenOrVal = aEntry.mLenOrVal;
+    mContainerType = aContainerType;
+    SetContainerOpen(false);
+}
+
+/**
+ *  Order entries of a tag order array by parent, then by tag, then by position
+ *  within the encoding.
+ */
+static bool TagOrderLess(const TLVIndexEntry *aEntries, uint16_t aFirst, uint16_t aSecond)
+{
+    const TLVIndexEntry &first  = aEntries[aFirst];
+    const TLVIndexEntry &second = aEntries[aSecond];
+
+    if (first.mParent != second.mParent)
+        return first.mParent < second.mParent;
+
+    if (first.mTag != second.mTag)
+        return first.mTag < second.mTag;
+
+    return aFirst < aSecond;
+}
+
+static void SiftDownTagOrder(const TLVIndexEntry *aEntries, uint16_t *aTagOrder, size_t aRoot, size_t aCount)
+{
+    size_t child;
+
+    while ((child = 2 * aRoot + 1) < aCount)
+    {
+        if (child + 1 < aCount && TagOrderLess(aEntries, aTagOrder[child], aTagOrder[child + 1]))
+            child++;
+
+        if (!TagOrderLess(aEntries, aTagOrder[aRoot], aTagOrder[child]))
+            break;
+
+        uint16_t temp     = aTagOrder[aRoot];
+        aTagOrder[aRoot]  = aTagOrder[child];
+        aTagOrder[child]  = temp;
+
+        aRoot = child;
+    }
+}
+
+/**
+ *  Build a structural index of the TLV data referenced by @a aReader.
+ *
+ *  Indexing covers the same elements that Iterate() would visit: if the reader
+ *  is positioned on an element, indexing begins with that element; otherwise it
+ *  begins with the next element.  Indexing continues, descending into all
+ *  containers, until the end of the encoding or of the reader's enclosing
+ *  container.  The reader itself is not modified.
+ *
+ *  @param[in]     aReader      A read-only reference to the TLV reader whose
+ *                              data is to be indexed.
+ *  @param[in]     aEntries     A pointer to storage for the index entries.
+ *  @param[in]     aMaxEntries  The number of entries available at @a aEntries.
+ *
+ *  @retval  #WEAVE_NO_ERROR                On success.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT  If @a aEntries is NULL, or the encoding
+ *                                          does not reside in a single contiguous
+ *                                          buffer.
+ *
+ *  @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL  If the encoding contains more than
+ *                                          @a aMaxEntries elements.
+ *
+ *  @retval  other                          Errors returned by the TLV reader while
+ *                                          parsing the encoding.
+ *
+ */
+WEAVE_ERROR TLVStructuralIndex::Init(const TLVReader &aReader, TLVIndexEntry *aEntries, uint16_t aMaxEntries)
+{
+    return Init(aReader, aEntries, NULL, aMaxEntries);
+}
+
+/**
+ *  Build a structural index of the TLV data referenced by @a aReader, along
+ *  with a tag order that allows children to be looked up by tag in
+ *  logarithmic time.
+ *
+ *  @param[in]     aReader      A read-only reference to the TLV reader whose
+ *                              data is to be indexed.
+ *  @param[in]     aEntries     A pointer to storage for the index entries.
+ *  @param[in]     aTagOrder    A pointer to storage for the tag order, with room
+ *                              for @a aMaxEntries values, or NULL to look up
+ *                              children by visiting them in turn.
+ *  @param[in]     aMaxEntries  The number of entries available at @a aEntries.
+ *
+ *  @retval  #WEAVE_NO_ERROR                On success.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT  If @a aEntries is NULL, or the encoding
+ *                                          does not reside in a single contiguous
+ *                                          buffer.
+ *
+ *  @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL  If the encoding contains more than
+ *                                          @a aMaxEntries elements.
+ *
+ *  @retval  other                          Errors returned by the TLV reader while
+ *                                          parsing the encoding.
+ *
+ */
+WEAVE_ERROR TLVStructuralIndex::Init(const TLVReader &aReader, TLVIndexEntry *aEntries, uint16_t *aTagOrder, uint16_t aMaxEntries)
+{
+    IndexTLVReader reader;
+    uint16_t       parent = kTLVIndex_None;
+    WEAVE_ERROR    err    = WEAVE_NO_ERROR;
+
+    mStart.Init(aReader);
+    mEntries    = aEntries;
+    mTagOrder   = aTagOrder;
+    mNumEntries = 0;
+
+    VerifyOrExit(aEntries != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Entry indices must leave room for kTLVIndex_None.
+    if (aMaxEntries == kTLVIndex_None)
+        aMaxEntries--;
+
+    reader.Init(aReader);
+
+    if (reader.GetType() == kTLVType_NotSpecified)
+        err = reader.Next();
+
+    while (true)
+    {
+        // Entries are restored by offsetting from the starting read point, which is only possible
+        // while the reader has not moved on to another buffer.
+        if (err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV)
+        {
+            const uint32_t lenRead = reader.GetLengthRead() - mStart.GetLengthRead();
+
+            VerifyOrExit(reader.GetReadPoint() == mStart.GetReadPoint() + lenRead, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+
+        if (err == WEAVE_END_OF_TLV)
+        {
+            if (parent == kTLVIndex_None)
+                break;
+
+            TLVIndexEntry &container = mEntries[parent];
+
+            err = reader.ExitContainer(GetContainerType(container.mParent));
+            SuccessOrExit(err);
+
+            container.mEndOffset      = reader.GetLengthRead() - mStart.GetLengthRead();
+            container.mNumDescendants = mNumEntries - parent - 1;
+
+            parent = container.mParent;
+        }
+        else
+        {
+            SuccessOrExit(err);
+
+            VerifyOrExit(mNumEntries < aMaxEntries, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+            const uint32_t dataOffset = reader.GetLengthRead() - mStart.GetLengthRead();
+            TLVIndexEntry &entry = mEntries[mNumEntries];
+
+            entry.mTag            = reader.GetTag();
+            entry.mLenOrVal       = reader.GetLenOrVal();
+            entry.mDataOffset     = dataOffset;
+            entry.mEndOffset      = dataOffset;
+            entry.mParent         = parent;
+            entry.mNumDescendants = 0;
+            entry.mControlByte    = reader.GetControlByte();
+            entry.mType           = reader.GetType();
+
+            if (TLVTypeIsContainer(entry.mType))
+            {
+                TLVType outerContainerType;
+
+                err = reader.EnterContainer(outerContainerType);
+                SuccessOrExit(err);
+
+                parent = mNumEntries;
+            }
+            else if (TLVTypeIsString(entry.mControlByte & kTLVTypeMask))
+            {
+                entry.mEndOffset += static_cast<uint32_t>(entry.mLenOrVal);
+            }
+
+            mNumEntries++;
+        }
+
+        err = reader.Next();
+    }
+
+    err = WEAVE_NO_ERROR;
+
+    if (mTagOrder != NULL)
+    {
+        SortTagOrder();
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        mNumEntries = 0;
+    }
+
+    return err;
+}
+
+/**
+ *  Sort the tag order array into (parent, tag, position) order.
+ */
+void TLVStructuralIndex::SortTagOrder(void)
+{
+    size_t i;
+
+    for (i = 0; i < mNumEntries; i++)
+        mTagOrder[i] = static_cast<uint16_t>(i);
+
+    for (i = mNumEntries / 2; i > 0; i--)
+        SiftDownTagOrder(mEntries, mTagOrder, i - 1, mNumEntries);
+
+    for (i = mNumEntries; i > 1; i--)
+    {
+        uint16_t temp     = mTagOrder[0];
+        mTagOrder[0]      = mTagOrder[i - 1];
+        mTagOrder[i - 1]  = temp;
+
+        SiftDownTagOrder(mEntries, mTagOrder, 0, i - 1);
+    }
+}
+
+/**
+ *  Return the index of the entry immediately following the last descendant of
+ *  the specified container, or of the last top-level element.
+ */
+uint16_t TLVStructuralIndex::GetChildrenEnd(uint16_t aParent) const
+{
+    if (aParent == kTLVIndex_None)
+        return mNumEntries;
+
+    return aParent + 1 + mEntries[aParent].mNumDescendants;
+}
+
+/**
+ *  Return the type of the container in which the children of the specified
+ *  entry reside.
+ */
+TLVType TLVStructuralIndex::GetContainerType(uint16_t aParent) const
+{
+    if (aParent == kTLVIndex_None)
+        return mStart.GetContainerType();
+
+    return static_cast<TLVType>(mEntries[aParent].mType);
+}
+
+/**
+ *  Return the index of the first element within the specified container.
+ *
+ *  @param[in]   aIndex         The index of a container entry, or
+ *                              #kTLVIndex_None for the top level.
+ *
+ *  @return  The index of the first child, or #kTLVIndex_None if the entry is
+ *           not a container or the container is empty.
+ *
+ */
+uint16_t TLVStructuralIndex::GetFirstChild(uint16_t aIndex) const
+{
+    uint16_t child = (aIndex == kTLVIndex_None) ? 0 : aIndex + 1;
+
+    return (child < GetChildrenEnd(aIndex)) ? child : static_cast<uint16_t>(kTLVIndex_None);
+}
+
+/**
+ *  Return the index of the element following the specified element within its
+ *  container, skipping over any contents of the element in constant time.
+ *
+ *  @param[in]   aIndex         The index of an entry.
+ *
+ *  @return  The index of the next sibling, or #kTLVIndex_None if the entry is
+ *           the last element of its container.
+ *
+ */
+uint16_t TLVStructuralIndex::GetNextSibling(uint16_t aIndex) const
+{
+    uint16_t sibling = aIndex + 1 + mEntries[aIndex].mNumDescendants;
+
+    return (sibling < GetChildrenEnd(mEntries[aIndex].mParent)) ? sibling : static_cast<uint16_t>(kTLVIndex_None);
+}
+
+/**
+ *  Find the first element with the specified tag within the specified
+ *  container.
+ *
+ *  @param[in]   aParent        The index of a container entry, or
+ *                              #kTLVIndex_None for the top level.
+ *  @param[in]   aTag           A read-only reference to the TLV tag to find.
+ *  @param[out]  aIndex         The index of the matching entry, on success.
+ *
+ *  @retval  #WEAVE_NO_ERROR                    On success.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT      If @a aParent is not a valid entry index.
+ *
+ *  @retval  #WEAVE_ERROR_TLV_TAG_NOT_FOUND     If the specified tag @a aTag was not found.
+ *
+ */
+WEAVE_ERROR TLVStructuralIndex::FindChild(uint16_t aParent, const uint64_t &aTag, uint16_t &aIndex) const
+{
+    WEAVE_ERROR err = WEAVE_ERROR_TLV_TAG_NOT_FOUND;
+
+    VerifyOrExit(aParent == kTLVIndex_None || aParent < mNumEntries, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (mTagOrder != NULL)
+    {
+        size_t low  = 0;
+        size_t high = mNumEntries;
+
+        // Locate the first entry at or after (aParent, aTag) in the tag order.
+        while (low < high)
+        {
+            const size_t         mid   = low + (high - low) / 2;
+            const TLVIndexEntry &entry = mEntries[mTagOrder[mid]];
+
+            if (entry.mParent < aParent || (entry.mParent == aParent && entry.mTag < aTag))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        if (low < mNumEntries && mEntries[mTagOrder[low]].mParent == aParent && mEntries[mTagOrder[low]].mTag == aTag)
+        {
+            aIndex = mTagOrder[low];
+            err    = WEAVE_NO_ERROR;
+        }
+    }
+    else
+    {
+        for (uint16_t child = GetFirstChild(aParent); child != kTLVIndex_None; child = GetNextSibling(child))
+        {
+            if (mEntries[child].mTag == aTag)
+            {
+                aIndex = child;
+                ExitNow(err = WEAVE_NO_ERROR);
+            }
+        }
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Find the element at the specified path of tags, starting from the top level
+ *  of the index.
+ *
+ *  @param[in]   aTags          A pointer to the tags to follow, outermost first.
+ *  @param[in]   aNumTags       The number of tags at @a aTags.
+ *  @param[out]  aIndex         The index of the matching entry, on success.
+ *
+ *  @retval  #WEAVE_NO_ERROR                    On success.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT      If @a aTags is NULL or @a aNumTags is zero.
+ *
+ *  @retval  #WEAVE_ERROR_TLV_TAG_NOT_FOUND     If no element matches the path.
+ *
+ */
+WEAVE_ERROR TLVStructuralIndex::FindPath(const uint64_t *aTags, size_t aNumTags, uint16_t &aIndex) const
+{
+    uint16_t    index = kTLVIndex_None;
+    WEAVE_ERROR err   = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aTags != NULL && aNumTags > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < aNumTags; i++)
+    {
+        err = FindChild(index, aTags[i], index);
+        SuccessOrExit(err);
+    }
+
+    aIndex = index;
+
+exit:
+    return err;
+}
+
+/**
+ *  Initialize a TLV reader positioned on the specified element, exactly as if
+ *  the reader had been advanced to it from the start of the index.
+ *
+ *  @param[in]   aIndex         The index of an entry.
+ *  @param[out]  aReader        A reference to the TLV reader to position.
+ *
+ *  @retval  #WEAVE_NO_ERROR                    On success.
+ *
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT      If @a aIndex is not a valid entry index.
+ *
+ */
+WEAVE_ERROR TLVStructuralIndex::GetReader(uint16_t aIndex, TLVReader &aReader) const
+{
+    IndexTLVReader reader;
+    WEAVE_ERROR    err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aIndex < mNumEntries, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    reader.Position(mStart, mEntries[aIndex], GetContainerType(mEntries[aIndex].mParent));
+
+    aReader.Init(reader);
+
+exit:
+    return err;
+}
+
+/**
+ *  Count the number of TLV elements within the specified structural index,
+ *  optionally including the contents of arrays or structures.
+ *
+ *  @param[in]     aIndex       A read-only reference to the structural index
+ *                              for which to count the number of TLV elements.
+ *  @param[inout]  aCount       A reference to storage for the returned count.
+ *  @param[in]     aRecurse     A Boolean indicating whether (true) or not (false)
+ *                              the contents of arrays or structures should be
+ *                              counted.
+ *
+ *  @retval  #WEAVE_NO_ERROR    On success.
+ *
+ */
+WEAVE_ERROR Count(const TLVStructuralIndex &aIndex, size_t &aCount, const bool aRecurse)
+{
+    if (aRecurse)
+    {
+        aCount = aIndex.GetNumEntries();
+    }
+    else
+    {
+        aCount = 0;
+
+        for (uint16_t i = aIndex.GetFirstChild(kTLVIndex_None); i != kTLVIndex_None; i = aIndex.GetNextSibling(i))
+            aCount++;
+    }
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ *  Search for the specified tag within the provided structural index.
+ *
+ *  @param[in]   aIndex         A read-only reference to the structural index
+ *                              in which to find the specified tag.
+ *  @param[in]   aTag           A read-only reference to the TLV tag to find.
+ *  @param[out]  aResult        A reference to storage to a TLV reader which
+ *                              will be positioned at the specified tag
+ *                              on success.
+ *
+ *  @retval  #WEAVE_NO_ERROR                    On success.
+ *
+ *  @retval  #WEAVE_ERROR_TLV_TAG_NOT_FOUND     If the specified tag @a aTag was not found.
+ *
+ */
+WEAVE_ERROR Find(const TLVStructuralIndex &aIndex, const uint64_t &aTag, TLVReader &aResult)
+{
+    const bool  recurse = true;
+    WEAVE_ERROR retval;
+
+    retval = Find(aIndex, aTag, aResult, recurse);
+
+    return retval;
+}
+
+/**
+ *  Search for the specified tag within the provided structural index,
+ *  optionally descending into arrays or structures.  The first matching
+ *  element in document order is found, as with the TLV reader form of Find().
+ *
+ *  @param[in]   aIndex         A read-only reference to the structural index
+ *                              in which to find the specified tag.
+ *  @param[in]   aTag           A read-only reference to the TLV tag to find.
+ *  @param[out]  aResult        A reference to storage to a TLV reader which
+ *                              will be positioned at the specified tag
+ *                              on success.
+ *  @param[in]   aRecurse       A Boolean indicating whether (true) or not (false)
+ *                              any encountered arrays or structures should be
+ *                              descended into.
+ *
+ *  @retval  #WEAVE_NO_ERROR                    On success.
+ *
+ *  @retval  #WEAVE_ERROR_TLV_TAG_NOT_FOUND     If the specified tag @a aTag was not found.
+ *
+ */
+WEAVE_ERROR Find(const TLVStructuralIndex &aIndex, const uint64_t &aTag, TLVReader &aResult, const bool aRecurse)
+{
+    uint16_t    index  = kTLVIndex_None;
+    WEAVE_ERROR retval = WEAVE_ERROR_TLV_TAG_NOT_FOUND;
+
+    if (aRecurse)
+    {
+        for (uint16_t i = 0; i < aIndex.GetNumEntries(); i++)
+        {
+            if (aIndex.GetEntry(i).mTag == aTag)
+            {
+                index  = i;
+                retval = WEAVE_NO_ERROR;
+                break;
+            }
+        }
+    }
+    else
+    {
+        retval = aIndex.FindChild(kTLVIndex_None, aTag, index);
+    }
+
+    SuccessOrExit(retval);
+
+    retval = aIndex.GetReader(index, aResult);
+
+ exit:
+    return retval;
+}
+
 } // namespace Utilities
 
 } // namespace TLV
@@ -61,6 +61,83 @@ extern WEAVE_ERROR Find(const TLVReader &aReader, const uint64_t &aTag, TLVReade
 
 extern WEAVE_ERROR Find(const TLVReader &aReader, IterateHandler aHandler, void *aContext, TLVReader &aResult);
 extern WEAVE_ERROR Find(const TLVReader &aReader, IterateHandler aHandler, void *aContext, TLVReader &aResult, const bool aRecurse);
+
+enum
+{
+    kTLVIndex_None                      = 0xFFFF    ///< Entry index denoting no element (e.g. the parent of a top-level element).
+};
+
+/**
+ *  @struct TLVIndexEntry
+ *
+ *  @brief
+ *    Describes a single element of an encoding indexed by a TLVStructuralIndex.
+ *
+ *    Offsets are relative to the position of the TLV reader from which the
+ *    index was built.
+ */
+struct TLVIndexEntry
+{
+    uint64_t    mTag;                   ///< The element's tag.
+    uint64_t    mLenOrVal;              ///< The element's length (strings) or raw value bits (scalars).
+    uint32_t    mDataOffset;            ///< Offset of the element's value or contents, immediately following its head.
+    uint32_t    mEndOffset;             ///< Offset immediately following the element, including any container contents.
+    uint16_t    mParent;                ///< Index of the enclosing container's entry, or #kTLVIndex_None.
+    uint16_t    mNumDescendants;        ///< Number of entries nested, at any depth, within this element.
+    uint16_t    mControlByte;           ///< The element's control byte.
+    int8_t      mType;                  ///< The element's TLVType.
+};
+
+/**
+ *  @class TLVStructuralIndex
+ *
+ *  @brief
+ *    A one-pass structural index over a TLV encoding residing in a single
+ *    contiguous buffer.
+ *
+ *    The index records every element of the encoding, in document order, in a
+ *    caller-supplied array of TLVIndexEntry.  Each container's entry is followed
+ *    by the entries of its contents, so that skipping over a container, however
+ *    large, is a single step.  When a caller-supplied tag order array is
+ *    provided, lookups of a child by tag are binary searches; otherwise they
+ *    visit only the direct children of the container.  In either case no TLV is
+ *    decoded after the index has been built.
+ *
+ *    The index refers to, but does not copy, the encoded data, which must
+ *    remain valid and unmodified for as long as the index is in use.
+ */
+class TLVStructuralIndex
+{
+public:
+    WEAVE_ERROR Init(const TLVReader &aReader, TLVIndexEntry *aEntries, uint16_t aMaxEntries);
+    WEAVE_ERROR Init(const TLVReader &aReader, TLVIndexEntry *aEntries, uint16_t *aTagOrder, uint16_t aMaxEntries);
+
+    uint16_t GetNumEntries(void) const { return mNumEntries; }
+    const TLVIndexEntry &GetEntry(uint16_t aIndex) const { return mEntries[aIndex]; }
+
+    uint16_t GetFirstChild(uint16_t aIndex) const;
+    uint16_t GetNextSibling(uint16_t aIndex) const;
+
+    WEAVE_ERROR FindChild(uint16_t aParent, const uint64_t &aTag, uint16_t &aIndex) const;
+    WEAVE_ERROR FindPath(const uint64_t *aTags, size_t aNumTags, uint16_t &aIndex) const;
+
+    WEAVE_ERROR GetReader(uint16_t aIndex, TLVReader &aReader) const;
+
+private:
+    TLVReader       mStart;
+    TLVIndexEntry * mEntries;
+    uint16_t *      mTagOrder;
+    uint16_t        mNumEntries;
+
+    uint16_t GetChildrenEnd(uint16_t aParent) const;
+    TLVType GetContainerType(uint16_t aParent) const;
+    void SortTagOrder(void);
+};
+
+extern WEAVE_ERROR Count(const TLVStructuralIndex &aIndex, size_t &aCount, const bool aRecurse);
+
+extern WEAVE_ERROR Find(const TLVStructuralIndex &aIndex, const uint64_t &aTag, TLVReader &aResult);
+extern WEAVE_ERROR Find(const TLVStructuralIndex &aIndex, const uint64_t &aTag, TLVReader &aResult, const bool aRecurse);
 } // namespace Utilities
 
 } // namespace TLV
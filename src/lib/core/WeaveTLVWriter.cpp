@@ -172,6 +172,7 @@ void TLVWriter::Init(uint8_t *buf, uint32_t maxLen)
     mContainerType = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
+    SetSizeOnly(false);
 
     ImplicitProfileId = kProfileIdNotSpecified;
     GetNewBuffer = NULL;
@@ -196,6 +197,7 @@ void TLVWriter::InitMalloced(uint8_t *& outBuf, uint32_t initialBufSize, uint32_
     mContainerType = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
+    SetSizeOnly(false);
 
     ImplicitProfileId = kProfileIdNotSpecified;
     FinalizeBuffer = NULL;
@@ -227,6 +229,7 @@ void TLVWriter::Init(PacketBuffer *buf, uint32_t maxLen)
     mContainerType = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
+    SetSizeOnly(false);
 
     ImplicitProfileId = kProfileIdNotSpecified;
     GetNewBuffer = NULL;
@@ -268,6 +271,22 @@ void TLVWriter::Init(PacketBuffer *buf, uint32_t maxLen, bool allowDiscontiguous
     }
 }
 
+/**
+ * Initializes a TLVSizer object to compute the length of a TLV encoding.
+ *
+ * @param[in]   maxLen  The maximum number of bytes that should be accounted for.  Writes that
+ *                      would exceed this length fail with WEAVE_ERROR_BUFFER_TOO_SMALL.
+ *
+ */
+void TLVSizer::Init(uint32_t maxLen)
+{
+    TLVWriter::Init((uint8_t *) NULL, maxLen);
+
+    // Without an output buffer, all data is routed through WriteData(), which only accounts for it.
+    mRemainingLen = 0;
+    SetSizeOnly(true);
+}
+
 /**
  * Returns the total number of bytes written since the writer was initialized.
  *
@@ -278,6 +297,18 @@ uint32_t TLVWriter::GetLengthWritten()
     return mLenWritten;
 }
 
+/**
+ * Returns the number of bytes that may still be written before the writer's maximum length is reached.
+ *
+ * For a container writer, the returned length excludes the space reserved for closing the container.
+ *
+ * @return Number of bytes that may still be written.
+ */
+uint32_t TLVWriter::GetRemainingLength() const
+{
+    return mMaxLen - mLenWritten;
+}
+
 /**
  * Finish the writing of a TLV encoding.
  *
@@ -758,6 +789,100 @@ WEAVE_ERROR TLVWriter::ContinuePutBytes(const uint8_t *buf, uint32_t len)
     return WriteData(buf, len);
 }
 
+/**
+ * Encodes a TLV byte string value whose contents are held in a chain of packet buffers.
+ *
+ * When the writer is writing into a chain of PacketBuffers (see Init(PacketBuffer *, uint32_t, bool))
+ * and the value does not fit in the space remaining in the current output buffer, the buffers
+ * holding the value are linked into the output chain in place, rather than their contents being
+ * copied.  The writer then continues writing in a new buffer following them.  In all other cases the
+ * contents of the buffers are copied into the encoding as by PutBytes().
+ *
+ * PutBytesRef() takes ownership of the supplied buffer chain, whether or not it succeeds.  Because
+ * the buffers may become part of the encoding, they can be modified in place by later processing of
+ * it (for example, message encryption).  Applications that need to retain the value must pass a copy.
+ *
+ * @param[in]   tag             The TLV tag to be encoded with the value, or @p AnonymousTag if the
+ *                              value should be encoded without a tag.  Tag values should be
+ *                              constructed with one of the tag definition functions ProfileTag(),
+ *                              ContextTag() or CommonTag().
+ * @param[in]   data            A chain of packet buffers containing the byte string to be encoded.
+ *
+ * @retval #WEAVE_NO_ERROR      If the method succeeded.
+ * @retval #WEAVE_ERROR_TLV_CONTAINER_OPEN
+ *                              If a container writer has been opened on the current writer and not
+ *                              yet closed.
+ * @retval #WEAVE_ERROR_INVALID_TLV_TAG
+ *                              If the specified tag value is invalid or inappropriate in the context
+ *                              in which the value is being written.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL
+ *                              If writing the value would exceed the limit on the maximum number of
+ *                              bytes specified when the writer was initialized.
+ * @retval #WEAVE_ERROR_NO_MEMORY
+ *                              If an attempt to allocate an output buffer failed due to lack of
+ *                              memory.
+ * @retval other                Other Weave or platform-specific errors returned by the configured
+ *                              GetNewBuffer() or FinalizeBuffer() functions.
+ *
+ */
+WEAVE_ERROR TLVWriter::PutBytesRef(uint64_t tag, PacketBuffer *data)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *lastBuf = data;
+    uint32_t len = 0;
+
+    // Sum the lengths of the individual buffers, the total length of a chain built by a TLVWriter is not reliable.
+    for (PacketBuffer *buf = data; buf != NULL; buf = buf->Next())
+    {
+        len += buf->DataLength();
+        lastBuf = buf;
+    }
+
+    err = StartPutBytes(tag, len);
+    SuccessOrExit(err);
+
+    if (len > mRemainingLen && GetNewBuffer == GetNewPacketBuffer && FinalizeBuffer == FinalizePacketBuffer)
+    {
+        PacketBuffer *curBuf = (PacketBuffer *) mBufHandle;
+
+        VerifyOrExit((mLenWritten + len) <= mMaxLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        err = FinalizeBuffer(*this, mBufHandle, mBufStart, mWritePoint - mBufStart);
+        SuccessOrExit(err);
+
+        // Link the value between the current output buffer and any buffers that follow it.
+        if (curBuf->Next() != NULL)
+        {
+            data->AddToEnd(curBuf->DetachTail());
+        }
+        curBuf->AddToEnd(data);
+        data = NULL;
+
+        // Continue in a new buffer after the value, leaving the last buffer of the value untouched.
+        mBufHandle = (uintptr_t) lastBuf;
+        mBufStart = lastBuf->Start();
+        mWritePoint = mBufStart + lastBuf->DataLength();
+        mRemainingLen = 0;
+        mLenWritten += len;
+    }
+    else
+    {
+        for (PacketBuffer *buf = data; buf != NULL; buf = buf->Next())
+        {
+            err = ContinuePutBytes(buf->Start(), buf->DataLength());
+            SuccessOrExit(err);
+        }
+    }
+
+exit:
+    if (data != NULL)
+    {
+        PacketBuffer::Free(data);
+    }
+
+    return err;
+}
+
 /**
  * Encodes a TLV UTF8 string value.
  *
@@ -974,12 +1099,15 @@ WEAVE_ERROR TLVWriter::VPutStringF(uint64_t tag, const char *fmt, va_list ap)
     // no facilities for splitting the stream across multiple buffers,
     // just write however much fits in the current buffer.
     // assume conservative tag length at this time (8 bytes)
-    size_t elementHeadLen = (1 + 8 + (1 << static_cast<uint8_t>(lenFieldSize)) + 1); // 1 : control byte, 8 : tag length, stringLen + 1 for null termination
-    VerifyOrExit(mRemainingLen >= elementHeadLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+    if (!IsSizeOnly())
+    {
+        size_t elementHeadLen = (1 + 8 + (1 << static_cast<uint8_t>(lenFieldSize)) + 1); // 1 : control byte, 8 : tag length, stringLen + 1 for null termination
+        VerifyOrExit(mRemainingLen >= elementHeadLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
-    maxLen =  mRemainingLen - elementHeadLen;
-    if (maxLen < dataLen)
-        dataLen = maxLen;
+        maxLen =  mRemainingLen - elementHeadLen;
+        if (maxLen < dataLen)
+            dataLen = maxLen;
+    }
 #endif
 
     // write length.
@@ -988,6 +1116,13 @@ WEAVE_ERROR TLVWriter::VPutStringF(uint64_t tag, const char *fmt, va_list ap)
 
     VerifyOrExit((mLenWritten + dataLen) <= mMaxLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
+    // A size-only writer has no output buffer; just account for the data.
+    if (IsSizeOnly())
+    {
+        mLenWritten += dataLen;
+        ExitNow();
+    }
+
     // write data
 #if CONFIG_HAVE_VSNPRINTF_EX
 
@@ -1319,6 +1454,7 @@ WEAVE_ERROR TLVWriter::OpenContainer(uint64_t tag, TLVType containerType, TLVWri
     containerWriter.mContainerType = containerType;
     containerWriter.SetContainerOpen(false);
     containerWriter.SetCloseContainerReserved(IsCloseContainerReserved());
+    containerWriter.SetSizeOnly(IsSizeOnly());
     containerWriter.ImplicitProfileId = ImplicitProfileId;
     containerWriter.GetNewBuffer = GetNewBuffer;
     containerWriter.FinalizeBuffer = FinalizeBuffer;
@@ -1895,6 +2031,13 @@ WEAVE_ERROR TLVWriter::WriteData(const uint8_t *p, uint32_t len)
 
     VerifyOrExit((mLenWritten + len) <= mMaxLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
+    // A size-only writer has no output buffer; just account for the data.
+    if (IsSizeOnly())
+    {
+        mLenWritten += len;
+        ExitNow();
+    }
+
     while (len > 0)
     {
         if (mRemainingLen == 0)
@@ -102,6 +102,31 @@ namespace Weave {
 #endif // PBUF_POOL_SIZE
 #endif // WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE
 
+/**
+ *  @def WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+ *
+ *  @brief
+ *    Enable (1) or disable (0) indexing of the WRMP retransmission table.
+ *
+ *    When enabled, the retransmission table is indexed by message id, so
+ *    that a received acknowledgment removes its entry without scanning the
+ *    table, and its entries are kept in a queue ordered by retransmission
+ *    time, so that each WRMP timer tick only visits the entries that are
+ *    due. The entries of each exchange context are also linked together,
+ *    so that closing or throttling an exchange only visits its own entries.
+ *    This costs about 30 bytes per retransmission table entry and is
+ *    worthwhile for nodes configured with hundreds of outstanding reliable
+ *    messages.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+#define WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE             0
+#endif // WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE
+
+#if WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE && (WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE > 65535)
+#error "FORBIDDEN: WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE supports at most 65535 retransmission table entries"
+#endif // WEAVE_CONFIG_WRMP_INDEXED_RETRANS_TABLE && ...
+
 /**
  *  @def WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS
  *
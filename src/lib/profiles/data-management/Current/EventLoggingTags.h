@@ -148,6 +148,8 @@ enum
 
     kTag_EventData               = 50, ///< Optional.  Event data itself.  If empty, it defaults to an empty structure.
 
+    kTag_EventSchemaRef          = 98, ///< Internal tag for a reference to the event schema dictionary.  Never transmitted across the wire, should never be used outside of Weave library
+
     kTag_ExternalEventStructure  = 99, ///< Internal tag for external events.  Never transmitted across the wire, should never be used outside of Weave library
 
 };
@@ -219,6 +221,26 @@ enum
 #endif
 };
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+/**
+ * @brief
+ *  Tags for persisting the entries of the event schema dictionary
+ */
+enum
+{
+    kTag_PersistSchema_Index                          = 1,
+    kTag_PersistSchema_ProfileId                      = 2,
+    kTag_PersistSchema_StructureType                  = 3,
+    kTag_PersistSchema_DataSchemaVersion              = 4,
+    kTag_PersistSchema_MinCompatibleDataSchemaVersion = 5,
+    kTag_PersistSchema_ResourceType                   = 6,
+    kTag_PersistSchema_ResourceId                     = 7,
+    kTag_PersistSchema_TraitInstanceId                = 8,
+    kTag_PersistSchema_RefCount                       = 9,
+    kTag_PersistSchema_SavedBytes                     = 10
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
 } // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 } // namespace Profiles
 } // namespace Weave
@@ -84,6 +84,9 @@ EventLoadOutContext::EventLoadOutContext(nl::Weave::TLV::TLVWriter & inWriter, I
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     mCurrentUTCTime(0), mFirstUtc(true),
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    mSchemaRef(kSchemaRef_None),
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
     mFirst(true)
 { }
 
@@ -228,6 +228,13 @@ struct EventOptions
     bool urgent;                       /**< A flag denoting that the event is time sensitive.  When set, it causes the event log to be flushed. */
 };
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+enum
+{
+    kSchemaRef_None = 0xFF, ///< The event is stored, or written out, with its schema fields in full
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
 /**
  * @brief
  *   Structure for copying event lists on output.
@@ -246,6 +253,9 @@ struct EventLoadOutContext
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     uint64_t mCurrentUTCTime;
     bool mFirstUtc;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    uint8_t mSchemaRef; ///< When storing an event, the schema dictionary entry to refer to in place of the schema fields
 #endif
     bool mFirst;
 };
@@ -0,0 +1,425 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Implementation of the persistent event spill store.
+ *
+ */
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/EventSpillStore.h>
+#include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+#include <Weave/Support/platform/PersistedStorage.h>
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Encoding;
+
+namespace PersistedStorage = nl::Weave::Platform::PersistedStorage;
+
+static const uint32_t kSegmentMagic = 0x53564557; // "WEVS"
+
+static const uint16_t kErasedRecordLength = 0xFFFF;
+
+static uint32_t ComputeCRC32(uint32_t inCRC, const uint8_t * inData, size_t inLength)
+{
+    uint32_t crc = ~inCRC;
+
+    while (inLength-- > 0)
+    {
+        crc ^= *inData++;
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+EventSpillStore::EventSpillStore(void) : mActiveSegment(0)
+{
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        ResetSegment(i, 0);
+    }
+}
+
+void EventSpillStore::ResetSegment(uint8_t inSegment, uint32_t inSequence)
+{
+    Segment & segment = mSegments[inSegment];
+
+    segment.mSequence    = inSequence;
+    segment.mWriteOffset = kSegmentHeaderSize;
+    segment.mSealed      = false;
+    memset(segment.mFirstEventID, 0, sizeof(segment.mFirstEventID));
+    memset(segment.mLastEventID, 0, sizeof(segment.mLastEventID));
+}
+
+void EventSpillStore::AddEvent(uint8_t inSegment, ImportanceType inImportance, event_id_t inEventID)
+{
+    Segment & segment  = mSegments[inSegment];
+    const size_t index = inImportance - kImportanceType_First;
+
+    if (segment.mFirstEventID[index] == 0)
+    {
+        segment.mFirstEventID[index] = inEventID;
+    }
+    segment.mLastEventID[index] = inEventID;
+}
+
+/**
+ * @brief
+ *   Recover the state of the store from persistent storage.
+ *
+ * Reads the segment headers and checks every record, rebuilding the
+ * range of event IDs held in each segment and the offset at which the
+ * next record is to be written.  A segment whose last record does not
+ * check out is closed to further writes.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ * @retval other           The error returned by the platform.
+ */
+WEAVE_ERROR EventSpillStore::Init(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t header[kSegmentHeaderSize];
+    uint32_t sequence;
+
+    mActiveSegment = 0;
+
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        ResetSegment(i, 0);
+
+        err = PersistedStorage::ReadSegment(i, 0, header, sizeof(header));
+        SuccessOrExit(err);
+
+        sequence = LittleEndian::Get32(header + 4);
+
+        if ((LittleEndian::Get32(header) != kSegmentMagic) || (sequence == 0) ||
+            (ComputeCRC32(0, header, 8) != LittleEndian::Get32(header + 8)))
+        {
+            continue;
+        }
+
+        mSegments[i].mSequence = sequence;
+
+        err = RecoverSegment(i);
+        SuccessOrExit(err);
+
+        if (sequence > mSegments[mActiveSegment].mSequence)
+        {
+            mActiveSegment = i;
+        }
+    }
+
+exit:
+    // Don't report events from a store that could not be read in full.
+    if (err != WEAVE_NO_ERROR)
+    {
+        for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+        {
+            ResetSegment(i, 0);
+        }
+
+        mActiveSegment = 0;
+    }
+
+    return err;
+}
+
+WEAVE_ERROR EventSpillStore::RecoverSegment(uint8_t inSegment)
+{
+    WEAVE_ERROR err   = WEAVE_NO_ERROR;
+    Segment & segment = mSegments[inSegment];
+    uint8_t record[kRecordHeaderSize + WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE];
+    uint16_t length;
+    uint8_t importance;
+
+    while (segment.mWriteOffset + kRecordHeaderSize <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE)
+    {
+        err = PersistedStorage::ReadSegment(inSegment, segment.mWriteOffset, record, kRecordHeaderSize);
+        SuccessOrExit(err);
+
+        length     = LittleEndian::Get16(record);
+        importance = record[2];
+
+        // Erased storage: the end of the records
+        VerifyOrExit(length != kErasedRecordLength, /* done */);
+
+        if ((length > WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE) ||
+            (segment.mWriteOffset + kRecordHeaderSize + length > WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE) ||
+            (importance < kImportanceType_First) || (importance > kImportanceType_Last))
+        {
+            break;
+        }
+
+        err = PersistedStorage::ReadSegment(inSegment, segment.mWriteOffset + kRecordHeaderSize, record + kRecordHeaderSize,
+                                            length);
+        SuccessOrExit(err);
+
+        if (ComputeCRC32(ComputeCRC32(0, record, 8), record + kRecordHeaderSize, length) != LittleEndian::Get32(record + 8))
+        {
+            break;
+        }
+
+        AddEvent(inSegment, static_cast<ImportanceType>(importance), LittleEndian::Get32(record + 4));
+        segment.mWriteOffset += kRecordHeaderSize + length;
+    }
+
+    // A record was interrupted while being written; the storage past
+    // the last good record may not be written again until erased.
+    if (segment.mWriteOffset + kRecordHeaderSize <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE)
+    {
+        WeaveLogError(EventLogging, "Spill segment %u: discarding torn record at offset %u", inSegment, segment.mWriteOffset);
+        segment.mSealed = true;
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR EventSpillStore::StartSegment(uint8_t inSegment)
+{
+    WEAVE_ERROR err         = WEAVE_NO_ERROR;
+    const uint32_t sequence = mSegments[mActiveSegment].mSequence + 1;
+    uint8_t header[kSegmentHeaderSize];
+
+    ResetSegment(inSegment, 0);
+
+    err = PersistedStorage::EraseSegment(inSegment);
+    SuccessOrExit(err);
+
+    LittleEndian::Put32(header, kSegmentMagic);
+    LittleEndian::Put32(header + 4, sequence);
+    LittleEndian::Put32(header + 8, ComputeCRC32(0, header, 8));
+
+    err = PersistedStorage::WriteSegment(inSegment, 0, header, sizeof(header));
+    SuccessOrExit(err);
+
+    ResetSegment(inSegment, sequence);
+    mActiveSegment = inSegment;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Append an event to the store.
+ *
+ * Erases the oldest segment when the active segment cannot hold the
+ * event.
+ *
+ * @param[in] inImportance The importance of the event.
+ *
+ * @param[in] inEventID    The ID of the event.  IDs of events of the
+ *                         same importance must be appended in
+ *                         increasing order.
+ *
+ * @param[in] inEvent      The event, as encoded by FetchEventsSince()
+ *                         for the first event it fetches.
+ *
+ * @param[in] inEventLen   The length of the event.
+ *
+ * @retval #WEAVE_NO_ERROR               On success.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL The event is larger than
+ *                                       WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE.
+ * @retval other                         The error returned by the platform.
+ */
+WEAVE_ERROR EventSpillStore::AppendEvent(ImportanceType inImportance, event_id_t inEventID, const uint8_t * inEvent,
+                                         uint16_t inEventLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t record[kRecordHeaderSize + WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE];
+    const uint32_t recordLen = kRecordHeaderSize + inEventLen;
+    Segment * segment;
+
+    VerifyOrExit(inEventLen <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    segment = &mSegments[mActiveSegment];
+    if (segment->mSequence == 0)
+    {
+        err = StartSegment(mActiveSegment);
+    }
+    else if (segment->mSealed || (segment->mWriteOffset + recordLen > WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE))
+    {
+        err = StartSegment((mActiveSegment + 1) % WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT);
+    }
+    SuccessOrExit(err);
+
+    segment = &mSegments[mActiveSegment];
+
+    LittleEndian::Put16(record, inEventLen);
+    record[2] = static_cast<uint8_t>(inImportance);
+    record[3] = 0;
+    LittleEndian::Put32(record + 4, inEventID);
+    memcpy(record + kRecordHeaderSize, inEvent, inEventLen);
+    LittleEndian::Put32(record + 8, ComputeCRC32(ComputeCRC32(0, record, 8), inEvent, inEventLen));
+
+    err = PersistedStorage::WriteSegment(mActiveSegment, segment->mWriteOffset, record, recordLen);
+    if (err != WEAVE_NO_ERROR)
+    {
+        // The record may be partially written; move on to the next
+        // segment for the next event.
+        segment->mSealed = true;
+        ExitNow();
+    }
+
+    AddEvent(mActiveSegment, inImportance, inEventID);
+    segment->mWriteOffset += recordLen;
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Copy the stored events of an importance into a TLVWriter.
+ *
+ * Copies the events, oldest first, with IDs from ioEventID up to, but
+ * not including, inEndEventID.  Each event carries its event ID and
+ * its timestamps.  The writer is left at an event boundary.
+ *
+ * @param[in] ioWriter      The writer receiving the events.
+ *
+ * @param[in] inImportance  The importance of the events to copy.
+ *
+ * @param[inout] ioEventID  On input, the ID of the first event to copy.
+ *                          On return, the ID following the last event
+ *                          copied.
+ *
+ * @param[in] inEndEventID  The ID following the last event to copy.
+ *
+ * @retval #WEAVE_NO_ERROR               All the events were copied.
+ * @retval #WEAVE_ERROR_NO_MEMORY        The writer ran out of space.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL The writer ran out of space.
+ * @retval other                         The error returned by the platform.
+ */
+WEAVE_ERROR EventSpillStore::FetchEventsSince(TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID,
+                                              event_id_t inEndEventID)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const size_t index = inImportance - kImportanceType_First;
+    uint8_t record[kRecordHeaderSize + WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE];
+    TLVWriter checkpoint;
+    TLVReader reader;
+    uint32_t offset;
+    uint16_t length;
+    event_id_t eventID;
+
+    // Oldest segment first: the one following the active segment
+    for (uint8_t i = 1; i <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        const uint8_t segmentIndex = (mActiveSegment + i) % WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT;
+        const Segment & segment    = mSegments[segmentIndex];
+
+        if ((segment.mSequence == 0) || (segment.mLastEventID[index] == 0) || (segment.mLastEventID[index] < ioEventID))
+        {
+            continue;
+        }
+
+        VerifyOrExit(segment.mFirstEventID[index] < inEndEventID, /* done */);
+
+        for (offset = kSegmentHeaderSize; offset < segment.mWriteOffset; offset += kRecordHeaderSize + length)
+        {
+            err = PersistedStorage::ReadSegment(segmentIndex, offset, record, kRecordHeaderSize);
+            SuccessOrExit(err);
+
+            length  = LittleEndian::Get16(record);
+            eventID = LittleEndian::Get32(record + 4);
+
+            if ((record[2] != inImportance) || (eventID < ioEventID))
+            {
+                continue;
+            }
+
+            VerifyOrExit(eventID < inEndEventID, /* done */);
+
+            err = PersistedStorage::ReadSegment(segmentIndex, offset + kRecordHeaderSize, record + kRecordHeaderSize, length);
+            SuccessOrExit(err);
+
+            reader.Init(record + kRecordHeaderSize, length);
+            err = reader.Next();
+            SuccessOrExit(err);
+
+            checkpoint = ioWriter;
+            err        = ioWriter.CopyElement(reader);
+            VerifyOrExit(err == WEAVE_NO_ERROR, ioWriter = checkpoint);
+
+            ioEventID = eventID + 1;
+        }
+    }
+
+exit:
+    return err;
+}
+
+event_id_t EventSpillStore::GetFirstEventID(ImportanceType inImportance) const
+{
+    const size_t index = inImportance - kImportanceType_First;
+
+    for (uint8_t i = 1; i <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        const Segment & segment = mSegments[(mActiveSegment + i) % WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT];
+
+        if ((segment.mSequence != 0) && (segment.mFirstEventID[index] != 0))
+        {
+            return segment.mFirstEventID[index];
+        }
+    }
+
+    return 0;
+}
+
+event_id_t EventSpillStore::GetLastEventID(ImportanceType inImportance) const
+{
+    const size_t index = inImportance - kImportanceType_First;
+
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        const Segment & segment =
+            mSegments[(mActiveSegment + WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT - i) % WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT];
+
+        if ((segment.mSequence != 0) && (segment.mLastEventID[index] != 0))
+        {
+            return segment.mLastEventID[index];
+        }
+    }
+
+    return 0;
+}
+
+} // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Persistent, append-only store for events spilled out of the
+ *   in-memory event buffers.
+ *
+ */
+#ifndef _WEAVE_DATA_MANAGEMENT_EVENT_SPILL_STORE_CURRENT_H
+#define _WEAVE_DATA_MANAGEMENT_EVENT_SPILL_STORE_CURRENT_H
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/EventLoggingTypes.h>
+#include <Weave/Core/WeaveTLV.h>
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+/**
+ * @brief
+ *   A segmented, append-only event store in persistent storage.
+ *
+ * The store is made of WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+ * segments of WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE bytes,
+ * provided by the platform.  Segments are filled one at a time; when the
+ * active segment is full, the next one is erased, dropping the oldest
+ * events, and becomes the active segment.
+ *
+ * A segment starts with a header holding a sequence number that orders
+ * the segments.  It is followed by one record per event; a record holds
+ * the length, importance and ID of the event, a CRC-32 over all of them,
+ * and the event itself, encoded as FetchEventsSince() encodes the first
+ * event it fetches.  Records are written with a single write, and
+ * recovery stops at the first record that does not check out, so an
+ * event interrupted while being written is discarded.
+ */
+class EventSpillStore
+{
+public:
+    enum
+    {
+        kSegmentHeaderSize = 12,
+        kRecordHeaderSize  = 12,
+    };
+
+    EventSpillStore(void);
+
+    WEAVE_ERROR Init(void);
+
+    WEAVE_ERROR AppendEvent(ImportanceType inImportance, event_id_t inEventID, const uint8_t * inEvent, uint16_t inEventLen);
+
+    WEAVE_ERROR FetchEventsSince(nl::Weave::TLV::TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID,
+                                 event_id_t inEndEventID);
+
+    event_id_t GetFirstEventID(ImportanceType inImportance) const;
+    event_id_t GetLastEventID(ImportanceType inImportance) const;
+
+private:
+    struct Segment
+    {
+        uint32_t mSequence;    ///< Sequence number of the segment; 0 when the segment holds no valid header
+        uint32_t mWriteOffset; ///< Offset at which the next record is written; the end of the valid records
+        bool mSealed;          ///< True when no more records may be written to the segment until it is erased
+        event_id_t mFirstEventID[kImportanceType_Last - kImportanceType_First + 1]; ///< 0 when no event of that importance
+        event_id_t mLastEventID[kImportanceType_Last - kImportanceType_First + 1];
+    };
+
+    void ResetSegment(uint8_t inSegment, uint32_t inSequence);
+    WEAVE_ERROR RecoverSegment(uint8_t inSegment);
+    WEAVE_ERROR StartSegment(uint8_t inSegment);
+    void AddEvent(uint8_t inSegment, ImportanceType inImportance, event_id_t inEventID);
+
+    Segment mSegments[WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT];
+    uint8_t mActiveSegment;
+};
+
+} // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+#endif // _WEAVE_DATA_MANAGEMENT_EVENT_SPILL_STORE_CURRENT_H
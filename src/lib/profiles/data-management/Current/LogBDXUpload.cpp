@@ -85,19 +85,21 @@ void LogBDXUpload::ThrottleIfNeeded(void)
     mFirstXfer = false;
 }
 
-void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransfer * aXfer, uint64_t * aLength,
-                                uint8_t ** aDataBlock, bool * aIsLastBlock)
+// Fill inBuffer with whole events, starting at the upload cursor
+// (`mCurrentImportance`, `mCurrentEventID`) and advancing it past the
+// events encoded.
+WEAVE_ERROR LogBDXUpload::EncodeBlock(uint8_t * inBuffer, uint32_t inBufferSize, UploadBlock & outBlock)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     TLVWriter writer;
     bool fullBlock = true;
 
-    writer.Init(*aDataBlock, *aLength);
+    writer.Init(inBuffer, inBufferSize);
 
     // If successful, these values will be reset below.  If the
     // function fails, these will be the return values.
-    *aIsLastBlock = true;
-    *aLength      = 0;
+    outBlock.mIsLastBlock = true;
+    outBlock.mLength      = 0;
 
     do
     {
@@ -111,23 +113,23 @@ void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransf
         // Reached the end of the current importance
         if ((err == WEAVE_END_OF_TLV) || (err == WEAVE_ERROR_TLV_UNDERRUN))
         {
+            err                                                               = WEAVE_NO_ERROR;
+            mLastScheduledEventId[mCurrentImportance - kImportanceType_First] = mCurrentEventID;
+
             if (mCurrentImportance == kImportanceType_Last)
             {
                 // reached the end of all importances.  We're at the
                 // end of the current transfer.  Signal end of
                 // transmission.
-                err                = WEAVE_NO_ERROR;
-                *aIsLastBlock      = true;
-                mCurrentImportance = kImportanceType_First;
+                outBlock.mIsLastBlock = true;
+                mCurrentImportance    = kImportanceType_First;
+                mCurrentEventID       = mLastScheduledEventId[0];
                 break;
             }
             else
             {
-                // Other importance levels are available.  Save the
-                // state of this importance, and move to the next one,
-                // restoring the last event appropriately
-                err                                                               = WEAVE_NO_ERROR;
-                mLastScheduledEventId[mCurrentImportance - kImportanceType_First] = mCurrentEventID;
+                // Other importance levels are available.  Move to the
+                // next one, restoring the last event appropriately
                 mCurrentImportance = static_cast<ImportanceType>(static_cast<uint32_t>(mCurrentImportance) + 1);
                 mCurrentEventID    = mLastScheduledEventId[mCurrentImportance - kImportanceType_First];
                 mFirstXfer         = true;
@@ -141,8 +143,9 @@ void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransf
         // that there will be more events to transfer.
         if ((err == WEAVE_ERROR_BUFFER_TOO_SMALL) || (err == WEAVE_ERROR_NO_MEMORY))
         {
-            err           = WEAVE_NO_ERROR;
-            *aIsLastBlock = false;
+            err                                                               = WEAVE_NO_ERROR;
+            mLastScheduledEventId[mCurrentImportance - kImportanceType_First] = mCurrentEventID;
+            outBlock.mIsLastBlock                                             = false;
             break;
         }
 
@@ -150,10 +153,141 @@ void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransf
     } while (err == WEAVE_NO_ERROR);
 
     SuccessOrExit(err);
-    // on success, the aLastBlock is already set.
-    *aLength = writer.GetLengthWritten();
+    // on success, the mIsLastBlock is already set.
+    outBlock.mLength = writer.GetLengthWritten();
+    memcpy(outBlock.mEndEventId, mLastScheduledEventId, sizeof(outBlock.mEndEventId));
 exit:
-    return;
+    return err;
+}
+
+// Record the events in an acknowledged block as transmitted.  The
+// block carries the cursor past its last event, so the transmitted
+// range is known without reading the events back.
+void LogBDXUpload::AcknowledgeBlock(const UploadBlock & inBlock)
+{
+    for (int i = 0; i <= kImportanceType_Last - kImportanceType_First; i++)
+    {
+        if (inBlock.mEndEventId[i] > mLastTransmittedEventId[i])
+        {
+            mLastTransmittedEventId[i] = inBlock.mEndEventId[i];
+        }
+    }
+
+    mBytesUploaded += inBlock.mLength;
+}
+
+// Report the events transmitted since the last report as delivered.
+// NotifyEventsDelivered() walks the event buffers, so this is done once
+// per transfer rather than for every acknowledged block.
+void LogBDXUpload::NotifyTransmittedEvents(void)
+{
+    for (int i = 0; i <= kImportanceType_Last - kImportanceType_First; i++)
+    {
+        if (mLastTransmittedEventId[i] > mLastNotifiedEventId[i])
+        {
+            mLastNotifiedEventId[i] = mLastTransmittedEventId[i];
+            mLogger->NotifyEventsDelivered(static_cast<ImportanceType>(i + kImportanceType_First), mLastTransmittedEventId[i] - 1,
+                                           mPeerNodeId);
+        }
+    }
+}
+
+// Drop the blocks not acknowledged yet, and move the upload cursor back
+// past the last acknowledged block.
+void LogBDXUpload::RewindToLastAcknowledged(void)
+{
+    ResetBlocks();
+    memcpy(mLastScheduledEventId, mLastTransmittedEventId, sizeof(mLastScheduledEventId));
+    mCurrentImportance = kImportanceType_First;
+    mCurrentEventID    = mLastScheduledEventId[mCurrentImportance - kImportanceType_First];
+}
+
+void LogBDXUpload::ResetBlocks(void)
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    mBlockSize        = 0;
+    mFirstBlock       = 0;
+    mNumBlocks        = 0;
+    mEncodedLastBlock = false;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    mBlockSent = false;
+}
+
+void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransfer * aXfer, uint64_t * aLength,
+                                uint8_t ** aDataBlock, bool * aIsLastBlock)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    uint32_t blockSize = WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE;
+    UploadBlock * block;
+
+    // A block may not exceed the size accepted by the receiver, nor the
+    // space left in the outgoing message.
+    if ((aXfer != NULL) && (aXfer->mMaxBlockSize != 0) && (aXfer->mMaxBlockSize < blockSize))
+    {
+        blockSize = aXfer->mMaxBlockSize;
+    }
+    if (*aLength < blockSize)
+    {
+        blockSize = static_cast<uint32_t>(*aLength);
+    }
+
+    // The sender-driven transfer asks for the next block only once the
+    // receiver acknowledged the previous one.
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    if (mBlockSent)
+    {
+        AcknowledgeBlock(mBlocks[mFirstBlock]);
+        mFirstBlock = (mFirstBlock + 1) % WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW;
+        mNumBlocks--;
+        mBlockSent = false;
+    }
+
+    // The blocks encoded ahead may no longer fit; encode them again,
+    // from the last acknowledged block, at the smaller size.
+    if (blockSize < mBlockSize)
+    {
+        RewindToLastAcknowledged();
+    }
+    mBlockSize = static_cast<uint16_t>(blockSize);
+
+    // Top up the window from the upload cursor.
+    while ((mNumBlocks < WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW) && !mEncodedLastBlock)
+    {
+        uint8_t next = (mFirstBlock + mNumBlocks) % WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW;
+
+        err = EncodeBlock(mBlockData[next], mBlockSize, mBlocks[next]);
+        SuccessOrExit(err);
+
+        mEncodedLastBlock = mBlocks[next].mIsLastBlock;
+        mNumBlocks++;
+    }
+
+    VerifyOrExit(mNumBlocks > 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    block       = &mBlocks[mFirstBlock];
+    *aDataBlock = mBlockData[mFirstBlock];
+#else
+    if (mBlockSent)
+    {
+        AcknowledgeBlock(mBlock);
+        mBlockSent = false;
+    }
+
+    block = &mBlock;
+    err   = EncodeBlock(*aDataBlock, blockSize, mBlock);
+    SuccessOrExit(err);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+
+    *aLength      = block->mLength;
+    *aIsLastBlock = block->mIsLastBlock;
+    mBlockSent    = true;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        *aIsLastBlock = true;
+        *aLength      = 0;
+    }
 }
 
 void BdxXferErrorHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransfer * aXfer,
@@ -204,6 +338,13 @@ WEAVE_ERROR LogBDXUpload::Init(LoggingManagement * inLogger)
     mCurrentEventID    = 0;
     memset(mLastScheduledEventId, 0, sizeof(mLastScheduledEventId));
     memset(mLastTransmittedEventId, 0, sizeof(mLastTransmittedEventId));
+    memset(mLastNotifiedEventId, 0, sizeof(mLastNotifiedEventId));
+    mPeerNodeId     = kNodeIdNotSpecified;
+    mUploadPosition = 0;
+    mBytesUploaded  = 0;
+    mThrottled      = false;
+    mFirstXfer      = true;
+    ResetBlocks();
     mLogger = inLogger;
     err     = mBdxNode.Init(mLogger->mExchangeMgr);
     SuccessOrExit(err);
@@ -235,10 +376,10 @@ WEAVE_ERROR LogBDXUpload::StartUpload(nl::Weave::Binding * aBinding)
     VerifyOrExit(aBinding != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // restore the point from which we need to resume
-    memcpy(mLastScheduledEventId, mLastTransmittedEventId, sizeof(mLastScheduledEventId));
-    mCurrentImportance = kImportanceType_First;
-    mCurrentEventID    = mLastScheduledEventId[mCurrentImportance - kImportanceType_First];
-    mFirstXfer         = true;
+    RewindToLastAcknowledged();
+    mFirstXfer     = true;
+    mPeerNodeId    = aBinding->GetPeerNodeId();
+    mBytesUploaded = 0;
 
     // create a transfer object
     xfer = NULL;
@@ -246,7 +387,7 @@ WEAVE_ERROR LogBDXUpload::StartUpload(nl::Weave::Binding * aBinding)
     SuccessOrExit(err);
 
     mState              = UploaderInProgress;
-    xfer->mMaxBlockSize = 1024;
+    xfer->mMaxBlockSize = WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE;
     xfer->mStartOffset  = 0;
     xfer->mLength       = 0;
 
@@ -266,9 +407,12 @@ exit:
 
 void LogBDXUpload::Abort(void)
 {
-    // Upload was aborted; last transmitted event Id not updated,
-    // instead, we rollback the last scheduled event IDs
-    memcpy(mLastScheduledEventId, mLastTransmittedEventId, sizeof(mLastScheduledEventId));
+    // Upload was aborted; the blocks acknowledged so far are delivered,
+    // the others are dropped, and we rollback the last scheduled event
+    // IDs to the last transmitted ones, so the next upload resumes after
+    // the last acknowledged block
+    NotifyTransmittedEvents();
+    RewindToLastAcknowledged();
     mState = UploaderInitialized;
     if (mThrottled)
     {
@@ -280,9 +424,23 @@ void LogBDXUpload::Abort(void)
 
 void LogBDXUpload::Done(void)
 {
-    // Upload was successful.  Transfer last scheduled event IDs to the
-    // last transmitted event IDS
-    memcpy(mLastTransmittedEventId, mLastScheduledEventId, sizeof(mLastTransmittedEventId));
+    // Upload was successful.  The last block was acknowledged along
+    // with the end of the transfer; this brings the last transmitted
+    // event IDs up to the last scheduled event IDs
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    if (mBlockSent)
+    {
+        AcknowledgeBlock(mBlocks[mFirstBlock]);
+    }
+#else
+    if (mBlockSent)
+    {
+        AcknowledgeBlock(mBlock);
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    NotifyTransmittedEvents();
+    ResetBlocks();
+    WeaveLogProgress(BDX, "Log upload complete, %" PRIu32 " bytes", mBytesUploaded);
     mState          = UploaderInitialized;
     mUploadPosition = mLogger->GetBytesWritten();
     if (mThrottled)
@@ -304,6 +462,16 @@ uint32_t LogBDXUpload::GetUploadPosition(void)
     return mUploadPosition;
 }
 
+/**
+ * @brief
+ *   The number of bytes of events acknowledged by the receiver in the
+ *   current, or the most recent, upload.
+ */
+uint32_t LogBDXUpload::GetBytesUploaded(void)
+{
+    return mBytesUploaded;
+}
+
 } // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 } // namespace Profiles
 } // namespace Weave
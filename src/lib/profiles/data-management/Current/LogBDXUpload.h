@@ -67,11 +67,29 @@ public:
     void Shutdown(void);
 
     uint32_t GetUploadPosition(void);
+    uint32_t GetBytesUploaded(void);
 
     UploaderState mState;
 
 private:
+    /**
+     * A block of events handed, or about to be handed, to the BDX
+     * transfer.  The block holds whole events, so once it is
+     * acknowledged every event before mEndEventId has been delivered.
+     */
+    struct UploadBlock
+    {
+        event_id_t mEndEventId[kImportanceType_Last - kImportanceType_First + 1]; ///< The upload cursor past the end of the block
+        uint32_t mLength;
+        bool mIsLastBlock;
+    };
+
     void ThrottleIfNeeded(void);
+    WEAVE_ERROR EncodeBlock(uint8_t * inBuffer, uint32_t inBufferSize, UploadBlock & outBlock);
+    void AcknowledgeBlock(const UploadBlock & inBlock);
+    void NotifyTransmittedEvents(void);
+    void RewindToLastAcknowledged(void);
+    void ResetBlocks(void);
 
     LoggingManagement * mLogger;
     nl::Weave::Profiles::BulkDataTransfer::BdxNode mBdxNode;
@@ -79,7 +97,21 @@ private:
     event_id_t mCurrentEventID;
     event_id_t mLastScheduledEventId[kImportanceType_Last - kImportanceType_First + 1];
     event_id_t mLastTransmittedEventId[kImportanceType_Last - kImportanceType_First + 1];
+    event_id_t mLastNotifiedEventId[kImportanceType_Last - kImportanceType_First + 1];
+    uint64_t mPeerNodeId;
     uint32_t mUploadPosition;
+    uint32_t mBytesUploaded;
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    UploadBlock mBlocks[WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW];
+    uint8_t mBlockData[WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW][WEAVE_CONFIG_EVENT_LOGGING_BDX_BLOCK_SIZE];
+    uint16_t mBlockSize;  ///< Largest size allowed for the blocks in the window; 0 until a block is requested
+    uint8_t mFirstBlock;  ///< Index of the oldest unacknowledged block in mBlocks
+    uint8_t mNumBlocks;   ///< Number of encoded blocks not yet acknowledged
+    bool mEncodedLastBlock;
+#else
+    UploadBlock mBlock;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_UPLOAD_WINDOW
+    bool mBlockSent; ///< True when the oldest encoded block was handed to the transfer and is awaiting acknowledgement
     bool mThrottled;
     bool mFirstXfer;
 };
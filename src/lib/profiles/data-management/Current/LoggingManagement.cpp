@@ -20,6 +20,11 @@
 #define __STDC_FORMAT_MACROS
 #endif // __STDC_FORMAT_MACROS
 
+// __STDC_LIMIT_MACROS must be defined for SIZE_MAX to be defined for pre-C++11 clib
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif // __STDC_LIMIT_MACROS
+
 // it is important for this first inclusion of inttypes.h to have all the right switches turned ON
 #include <inttypes.h>
 
@@ -91,6 +96,10 @@ WEAVE_ERROR LoggingManagement::CopyToNextBuffer(CircularEventBuffer * inEventBuf
     WeaveCircularTLVBuffer checkpoint   = inEventBuffer->mNext->mBuffer;
     WeaveCircularTLVBuffer * nextBuffer = &(inEventBuffer->mNext->mBuffer);
     WEAVE_ERROR err;
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    const EventSeekCheckpoint * headCheckpoint = inEventBuffer->GetHeadSeekCheckpoint();
+    uint32_t nextOffset                        = inEventBuffer->mNext->mBytesAppended;
+#endif
 
     // Set up the next buffer s.t. it fails if needs to evict an element
     nextBuffer->mProcessEvictedElement = AlwaysFail;
@@ -109,6 +118,18 @@ WEAVE_ERROR LoggingManagement::CopyToNextBuffer(CircularEventBuffer * inEventBuf
     err = writer.Finalize();
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    // The event keeps its place in the stream of events, so a checkpoint
+    // at the event stays accurate in the next buffer.
+    inEventBuffer->mNext->mBytesAppended += writer.GetLengthWritten();
+    if (headCheckpoint != NULL)
+    {
+        EventSeekCheckpoint nextCheckpoint = *headCheckpoint;
+        nextCheckpoint.mOffset             = nextOffset;
+        inEventBuffer->mNext->AddSeekCheckpoint(nextCheckpoint);
+    }
+#endif
+
 exit:
     if (err != WEAVE_NO_ERROR)
     {
@@ -300,92 +321,451 @@ WEAVE_ERROR LoggingManagement::BlitEvent(EventLoadOutContext * aContext, const E
         }
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    if (aContext->mSchemaRef != kSchemaRef_None)
+    {
+        // Stored event; the schema fields are restored from the
+        // dictionary when the event is fetched.
+        err = aContext->mWriter.Put(ContextTag(kTag_EventSchemaRef), aContext->mSchemaRef);
+        SuccessOrExit(err);
+    }
+    else
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    {
+        err = WriteEventSchemaFields(aContext->mWriter, inSchema, inOptions->eventSource);
+        SuccessOrExit(err);
+    }
+
+    // Callback to write the EventData
+    err = inEventWriter(aContext->mWriter, kTag_EventData, inAppData);
+    SuccessOrExit(err);
+
+    err = aContext->mWriter.EndContainer(containerType);
+    SuccessOrExit(err);
+
+    err = aContext->mWriter.Finalize();
+    SuccessOrExit(err);
+
+    // only update mFirst if an event was successfully written.
+    if (aContext->mFirst)
+    {
+        aContext->mFirst = false;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        aContext->mWriter = checkpoint;
+    }
+    else
+    {
+        // update these variables since BlitEvent can be used to track the
+        // state of a set of events over multiple calls.
+        aContext->mCurrentEventID++;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        if (inOptions->timestampType == kTimestampType_UTC)
+        {
+            aContext->mCurrentUTCTime = inOptions->timestamp.utcTimestamp;
+        }
+        else
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        {
+            aContext->mCurrentTime = inOptions->timestamp.systemTimestamp;
+        }
+    }
+    return err;
+}
+
+// Writes the trait profile ID (with schema versions), the event
+// source and the event type of an event.
+WEAVE_ERROR LoggingManagement::WriteEventSchemaFields(TLVWriter & ioWriter, const EventSchema & inSchema,
+                                                     const DetailedRootSection * inEventSource)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
     // Event Trait Profile ID
     if (inSchema.mMinCompatibleDataSchemaVersion != 1 || inSchema.mDataSchemaVersion != 1)
     {
         TLV::TLVType type;
 
-        err = aContext->mWriter.StartContainer(ContextTag(kTag_EventTraitProfileID), kTLVType_Array, type);
+        err = ioWriter.StartContainer(ContextTag(kTag_EventTraitProfileID), kTLVType_Array, type);
         SuccessOrExit(err);
 
-        err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mProfileId);
+        err = ioWriter.Put(TLV::AnonymousTag, inSchema.mProfileId);
         SuccessOrExit(err);
 
         if (inSchema.mDataSchemaVersion != 1)
         {
-            err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mDataSchemaVersion);
+            err = ioWriter.Put(TLV::AnonymousTag, inSchema.mDataSchemaVersion);
             SuccessOrExit(err);
         }
 
         if (inSchema.mMinCompatibleDataSchemaVersion != 1)
         {
-            err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mMinCompatibleDataSchemaVersion);
+            err = ioWriter.Put(TLV::AnonymousTag, inSchema.mMinCompatibleDataSchemaVersion);
             SuccessOrExit(err);
         }
 
-        err = aContext->mWriter.EndContainer(type);
+        err = ioWriter.EndContainer(type);
         SuccessOrExit(err);
     }
     else
     {
-        err = aContext->mWriter.Put(ContextTag(kTag_EventTraitProfileID), inSchema.mProfileId);
+        err = ioWriter.Put(ContextTag(kTag_EventTraitProfileID), inSchema.mProfileId);
         SuccessOrExit(err);
     }
 
     // Event resource
-    if (inOptions->eventSource != NULL)
+    if (inEventSource != NULL)
     {
-        err = inOptions->eventSource->ResourceID.ToTLV(aContext->mWriter, ContextTag(kTag_EventResourceID));
+        err = inEventSource->ResourceID.ToTLV(ioWriter, ContextTag(kTag_EventResourceID));
         SuccessOrExit(err);
 
-        err = aContext->mWriter.Put(ContextTag(kTag_EventTraitInstanceID), inOptions->eventSource->TraitInstanceID);
+        err = ioWriter.Put(ContextTag(kTag_EventTraitInstanceID), inEventSource->TraitInstanceID);
         SuccessOrExit(err);
     }
 
     // Event Type (aka Event Message ID)
-    err = aContext->mWriter.Put(ContextTag(kTag_EventType), inSchema.mStructureType);
+    err = ioWriter.Put(ContextTag(kTag_EventType), inSchema.mStructureType);
     SuccessOrExit(err);
 
-    // Callback to write the EventData
-    err = inEventWriter(aContext->mWriter, kTag_EventData, inAppData);
+exit:
+    return err;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
+void LoggingManagement::ClearSchemaDictionary(void)
+{
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE; i++)
+    {
+        mSchemaDictionary[i].mRefCount = 0;
+    }
+}
+
+/**
+ * @brief
+ *   Find the schema dictionary entry for an event about to be logged,
+ *   adding one if needed.
+ *
+ * An entry matches when the trait profile, the schema versions, the
+ * event type and the event source all match the event.  The returned
+ * entry is not referenced until the event is committed to the log.
+ *
+ * @param[in] inSchema   Schema of the event.
+ *
+ * @param[in] inOptions  Options of the event; only the event source is
+ *                       considered.
+ *
+ * @return The index of the entry, or kSchemaRef_None when the event
+ *         should be stored in the standard format because the
+ *         dictionary is full or storing the reference saves nothing.
+ */
+uint8_t LoggingManagement::FindOrAddSchemaDictionaryEntry(const EventSchema & inSchema, const EventOptions & inOptions)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t retval  = kSchemaRef_None;
+    uint8_t scratch[64];
+    TLVWriter writer;
+    TLVType container;
+    uint32_t startLen, fieldsLen, refLen;
+    EventSchemaDictionaryEntry * entry;
+
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE; i++)
+    {
+        entry = &mSchemaDictionary[i];
+
+        if ((entry->mRefCount == 0) && (retval == kSchemaRef_None))
+        {
+            retval = i;
+        }
+
+        if ((entry->mRefCount != 0) && (entry->mProfileId == inSchema.mProfileId) &&
+            (entry->mStructureType == inSchema.mStructureType) && (entry->mDataSchemaVersion == inSchema.mDataSchemaVersion) &&
+            (entry->mMinCompatibleDataSchemaVersion == inSchema.mMinCompatibleDataSchemaVersion) &&
+            (entry->mHasEventSource == (inOptions.eventSource != NULL)) &&
+            ((inOptions.eventSource == NULL) ||
+             ((entry->mEventSource.ResourceID == inOptions.eventSource->ResourceID) &&
+              (entry->mEventSource.TraitInstanceID == inOptions.eventSource->TraitInstanceID))))
+        {
+            // The count is incremented once the event is committed;
+            // keep it from wrapping around.
+            return (entry->mRefCount < 0xFFFF) ? i : static_cast<uint8_t>(kSchemaRef_None);
+        }
+    }
+
+    if (retval == kSchemaRef_None)
+    {
+        // The dictionary is full
+        ExitNow();
+    }
+
+    // Measure what the reference saves over the fields it replaces
+    writer.Init(scratch, sizeof(scratch));
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, container);
     SuccessOrExit(err);
 
-    err = aContext->mWriter.EndContainer(containerType);
+    startLen = writer.GetLengthWritten();
+
+    err = WriteEventSchemaFields(writer, inSchema, inOptions.eventSource);
     SuccessOrExit(err);
 
-    err = aContext->mWriter.Finalize();
+    fieldsLen = writer.GetLengthWritten() - startLen;
+
+    err = writer.Put(ContextTag(kTag_EventSchemaRef), retval);
     SuccessOrExit(err);
 
-    // only update mFirst if an event was successfully written.
-    if (aContext->mFirst)
+    refLen = writer.GetLengthWritten() - startLen - fieldsLen;
+
+    VerifyOrExit(fieldsLen > refLen, retval = kSchemaRef_None);
+
+    entry                                  = &mSchemaDictionary[retval];
+    entry->mProfileId                      = inSchema.mProfileId;
+    entry->mStructureType                  = inSchema.mStructureType;
+    entry->mDataSchemaVersion              = inSchema.mDataSchemaVersion;
+    entry->mMinCompatibleDataSchemaVersion = inSchema.mMinCompatibleDataSchemaVersion;
+    entry->mHasEventSource                 = (inOptions.eventSource != NULL);
+    if (entry->mHasEventSource)
     {
-        aContext->mFirst = false;
+        entry->mEventSource = *(inOptions.eventSource);
     }
+    entry->mSavedBytes = static_cast<uint16_t>(fieldsLen - refLen);
 
 exit:
     if (err != WEAVE_NO_ERROR)
     {
-        aContext->mWriter = checkpoint;
+        retval = kSchemaRef_None;
     }
-    else
+
+    return retval;
+}
+
+/**
+ * @brief
+ *   Drop the reference an event held on the schema dictionary, if any.
+ *
+ * @param[in] inEventReader  A reader positioned inside the event
+ *                           structure, before its first element.
+ */
+void LoggingManagement::ReleaseSchemaDictionaryEntry(const TLVReader & inEventReader)
+{
+    TLVReader reader;
+    uint8_t ref;
+
+    if ((nl::Weave::TLV::Utilities::Find(inEventReader, ContextTag(kTag_EventSchemaRef), reader, false) == WEAVE_NO_ERROR) &&
+        (reader.Get(ref) == WEAVE_NO_ERROR) && (ref < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE) &&
+        (mSchemaDictionary[ref].mRefCount > 0))
     {
-        // update these variables since BlitEvent can be used to track the
-        // state of a set of events over multiple calls.
-        aContext->mCurrentEventID++;
-#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-        if (inOptions->timestampType == kTimestampType_UTC)
+        mSchemaDictionary[ref].mRefCount--;
+    }
+}
+
+/**
+ * @brief
+ *   Replace a schema dictionary reference with the fields it stands for.
+ *
+ * @param[in] ioWriter  The writer receiving the expanded event.
+ *
+ * @param[in] ioReader  A reader positioned on the reference.
+ *
+ * @retval #WEAVE_ERROR_INVALID_TLV_ELEMENT  The reference does not name
+ *                                           an entry in use.
+ */
+WEAVE_ERROR LoggingManagement::ExpandSchemaRef(TLVWriter & ioWriter, TLVReader & ioReader) const
+{
+    WEAVE_ERROR err;
+    uint8_t ref;
+    EventSchema schema;
+    const EventSchemaDictionaryEntry * entry;
+
+    err = ioReader.Get(ref);
+    SuccessOrExit(err);
+
+    VerifyOrExit((ref < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE) && (mSchemaDictionary[ref].mRefCount > 0),
+                 err = WEAVE_ERROR_INVALID_TLV_ELEMENT);
+
+    entry                                  = &mSchemaDictionary[ref];
+    schema.mProfileId                      = entry->mProfileId;
+    schema.mStructureType                  = entry->mStructureType;
+    schema.mDataSchemaVersion              = entry->mDataSchemaVersion;
+    schema.mMinCompatibleDataSchemaVersion = entry->mMinCompatibleDataSchemaVersion;
+
+    err = WriteEventSchemaFields(ioWriter, schema, entry->mHasEventSource ? &(entry->mEventSource) : NULL);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LoggingManagement::SerializeSchemaDictionary(TLVWriter & ioWriter) const
+{
+    WEAVE_ERROR err;
+    TLVType arrayContainer;
+    TLVType container;
+    const EventSchemaDictionaryEntry * entry;
+
+    err = ioWriter.StartContainer(AnonymousTag, kTLVType_Array, arrayContainer);
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE; i++)
+    {
+        entry = &mSchemaDictionary[i];
+
+        if (entry->mRefCount == 0)
+            continue;
+
+        err = ioWriter.StartContainer(AnonymousTag, kTLVType_Structure, container);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_Index), i);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_ProfileId), entry->mProfileId);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_StructureType), entry->mStructureType);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_DataSchemaVersion), entry->mDataSchemaVersion);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_MinCompatibleDataSchemaVersion), entry->mMinCompatibleDataSchemaVersion);
+        SuccessOrExit(err);
+
+        if (entry->mHasEventSource)
         {
-            aContext->mCurrentUTCTime = inOptions->timestamp.utcTimestamp;
+            err = ioWriter.Put(ContextTag(kTag_PersistSchema_ResourceType), entry->mEventSource.ResourceID.GetResourceType());
+            SuccessOrExit(err);
+
+            err = ioWriter.Put(ContextTag(kTag_PersistSchema_ResourceId), entry->mEventSource.ResourceID.GetResourceId());
+            SuccessOrExit(err);
+
+            err = ioWriter.Put(ContextTag(kTag_PersistSchema_TraitInstanceId), entry->mEventSource.TraitInstanceID);
+            SuccessOrExit(err);
         }
-        else
-#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_RefCount), entry->mRefCount);
+        SuccessOrExit(err);
+
+        err = ioWriter.Put(ContextTag(kTag_PersistSchema_SavedBytes), entry->mSavedBytes);
+        SuccessOrExit(err);
+
+        err = ioWriter.EndContainer(container);
+        SuccessOrExit(err);
+    }
+
+    err = ioWriter.EndContainer(arrayContainer);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LoggingManagement::LoadSchemaDictionary(TLVReader & ioReader)
+{
+    WEAVE_ERROR err;
+    TLVType arrayContainer;
+    TLVType container;
+    uint8_t index;
+    uint16_t resourceType;
+    uint64_t resourceId;
+    EventSchemaDictionaryEntry * entry;
+    TLVReader peekReader;
+
+    ClearSchemaDictionary();
+
+    // Snapshots serialized without the dictionary end after the event
+    // buffers; their events are all stored in the standard format.
+    peekReader.Init(ioReader);
+    err = peekReader.Next();
+    VerifyOrExit(err != WEAVE_END_OF_TLV, err = WEAVE_NO_ERROR);
+
+    err = ioReader.Next(kTLVType_Array, AnonymousTag);
+    SuccessOrExit(err);
+    err = ioReader.EnterContainer(arrayContainer);
+    SuccessOrExit(err);
+
+    while ((err = ioReader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = ioReader.EnterContainer(container);
+        SuccessOrExit(err);
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_Index));
+        SuccessOrExit(err);
+        err = ioReader.Get(index);
+        SuccessOrExit(err);
+        VerifyOrExit(index < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE, err = WEAVE_ERROR_INVALID_TLV_ELEMENT);
+
+        entry = &mSchemaDictionary[index];
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_ProfileId));
+        SuccessOrExit(err);
+        err = ioReader.Get(entry->mProfileId);
+        SuccessOrExit(err);
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_StructureType));
+        SuccessOrExit(err);
+        err = ioReader.Get(entry->mStructureType);
+        SuccessOrExit(err);
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_DataSchemaVersion));
+        SuccessOrExit(err);
+        err = ioReader.Get(entry->mDataSchemaVersion);
+        SuccessOrExit(err);
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_MinCompatibleDataSchemaVersion));
+        SuccessOrExit(err);
+        err = ioReader.Get(entry->mMinCompatibleDataSchemaVersion);
+        SuccessOrExit(err);
+
+        err = ioReader.Next();
+        SuccessOrExit(err);
+
+        entry->mHasEventSource = (ioReader.GetTag() == ContextTag(kTag_PersistSchema_ResourceType));
+        if (entry->mHasEventSource)
         {
-            aContext->mCurrentTime = inOptions->timestamp.systemTimestamp;
+            err = ioReader.Get(resourceType);
+            SuccessOrExit(err);
+
+            err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_ResourceId));
+            SuccessOrExit(err);
+            err = ioReader.Get(resourceId);
+            SuccessOrExit(err);
+
+            entry->mEventSource.ResourceID = ResourceIdentifier(resourceType, resourceId);
+
+            err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_TraitInstanceId));
+            SuccessOrExit(err);
+            err = ioReader.Get(entry->mEventSource.TraitInstanceID);
+            SuccessOrExit(err);
+
+            err = ioReader.Next();
+            SuccessOrExit(err);
         }
+
+        VerifyOrExit(ioReader.GetTag() == ContextTag(kTag_PersistSchema_RefCount), err = WEAVE_ERROR_INVALID_TLV_ELEMENT);
+        err = ioReader.Get(entry->mRefCount);
+        SuccessOrExit(err);
+
+        err = ioReader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistSchema_SavedBytes));
+        SuccessOrExit(err);
+        err = ioReader.Get(entry->mSavedBytes);
+        SuccessOrExit(err);
+
+        err = ioReader.ExitContainer(container);
+        SuccessOrExit(err);
     }
+
+    VerifyOrExit(err == WEAVE_END_OF_TLV, );
+    err = ioReader.ExitContainer(arrayContainer);
+    SuccessOrExit(err);
+
+exit:
     return err;
 }
 
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
 /**
  * @brief Helper function to skip writing an event corresponding to an allocated
  *   event id.
@@ -467,6 +847,12 @@ WEAVE_ERROR LoggingManagement::SerializeEvents(TLVWriter & writer)
         eventBuffer = eventBuffer->mNext;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    // The serialized events may refer to the dictionary
+    err = SerializeSchemaDictionary(writer);
+    SuccessOrExit(err);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
     err = writer.EndContainer(container);
     SuccessOrExit(err);
 
@@ -502,6 +888,11 @@ WEAVE_ERROR LoggingManagement::LoadEvents(TLVReader & reader)
         eventBuffer = eventBuffer->mNext;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    err = LoadSchemaDictionary(reader);
+    SuccessOrExit(err);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
     err = reader.VerifyEndOfContainer();
     SuccessOrExit(err);
     err = reader.ExitContainer(container);
@@ -629,6 +1020,19 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
     mBytesWritten        = 0;
     mUploadRequested     = false;
     mMaxImportanceBuffer = kImportanceType_Last;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    ClearSchemaDictionary();
+    memset(&mStorageStats, 0, sizeof(mStorageStats));
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    InitStagingQueue();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    InitSpillStore();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
 }
 
 /**
@@ -641,7 +1045,21 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
 LoggingManagement::LoggingManagement(void) :
     mEventBuffer(NULL), mExchangeMgr(NULL), mState(kLoggingManagementState_Idle), mBDXUploader(NULL), mBytesWritten(0),
     mThrottled(0), mMaxImportanceBuffer(kImportanceType_Invalid), mUploadRequested(false)
-{ }
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    ClearSchemaDictionary();
+    memset(&mStorageStats, 0, sizeof(mStorageStats));
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    InitStagingQueue();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    memset(mSpilledEventID, 0, sizeof(mSpilledEventID));
+    mSpillEnabled = false;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+}
 
 /**
  * @brief
@@ -735,13 +1153,27 @@ event_id_t LoggingManagement::GetLastEventID(ImportanceType inImportance)
  * @brief
  *   Fetch the first event ID currently stored for a particular importance level
  *
+ * When the spill store is enabled, events in the spill store count as
+ * stored.
+ *
  * @param inImportance Importance level
  *
  * @return event_id_t First currently stored event ID for that event importance
  */
 event_id_t LoggingManagement::GetFirstEventID(ImportanceType inImportance)
 {
-    return GetImportanceBuffer(inImportance)->mFirstEventID;
+    event_id_t firstEventID = GetImportanceBuffer(inImportance)->mFirstEventID;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    const event_id_t firstSpilledEventID = mSpillStore.GetFirstEventID(inImportance);
+
+    if ((firstSpilledEventID != 0) && (firstSpilledEventID < firstEventID))
+    {
+        firstEventID = firstSpilledEventID;
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+    return firstEventID;
 }
 
 CircularEventBuffer * LoggingManagement::GetImportanceBuffer(ImportanceType inImportance) const
@@ -952,6 +1384,13 @@ WEAVE_ERROR LoggingManagement::RegisterEventCallbackForImportance(ImportanceType
 
     mBytesWritten += writer.GetLengthWritten();
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    if (err == WEAVE_NO_ERROR)
+    {
+        mEventBuffer->mBytesAppended += writer.GetLengthWritten();
+    }
+#endif
+
 exit:
 
     if (err != WEAVE_NO_ERROR)
@@ -1118,6 +1557,12 @@ WEAVE_ERROR LoggingManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader,
         }
     }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    else if (aReader.GetTag() == ContextTag(kTag_EventSchemaRef))
+    {
+        err = GetInstance().ExpandSchemaRef(*(ctx->mWriter), reader);
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
     else
     {
         err = ctx->mWriter->CopyElement(reader);
@@ -1270,6 +1715,10 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
         opts.relatedImportance = inOptions->relatedImportance;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    ctxt.mSchemaRef = FindOrAddSchemaDictionaryEntry(inSchema, opts);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
     ctxt.mFirst          = false;
     ctxt.mCurrentEventID = GetImportanceBuffer(inSchema.mImportance)->mLastEventID;
     ctxt.mCurrentTime    = GetImportanceBuffer(inSchema.mImportance)->mLastEventTimestamp;
@@ -1330,6 +1779,27 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
 
     mBytesWritten += writer.GetLengthWritten();
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    mStorageStats.mEventsWritten++;
+    mStorageStats.mBytesWritten += writer.GetLengthWritten();
+    mStorageStats.mUncompressedBytesWritten += writer.GetLengthWritten();
+    if (ctxt.mSchemaRef != kSchemaRef_None)
+    {
+        mSchemaDictionary[ctxt.mSchemaRef].mRefCount++;
+        mStorageStats.mUncompressedBytesWritten += mSchemaDictionary[ctxt.mSchemaRef].mSavedBytes;
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    {
+        EventSeekCheckpoint seekCheckpoint;
+
+        GetSeekCheckpoint(seekCheckpoint);
+        mEventBuffer->mBytesAppended += writer.GetLengthWritten();
+        mEventBuffer->AddSeekCheckpoint(seekCheckpoint);
+    }
+#endif
+
 exit:
 
     if (err != WEAVE_NO_ERROR)
@@ -1365,11 +1835,264 @@ exit:
         }
 
         ScheduleFlushIfNeeded(inOptions == NULL ? false : inOptions->urgent);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+        // Spill ahead of eviction, a bounded batch at a time, so that
+        // dropping an event from memory seldom has to write it out.
+        if (mSpillEnabled && (mEventBuffer->mBuffer.AvailableDataLength() < WEAVE_CONFIG_EVENT_LOGGING_SPILL_WATERMARK))
+        {
+            SpillEventsPrivate(WEAVE_CONFIG_EVENT_LOGGING_SPILL_BATCH_SIZE);
+        }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
     }
 
     return event_id;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
+void LoggingManagement::InitStagingQueue(void)
+{
+    for (uint32_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE; i++)
+    {
+        mStagedEvents[i].mSequence = i;
+    }
+
+    mStagingEnqueuePos     = 0;
+    mStagingDequeuePos     = 0;
+    mStagingDrainScheduled = false;
+}
+
+/**
+ * @brief
+ *   Stage an event for logging without entering the event logging
+ *   critical section.
+ *
+ * The event data is serialized by the calling thread into a slot of a
+ * bounded, lock-free multi-producer queue, together with the schema,
+ * the options and the current system timestamp.  The staged events
+ * are moved into the event buffers by DrainStagedEvents(), which is
+ * scheduled on the Weave thread when the first event of a batch is
+ * staged.  Event IDs and the encoded delta timestamps are assigned at
+ * that time, so, unlike LogEvent(), this function cannot return the ID
+ * of the event.  Events staged by different threads are logged in the
+ * order in which they claimed their slots.
+ *
+ * If the logger has no exchange manager, nothing is scheduled and the
+ * application is responsible for calling DrainStagedEvents().
+ *
+ * @param[in] inSchema     Schema defining importance, profile ID, and
+ *                         structure type of this event.
+ *
+ * @param[in] inEventWriter The callback to invoke to actually
+ *                         serialize the event data
+ *
+ * @param[in] inAppData    Application context for the callback.
+ *
+ * @param[in] inOptions    The options for the event metadata. May be NULL.
+ *
+ * @retval #WEAVE_NO_ERROR              On success, or if the event was
+ *                                      discarded by the current logging
+ *                                      importance.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE The logger is shut down.
+ * @retval #WEAVE_ERROR_NO_MEMORY       The staging queue is full.
+ * @retval other                        The error returned by
+ *                                      inEventWriter, e.g.
+ *                                      #WEAVE_ERROR_BUFFER_TOO_SMALL if the
+ *                                      event data does not fit in a slot.
+ */
+WEAVE_ERROR LoggingManagement::StageEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                                          const EventOptions * inOptions)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    StagedEvent * slot = NULL;
+    uint32_t position;
+    TLVWriter writer;
+    TLVType outerType;
+
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Checked again when the event is drained; checking here keeps
+    // discarded events from occupying the queue.
+    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), /* no-op */);
+
+    // Claim a slot.  A slot is free for position p when its sequence
+    // equals p; a smaller sequence means the drain has not yet consumed
+    // the slot from the previous lap, i.e. the queue is full.
+    position = __sync_fetch_and_add(&mStagingEnqueuePos, 0);
+    while (true)
+    {
+        uint32_t sequence;
+
+        slot     = &mStagedEvents[position & (WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1)];
+        sequence = __sync_fetch_and_add(&slot->mSequence, 0);
+
+        if (sequence == position)
+        {
+            if (__sync_bool_compare_and_swap(&mStagingEnqueuePos, position, position + 1))
+                break;
+        }
+        else if (static_cast<int32_t>(sequence - position) < 0)
+        {
+            slot = NULL;
+            ExitNow(err = WEAVE_ERROR_NO_MEMORY);
+        }
+
+        position = __sync_fetch_and_add(&mStagingEnqueuePos, 0);
+    }
+
+    slot->mSchema         = inSchema;
+    slot->mOptions        = (inOptions != NULL) ? *inOptions : EventOptions();
+    slot->mHasEventSource = (slot->mOptions.eventSource != NULL);
+    slot->mDataLen        = 0;
+
+    if (slot->mHasEventSource)
+    {
+        slot->mEventSource = *(slot->mOptions.eventSource);
+    }
+
+    // Capture the system time now rather than at drain time; the drain
+    // derives the UTC timestamp, if any, relative to it.
+    if (slot->mOptions.timestampType != kTimestampType_System && slot->mOptions.timestampType != kTimestampType_UTC)
+    {
+        slot->mOptions.timestamp.systemTimestamp = static_cast<timestamp_t>(System::Timer::GetCurrentEpoch());
+        slot->mOptions.timestampType             = kTimestampType_System;
+    }
+
+    // Context tags are only valid inside a structure, so the event data
+    // is staged inside an anonymous one.
+    writer.Init(slot->mData, sizeof(slot->mData));
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerType);
+    SuccessOrExit(err);
+
+    err = inEventWriter(writer, kTag_EventData, inAppData);
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(outerType);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    slot->mDataLen = static_cast<uint16_t>(writer.GetLengthWritten());
+
+exit:
+    if (slot != NULL)
+    {
+        // The slot has been claimed and must be published even if the
+        // event could not be encoded; the drain skips empty slots.
+        __sync_fetch_and_add(&slot->mSequence, 1);
+
+        if (__sync_bool_compare_and_swap(&mStagingDrainScheduled, false, true))
+        {
+            if ((mExchangeMgr == NULL) || (mExchangeMgr->MessageLayer == NULL) || (mExchangeMgr->MessageLayer->SystemLayer == NULL) ||
+                (mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(StagedEventsDrainHandler, this) != WEAVE_SYSTEM_NO_ERROR))
+            {
+                __sync_lock_release(&mStagingDrainScheduled);
+            }
+        }
+    }
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(EventLogging, "Failed to stage event for profile id: 0x%x (err: %d)", inSchema.mProfileId, err);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *   Move all staged events into the event buffers.
+ *
+ * Enters the event logging critical section once for the whole batch
+ * and logs each event staged by StageEvent(), in staging order,
+ * assigning its event ID.  Normally invoked on the Weave thread in
+ * response to StageEvent(); may also be called directly, e.g. before
+ * SerializeEvents() or FetchEventsSince() when all staged events must
+ * be visible.
+ *
+ * @return The number of staged events that were logged.
+ */
+size_t LoggingManagement::DrainStagedEvents(void)
+{
+    size_t numLogged = 0;
+
+    Platform::CriticalSectionEnter();
+
+    // Clear the flag before looking at the queue, so that an event
+    // published after the last slot we consume schedules a new drain.
+    __sync_lock_release(&mStagingDrainScheduled);
+
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, /* no-op */);
+
+    while (true)
+    {
+        StagedEvent & slot = mStagedEvents[mStagingDequeuePos & (WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1)];
+
+        if (__sync_fetch_and_add(&slot.mSequence, 0) != mStagingDequeuePos + 1)
+            break;
+
+        if (slot.mDataLen != 0)
+        {
+            TLVReader reader;
+
+            if (slot.mHasEventSource)
+            {
+                slot.mOptions.eventSource = &slot.mEventSource;
+            }
+
+            reader.Init(slot.mData, slot.mDataLen);
+
+            if (LogEventPrivate(slot.mSchema, StagedEventWriter, &reader, &slot.mOptions) != 0)
+            {
+                numLogged++;
+            }
+        }
+
+        __sync_fetch_and_add(&slot.mSequence, WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1);
+        mStagingDequeuePos++;
+    }
+
+exit:
+    Platform::CriticalSectionExit();
+
+    return numLogged;
+}
+
+void LoggingManagement::StagedEventsDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err)
+{
+    LoggingManagement * logger = static_cast<LoggingManagement *>(appState);
+    logger->DrainStagedEvents();
+}
+
+// Copies the event data element encoded by StageEvent() into the
+// event buffer.  The tag is replaced with the eventData tag, as in
+// EventWriterTLVCopy().
+WEAVE_ERROR LoggingManagement::StagedEventWriter(TLVWriter & ioWriter, uint8_t inDataTag, void * appData)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    TLVReader * reader = static_cast<TLVReader *>(appData);
+    TLVType outerType;
+
+    err = reader->Next();
+    SuccessOrExit(err);
+
+    err = reader->EnterContainer(outerType);
+    SuccessOrExit(err);
+
+    err = reader->Next();
+    SuccessOrExit(err);
+
+    err = ioWriter.CopyElement(ContextTag(kTag_EventData), *reader);
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
 /**
  * @brief
  *   ThrottleLogger elevates the effective logging level to the Production level.
@@ -1613,6 +2336,16 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
         buf = buf->mNext;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    // Events older than the ones in memory come from the spill store
+    if (mSpillEnabled && (ioEventID < buf->mFirstEventID))
+    {
+        aContext.mCurrentEventID = ioEventID;
+        err = mSpillStore.FetchEventsSince(ioWriter, inImportance, aContext.mCurrentEventID, buf->mFirstEventID);
+        SuccessOrExit(err);
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
     aContext.mCurrentTime = buf->mFirstEventTimestamp;
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     aContext.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
@@ -1621,6 +2354,10 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
     err                      = GetEventReader(reader, inImportance);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    SeekEventReader(reader, aContext, inImportance);
+#endif
+
     err = nl::Weave::TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, recurse);
 
 #if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
@@ -1645,6 +2382,99 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+/**
+ * @brief
+ *   Internal API used to record a seek checkpoint at the tail of the event log
+ *
+ * Captures, for every importance level, the ID of the next event to be
+ * vended and the timestamps the next event's deltas will be computed
+ * against.  Must be called before the event being appended is assigned
+ * its ID.
+ *
+ * @param[out] outCheckpoint The checkpoint for the event being appended to
+ *                           mEventBuffer
+ */
+void LoggingManagement::GetSeekCheckpoint(EventSeekCheckpoint & outCheckpoint) const
+{
+    outCheckpoint.mOffset = mEventBuffer->mBytesAppended;
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        const CircularEventBuffer * buf = GetImportanceBuffer(static_cast<ImportanceType>(i));
+        const size_t index              = i - kImportanceType_First;
+
+        outCheckpoint.mEventID[index]   = static_cast<event_id_t>(buf->mEventIdCounter->GetValue());
+        outCheckpoint.mTimestamp[index] = buf->mLastEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        outCheckpoint.mUTCTimestamp[index] = buf->mUTCInitialized ? buf->mLastEventUTCTimestamp : 0;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    }
+}
+
+/**
+ * @brief
+ *   Internal API used to implement #FetchEventsSince
+ *
+ * Repositions a reader set up by GetEventReader() at the last seek
+ * checkpoint preceding the starting event of the context, so that the
+ * events before the checkpoint need not be iterated over.  The reader
+ * and context are left unchanged when no such checkpoint exists.
+ *
+ * @param[inout] ioReader     The reader to reposition
+ *
+ * @param[inout] ioContext    The fetch context; its current event ID and
+ *                            timestamps are updated to the checkpoint
+ *
+ * @param[in]    inImportance The importance of events being fetched
+ */
+void LoggingManagement::SeekEventReader(TLVReader & ioReader, EventLoadOutContext & ioContext, ImportanceType inImportance)
+{
+    const size_t index                     = inImportance - kImportanceType_First;
+    CircularEventBuffer * importanceBuffer = GetImportanceBuffer(inImportance);
+    const EventSeekCheckpoint * checkpoint = NULL;
+    CircularEventBuffer * buf;
+    CircularEventReader reader;
+
+    VerifyOrExit(ioContext.mStartingEventID > ioContext.mCurrentEventID, /* nothing to skip */);
+
+    // The reader visits the importance buffer first and the less
+    // important buffers after it, so the newest events are in
+    // mEventBuffer: search from there towards the importance buffer.
+    for (buf = mEventBuffer;; buf = buf->mNext)
+    {
+        checkpoint = buf->FindSeekCheckpoint(inImportance, ioContext.mStartingEventID);
+        if ((checkpoint != NULL) || (buf == importanceBuffer))
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit((checkpoint != NULL) && (checkpoint->mEventID[index] > ioContext.mCurrentEventID), /* no-op */);
+
+    reader.Init(buf, *checkpoint);
+    ioReader.Init(reader);
+
+    ioContext.mCurrentEventID = checkpoint->mEventID[index];
+
+    // A zero timestamp means the first event of this importance follows
+    // the checkpoint; its delta is relative to the buffer's first timestamp.
+    if (checkpoint->mTimestamp[index] != 0)
+    {
+        ioContext.mCurrentTime = checkpoint->mTimestamp[index];
+    }
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    if (checkpoint->mUTCTimestamp[index] != 0)
+    {
+        ioContext.mCurrentUTCTime = checkpoint->mUTCTimestamp[index];
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+exit:
+    return;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+
 /**
  * @brief
  *   A helper method useful for examining the in-memory log buffers
@@ -1740,6 +2570,12 @@ WEAVE_ERROR LoggingManagement::EvictEvent(WeaveCircularTLVBuffer & inBuffer, voi
     const bool recurse = false;
     WEAVE_ERROR err;
     ImportanceType imp = kImportanceType_Invalid;
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    TLVReader eventReader;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    TLVReader spillReader;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
 
 #if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
     ExternalEvents ev;
@@ -1754,9 +2590,17 @@ WEAVE_ERROR LoggingManagement::EvictEvent(WeaveCircularTLVBuffer & inBuffer, voi
     err = inReader.Next();
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    spillReader.Init(inReader);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
     err = inReader.EnterContainer(containerType);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    eventReader.Init(inReader);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
     nl::Weave::TLV::Utilities::Iterate(inReader, FetchEventParameters, &context, recurse);
 
     err = inReader.ExitContainer(containerType);
@@ -1782,8 +2626,36 @@ WEAVE_ERROR LoggingManagement::EvictEvent(WeaveCircularTLVBuffer & inBuffer, voi
         }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+        if (!ev.IsValid())
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+        {
+            // Spill the event, unless it already was, before it is lost
+            TLVWriter spillWriter;
+            EventLoadOutContext spillContext(spillWriter, imp, eventBuffer->mFirstEventID, NULL);
+            WEAVE_ERROR spillErr;
+
+            spillContext.mCurrentEventID = eventBuffer->mFirstEventID;
+            spillContext.mCurrentTime    = eventBuffer->mFirstEventTimestamp + context.mDeltaTime;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            spillContext.mCurrentUTCTime = eventBuffer->mFirstEventUTCTimestamp + context.mDeltaUtc;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+            spillErr = GetInstance().SpillEvent(spillReader, spillContext);
+            if (spillErr != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(EventLogging, "Failed to spill event: { importance_level: %d, id: %u, err: %d };", imp,
+                              spillContext.mCurrentEventID, spillErr);
+            }
+        }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
         eventBuffer->RemoveEvent(numEventsToDrop);
         eventBuffer->mFirstEventTimestamp += context.mDeltaTime;
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+        GetInstance().ReleaseSchemaDictionaryEntry(eventReader);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
         WeaveLogDetail(EventLogging, "Dropped events due to overflow: { importance_level: %d, count: %d };", imp, numEventsToDrop);
 
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
@@ -1802,6 +2674,267 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+/**
+ * @brief
+ *   Internal API used to recover the spill store on startup
+ *
+ * Makes sure event IDs are not reused across a restart: when the spill
+ * store holds events at or past the next ID an importance level would
+ * vend, as happens when the event ID counter is not persisted, the
+ * counter is moved past them.
+ */
+void LoggingManagement::InitSpillStore(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    CircularEventBuffer * buffer;
+    event_id_t lastSpilledEventID;
+
+    memset(mSpilledEventID, 0, sizeof(mSpilledEventID));
+
+    // Without a usable store, e.g. on a platform whose segment storage
+    // always fails, events are dropped from memory as if there were none.
+    err           = mSpillStore.Init();
+    mSpillEnabled = (err == WEAVE_NO_ERROR);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(EventLogging, "%s EventSpillStore::Init() failed with %d, not spilling events", __FUNCTION__, err);
+        ExitNow();
+    }
+
+    for (buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+    {
+        lastSpilledEventID = mSpillStore.GetLastEventID(buffer->mImportance);
+
+        mSpilledEventID[buffer->mImportance - kImportanceType_First] = lastSpilledEventID;
+
+        if ((lastSpilledEventID == 0) || (lastSpilledEventID < buffer->mEventIdCounter->GetValue()))
+        {
+            continue;
+        }
+
+        if (buffer->mEventIdCounter == &(buffer->mNonPersistedCounter))
+        {
+            err = buffer->mNonPersistedCounter.Init(lastSpilledEventID + 1);
+        }
+        else
+        {
+            err = static_cast<PersistedCounter *>(buffer->mEventIdCounter)->SetValue(lastSpilledEventID + 1);
+        }
+
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(EventLogging, "%s SetValue() for importance %d failed with %d", __FUNCTION__, buffer->mImportance, err);
+        }
+
+        buffer->mFirstEventID = buffer->mEventIdCounter->GetValue();
+        buffer->mLastEventID  = lastSpilledEventID;
+    }
+
+exit:
+    return;
+}
+
+/**
+ * @brief
+ *   Internal API used to write a single event to the spill store
+ *
+ * The event is encoded as the first event returned by #FetchEventsSince,
+ * with its event ID and its timestamps.  Events already spilled are
+ * skipped, and an event too large for
+ * WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE is not spilled.
+ *
+ * @param[in] inEventReader A reader positioned on the event in the log
+ *
+ * @param[in] ioContext     The importance, ID and absolute timestamps of
+ *                          the event.  Its writer is used to encode the
+ *                          event.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ * @retval other           The error returned by the spill store.
+ */
+WEAVE_ERROR LoggingManagement::SpillEvent(const TLVReader & inEventReader, EventLoadOutContext & ioContext)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const size_t index = ioContext.mImportance - kImportanceType_First;
+    uint8_t event[WEAVE_CONFIG_EVENT_LOGGING_SPILL_EVENT_SIZE];
+
+    VerifyOrExit(mSpillEnabled, /* no-op */);
+    VerifyOrExit(ioContext.mCurrentEventID > mSpilledEventID[index], /* already spilled */);
+
+    ioContext.mWriter.Init(event, sizeof(event));
+    ioContext.mFirst = true;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    ioContext.mFirstUtc = true;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+    err = CopyEvent(inEventReader, ioContext.mWriter, &ioContext);
+    if (err == WEAVE_NO_ERROR)
+    {
+        err = mSpillStore.AppendEvent(ioContext.mImportance, ioContext.mCurrentEventID, event,
+                                      static_cast<uint16_t>(ioContext.mWriter.GetLengthWritten()));
+        SuccessOrExit(err);
+    }
+    else
+    {
+        VerifyOrExit((err == WEAVE_ERROR_BUFFER_TOO_SMALL) || (err == WEAVE_ERROR_NO_MEMORY), /* no-op */);
+
+        WeaveLogError(EventLogging, "Event too large to spill: { importance_level: %d, id: %u };", ioContext.mImportance,
+                      ioContext.mCurrentEventID);
+        err = WEAVE_NO_ERROR;
+    }
+
+    mSpilledEventID[index] = ioContext.mCurrentEventID;
+
+exit:
+    return err;
+}
+
+namespace {
+
+/**
+ * The context of #SpillEventsPrivate: the events of one importance
+ * being spilled, and how many more of them may be.
+ */
+struct SpillEventsContext : public EventLoadOutContext
+{
+    SpillEventsContext(TLVWriter & inWriter, ImportanceType inImportance, uint32_t inStartingEventID,
+                       ExternalEvents * ioExternalEvent, size_t inMaxEvents) :
+        EventLoadOutContext(inWriter, inImportance, inStartingEventID, ioExternalEvent),
+        mNumEventsLeft(inMaxEvents)
+    { }
+
+    size_t mNumEventsLeft; ///< The number of events that may still be spilled, or SIZE_MAX for no limit
+};
+
+} // namespace
+
+/**
+ * @brief
+ *   Internal API used to implement #SpillEventsPrivate
+ *
+ * Iterator function spilling the events, from the starting event ID of
+ * the context on, to the spill store, until the context runs out of
+ * events to spill.  External events are left to the application.
+ */
+WEAVE_ERROR LoggingManagement::SpillEventsSince(const TLVReader & aReader, size_t aDepth, void * aContext)
+{
+    WEAVE_ERROR err                      = WEAVE_NO_ERROR;
+    EventLoadOutContext * loadOutContext = static_cast<EventLoadOutContext *>(aContext);
+    SpillEventsContext * spillContext    = static_cast<SpillEventsContext *>(loadOutContext);
+
+    err = EventIterator(aReader, aDepth, aContext);
+    if (err == WEAVE_EVENT_ID_FOUND)
+    {
+        VerifyOrExit(spillContext->mNumEventsLeft > 0, err = WEAVE_END_OF_TLV);
+
+        err = GetInstance().SpillEvent(aReader, *loadOutContext);
+        SuccessOrExit(err);
+
+        loadOutContext->mCurrentEventID++;
+        spillContext->mNumEventsLeft--;
+    }
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    else if ((err == WEAVE_END_OF_TLV) && loadOutContext->mExternalEvents->IsValid())
+    {
+        loadOutContext->mCurrentEventID = loadOutContext->mExternalEvents->mLastEventID + 1;
+        err                             = WEAVE_NO_ERROR;
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+exit:
+    return err;
+}
+
+// Note: the function below must be called with the critical section
+// locked.  It spills at most inMaxEvents events of each importance,
+// picking up after the last event spilled.
+
+WEAVE_ERROR LoggingManagement::SpillEventsPrivate(size_t inMaxEvents)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const bool recurse = false;
+    CircularEventBuffer * buf;
+    TLVWriter writer;
+    TLVReader reader;
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    ExternalEvents ev;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+    VerifyOrExit(mSpillEnabled, /* no-op */);
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        const ImportanceType importance = static_cast<ImportanceType>(i);
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+        SpillEventsContext context(writer, importance, mSpilledEventID[i - kImportanceType_First] + 1, &ev, inMaxEvents);
+#else
+        SpillEventsContext context(writer, importance, mSpilledEventID[i - kImportanceType_First] + 1, NULL, inMaxEvents);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+        buf = GetImportanceBuffer(importance);
+        if ((buf->mLastEventID < buf->mFirstEventID) || (buf->mLastEventID < context.mStartingEventID))
+        {
+            continue;
+        }
+
+        context.mCurrentTime = buf->mFirstEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        context.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        context.mCurrentEventID = buf->mFirstEventID;
+
+        err = GetEventReader(reader, importance);
+        SuccessOrExit(err);
+
+        // Resume at the seek checkpoint nearest the first event not yet
+        // spilled, rather than walking the events already spilled.
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+        SeekEventReader(reader, context, importance);
+#endif
+
+        err = nl::Weave::TLV::Utilities::Iterate(reader, SpillEventsSince, static_cast<EventLoadOutContext *>(&context), recurse);
+        VerifyOrExit((err == WEAVE_NO_ERROR) || (err == WEAVE_END_OF_TLV), /* no-op */);
+
+        err = WEAVE_NO_ERROR;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(EventLogging, "Failed to spill events (err: %d)", err);
+    }
+    return err;
+}
+
+/**
+ * @brief
+ *   Write the events not yet spilled to the spill store.
+ *
+ * Events are spilled as they are dropped from the in-memory buffers.
+ * This function spills all the events held in memory that are not yet
+ * in the spill store, e.g. periodically from the application or ahead
+ * of a planned shutdown.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ * @retval other           The error returned by the spill store.
+ */
+WEAVE_ERROR LoggingManagement::SpillEvents(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    Platform::CriticalSectionEnter();
+
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, /* no-op */);
+
+    err = SpillEventsPrivate(SIZE_MAX);
+
+exit:
+    Platform::CriticalSectionExit();
+    return err;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
 // Notes: called as a result of the timer expiration.  Main job:
 // figure out whether trigger still applies, if it does, then kick off
 // the upload.  If it does not, perform the appropriate backoff.
@@ -2044,6 +3177,42 @@ uint32_t LoggingManagement::GetBytesWritten(void) const
     return mBytesWritten;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+/**
+ * @brief
+ *   Get the counters comparing the storage taken by the events logged
+ *   since the instantiation of this log with the storage they would
+ *   have taken without the event schema dictionary.
+ *
+ * @param[out] outStats  The storage counters.
+ */
+void LoggingManagement::GetEventStorageStats(EventStorageStats & outStats) const
+{
+    outStats = mStorageStats;
+}
+
+/**
+ * @brief
+ *   The number of events stored per kilobyte of log buffer.
+ */
+uint32_t EventStorageStats::GetEventsPerKB(void) const
+{
+    return (mBytesWritten == 0) ? 0 : static_cast<uint32_t>((static_cast<uint64_t>(mEventsWritten) * 1024) / mBytesWritten);
+}
+
+/**
+ * @brief
+ *   The number of events that would have been stored per kilobyte of
+ *   log buffer in the standard format.
+ */
+uint32_t EventStorageStats::GetUncompressedEventsPerKB(void) const
+{
+    return (mUncompressedBytesWritten == 0)
+        ? 0
+        : static_cast<uint32_t>((static_cast<uint64_t>(mEventsWritten) * 1024) / mUncompressedBytesWritten);
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
 void LoggingManagement::NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID,
                                               uint64_t inRecipientNodeID)
 {
@@ -2055,7 +3224,7 @@ void LoggingManagement::NotifyEventsDelivered(ImportanceType inImportance, event
     event_id_t currentId;
 
     Platform::CriticalSectionEnter();
-    currentId = GetFirstEventID(inImportance);
+    currentId = GetImportanceBuffer(inImportance)->mFirstEventID;
     while (currentId <= inLastDeliveredEventID)
     {
         err = GetExternalEventsFromEventId(inImportance, currentId, &ev, reader);
@@ -2173,6 +3342,9 @@ CircularEventBuffer::CircularEventBuffer(uint8_t * inBuffer, size_t inBufferLeng
     mFirstEventUTCTimestamp(0), mLastEventUTCTimestamp(0), mUTCInitialized(false),
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     mEventIdCounter(NULL)
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    , mBytesAppended(0), mSeekIndexHead(0), mSeekIndexCount(0)
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
 {
     // TODO: hook up the platform-specific persistent event ID.
 }
@@ -2231,6 +3403,135 @@ void CircularEventBuffer::AddEventUTC(utc_timestamp_t inEventTimestamp)
 }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+/**
+ * @brief
+ *   Checks whether the event a checkpoint refers to is still in the buffer.
+ *
+ * @param[in] inCheckpoint A checkpoint previously added to this buffer.
+ *
+ * @retval true  The checkpoint may be used to read from this buffer.
+ * @retval false The event at the checkpoint has been evicted.
+ */
+bool CircularEventBuffer::IsSeekCheckpointValid(const EventSeekCheckpoint & inCheckpoint) const
+{
+    // Number of bytes from the checkpoint to the tail of the buffer;
+    // unsigned arithmetic keeps this correct when mBytesAppended wraps.
+    uint32_t distance = mBytesAppended - inCheckpoint.mOffset;
+
+    return (distance > 0) && (distance <= mBuffer.DataLength());
+}
+
+/**
+ * @brief
+ *   Adds a checkpoint for the event most recently appended to this buffer.
+ *
+ * Checkpoints are kept at least 1/WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+ * of the buffer apart; a checkpoint closer than that to the previous one
+ * is ignored.  Checkpoints for evicted events are discarded, and when the
+ * index is full the oldest checkpoint is replaced.
+ *
+ * @param[in] inCheckpoint The checkpoint, with mOffset set to the value of
+ *                         mBytesAppended before the event was appended.
+ */
+void CircularEventBuffer::AddSeekCheckpoint(const EventSeekCheckpoint & inCheckpoint)
+{
+    const uint32_t spacing = mBuffer.GetQueueSize() / WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE;
+
+    while ((mSeekIndexCount > 0) && !IsSeekCheckpointValid(mSeekIndex[mSeekIndexHead]))
+    {
+        mSeekIndexHead = (mSeekIndexHead + 1) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE;
+        mSeekIndexCount--;
+    }
+
+    if (mSeekIndexCount > 0)
+    {
+        const EventSeekCheckpoint & newest =
+            mSeekIndex[(mSeekIndexHead + mSeekIndexCount - 1) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE];
+
+        if (static_cast<uint32_t>(inCheckpoint.mOffset - newest.mOffset) < spacing)
+        {
+            return;
+        }
+    }
+
+    if (mSeekIndexCount == WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE)
+    {
+        mSeekIndexHead = (mSeekIndexHead + 1) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE;
+        mSeekIndexCount--;
+    }
+
+    mSeekIndex[(mSeekIndexHead + mSeekIndexCount) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE] = inCheckpoint;
+    mSeekIndexCount++;
+}
+
+/**
+ * @brief
+ *   Finds the checkpoint from which to read events starting at a given ID.
+ *
+ * @param[in] inImportance The importance of the events to be read.
+ *
+ * @param[in] inEventID    The ID of the first event to be read.
+ *
+ * @return The newest checkpoint in this buffer that precedes the event, or
+ *         NULL if there is none.
+ */
+const EventSeekCheckpoint * CircularEventBuffer::FindSeekCheckpoint(ImportanceType inImportance, event_id_t inEventID) const
+{
+    const size_t index = inImportance - kImportanceType_First;
+
+    for (size_t i = mSeekIndexCount; i > 0; i--)
+    {
+        const EventSeekCheckpoint & checkpoint = mSeekIndex[(mSeekIndexHead + i - 1) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE];
+
+        // Checkpoints older than an evicted one have been evicted too.
+        if (!IsSeekCheckpointValid(checkpoint))
+        {
+            break;
+        }
+
+        if (checkpoint.mEventID[index] <= inEventID)
+        {
+            return &checkpoint;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief
+ *   Returns the checkpoint at the head event of the buffer, if any.
+ *
+ * @return The checkpoint for the oldest event in the buffer, or NULL if
+ *         that event has no checkpoint.
+ */
+const EventSeekCheckpoint * CircularEventBuffer::GetHeadSeekCheckpoint(void) const
+{
+    for (size_t i = 0; i < mSeekIndexCount; i++)
+    {
+        const EventSeekCheckpoint & checkpoint = mSeekIndex[(mSeekIndexHead + i) % WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE];
+
+        if (IsSeekCheckpointValid(checkpoint))
+        {
+            return (static_cast<uint32_t>(mBytesAppended - checkpoint.mOffset) == mBuffer.DataLength()) ? &checkpoint : NULL;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief
+ *   Discards all seek checkpoints of the buffer.
+ */
+void CircularEventBuffer::ClearSeekIndex(void)
+{
+    mSeekIndexHead  = 0;
+    mSeekIndexCount = 0;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+
 void CircularEventBuffer::RemoveEvent(size_t aNumEvents)
 {
     event_id_t currentFirstEventID = mFirstEventID;
@@ -2264,6 +3565,38 @@ void CircularEventReader::Init(CircularEventBuffer * inBuf)
     }
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+/**
+ * @brief
+ *   Initializes a TLVReader object backed by CircularEventBuffer,
+ *   positioned at a seek checkpoint
+ *
+ * Reading begins at the event marked by the checkpoint and then
+ * continues as for a reader initialized at the head of the buffer.
+ *
+ * @param[in] inBuf        A pointer to a fully initialized CircularEventBuffer
+ *
+ * @param[in] inCheckpoint A valid checkpoint within inBuf
+ *
+ */
+void CircularEventReader::Init(CircularEventBuffer * inBuf, const EventSeekCheckpoint & inCheckpoint)
+{
+    const WeaveCircularTLVBuffer & buffer = inBuf->mBuffer;
+    const size_t queueSize                = buffer.GetQueueSize();
+    const size_t distance                 = static_cast<uint32_t>(inBuf->mBytesAppended - inCheckpoint.mOffset);
+    const uint8_t * tail                  = buffer.QueueTail();
+    const uint8_t * start                 = buffer.GetQueue() + ((tail - buffer.GetQueue()) + queueSize - distance) % queueSize;
+
+    Init(inBuf);
+
+    // Skip the data ahead of the checkpoint; the buffer chain is then
+    // traversed exactly as from the head.
+    mMaxLen -= buffer.DataLength() - distance;
+    mReadPoint = start;
+    mBufEnd    = (tail > start) ? tail : buffer.GetQueue() + queueSize;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+
 WEAVE_ERROR CircularEventBuffer::SerializeEvents(TLVWriter & writer)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2364,6 +3697,12 @@ WEAVE_ERROR CircularEventBuffer::LoadEvents(TLVReader & reader)
     err = reader.GetBytes(mBuffer.GetQueue(), mBuffer.DataLength());
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    // The loaded events were not appended through this buffer; there is
+    // no checkpoint to be had for them.
+    ClearSeekIndex();
+#endif
+
     err = reader.Next(kTLVType_UnsignedInteger, ContextTag(kTag_PersistEvent_FirstEventId));
     SuccessOrExit(err);
     err = reader.Get(mFirstEventID);
@@ -35,11 +35,73 @@
 
 #include <Weave/Support/PersistedCounter.h>
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+#include <Weave/Profiles/data-management/Current/EventSpillStore.h>
+#endif
+
 namespace nl {
 namespace Weave {
 namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+/**
+ * @brief
+ *   A position in a CircularEventBuffer from which events may be read.
+ *
+ * The checkpoint marks the start of an event and records, for each
+ * importance, the ID of the first event of that importance at or after
+ * the mark and the timestamps from which that event's deltas are
+ * computed.  Timestamps of 0 mean no event of that importance had been
+ * logged before the mark.
+ */
+struct EventSeekCheckpoint
+{
+    uint32_t mOffset; ///< The value of CircularEventBuffer::mBytesAppended when the event was appended
+    event_id_t mEventID[kImportanceType_Last - kImportanceType_First + 1];
+    timestamp_t mTimestamp[kImportanceType_Last - kImportanceType_First + 1];
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    utc_timestamp_t mUTCTimestamp[kImportanceType_Last - kImportanceType_First + 1];
+#endif
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+/**
+ * @brief
+ *   An entry of the event schema dictionary.
+ *
+ * Holds the fields that identify the schema and the source of an event,
+ * shared by all stored events that refer to the entry.
+ */
+struct EventSchemaDictionaryEntry
+{
+    uint32_t mProfileId;
+    uint32_t mStructureType;
+    SchemaVersion mDataSchemaVersion;
+    SchemaVersion mMinCompatibleDataSchemaVersion;
+    DetailedRootSection mEventSource;
+    bool mHasEventSource;
+    uint16_t mRefCount;   ///< Number of events in the log that refer to this entry; the entry is free when 0
+    uint16_t mSavedBytes; ///< Bytes saved per event by storing the reference instead of the fields
+};
+
+/**
+ * @brief
+ *   Counters comparing the storage taken by the logged events with the
+ *   storage they would have taken in the standard format.
+ */
+struct EventStorageStats
+{
+    uint32_t mEventsWritten;            ///< Number of events written to the log
+    uint32_t mBytesWritten;             ///< Bytes taken by those events
+    uint32_t mUncompressedBytesWritten; ///< Bytes those events would have taken in the standard format
+
+    uint32_t GetEventsPerKB(void) const;
+    uint32_t GetUncompressedEventsPerKB(void) const;
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
 /**
  * @brief
  *   Internal event buffer, built around the nl::Weave::TLV::WeaveCircularTLVBuffer
@@ -69,6 +131,15 @@ struct CircularEventBuffer
     void AddEventUTC(utc_timestamp_t inEventTimestamp);
 #endif
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    // for doxygen, see the CPP file
+    void AddSeekCheckpoint(const EventSeekCheckpoint & inCheckpoint);
+    const EventSeekCheckpoint * FindSeekCheckpoint(ImportanceType inImportance, event_id_t inEventID) const;
+    const EventSeekCheckpoint * GetHeadSeekCheckpoint(void) const;
+    void ClearSeekIndex(void);
+    bool IsSeekCheckpointValid(const EventSeekCheckpoint & inCheckpoint) const;
+#endif
+
     nl::Weave::TLV::WeaveCircularTLVBuffer mBuffer; ///< The underlying TLV buffer storing the events in a TLV representation
 
     CircularEventBuffer * mPrev; ///< A pointer #CircularEventBuffer storing events less important events
@@ -96,6 +167,13 @@ struct CircularEventBuffer
     // The backup counter to use if no counter is provided for us.
     nl::Weave::MonotonicallyIncreasingCounter mNonPersistedCounter;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    uint32_t mBytesAppended; ///< Running count of bytes appended to mBuffer; positions events independently of evictions
+    EventSeekCheckpoint mSeekIndex[WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE]; ///< Ring of checkpoints, oldest at mSeekIndexHead
+    size_t mSeekIndexHead;
+    size_t mSeekIndexCount;
+#endif
+
     static WEAVE_ERROR GetNextBufferFunct(nl::Weave::TLV::TLVReader & ioReader, uintptr_t & inBufHandle,
                                           const uint8_t *& outBufStart, uint32_t & outBufLen);
 };
@@ -110,6 +188,9 @@ class CircularEventReader : public nl::Weave::TLV::TLVReader
 
 public:
     void Init(CircularEventBuffer * inBuf);
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    void Init(CircularEventBuffer * inBuf, const EventSeekCheckpoint & inCheckpoint);
+#endif
 };
 
 /**
@@ -213,6 +294,13 @@ public:
     event_id_t LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
                         const EventOptions * inOptions);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    WEAVE_ERROR StageEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                           const EventOptions * inOptions);
+
+    size_t DrainStagedEvents(void);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
     WEAVE_ERROR GetEventReader(nl::Weave::TLV::TLVReader & ioReader, ImportanceType inImportance);
 
     WEAVE_ERROR FetchEventsSince(nl::Weave::TLV::TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID);
@@ -223,6 +311,14 @@ public:
 
     uint32_t GetBytesWritten(void) const;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    WEAVE_ERROR SpillEvents(void);
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    void GetEventStorageStats(EventStorageStats & outStats) const;
+#endif
+
     void NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID, uint64_t inRecipientNodeID);
 
     /**
@@ -281,8 +377,56 @@ private:
     static WEAVE_ERROR CopyEvent(const nl::Weave::TLV::TLVReader & aReader, nl::Weave::TLV::TLVWriter & aWriter,
                                  EventLoadOutContext * aContext);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+    void GetSeekCheckpoint(EventSeekCheckpoint & outCheckpoint) const;
+    void SeekEventReader(nl::Weave::TLV::TLVReader & ioReader, EventLoadOutContext & ioContext, ImportanceType inImportance);
+#endif
+
     static void LoggingFlushHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
 
+    static WEAVE_ERROR WriteEventSchemaFields(nl::Weave::TLV::TLVWriter & ioWriter, const EventSchema & inSchema,
+                                             const DetailedRootSection * inEventSource);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    void ClearSchemaDictionary(void);
+    uint8_t FindOrAddSchemaDictionaryEntry(const EventSchema & inSchema, const EventOptions & inOptions);
+    void ReleaseSchemaDictionaryEntry(const nl::Weave::TLV::TLVReader & inEventReader);
+    WEAVE_ERROR ExpandSchemaRef(nl::Weave::TLV::TLVWriter & ioWriter, nl::Weave::TLV::TLVReader & ioReader) const;
+    WEAVE_ERROR SerializeSchemaDictionary(nl::Weave::TLV::TLVWriter & ioWriter) const;
+    WEAVE_ERROR LoadSchemaDictionary(nl::Weave::TLV::TLVReader & ioReader);
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    void InitSpillStore(void);
+    WEAVE_ERROR SpillEventsPrivate(size_t inMaxEvents);
+    WEAVE_ERROR SpillEvent(const nl::Weave::TLV::TLVReader & inEventReader, EventLoadOutContext & ioContext);
+    static WEAVE_ERROR SpillEventsSince(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    /**
+     * @brief
+     *   One slot of the staging queue.  A producer owns the slot once it
+     *   has claimed the matching enqueue position, and hands it to the
+     *   drain by publishing mSequence = position + 1; the drain hands it
+     *   back by setting mSequence = position + queue size.
+     */
+    struct StagedEvent
+    {
+        uint32_t mSequence;
+        EventSchema mSchema;
+        EventOptions mOptions;
+        DetailedRootSection mEventSource;
+        bool mHasEventSource;
+        uint16_t mDataLen;
+        uint8_t mData[WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE];
+    };
+
+    static void StagedEventsDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
+    static WEAVE_ERROR StagedEventWriter(nl::Weave::TLV::TLVWriter & ioWriter, uint8_t inDataTag, void * appData);
+    void InitStagingQueue(void);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
 #if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
     bool CheckShouldRunBDX(void);
 #endif
@@ -308,6 +452,21 @@ private:
     uint32_t mThrottled;
     ImportanceType mMaxImportanceBuffer;
     bool mUploadRequested;
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    EventSchemaDictionaryEntry mSchemaDictionary[WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE];
+    EventStorageStats mStorageStats;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    StagedEvent mStagedEvents[WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE];
+    uint32_t mStagingEnqueuePos;
+    uint32_t mStagingDequeuePos;
+    bool mStagingDrainScheduled;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    EventSpillStore mSpillStore;
+    event_id_t mSpilledEventID[kImportanceType_Last - kImportanceType_First + 1]; ///< ID of the last event spilled, per importance
+    bool mSpillEnabled; ///< False when the spill store could not be recovered, and events are not spilled
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
 };
 
 namespace Platform {
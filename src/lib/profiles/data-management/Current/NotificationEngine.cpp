@@ -77,6 +77,9 @@ exit:
 WEAVE_ERROR NotificationEngine::BasicGraphSolver::SetDirty(TraitDataHandle aDataHandle, PropertyPathHandle aPropertyHandle)
 {
     SubscriptionEngine * subEngine = SubscriptionEngine::GetInstance();
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    System::Timer::Epoch now = System::Timer::GetCurrentEpoch();
+#endif
 
     // Iterate over all subscriptions and their trait instance info lists and mark them dirty as appropriate
     for (int i = 0; i < SubscriptionEngine::kMaxNumSubscriptionHandlers; ++i)
@@ -93,6 +96,13 @@ WEAVE_ERROR NotificationEngine::BasicGraphSolver::SetDirty(TraitDataHandle aData
                 {
                     WeaveLogDetail(DataManagement, "<BSolver:SetD> Set S%u:T%u dirty", i, j);
                     traitInstance[j].SetDirty();
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+                    if (subHandler->mDirtySince == 0)
+                    {
+                        subHandler->mDirtySince = now;
+                    }
+#endif
                 }
             }
         }
@@ -284,6 +294,12 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::SetDirty(TraitDataHandl
     VerifyOrExit(!dataSource->IsRootDirty(), WeaveLogDetail(DataManagement, "<ISolver:SetDirty> Already root dirty!");
                  err = WEAVE_NO_ERROR);
 
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    // Properties outside of dictionaries are tracked in the data source's bitmap. Duplicates collapse onto the same bit and
+    // coalescing into a common ancestor is deferred until the notify is built.
+    VerifyOrExit(!dataSource->SetPropertyDirty(aPropertyHandle), err = WEAVE_NO_ERROR);
+#endif
+
     // if previously present in the delete store, nothing more to be done!
     if (mDirtyStore.IsPresent(TraitPath(aDataHandle, aPropertyHandle)))
     {
@@ -339,45 +355,68 @@ exit:
 }
 
 PropertyPathHandle NotificationEngine::IntermediateGraphSolver::GetNextCandidateHandle(uint32_t & aChangeStoreCursor,
+                                                                                       TraitDataSource * aTargetDataSource,
                                                                                        TraitDataHandle aTargetDataHandle,
                                                                                        bool & aCandidateHandleIsDelete)
 {
-    PropertyPathHandle candidateHandle = kNullPropertyPathHandle;
+    const uint32_t kDirtyBitmapCursorSpan = WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP;
+    PropertyPathHandle candidateHandle    = kNullPropertyPathHandle;
+    uint32_t storeCursor;
+
+    // The cursor spans the dirty bitmap of the data source (if enabled), followed by the dirty store and then the delete store.
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    if (aChangeStoreCursor < WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP)
+    {
+        candidateHandle = aTargetDataSource->GetNextDirtyProperty(aChangeStoreCursor);
+
+        if (candidateHandle != kNullPropertyPathHandle)
+        {
+            aCandidateHandleIsDelete = false;
+            return candidateHandle;
+        }
+    }
+#else
+    IgnoreUnusedVariable(aTargetDataSource);
+#endif
 
-    while (aChangeStoreCursor < mDirtyStore.GetStoreSize())
+    storeCursor = aChangeStoreCursor - kDirtyBitmapCursorSpan;
+
+    while (storeCursor < mDirtyStore.GetStoreSize())
     {
-        TraitPath dirtyPath = mDirtyStore.mStore[aChangeStoreCursor];
+        TraitPath dirtyPath = mDirtyStore.mStore[storeCursor];
 
-        if (mDirtyStore.mValidFlags[aChangeStoreCursor] && (dirtyPath.mTraitDataHandle == aTargetDataHandle))
+        if (mDirtyStore.mValidFlags[storeCursor] && (dirtyPath.mTraitDataHandle == aTargetDataHandle))
         {
             candidateHandle          = dirtyPath.mPropertyPathHandle;
             aCandidateHandleIsDelete = false;
-            aChangeStoreCursor++;
+            storeCursor++;
             break;
         }
 
-        aChangeStoreCursor++;
+        storeCursor++;
     }
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
-    while (aChangeStoreCursor >= mDirtyStore.GetStoreSize() &&
-           aChangeStoreCursor < (mDeleteStore.GetStoreSize() + mDirtyStore.GetStoreSize()))
+    while (candidateHandle == kNullPropertyPathHandle && storeCursor >= mDirtyStore.GetStoreSize() &&
+           storeCursor < (mDeleteStore.GetStoreSize() + mDirtyStore.GetStoreSize()))
     {
-        TraitPath deletePath = mDeleteStore.mStore[aChangeStoreCursor - mDirtyStore.GetStoreSize()];
+        TraitPath deletePath = mDeleteStore.mStore[storeCursor - mDirtyStore.GetStoreSize()];
 
-        if (mDeleteStore.mValidFlags[aChangeStoreCursor - mDirtyStore.GetStoreSize()] &&
+        if (mDeleteStore.mValidFlags[storeCursor - mDirtyStore.GetStoreSize()] &&
             (deletePath.mTraitDataHandle == aTargetDataHandle))
         {
             candidateHandle          = deletePath.mPropertyPathHandle;
             aCandidateHandleIsDelete = true;
-            aChangeStoreCursor++;
+            storeCursor++;
             break;
         }
 
-        aChangeStoreCursor++;
+        storeCursor++;
     }
 #endif // TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
 
+    aChangeStoreCursor = storeCursor + kDirtyBitmapCursorSpan;
+
     return candidateHandle;
 }
 
@@ -468,7 +507,7 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
         //      mergeHandleSet = set of handles that will be merged in relative to the currentCommonHandle. If empty, all children
         //                   under the commonHandle will be included.
         //
-        while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, aTraitDataHandle, candidateHandleIsDelete)) !=
+        while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, dataSource, aTraitDataHandle, candidateHandleIsDelete)) !=
                kNullPropertyPathHandle)
         {
             oldCandidateHandleIsDelete = candidateHandleIsDelete;
@@ -704,6 +743,10 @@ void NotificationEngine::IntermediateGraphSolver::ClearTraitInstanceDirty(void *
 {
     TraitDataSource * dataSource = static_cast<TraitDataSource *>(aDataSource);
     dataSource->ClearRootDirty();
+
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    dataSource->ClearPropertiesDirty();
+#endif
 }
 
 WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::ClearDirty()
@@ -727,6 +770,90 @@ void NotificationEngine::IntermediateGraphSolver::Store::Clear()
     memset(mValidFlags, 0, sizeof(mValidFlags));
 }
 
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// EncodingCache
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool NotificationEngine::EncodingCache::Key::operator==(const Key & aOther) const
+{
+    if (mTraitDataHandle != aOther.mTraitDataHandle || mPropertyPathHandle != aOther.mPropertyPathHandle ||
+        mSchemaVersion != aOther.mSchemaVersion || mDataVersion != aOther.mDataVersion ||
+        mNumMergeHandles != aOther.mNumMergeHandles || mNumDeleteHandles != aOther.mNumDeleteHandles)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < mNumMergeHandles; i++)
+    {
+        if (mMergeHandleSet[i] != aOther.mMergeHandleSet[i])
+        {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < mNumDeleteHandles; i++)
+    {
+        if (mDeleteHandleSet[i] != aOther.mDeleteHandleSet[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+NotificationEngine::EncodingCache::EncodingCache()
+{
+    mNumHits    = 0;
+    mNumLookups = 0;
+
+    Clear();
+}
+
+void NotificationEngine::EncodingCache::Clear()
+{
+    mNumEntries = 0;
+    mBufferUsed = 0;
+}
+
+const uint8_t * NotificationEngine::EncodingCache::Find(const Key & aKey, uint32_t & aLength)
+{
+    mNumLookups++;
+
+    for (size_t i = 0; i < mNumEntries; i++)
+    {
+        if (mEntries[i].mKey == aKey)
+        {
+            mNumHits++;
+            aLength = mEntries[i].mLength;
+            return mBuffer + mEntries[i].mOffset;
+        }
+    }
+
+    return NULL;
+}
+
+uint8_t * NotificationEngine::EncodingCache::GetFreeSpace(uint32_t & aLength)
+{
+    // With no entries left, there is no room for another encoding regardless of the space left in the buffer.
+    aLength = (mNumEntries < WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES) ? sizeof(mBuffer) - mBufferUsed : 0;
+
+    return mBuffer + mBufferUsed;
+}
+
+void NotificationEngine::EncodingCache::Commit(const Key & aKey, uint32_t aLength)
+{
+    VerifyOrDie(mNumEntries < WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES && aLength <= sizeof(mBuffer) - mBufferUsed);
+
+    mEntries[mNumEntries].mKey    = aKey;
+    mEntries[mNumEntries].mOffset = static_cast<uint16_t>(mBufferUsed);
+    mEntries[mNumEntries].mLength = static_cast<uint16_t>(aLength);
+
+    mNumEntries++;
+    mBufferUsed += aLength;
+}
+#endif // WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // NotifyRequestBuilder
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -745,6 +872,10 @@ WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::Init(PacketBuffer * aBuf,
     mSub            = aSubHandler;
     mMaxPayloadSize = aMaxPayloadSize;
 
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    mEncodingCache = NULL;
+#endif
+
 exit:
 
     return err;
@@ -859,62 +990,160 @@ NotificationEngine::NotifyRequestBuilder::WriteDataElement(TraitDataHandle aTrai
                                                            uint32_t aNumDeleteHandles)
 {
     WEAVE_ERROR err;
-    TLVType dummyContainerType;
     TraitDataSource * dataSource;
-    bool retrievingData = false;
-    SchemaVersionRange versionRange;
 
     VerifyOrExit(mState == kNotifyRequestBuilder_BuildDataList, err = WEAVE_ERROR_INCORRECT_STATE);
 
-    err = mWriter->StartContainer(AnonymousTag, kTLVType_Structure, dummyContainerType);
+    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitDataHandle, &dataSource);
     SuccessOrExit(err);
 
-    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitDataHandle, &dataSource);
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    if (aNumMergeDataHandles == 0 && aNumDeleteHandles == 0)
+    {
+        uint32_t dataSize;
+
+        // If the data alone is known not to fit in the remaining space, fail before encoding any of the element so that the
+        // caller can roll back and move it to the next notify request without retrieving the data in full. Only a size left
+        // behind by an earlier encoding at this version is consulted; measuring a cold size would retrieve the data twice, so
+        // in that case the element is encoded directly and rolled back by the caller if it overflows.
+        if (dataSource->GetCachedEncodedSize(aPropertyPathHandle, ContextTag(DataElement::kCsTag_Data), dataSize))
+        {
+            VerifyOrExit(dataSize < mWriter->GetRemainingLength(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+        }
+    }
+#endif // WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    if (mEncodingCache != NULL && aNumMergeDataHandles <= WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET &&
+        aNumDeleteHandles <= WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET)
+    {
+        EncodingCache::Key key;
+        const uint8_t * encoding;
+        uint32_t encodingLen;
+
+        memset(&key, 0, sizeof(key));
+        key.mTraitDataHandle    = aTraitDataHandle;
+        key.mPropertyPathHandle = aPropertyPathHandle;
+        key.mSchemaVersion      = aSchemaVersion;
+        key.mDataVersion        = dataSource->GetVersion();
+        key.mNumMergeHandles    = static_cast<uint8_t>(aNumMergeDataHandles);
+        key.mNumDeleteHandles   = static_cast<uint8_t>(aNumDeleteHandles);
+
+        for (size_t i = 0; i < aNumMergeDataHandles; i++)
+        {
+            key.mMergeHandleSet[i] = aMergeDataHandleSet[i];
+        }
+
+        for (size_t i = 0; i < aNumDeleteHandles; i++)
+        {
+            key.mDeleteHandleSet[i] = aDeleteHandleSet[i];
+        }
+
+        encoding = mEncodingCache->Find(key, encodingLen);
+
+        if (encoding == NULL)
+        {
+            uint8_t * cacheSpace = mEncodingCache->GetFreeSpace(encodingLen);
+
+            // Only encode into the cache if it has at least as much free space as is left in the request. Anything that fits in
+            // the request then fits in the cache, so a failure here means the element would not have fit in the request either
+            // and the data is never retrieved twice. Otherwise, encode the element straight into the request.
+            if (encodingLen >= mWriter->GetRemainingLength())
+            {
+                TLVWriter cacheWriter;
+
+                cacheWriter.Init(cacheSpace, encodingLen);
+                cacheWriter.ImplicitProfileId = mWriter->ImplicitProfileId;
+
+                err = EncodeDataElement(cacheWriter, dataSource, aTraitDataHandle, aPropertyPathHandle, aSchemaVersion,
+                                        aMergeDataHandleSet, aNumMergeDataHandles, aDeleteHandleSet, aNumDeleteHandles);
+                SuccessOrExit(err);
+
+                err = cacheWriter.Finalize();
+                SuccessOrExit(err);
+
+                encoding    = cacheSpace;
+                encodingLen = cacheWriter.GetLengthWritten();
+                mEncodingCache->Commit(key, encodingLen);
+            }
+        }
+
+        if (encoding != NULL)
+        {
+            err = mWriter->CopyContainer(AnonymousTag, encoding, static_cast<uint16_t>(encodingLen));
+            ExitNow();
+        }
+    }
+#endif // WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+
+    err = EncodeDataElement(*mWriter, dataSource, aTraitDataHandle, aPropertyPathHandle, aSchemaVersion, aMergeDataHandleSet,
+                            aNumMergeDataHandles, aDeleteHandleSet, aNumDeleteHandles);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::EncodeDataElement(TLVWriter & aWriter, TraitDataSource * aDataSource,
+                                                                         TraitDataHandle aTraitDataHandle,
+                                                                         PropertyPathHandle aPropertyPathHandle,
+                                                                         SchemaVersion aSchemaVersion,
+                                                                         PropertyPathHandle * aMergeDataHandleSet,
+                                                                         uint32_t aNumMergeDataHandles,
+                                                                         PropertyPathHandle * aDeleteHandleSet,
+                                                                         uint32_t aNumDeleteHandles)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainerType;
+    TLVType dummyContainerType;
+    bool retrievingData = false;
+    SchemaVersionRange versionRange;
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
     SuccessOrExit(err);
 
     versionRange.mMaxVersion = aSchemaVersion;
-    versionRange.mMinVersion = dataSource->GetSchemaEngine()->GetLowestCompatibleVersion(versionRange.mMaxVersion);
+    versionRange.mMinVersion = aDataSource->GetSchemaEngine()->GetLowestCompatibleVersion(versionRange.mMaxVersion);
 
-    err = mWriter->StartContainer(ContextTag(DataElement::kCsTag_Path), kTLVType_Path, dummyContainerType);
+    err = aWriter.StartContainer(ContextTag(DataElement::kCsTag_Path), kTLVType_Path, dummyContainerType);
     SuccessOrExit(err);
 
-    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->HandleToAddress(aTraitDataHandle, *mWriter, versionRange);
+    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->HandleToAddress(aTraitDataHandle, aWriter, versionRange);
     SuccessOrExit(err);
 
-    err = dataSource->GetSchemaEngine()->MapHandleToPath(aPropertyPathHandle, *mWriter);
+    err = aDataSource->GetSchemaEngine()->MapHandleToPath(aPropertyPathHandle, aWriter);
     SuccessOrExit(err);
 
-    err = mWriter->EndContainer(dummyContainerType);
+    err = aWriter.EndContainer(dummyContainerType);
     SuccessOrExit(err);
 
-    err = mWriter->Put(ContextTag(DataElement::kCsTag_Version), dataSource->GetVersion());
+    err = aWriter.Put(ContextTag(DataElement::kCsTag_Version), aDataSource->GetVersion());
     SuccessOrExit(err);
 
     if (aNumMergeDataHandles > 0 || aNumDeleteHandles > 0)
     {
-        const TraitSchemaEngine * schemaEngine = dataSource->GetSchemaEngine();
+        const TraitSchemaEngine * schemaEngine = aDataSource->GetSchemaEngine();
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
         if (aNumDeleteHandles > 0)
         {
             err =
-                mWriter->StartContainer(ContextTag(DataElement::kCsTag_DeletedDictionaryKeys), kTLVType_Array, dummyContainerType);
+                aWriter.StartContainer(ContextTag(DataElement::kCsTag_DeletedDictionaryKeys), kTLVType_Array, dummyContainerType);
             SuccessOrExit(err);
 
             for (size_t i = 0; i < aNumDeleteHandles; i++)
             {
-                err = mWriter->Put(AnonymousTag, GetPropertyDictionaryKey(aDeleteHandleSet[i]));
+                err = aWriter.Put(AnonymousTag, GetPropertyDictionaryKey(aDeleteHandleSet[i]));
                 SuccessOrExit(err);
             }
 
-            err = mWriter->EndContainer(dummyContainerType);
+            err = aWriter.EndContainer(dummyContainerType);
             SuccessOrExit(err);
         }
 #endif // TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
 
         if (aNumMergeDataHandles > 0)
         {
-            err = mWriter->StartContainer(ContextTag(DataElement::kCsTag_Data), kTLVType_Structure, dummyContainerType);
+            err = aWriter.StartContainer(ContextTag(DataElement::kCsTag_Data), kTLVType_Structure, dummyContainerType);
             SuccessOrExit(err);
 
             retrievingData = true;
@@ -923,13 +1152,13 @@ NotificationEngine::NotifyRequestBuilder::WriteDataElement(TraitDataHandle aTrai
             {
                 WeaveLogDetail(DataManagement, "<NE::WriteDE> Merging in 0x%08x", aMergeDataHandleSet[i]);
 
-                err = dataSource->ReadData(aMergeDataHandleSet[i], schemaEngine->GetTag(aMergeDataHandleSet[i]), *mWriter);
+                err = aDataSource->ReadData(aMergeDataHandleSet[i], schemaEngine->GetTag(aMergeDataHandleSet[i]), aWriter);
                 SuccessOrExit(err);
             }
 
             retrievingData = false;
 
-            err = mWriter->EndContainer(dummyContainerType);
+            err = aWriter.EndContainer(dummyContainerType);
             SuccessOrExit(err);
         }
     }
@@ -937,20 +1166,20 @@ NotificationEngine::NotifyRequestBuilder::WriteDataElement(TraitDataHandle aTrai
     {
         retrievingData = true;
 
-        err = dataSource->ReadData(aPropertyPathHandle, ContextTag(DataElement::kCsTag_Data), *mWriter);
+        err = aDataSource->ReadData(aPropertyPathHandle, ContextTag(DataElement::kCsTag_Data), aWriter);
         SuccessOrExit(err);
 
         retrievingData = false;
     }
 
-    err = mWriter->EndContainer(kTLVType_Array);
+    err = aWriter.EndContainer(outerContainerType);
     SuccessOrExit(err);
 
 exit:
     if (retrievingData && err != WEAVE_NO_ERROR)
     {
         WeaveLogError(DataManagement, "Error retrieving data from trait (instanceHandle: %u, profileId: %08x), err = %d",
-                      aTraitDataHandle, dataSource->GetSchemaEngine()->GetProfileId(), err);
+                      aTraitDataHandle, aDataSource->GetSchemaEngine()->GetProfileId(), err);
     }
 
     return err;
@@ -1034,6 +1263,22 @@ WEAVE_ERROR NotificationEngine::Init()
     mCurTraitInstanceIdx       = 0;
     mNumNotifiesInFlight       = 0;
 
+    mNumNotifiesSentThisRun = 0;
+    mMaxNotifiesPerRun      = WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN;
+#if WDM_PUBLISHER_MAX_RUN_TIME_MS
+    mRunStart = 0;
+#endif
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    memset(mNotifyLatencyHistogram, 0, sizeof(mNotifyLatencyHistogram));
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    mEncodingCache.mNumHits    = 0;
+    mEncodingCache.mNumLookups = 0;
+    mEncodingCache.Clear();
+#endif
+
     return WEAVE_NO_ERROR;
 }
 
@@ -1128,6 +1373,8 @@ WEAVE_ERROR NotificationEngine::SendNotify(PacketBuffer * aBuffer, SubscriptionH
     err = aSubHandler->SendNotificationRequest(aBuffer);
     SuccessOrExit(err);
 
+    mNumNotifiesSentThisRun++;
+
 exit:
     if (err != WEAVE_NO_ERROR)
     {
@@ -1455,6 +1702,14 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
 
         aSubHandler->mCurProcessingTraitInstanceIdx++;
         traitInfo++;
+
+        // Send what has been written so far rather than finishing the subscription once the run is out of budget; the
+        // remaining trait instances are picked up by a later run.
+        if (aNeWriteInProgress && IsRunBudgetSpent())
+        {
+            WeaveLogDetail(DataManagement, "<NE:Run> Run budget spent, cutting notify short");
+            break;
+        }
     }
 
     // Only do this if our sub handler is still valid at this point (which it may not be)
@@ -1547,6 +1802,11 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * a
     err = notifyRequest.Init(buf, &writer, aSubHandler, maxPayloadSize);
     SuccessOrExit(err);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    // Share data elements with the other subscriptions evaluated in this run.
+    notifyRequest.SetEncodingCache(&mEncodingCache);
+#endif
+
     // Fill in the DataList.  Allocation may take place
     subClean = true;
 
@@ -1584,6 +1844,10 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * a
         // NULL out the buf since we've handed it over to the message layer
         buf = NULL;
         VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogError(DataManagement, "<NE:Run> Error sending out notify!"));
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+        RecordNotifyLatency(aSubHandler);
+#endif
     }
 
 exit:
@@ -1721,24 +1985,126 @@ void NotificationEngine::ScheduleRun()
     SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->ScheduleWork(Run, this);
 }
 
+void NotificationEngine::PrioritizeSubscriptionNearestLivenessTimeout()
+{
+    SubscriptionEngine * subEngine = SubscriptionEngine::GetInstance();
+    System::Timer::Epoch earliestDeadline = 0;
+
+    // Start the run at the notifiable subscription with pending changes that is closest to timing out. The remaining
+    // subscriptions are still visited in round-robin order after it.
+    for (uint32_t i = 0; i < SubscriptionEngine::kMaxNumSubscriptionHandlers; i++)
+    {
+        SubscriptionHandler * subHandler                   = subEngine->mHandlers + i;
+        SubscriptionHandler::TraitInstanceInfo * traitInfo = subHandler->GetTraitInstanceInfoList();
+        bool isDirty                                       = false;
+
+        if (!subHandler->IsNotifiable() || subHandler->mLivenessDeadline == 0 ||
+            (earliestDeadline != 0 && subHandler->mLivenessDeadline >= earliestDeadline))
+        {
+            continue;
+        }
+
+        for (size_t j = 0; j < subHandler->GetNumTraitInstances() && !isDirty; j++)
+        {
+            isDirty = traitInfo[j].IsDirty();
+        }
+
+        if (isDirty)
+        {
+            earliestDeadline           = subHandler->mLivenessDeadline;
+            mCurSubscriptionHandlerIdx = i;
+        }
+    }
+}
+
+bool NotificationEngine::IsRunBudgetSpent() const
+{
+    if (mMaxNotifiesPerRun != 0 && mNumNotifiesSentThisRun >= mMaxNotifiesPerRun)
+    {
+        return true;
+    }
+
+#if WDM_PUBLISHER_MAX_RUN_TIME_MS
+    if (System::Timer::GetCurrentEpoch() - mRunStart >= WDM_PUBLISHER_MAX_RUN_TIME_MS)
+    {
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+void NotificationEngine::RecordNotifyLatency(SubscriptionHandler * aSubHandler)
+{
+    System::Timer::Epoch latency;
+    uint32_t bucket = 0;
+
+    // Notifies sent while establishing the subscription aren't the result of a change.
+    VerifyOrExit(aSubHandler->mDirtySince != 0, );
+
+    latency = System::Timer::GetCurrentEpoch() - aSubHandler->mDirtySince;
+
+    while (latency != 0 && bucket < kNumNotifyLatencyBuckets - 1)
+    {
+        latency >>= 1;
+        bucket++;
+    }
+
+    mNotifyLatencyHistogram[bucket]++;
+
+    // If changes were left behind for a later notify, they have been pending since the same point in time. Otherwise the notify
+    // has caught up: the data list wrapped back to the first trait instance and no event upload is underway.
+    if (aSubHandler->mCurProcessingTraitInstanceIdx == 0
+#if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+        && aSubHandler->mCurrentImportance == kImportanceType_Invalid
+#endif
+    )
+    {
+        aSubHandler->mDirtySince = 0;
+    }
+
+exit:
+    return;
+}
+#endif // WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+
 void NotificationEngine::Run()
 {
     WEAVE_ERROR err                  = WEAVE_NO_ERROR;
     uint32_t numSubscriptionsHandled = 0;
     SubscriptionEngine * subEngine   = SubscriptionEngine::GetInstance();
-    SubscriptionHandler * subHandler = subEngine->mHandlers + mCurSubscriptionHandlerIdx;
+    SubscriptionHandler * subHandler;
     bool subscriptionHandled, isSubscriptionClean;
     bool isClean  = true;
     bool isLocked = false;
 
+    mNumNotifiesSentThisRun = 0;
+#if WDM_PUBLISHER_MAX_RUN_TIME_MS
+    mRunStart = System::Timer::GetCurrentEpoch();
+#endif
+
     // Lock before attempting to modify any of the shared data structures.
     err = subEngine->Lock();
     SuccessOrExit(err);
 
     isLocked = true;
 
+    if (mMaxNotifiesPerRun != 0 || WDM_PUBLISHER_MAX_RUN_TIME_MS != 0)
+    {
+        PrioritizeSubscriptionNearestLivenessTimeout();
+    }
+
+    subHandler = subEngine->mHandlers + mCurSubscriptionHandlerIdx;
+
     WeaveLogDetail(DataManagement, "<NE:Run> NotifiesInFlight = %u", mNumNotifiesInFlight);
 
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    // Encodings are only shared within a single run; data may change, and trait data handles may be reused by another
+    // data source, once the lock is released.
+    mEncodingCache.Clear();
+#endif
+
     while ((mNumNotifiesInFlight < WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT) &&
            (numSubscriptionsHandled < SubscriptionEngine::kMaxNumSubscriptionHandlers))
     {
@@ -1778,6 +2144,13 @@ void NotificationEngine::Run()
 
         mCurSubscriptionHandlerIdx = (mCurSubscriptionHandlerIdx + 1) % SubscriptionEngine::kMaxNumSubscriptionHandlers;
         subHandler                 = subEngine->mHandlers + mCurSubscriptionHandlerIdx;
+
+        if (IsRunBudgetSpent())
+        {
+            WeaveLogDetail(DataManagement, "<NE:Run> Run budget spent, yielding");
+            ScheduleRun();
+            break;
+        }
     }
 
     subHandler = subEngine->mHandlers;
@@ -141,6 +141,91 @@ public:
     WEAVE_ERROR SendSubscriptionlessNotification(Binding * const apBinding, TraitPath *aPathList, uint16_t aPathListSize);
 #endif // WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
 
+    /**
+     * Sets the maximum number of notifies sent out in a single invocation of the run loop, overriding the default of
+     * #WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN.
+     *
+     * @param[in] aMaxNotifiesPerRun  The number of notifies after which the engine yields, or 0 to not limit it.
+     */
+    void SetMaxNotifiesPerRun(uint32_t aMaxNotifiesPerRun) { mMaxNotifiesPerRun = aMaxNotifiesPerRun; }
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    enum
+    {
+        kNumNotifyLatencyBuckets = 16
+    };
+
+    /**
+     * Retrieves the histogram of latencies between a subscription being marked dirty and a notify being sent to it, accumulated
+     * since the engine was initialized. Bucket 0 counts notifies sent within 1 ms, bucket i counts latencies in [2^(i-1), 2^i) ms
+     * and the last bucket counts all latencies beyond that.
+     *
+     * @return An array of kNumNotifyLatencyBuckets counters.
+     */
+    const uint32_t * GetNotifyLatencyHistogram(void) const { return mNotifyLatencyHistogram; }
+#endif
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    /**
+     * Retrieves the statistics of the notify encoding cache, accumulated since the engine was initialized.
+     *
+     * @param[out] aNumHits     The number of data elements copied out of the cache.
+     * @param[out] aNumLookups  The number of data elements looked up in the cache.
+     */
+    void GetEncodingCacheStats(uint32_t & aNumHits, uint32_t & aNumLookups) const
+    {
+        aNumHits    = mEncodingCache.mNumHits;
+        aNumLookups = mEncodingCache.mNumLookups;
+    }
+
+    /**
+     *  @class EncodingCache
+     *
+     *  @brief Holds data elements encoded during a single run of the engine so that subscribers to the same trait instance can
+     *         share a single encoding of the same data. Entries are keyed on everything that goes into the encoding of the
+     *         element, and the cache is emptied at the start of every run.
+     */
+    class EncodingCache
+    {
+    public:
+        struct Key
+        {
+            TraitDataHandle mTraitDataHandle;
+            PropertyPathHandle mPropertyPathHandle;
+            SchemaVersion mSchemaVersion;
+            uint64_t mDataVersion;
+            PropertyPathHandle mMergeHandleSet[WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET];
+            PropertyPathHandle mDeleteHandleSet[WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET];
+            uint8_t mNumMergeHandles;
+            uint8_t mNumDeleteHandles;
+
+            bool operator==(const Key & aOther) const;
+        };
+
+        EncodingCache();
+        void Clear(void);
+        const uint8_t * Find(const Key & aKey, uint32_t & aLength);
+        uint8_t * GetFreeSpace(uint32_t & aLength);
+        void Commit(const Key & aKey, uint32_t aLength);
+
+        uint32_t mNumHits;
+        uint32_t mNumLookups;
+
+    private:
+        struct Entry
+        {
+            Key mKey;
+            uint16_t mOffset;
+            uint16_t mLength;
+        };
+
+        Entry mEntries[WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_MAX_ENTRIES];
+        uint8_t mBuffer[WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE];
+        uint32_t mNumEntries;
+        uint32_t mBufferUsed;
+    };
+#endif // WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+
     enum NotifyRequestBuilderState
     {
         kNotifyRequestBuilder_Idle = 0,      ///< The request has not been opened or has been closed and finalized
@@ -256,6 +341,16 @@ public:
 
         TLV::TLVWriter * GetWriter(void) { return mWriter; }
 
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+        /**
+         * Share data elements written by this builder through the given encoding cache. Data elements already present in the
+         * cache are copied into the request rather than being encoded again.
+         *
+         * @param[in] aCache  The cache to use, or NULL to always encode data elements directly.
+         */
+        void SetEncodingCache(EncodingCache * aCache) { mEncodingCache = aCache; }
+#endif
+
         /**
          * The main state transition function. The function takes the desired state (i.e., the phase of the notify request builder
          * that we would like to reach), and transitions the request into that state. If the desired state is the same as the
@@ -275,11 +370,19 @@ public:
         WEAVE_ERROR MoveToState(NotifyRequestBuilderState aDesiredState);
 
     private:
+        WEAVE_ERROR EncodeDataElement(TLV::TLVWriter & aWriter, TraitDataSource * aDataSource, TraitDataHandle aTraitDataHandle,
+                                      PropertyPathHandle aPropertyPathHandle, SchemaVersion aSchemaVersion,
+                                      PropertyPathHandle * aMergeDataHandleSet, uint32_t aNumMergeDataHandles,
+                                      PropertyPathHandle * aDeleteHandleSet, uint32_t aNumDeleteHandles);
+
         TLV::TLVWriter * mWriter;
         NotifyRequestBuilderState mState;
         PacketBuffer * mBuf;
         SubscriptionHandler * mSub;
         uint32_t mMaxPayloadSize;
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+        EncodingCache * mEncodingCache;
+#endif
     };
 
     /*
@@ -330,6 +433,9 @@ public:
      *         of WDM to only include child trees of that LCA that contain dirty elements. This is pretty efficient given the
      *         reasonably flat, shallow structure of our IDLs.
      *
+     *         If WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP is non-zero, properties outside of dictionaries are instead
+     *         tracked in a per trait instance bitmap indexed by schema handle, leaving the granular store for dictionary elements.
+     *
      *         If it is unable to store anymore dirty items in the granular store, it will degrade to marking the entire trait
      *         instance as dirty. In addition, if it runs out of space in the merge handle set, it will degrade to including all
      *         child trees of the LCA'ed node.
@@ -369,8 +475,8 @@ public:
 
     private:
         static void ClearTraitInstanceDirty(void * aDataSource, TraitDataHandle aDataHandle, void * aContext);
-        PropertyPathHandle GetNextCandidateHandle(uint32_t & aChangeStoreCursor, TraitDataHandle aTargetDataHandle,
-                                                  bool & aCandidateHandleIsDelete);
+        PropertyPathHandle GetNextCandidateHandle(uint32_t & aChangeStoreCursor, TraitDataSource * aTargetDataSource,
+                                                  TraitDataHandle aTargetDataHandle, bool & aCandidateHandleIsDelete);
 
         Store mDirtyStore;
 
@@ -409,6 +515,13 @@ private:
 
     static void Run(System::Layer * aSystemLayer, void * aAppState, System::Error);
 
+    void PrioritizeSubscriptionNearestLivenessTimeout(void);
+    bool IsRunBudgetSpent(void) const;
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    void RecordNotifyLatency(SubscriptionHandler * aSubHandler);
+#endif
+
 #if WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
     WEAVE_ERROR BuildSubscriptionlessNotification(PacketBuffer *msgBuf, uint32_t maxPayloadSize, TraitPath *aPathList,
                                                   uint16_t aPathListSize);
@@ -416,8 +529,19 @@ private:
     uint32_t mCurSubscriptionHandlerIdx;
     uint32_t mCurTraitInstanceIdx;
     uint32_t mNumNotifiesInFlight;
+    uint32_t mNumNotifiesSentThisRun;
+    uint32_t mMaxNotifiesPerRun;
+#if WDM_PUBLISHER_MAX_RUN_TIME_MS
+    System::Timer::Epoch mRunStart;
+#endif
     nl::Weave::TLV::TLVType mOuterContainerType;
     WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER mGraphSolver;
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    uint32_t mNotifyLatencyHistogram[kNumNotifyLatencyBuckets];
+#endif
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    EncodingCache mEncodingCache;
+#endif
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
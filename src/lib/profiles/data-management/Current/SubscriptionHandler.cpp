@@ -60,6 +60,10 @@ void SubscriptionHandler::InitAsFree()
     mCurrentState                  = kState_Free;
     mEC                            = NULL;
     mLivenessTimeoutMsec           = kNoTimeout;
+    mLivenessDeadline              = 0;
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    mDirtySince                    = 0;
+#endif
     mPeerNodeId                    = 0;
     mSubscriptionId                = 0;
     mBinding                       = NULL;
@@ -1312,6 +1316,7 @@ WEAVE_ERROR SubscriptionHandler::RefreshTimer(void)
 
     // Cancel timer first
     SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->CancelTimer(OnTimerCallback, this);
+    mLivenessDeadline = 0;
 
     // Arm timer according to current state
     switch (mCurrentState)
@@ -1333,6 +1338,8 @@ WEAVE_ERROR SubscriptionHandler::RefreshTimer(void)
                 mLivenessTimeoutMsec, OnTimerCallback, this);
 
             VerifyOrExit(WEAVE_SYSTEM_NO_ERROR == err, /* no-op */);
+
+            mLivenessDeadline = System::Timer::GetCurrentEpoch() + mLivenessTimeoutMsec;
         }
         break;
     case kState_Terminated:
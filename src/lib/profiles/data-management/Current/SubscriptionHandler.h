@@ -241,6 +241,10 @@ private:
     int8_t mRefCount;
     nl::Weave::ExchangeContext * mEC;
     uint32_t mLivenessTimeoutMsec;
+    System::Timer::Epoch mLivenessDeadline; // when the liveness timer fires, or 0 if it isn't armed
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    System::Timer::Epoch mDirtySince; // when this subscription last went from clean to dirty, or 0 if it is clean
+#endif
     uint64_t mPeerNodeId;
     uint64_t mSubscriptionId;
     Binding * mBinding;
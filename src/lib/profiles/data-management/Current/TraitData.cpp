@@ -40,6 +40,9 @@
 #if WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
 #include <string>
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
+#if TDM_SCHEMA_INDEX_SUPPORT
+#include <string.h>
+#endif // TDM_SCHEMA_INDEX_SUPPORT
 
 using namespace ::nl::Weave;
 using namespace ::nl::Weave::TLV;
@@ -48,6 +51,13 @@ using namespace ::nl::Weave::Profiles::Common;
 using namespace ::nl::Weave::Profiles::DataManagement;
 using namespace ::nl::Weave::Profiles::DataManagement_Current;
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+// Schema tree indices are built on first use and live for as long as their (static) schema tables, so the entries are carved
+// sequentially out of a single pool and never returned to it.
+static TraitSchemaEngine::PropertyIndexEntry sSchemaIndexPool[TDM_SCHEMA_INDEX_POOL_SIZE];
+static uint32_t sSchemaIndexPoolUsed;
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
 UpdateDirtyPathFilter::UpdateDirtyPathFilter(SubscriptionClient * apSubClient, TraitDataHandle traitDataHandle,
                                              const TraitSchemaEngine * aEngine)
 {
@@ -396,6 +406,31 @@ exit:
     return err;
 }
 
+WEAVE_ERROR TraitSchemaEngine::GetEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, IGetDataDelegate * aDelegate,
+                                              uint32_t & aEncodedSize) const
+{
+    WEAVE_ERROR err;
+    TLVSizer sizer;
+    TLVType outerType;
+    uint32_t startLen;
+
+    sizer.Init();
+
+    // A context tag is only valid inside a structure, so measure the data inside an anonymous one.
+    err = sizer.StartContainer(AnonymousTag, kTLVType_Structure, outerType);
+    SuccessOrExit(err);
+
+    startLen = sizer.GetLengthWritten();
+
+    err = RetrieveData(aHandle, aTagToWrite, sizer, aDelegate);
+    SuccessOrExit(err);
+
+    aEncodedSize = sizer.GetLengthWritten() - startLen;
+
+exit:
+    return err;
+}
+
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
 WEAVE_ERROR TraitSchemaEngine::RetrieveUpdatableDictionaryData(PropertyPathHandle aHandle, uint64_t aTagToWrite,
                                                                TLVWriter & aWriter, IGetDataDelegate * aDelegate,
@@ -690,6 +725,26 @@ bool TraitSchemaEngine::IsParent(PropertyPathHandle aChildHandle, PropertyPathHa
 
     VerifyOrExit(aChildHandle != kNullPropertyPathHandle && aParentHandle != kNullPropertyPathHandle, );
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+    if (GetIndex() != NULL)
+    {
+        int32_t childDepth  = GetDepth(aChildHandle);
+        int32_t parentDepth = GetDepth(aParentHandle);
+
+        // Every step up the tree reduces the depth by one, so the parent can only be reached after exactly as many steps as
+        // the two handles are apart in depth. Walking those steps, rather than comparing schema handles alone, keeps the
+        // dictionary keys of the two handles significant.
+        VerifyOrExit(childDepth >= 0 && parentDepth >= 0 && childDepth > parentDepth, );
+
+        for (; childDepth > parentDepth; childDepth--)
+        {
+            aChildHandle = GetParent(aChildHandle);
+        }
+
+        ExitNow(retval = (aChildHandle == aParentHandle));
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
     do
     {
         aChildHandle = GetParent(aChildHandle);
@@ -740,6 +795,37 @@ PropertyPathHandle TraitSchemaEngine::GetNextChild(PropertyPathHandle aParentHan
     PropertySchemaHandle childSchemaHandle    = GetPropertySchemaHandle(aChildHandle);
     PropertyDictionaryKey parentDictionaryKey = GetPropertyDictionaryKey(aParentHandle);
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+    const PropertyIndexEntry * index = GetIndex();
+
+    if (index != NULL && parentSchemaHandle >= kRootPropertyPathHandle &&
+        parentSchemaHandle < (mSchema.mNumSchemaHandleEntries + kHandleTableOffset))
+    {
+        PropertySchemaHandle nextSchemaHandle = kNullPropertyPathHandle;
+        bool found                            = false;
+
+        if (childSchemaHandle == kRootPropertyPathHandle)
+        {
+            nextSchemaHandle = index[parentSchemaHandle - kRootPropertyPathHandle].mFirstChild;
+            found            = true;
+        }
+        else if (childSchemaHandle >= kHandleTableOffset &&
+                 childSchemaHandle < (mSchema.mNumSchemaHandleEntries + kHandleTableOffset) &&
+                 mSchema.mSchemaHandleTbl[childSchemaHandle - kHandleTableOffset].mParentHandle == parentSchemaHandle)
+        {
+            nextSchemaHandle = index[childSchemaHandle - kRootPropertyPathHandle].mNextSibling;
+            found            = true;
+        }
+
+        // A child that does not belong to the parent leaves no sibling to follow, so that case falls through to the scan below.
+        if (found)
+        {
+            return (nextSchemaHandle == kNullPropertyPathHandle) ? kNullPropertyPathHandle
+                                                                  : CreatePropertyPathHandle(nextSchemaHandle, parentDictionaryKey);
+        }
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
     // Starting from 1 node after the child node that's been passed in, iterate till we find the next child belonging to aParentId.
     for (i = (childSchemaHandle - 1); i < mSchema.mNumSchemaHandleEntries; i++)
     {
@@ -805,6 +891,16 @@ bool TraitSchemaEngine::IsLeaf(PropertyPathHandle aHandle) const
     }
     else
     {
+#if TDM_SCHEMA_INDEX_SUPPORT
+        const PropertyIndexEntry * index = GetIndex();
+
+        if (index != NULL && schemaHandle >= kHandleTableOffset &&
+            schemaHandle < (mSchema.mNumSchemaHandleEntries + kHandleTableOffset))
+        {
+            return index[schemaHandle - kRootPropertyPathHandle].mFirstChild == kNullPropertyPathHandle;
+        }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
         for (unsigned int i = 0; i < mSchema.mNumSchemaHandleEntries; i++)
         {
             if (mSchema.mSchemaHandleTbl[i].mParentHandle == schemaHandle)
@@ -827,6 +923,17 @@ int32_t TraitSchemaEngine::GetDepth(PropertyPathHandle aHandle) const
         return -1;
     }
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+    {
+        const PropertyIndexEntry * index = GetIndex();
+
+        if (index != NULL && schemaHandle >= kRootPropertyPathHandle)
+        {
+            return index[schemaHandle - kRootPropertyPathHandle].mDepth;
+        }
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
     while (schemaHandle != kRootPropertyPathHandle)
     {
         depth++;
@@ -890,6 +997,72 @@ PropertyPathHandle TraitSchemaEngine::FindLowestCommonAncestor(PropertyPathHandl
     return aHandle1;
 }
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+const TraitSchemaEngine::PropertyIndexEntry * TraitSchemaEngine::GetIndex(void) const
+{
+    if (mIndex == NULL && !mIndexBuildFailed)
+    {
+        mIndex            = BuildIndex();
+        mIndexBuildFailed = (mIndex == NULL);
+    }
+
+    return mIndex;
+}
+
+const TraitSchemaEngine::PropertyIndexEntry * TraitSchemaEngine::BuildIndex(void) const
+{
+    const uint32_t numEntries   = mSchema.mNumSchemaHandleEntries + kRootPropertyPathHandle;
+    PropertyIndexEntry * index  = NULL;
+    PropertySchemaHandle handle = kNullPropertyPathHandle;
+    PropertySchemaHandle parent = kNullPropertyPathHandle;
+    uint32_t depth              = 0;
+
+    VerifyOrExit(mSchema.mNumSchemaHandleEntries == 0 || mSchema.mSchemaHandleTbl != NULL, );
+    VerifyOrExit(numEntries <= TDM_SCHEMA_INDEX_POOL_SIZE - sSchemaIndexPoolUsed, );
+
+    // Claim the entries before filling them in. Should the table turn out to be malformed, the entries are lost, but the engine
+    // never asks for them again.
+    index = &sSchemaIndexPool[sSchemaIndexPoolUsed];
+    sSchemaIndexPoolUsed += numEntries;
+
+    memset(index, 0, numEntries * sizeof(PropertyIndexEntry));
+
+    // Link the children of every handle, visiting the table backwards so that each child is prepended ahead of the children
+    // that follow it in the table. The resulting sibling lists are in table order, which is the order the table scan yields.
+    for (uint32_t i = mSchema.mNumSchemaHandleEntries; i > 0; i--)
+    {
+        handle = static_cast<PropertySchemaHandle>(i - 1 + kHandleTableOffset);
+        parent = mSchema.mSchemaHandleTbl[i - 1].mParentHandle;
+
+        VerifyOrExit(parent >= kRootPropertyPathHandle && parent < numEntries + kRootPropertyPathHandle && parent != handle,
+                     index = NULL);
+
+        index[handle - kRootPropertyPathHandle].mNextSibling = index[parent - kRootPropertyPathHandle].mFirstChild;
+        index[parent - kRootPropertyPathHandle].mFirstChild  = handle;
+    }
+
+    for (uint32_t i = 1; i < numEntries; i++)
+    {
+        depth  = 0;
+        handle = static_cast<PropertySchemaHandle>(i + kRootPropertyPathHandle);
+
+        while (handle != kRootPropertyPathHandle)
+        {
+            // A path up the tree cannot be longer than the number of handles, unless the table has a cycle.
+            VerifyOrExit(depth < numEntries, index = NULL);
+
+            depth++;
+            handle = mSchema.mSchemaHandleTbl[handle - kHandleTableOffset].mParentHandle;
+        }
+
+        index[i].mDepth = static_cast<uint16_t>(depth);
+    }
+
+exit:
+    return index;
+}
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
 const TraitSchemaEngine::PropertyInfo * TraitSchemaEngine::GetMap(PropertyPathHandle aHandle) const
 {
     PropertySchemaHandle schemaHandle = GetPropertySchemaHandle(aHandle);
@@ -1262,8 +1435,15 @@ TraitDataSource::TraitDataSource(const TraitSchemaEngine * aEngine)
     mSetDirtyCalled = false;
     mSchemaEngine   = aEngine;
 
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    mCachedSizeHandle = kNullPropertyPathHandle;
+#endif
+
 #if (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver)
     ClearRootDirty();
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    ClearPropertiesDirty();
+#endif
 #endif
 }
 
@@ -1280,6 +1460,52 @@ uint64_t TraitDataSource::GetVersion(void)
     return mVersion;
 }
 
+#if (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver) && WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+bool TraitDataSource::SetPropertyDirty(PropertyPathHandle aHandle)
+{
+    PropertySchemaHandle schemaHandle = GetPropertySchemaHandle(aHandle);
+    PropertyPathHandle dictionaryItemHandle;
+
+    // Dictionary elements are keyed and cannot be expressed by their schema handle alone.
+    if (schemaHandle >= WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP || GetPropertyDictionaryKey(aHandle) != 0 ||
+        mSchemaEngine->IsInDictionary(aHandle, dictionaryItemHandle))
+    {
+        return false;
+    }
+
+    mDirtyPropertyBitmap[schemaHandle / 32] |= (1UL << (schemaHandle % 32));
+
+    return true;
+}
+
+PropertyPathHandle TraitDataSource::GetNextDirtyProperty(uint32_t & aCursor) const
+{
+    while (aCursor < WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP)
+    {
+        uint32_t word = mDirtyPropertyBitmap[aCursor / 32] >> (aCursor % 32);
+
+        // Skip over runs of clean handles a word at a time.
+        if (word == 0)
+        {
+            aCursor = (aCursor / 32 + 1) * 32;
+            continue;
+        }
+
+        while ((word & 1) == 0)
+        {
+            word >>= 1;
+            aCursor++;
+        }
+
+        return CreatePropertyPathHandle(aCursor++);
+    }
+
+    aCursor = WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP;
+
+    return kNullPropertyPathHandle;
+}
+#endif // (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver) && WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+
 void TraitDataSource::IncrementVersion()
 {
     // By invoking GetVersion within here, we get the benefit of checking if the version is currently 0 and if so, randomize it.
@@ -1352,18 +1578,110 @@ WEAVE_ERROR TraitDataSource::GetData(PropertyPathHandle aHandle, uint64_t aTagTo
 WEAVE_ERROR TraitDataSource::ReadData(PropertyPathHandle aHandle, uint64_t aTagToWrite, TLVWriter & aWriter)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    uint32_t startLen = aWriter.GetLengthWritten();
+#endif
+
     Lock();
     err = mSchemaEngine->RetrieveData(aHandle, aTagToWrite, aWriter, this);
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    if (err == WEAVE_NO_ERROR)
+    {
+        CacheEncodedSize(aHandle, aTagToWrite, aWriter.GetLengthWritten() - startLen);
+    }
+#endif
     Unlock();
 
     return err;
 }
 
+/**
+ * Compute the number of bytes ReadData() would write for the given path handle and tag.
+ *
+ * The data is retrieved from the source but not stored.  If WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE is enabled,
+ * the size of the most recent encoding is remembered and returned without retrieving the data again for as long
+ * as the version of the data source is unchanged.
+ *
+ * @param[in]  aHandle          The property path handle of the data to measure.
+ * @param[in]  aTagToWrite      The tag the data would be written with.
+ * @param[out] aEncodedSize     The number of bytes the encoding would occupy.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ * @retval other           Errors retrieving the data from the source.
+ */
+WEAVE_ERROR TraitDataSource::GetEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, uint32_t & aEncodedSize)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    Lock();
+
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    if (aHandle == mCachedSizeHandle && aTagToWrite == mCachedSizeTag && GetVersion() == mCachedSizeVersion)
+    {
+        aEncodedSize = mCachedSize;
+        ExitNow();
+    }
+#endif
+
+    err = mSchemaEngine->GetEncodedSize(aHandle, aTagToWrite, this, aEncodedSize);
+    SuccessOrExit(err);
+
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    CacheEncodedSize(aHandle, aTagToWrite, aEncodedSize);
+#endif
+
+exit:
+    Unlock();
+
+    return err;
+}
+
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+/**
+ * Look up the size of the most recent encoding of the given path handle and tag, without retrieving any data.
+ *
+ * @param[in]  aHandle          The property path handle of the data to measure.
+ * @param[in]  aTagToWrite      The tag the data would be written with.
+ * @param[out] aEncodedSize     The number of bytes the encoding occupied.
+ *
+ * @retval true  If a size is cached for the handle and tag at the current version of the data source.
+ * @retval false Otherwise; aEncodedSize is left unchanged.
+ */
+bool TraitDataSource::GetCachedEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, uint32_t & aEncodedSize)
+{
+    bool found;
+
+    Lock();
+
+    found = (aHandle == mCachedSizeHandle && aTagToWrite == mCachedSizeTag && GetVersion() == mCachedSizeVersion);
+    if (found)
+    {
+        aEncodedSize = mCachedSize;
+    }
+
+    Unlock();
+
+    return found;
+}
+
+void TraitDataSource::CacheEncodedSize(PropertyPathHandle aHandle, uint64_t aTag, uint32_t aEncodedSize)
+{
+    mCachedSizeHandle  = aHandle;
+    mCachedSizeTag     = aTag;
+    mCachedSizeVersion = GetVersion();
+    mCachedSize        = aEncodedSize;
+}
+#endif // WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+
 void TraitDataSource::SetDirty(PropertyPathHandle aPropertyHandle)
 {
     if (aPropertyHandle != kNullPropertyPathHandle)
     {
         mSetDirtyCalled = true;
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+        // The data is changing; don't rely on the application to bump the version before the size is next queried.
+        mCachedSizeHandle = kNullPropertyPathHandle;
+#endif
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->SetDirty(this, aPropertyHandle);
     }
 }
@@ -178,6 +178,18 @@ public:
         uint8_t mContextTag;
     };
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+    /* An entry of the schema tree index, describing a schema handle. The root handle has the first entry, and every other
+     * schema handle has the entry following that of the preceding handle.
+     */
+    struct PropertyIndexEntry
+    {
+        PropertySchemaHandle mFirstChild;  ///< The first child of the handle in table order, or kNullPropertyPathHandle.
+        PropertySchemaHandle mNextSibling; ///< The next child of the same parent in table order, or kNullPropertyPathHandle.
+        uint16_t mDepth;                   ///< The depth of the handle in the schema tree.
+    };
+#endif
+
     /**
      *  @brief
      *    The main schema structure that houses the schema information.
@@ -391,6 +403,15 @@ public:
     WEAVE_ERROR RetrieveData(PropertyPathHandle aHandle, uint64_t aTagToWrite, nl::Weave::TLV::TLVWriter & aWriter,
                              IGetDataDelegate * aDelegate, IDirtyPathCut * apDirtyPathCut = NULL) const;
 
+    /**
+     * Given a path handle, compute the number of bytes RetrieveData() would write for it, without writing any data.
+     *
+     * @retval #WEAVE_NO_ERROR On success.
+     * @retval other           Encountered errors retrieving the data.
+     */
+    WEAVE_ERROR GetEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, IGetDataDelegate * aDelegate,
+                               uint32_t & aEncodedSize) const;
+
     WEAVE_ERROR RetrieveUpdatableDictionaryData(PropertyPathHandle aHandle, uint64_t aTagToWrite,
                                                 nl::Weave::TLV::TLVWriter & aWriter, IGetDataDelegate * aDelegate,
                                                 PropertyPathHandle & aPropertyPathHandleOfDictItemToStartFrom) const;
@@ -561,8 +582,21 @@ private:
      */
     WEAVE_ERROR ParseTagString(const char * apTagString, char ** apEndptr, uint8_t & aParseRes) const;
 
+#if TDM_SCHEMA_INDEX_SUPPORT
+    const PropertyIndexEntry * GetIndex(void) const;
+    const PropertyIndexEntry * BuildIndex(void) const;
+#endif
+
 public:
     const Schema mSchema;
+#if TDM_SCHEMA_INDEX_SUPPORT
+    /* The schema tree index, built the first time it is needed. This is left out of the initializers of the generated schema
+     * tables, and so starts out NULL. It remains NULL if the index could not be built, in which case queries fall back to
+     * scanning the schema handle table.
+     */
+    mutable const PropertyIndexEntry * mIndex;
+    mutable bool mIndexBuildFailed;
+#endif
 };
 
 /*
@@ -878,6 +912,10 @@ public:
     uint64_t GetVersion(void);
 
     WEAVE_ERROR ReadData(PropertyPathHandle aHandle, uint64_t aTagToWrite, TLV::TLVWriter & aWriter);
+    WEAVE_ERROR GetEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, uint32_t & aEncodedSize);
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    bool GetCachedEncodedSize(PropertyPathHandle aHandle, uint64_t aTagToWrite, uint32_t & aEncodedSize);
+#endif
 
     /* Interactions with the underlying data has to always be done within a locked context. This applies to both the app logic
      * (e.g., a publisher when modifying its source data) as well as to the core WDM logic (when trying to access that published
@@ -929,6 +967,15 @@ public:
     void ClearRootDirty(void) { mRootIsDirty = false; }
     bool IsRootDirty(void) const { return mRootIsDirty; }
     bool mRootIsDirty;
+
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    /* Set of functions to be called by the intermediate graph solver for tracking individual dirty properties that lie outside
+     * of dictionaries. SetPropertyDirty returns false if the handle cannot be tracked in the bitmap. */
+    bool SetPropertyDirty(PropertyPathHandle aHandle);
+    PropertyPathHandle GetNextDirtyProperty(uint32_t & aCursor) const;
+    void ClearPropertiesDirty(void) { memset(mDirtyPropertyBitmap, 0, sizeof(mDirtyPropertyBitmap)); }
+    uint32_t mDirtyPropertyBitmap[(WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP + 31) / 32];
+#endif
 #endif
 
     // Set current version of the data in this source.
@@ -962,6 +1009,9 @@ protected: // IGetDataDelegate
     // Controls whether mVersion is incremented automatically or not.
     bool mManagedVersion;
 
+    // The delegate through which the schema engine reads this source, for visitors that hand properties back to the engine.
+    TraitSchemaEngine::IGetDataDelegate * GetDataDelegate(void) { return this; }
+
     const TraitSchemaEngine * mSchemaEngine;
 
 private:
@@ -969,6 +1019,16 @@ private:
     uint64_t mVersion;
     // Tracks whether SetDirty was called within a Lock/Unlock 'session'
     bool mSetDirtyCalled;
+
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    void CacheEncodedSize(PropertyPathHandle aHandle, uint64_t aTag, uint32_t aEncodedSize);
+
+    // Size of the most recent encoding of this source's data, valid while the version is unchanged.
+    uint64_t mCachedSizeTag;
+    uint64_t mCachedSizeVersion;
+    uint32_t mCachedSize;
+    PropertyPathHandle mCachedSizeHandle;
+#endif // WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
 };
 
 #if WDM_ENABLE_PUBLISHER_UPDATE_SERVER_SUPPORT
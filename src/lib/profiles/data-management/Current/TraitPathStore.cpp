@@ -18,7 +18,8 @@
 
 /**
  *    @file
- *    Implements TraitPathStore: a data structure to store lists or sets of TraitPaths.
+ *    Implements TraitPathStore: a data structure to store lists or sets of TraitPaths,
+ *    and SortedTraitPathStore: a sorted set of TraitPaths with fast lookups.
  *
  */
 
@@ -531,3 +532,287 @@ void TraitPathStore::SetFlags(size_t aIndex, Flags aFlags, bool aValue)
         mStore[aIndex].mFlags |= aFlags;
     }
 }
+
+/**
+ * Empty constructor
+ */
+SortedTraitPathStore::SortedTraitPathStore()
+    : mStore(NULL), mStoreSize(0), mNumItems(0)
+{
+}
+
+/**
+ * Inits the SortedTraitPathStore
+ *
+ * @param[in]   aPathArray      Pointer to an array of TraitPaths that will be used
+ *                              to store the paths.
+ * @param[in]   aArrayLength    Length of the storage array in number of items.
+ */
+void SortedTraitPathStore::Init(TraitPath *aPathArray, size_t aArrayLength)
+{
+    mStore = aPathArray;
+    mStoreSize = aArrayLength;
+
+    Clear();
+}
+
+/**
+ * Adds a TraitPath to the store, keeping the store sorted.
+ * Adding a path that is already present has no effect.
+ *
+ * @param[in]   aItem   The TraitPath to be stored
+ *
+ * @retval WEAVE_NO_ERROR                   in case of success.
+ * @retval WEAVE_ERROR_WDM_PATH_STORE_FULL  if the store is full.
+ */
+WEAVE_ERROR SortedTraitPathStore::AddItem(const TraitPath &aItem)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    size_t i = LowerBound(aItem.mTraitDataHandle, aItem.mPropertyPathHandle);
+
+    WEAVE_FAULT_INJECT(FaultInjection::kFault_WDM_PathStoreFull, return WEAVE_ERROR_WDM_PATH_STORE_FULL);
+
+    VerifyOrExit(i == mNumItems || !(mStore[i] == aItem), /* already present */);
+
+    VerifyOrExit(false == IsFull(), err = WEAVE_ERROR_WDM_PATH_STORE_FULL);
+
+    memmove(&mStore[i+1], &mStore[i], (mNumItems - i) * sizeof(mStore[0]));
+    mStore[i] = aItem;
+    mNumItems++;
+
+exit:
+    return err;
+}
+
+/**
+ * Adds a TraitPath to the store, unless the store already includes it.
+ * Any paths in the store that are descendants of the new path are removed.
+ *
+ * @param[in]   aItem           The TraitPath to be stored
+ * @param[in]   aSchemaEngine   A pointer to the TraitSchemaEngine for the trait instance
+ *                              aItem refers to.
+ *
+ * @retval WEAVE_NO_ERROR                   in case of success.
+ * @retval WEAVE_ERROR_WDM_PATH_STORE_FULL  if the store is full.
+ */
+WEAVE_ERROR SortedTraitPathStore::AddItemDedup(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    size_t i, j;
+
+    if (Includes(aItem, aSchemaEngine))
+    {
+        WeaveLogDetail(DataManagement, "Path already present");
+        ExitNow();
+    }
+
+    // Remove any paths of which aItem is an ancestor, compacting the paths of the trait instance in a single pass.
+    i = j = GetFirstItem(aItem.mTraitDataHandle);
+
+    for (; i < mNumItems && mStore[i].mTraitDataHandle == aItem.mTraitDataHandle; i++)
+    {
+        if (aSchemaEngine->IsParent(mStore[i].mPropertyPathHandle, aItem.mPropertyPathHandle))
+        {
+            WeaveLogDetail(DataManagement, "Removing item %u t%u p%u while adding p%u", i,
+                    mStore[i].mTraitDataHandle,
+                    mStore[i].mPropertyPathHandle,
+                    aItem.mPropertyPathHandle);
+            continue;
+        }
+
+        mStore[j++] = mStore[i];
+    }
+
+    memmove(&mStore[j], &mStore[i], (mNumItems - i) * sizeof(mStore[0]));
+    mNumItems -= (i - j);
+
+    err = AddItem(aItem);
+
+exit:
+    return err;
+}
+
+/**
+ * @param[in] aDataHandle   The TraitDataHandle to look for.
+ *
+ * @return  The index of the first path in the store referring to the given
+ *          TraitDataHandle. The following paths of the trait instance are stored
+ *          contiguously after it. If there are none, the function returns an index
+ *          referring to a different trait instance, or GetNumItems().
+ */
+size_t SortedTraitPathStore::GetFirstItem(TraitDataHandle aDataHandle) const
+{
+    return LowerBound(aDataHandle, 0);
+}
+
+/**
+ * Remove all TraitPaths that refer to a given TraitDataHandle
+ *
+ * @param[in]   aDataHandle     The TraitDataHandle
+ */
+void SortedTraitPathStore::RemoveTrait(TraitDataHandle aDataHandle)
+{
+    size_t first = GetFirstItem(aDataHandle);
+    size_t last = first;
+
+    while (last < mNumItems && mStore[last].mTraitDataHandle == aDataHandle)
+    {
+        last++;
+    }
+
+    memmove(&mStore[first], &mStore[last], (mNumItems - last) * sizeof(mStore[0]));
+    mNumItems -= (last - first);
+}
+
+void SortedTraitPathStore::RemoveItem(const TraitPath &aItem)
+{
+    size_t i = LowerBound(aItem.mTraitDataHandle, aItem.mPropertyPathHandle);
+
+    if (i < mNumItems && mStore[i] == aItem)
+    {
+        WeaveLogDetail(DataManagement, "Removing item %u t%u p%u", i,
+                       aItem.mTraitDataHandle,
+                       aItem.mPropertyPathHandle);
+        RemoveItemAt(i);
+    }
+}
+
+void SortedTraitPathStore::RemoveItemAt(size_t aIndex)
+{
+    VerifyOrDie(aIndex < mNumItems);
+
+    memmove(&mStore[aIndex], &mStore[aIndex+1], (mNumItems - aIndex - 1) * sizeof(mStore[0]));
+    mNumItems--;
+}
+
+/**
+ * Checks if a given TraitPath is already in the store.
+ *
+ * @param[in] aItem The TraitPath to look for.
+ *
+ * @return Returns true if the store contains aItem.
+ */
+bool SortedTraitPathStore::IsPresent(const TraitPath &aItem) const
+{
+    size_t i = LowerBound(aItem.mTraitDataHandle, aItem.mPropertyPathHandle);
+
+    return (i < mNumItems && mStore[i] == aItem);
+}
+
+/**
+ * Check if any of the TraitPaths in the store includes a given TraitPath.
+ * TraitPath A includes TraitPath B if either:
+ * - the two TraitPaths are the same;
+ * - A is an ancestor of B.
+ *
+ * Rather than comparing every path in the store against aItem, this looks up
+ * aItem and each of its ancestors in turn.
+ *
+ * @param[in]   aItem           The TraitPath to be checked against the store.
+ * @param[in]   aSchemaEngine   A pointer to the TraitSchemaEngine for the trait instance
+ *                              aItem refers to.
+ *
+ * @return  true if the TraitPath is already included by the paths in the store.
+ */
+bool SortedTraitPathStore::Includes(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine) const
+{
+    TraitPath path = aItem;
+
+    VerifyOrExit(IsTraitPresent(aItem.mTraitDataHandle), );
+
+    while (path.mPropertyPathHandle != kNullPropertyPathHandle)
+    {
+        if (IsPresent(path))
+        {
+            return true;
+        }
+
+        path.mPropertyPathHandle = aSchemaEngine->GetParent(path.mPropertyPathHandle);
+    }
+
+exit:
+    return false;
+}
+
+/**
+ * Check if any of the TraitPaths in the store intersects a given TraitPath.
+ * Two TraitPaths intersect each other if any of the following is true:
+ * - the two TraitPaths are the same;
+ * - one of the two TraitPaths is an ancestor of the other TraitPath.
+ *
+ * Ancestors of aItem are looked up as in Includes(); descendants are searched
+ * for among the paths of the same trait instance only.
+ *
+ * @param[in]   aItem           The TraitPath to be checked against the store.
+ * @param[in]   aSchemaEngine   A pointer to the TraitSchemaEngine for the trait instance
+ *                              aItem refers to.
+ *
+ * @return  true if the store intersects the given TraitPath; false otherwise.
+ */
+bool SortedTraitPathStore::Intersects(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine) const
+{
+    if (Includes(aItem, aSchemaEngine))
+    {
+        return true;
+    }
+
+    // Every path of the trait instance descends from its root.
+    if (aItem.mPropertyPathHandle == kRootPropertyPathHandle)
+    {
+        return IsTraitPresent(aItem.mTraitDataHandle);
+    }
+
+    for (size_t i = GetFirstItem(aItem.mTraitDataHandle);
+         i < mNumItems && mStore[i].mTraitDataHandle == aItem.mTraitDataHandle;
+         i++)
+    {
+        if (aSchemaEngine->IsParent(mStore[i].mPropertyPathHandle, aItem.mPropertyPathHandle))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @param[in] aDataHandle   The TraitDataHandle to look for.
+ * @return  Returns true if the store contains one or more paths referring
+ *          to the given TraitDataHandle
+ */
+bool SortedTraitPathStore::IsTraitPresent(TraitDataHandle aDataHandle) const
+{
+    size_t i = GetFirstItem(aDataHandle);
+
+    return (i < mNumItems && mStore[i].mTraitDataHandle == aDataHandle);
+}
+
+// Private members
+
+/**
+ * @return The index of the first path in the store that does not sort before
+ *          the given TraitDataHandle and PropertyPathHandle, or GetNumItems() if
+ *          there is none.
+ */
+size_t SortedTraitPathStore::LowerBound(TraitDataHandle aDataHandle, PropertyPathHandle aPropertyPathHandle) const
+{
+    size_t low = 0;
+    size_t high = mNumItems;
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (mStore[mid].mTraitDataHandle < aDataHandle ||
+            (mStore[mid].mTraitDataHandle == aDataHandle && mStore[mid].mPropertyPathHandle < aPropertyPathHandle))
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
@@ -18,7 +18,8 @@
 
 /**
  *    @file
- *    Defines TraitPathStore: a data structure to store lists or sets of TraitPaths.
+ *    Defines TraitPathStore: a data structure to store lists or sets of TraitPaths,
+ *    and SortedTraitPathStore: a sorted set of TraitPaths with fast lookups.
  *
  */
 
@@ -111,6 +112,51 @@ struct TraitPathStore
         size_t mNumItems;
 };
 
+/**
+ * A set of TraitPaths kept sorted by TraitDataHandle and PropertyPathHandle.
+ *
+ * Unlike TraitPathStore, lookups do not scan the whole store: IsPresent() is a binary search, Includes() looks up each
+ * ancestor of the path in turn and Intersects() additionally only visits the paths of the same trait instance. This makes
+ * it suitable for large sets of paths that are queried often. The store has no per-item flags and holds no gaps, so the
+ * paths can be iterated over with GetItemAt() from 0 to GetNumItems().
+ */
+struct SortedTraitPathStore
+{
+    public:
+        SortedTraitPathStore();
+
+        void Init(TraitPath *aPathArray, size_t aArrayLength);
+
+        bool IsEmpty() const { return mNumItems == 0; }
+        bool IsFull() const { return mNumItems >= mStoreSize; }
+        size_t GetNumItems() const { return mNumItems; }
+        size_t GetPathStoreSize() const { return mStoreSize; }
+
+        WEAVE_ERROR AddItem(const TraitPath &aItem);
+        WEAVE_ERROR AddItemDedup(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine);
+
+        const TraitPath &GetItemAt(size_t aIndex) const { return mStore[aIndex]; }
+        size_t GetFirstItem(TraitDataHandle aDataHandle) const;
+
+        void RemoveTrait(TraitDataHandle aDataHandle);
+        void RemoveItem(const TraitPath &aItem);
+        void RemoveItemAt(size_t aIndex);
+
+        void Clear() { mNumItems = 0; }
+
+        bool IsPresent(const TraitPath &aItem) const;
+        bool Includes(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine) const;
+        bool Intersects(const TraitPath &aItem, const TraitSchemaEngine * const aSchemaEngine) const;
+        bool IsTraitPresent(TraitDataHandle aDataHandle) const;
+
+    private:
+        size_t LowerBound(TraitDataHandle aDataHandle, PropertyPathHandle aPropertyPathHandle) const;
+
+        TraitPath *mStore;
+        size_t mStoreSize;
+        size_t mNumItems;
+};
+
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }; // namespace Profiles
 }; // namespace Weave
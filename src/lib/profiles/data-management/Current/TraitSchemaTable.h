@@ -0,0 +1,558 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines compile-time helpers for trait schema tables: checks
+ *      of the consistency of a property table, usable in static assertions,
+ *      templates that derive the per-handle flag bitfields and the schema
+ *      tree index of a TraitSchemaEngine from the table while compiling, and
+ *      a visitor that reads and writes trait data along the table without
+ *      interpreting it at run time.
+ *
+ *      The helpers evaluate their arguments in constant expressions, so the
+ *      property table must be declared constexpr, and they require C++11.
+ *
+ */
+
+#ifndef _WEAVE_DATA_MANAGEMENT_TRAIT_SCHEMA_TABLE_CURRENT_H
+#define _WEAVE_DATA_MANAGEMENT_TRAIT_SCHEMA_TABLE_CURRENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/TraitData.h>
+
+#if defined(__cplusplus) && (__cplusplus >= 201103L)
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+/**
+ *  @class TraitSchemaTable
+ *
+ *  @brief
+ *    Compile-time queries on a trait property table, that is, an array of
+ *    TraitSchemaEngine::PropertyInfo whose element i describes schema handle
+ *    i + TraitSchemaEngine::kHandleTableOffset.
+ *
+ *    The queries recurse once per table element, so tables are limited by the
+ *    constexpr recursion depth of the compiler (512 by default for GCC and
+ *    Clang), which comfortably covers the traits in use.
+ */
+class TraitSchemaTable
+{
+public:
+    typedef TraitSchemaEngine::PropertyInfo PropertyInfo;
+
+    /**
+     *  Check that every property names a parent that precedes it in the table, or the root.
+     */
+    static constexpr bool ParentsPrecedeChildren(const PropertyInfo * aTable, uint32_t aNumEntries, uint32_t aIndex = 0)
+    {
+        return (aIndex == aNumEntries) ||
+            ((aTable[aIndex].mParentHandle >= kRootPropertyPathHandle) &&
+             (aTable[aIndex].mParentHandle < aIndex + TraitSchemaEngine::kHandleTableOffset) &&
+             ParentsPrecedeChildren(aTable, aNumEntries, aIndex + 1));
+    }
+
+    /**
+     *  Check that no two properties of the same parent have the same context tag.
+     */
+    static constexpr bool SiblingTagsAreUnique(const PropertyInfo * aTable, uint32_t aNumEntries, uint32_t aIndex = 0)
+    {
+        return (aIndex == aNumEntries) ||
+            (IsTagUniqueAfter(aTable, aNumEntries, aIndex, aIndex + 1) && SiblingTagsAreUnique(aTable, aNumEntries, aIndex + 1));
+    }
+
+    /**
+     *  Get the schema handle of the child of a property with a given context tag, or kNullPropertyPathHandle.
+     */
+    static constexpr PropertySchemaHandle ChildHandle(const PropertyInfo * aTable, uint32_t aNumEntries,
+                                                      PropertySchemaHandle aParentHandle, uint8_t aContextTag, uint32_t aIndex = 0)
+    {
+        return (aIndex == aNumEntries) ? static_cast<PropertySchemaHandle>(kNullPropertyPathHandle) :
+            (aTable[aIndex].mParentHandle == aParentHandle && aTable[aIndex].mContextTag == aContextTag) ?
+            static_cast<PropertySchemaHandle>(aIndex + TraitSchemaEngine::kHandleTableOffset) :
+            ChildHandle(aTable, aNumEntries, aParentHandle, aContextTag, aIndex + 1);
+    }
+
+    /**
+     *  Get the schema handle of the first child of a property found at or after a given table index, or
+     *  kNullPropertyPathHandle.
+     */
+    static constexpr PropertySchemaHandle NextChild(const PropertyInfo * aTable, uint32_t aNumEntries,
+                                                    PropertySchemaHandle aParentHandle, uint32_t aIndex)
+    {
+        return (aIndex >= aNumEntries) ? static_cast<PropertySchemaHandle>(kNullPropertyPathHandle) :
+            (aTable[aIndex].mParentHandle == aParentHandle) ?
+            static_cast<PropertySchemaHandle>(aIndex + TraitSchemaEngine::kHandleTableOffset) :
+            NextChild(aTable, aNumEntries, aParentHandle, aIndex + 1);
+    }
+
+    /**
+     *  Get the depth of a schema handle in the schema tree.
+     */
+    static constexpr uint32_t Depth(const PropertyInfo * aTable, PropertySchemaHandle aHandle)
+    {
+        return (aHandle == kRootPropertyPathHandle) ? 0 :
+            1 + Depth(aTable, aTable[aHandle - TraitSchemaEngine::kHandleTableOffset].mParentHandle);
+    }
+
+    /**
+     *  Get the depth of the deepest property of the table, suitable for Schema::mTreeDepth.
+     */
+    static constexpr uint32_t TreeDepth(const PropertyInfo * aTable, uint32_t aNumEntries, uint32_t aIndex = 0)
+    {
+        return (aIndex == aNumEntries) ? 0 :
+            Max(Depth(aTable, static_cast<PropertySchemaHandle>(aIndex + TraitSchemaEngine::kHandleTableOffset)),
+                TreeDepth(aTable, aNumEntries, aIndex + 1));
+    }
+
+    /**
+     *  Check that each of a list of schema handles names a property of a table with the given number of entries.
+     */
+    static constexpr bool HandlesAreInRange(uint32_t) { return true; }
+
+    template <typename... Handles>
+    static constexpr bool HandlesAreInRange(uint32_t aNumEntries, PropertySchemaHandle aHandle, Handles... aHandles)
+    {
+        return (aHandle >= TraitSchemaEngine::kHandleTableOffset) &&
+            (aHandle < aNumEntries + TraitSchemaEngine::kHandleTableOffset) && HandlesAreInRange(aNumEntries, aHandles...);
+    }
+
+    /**
+     *  Get one byte of the bitfield in which the bits of the given schema handles are set.
+     */
+    static constexpr uint8_t BitfieldByte(uint32_t) { return 0; }
+
+    template <typename... Handles>
+    static constexpr uint8_t BitfieldByte(uint32_t aByte, PropertySchemaHandle aHandle, Handles... aHandles)
+    {
+        return static_cast<uint8_t>((((aHandle - TraitSchemaEngine::kHandleTableOffset) / 8 == aByte) ?
+                                     (1U << ((aHandle - TraitSchemaEngine::kHandleTableOffset) % 8)) : 0U) |
+                                    BitfieldByte(aByte, aHandles...));
+    }
+
+#if TDM_SCHEMA_INDEX_SUPPORT
+    /**
+     *  Get the schema tree index entry of a schema handle.
+     */
+    static constexpr TraitSchemaEngine::PropertyIndexEntry IndexEntry(const PropertyInfo * aTable, uint32_t aNumEntries,
+                                                                      PropertySchemaHandle aHandle)
+    {
+        return TraitSchemaEngine::PropertyIndexEntry {
+            NextChild(aTable, aNumEntries, aHandle, 0),
+            (aHandle == kRootPropertyPathHandle) ? static_cast<PropertySchemaHandle>(kNullPropertyPathHandle) :
+                NextChild(aTable, aNumEntries, aTable[aHandle - TraitSchemaEngine::kHandleTableOffset].mParentHandle,
+                          aHandle - TraitSchemaEngine::kHandleTableOffset + 1),
+            static_cast<uint16_t>(Depth(aTable, aHandle))
+        };
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
+    template <size_t... kIndices>
+    struct IndexSequence
+    {
+    };
+
+    template <size_t kCount, size_t... kIndices>
+    struct MakeIndexSequence : MakeIndexSequence<kCount - 1, kCount - 1, kIndices...>
+    {
+    };
+
+    template <size_t... kIndices>
+    struct MakeIndexSequence<0, kIndices...>
+    {
+        typedef IndexSequence<kIndices...> Type;
+    };
+
+private:
+    static constexpr bool IsTagUniqueAfter(const PropertyInfo * aTable, uint32_t aNumEntries, uint32_t aIndex, uint32_t aOther)
+    {
+        return (aOther == aNumEntries) ||
+            ((aTable[aOther].mParentHandle != aTable[aIndex].mParentHandle ||
+              aTable[aOther].mContextTag != aTable[aIndex].mContextTag) &&
+             IsTagUniqueAfter(aTable, aNumEntries, aIndex, aOther + 1));
+    }
+
+    static constexpr uint32_t Max(uint32_t aA, uint32_t aB) { return (aA > aB) ? aA : aB; }
+};
+
+/**
+ *  @class TraitSchemaBitfield
+ *
+ *  @brief
+ *    A per-handle flag bitfield, such as Schema::mIsDictionaryBitfield, in which the bits of
+ *    the schema handles @a kHandles are set, for a trait with @a kNumEntries properties.
+ *
+ *    The bitfield is constant-initialized, and so costs no code to set up.
+ */
+template <uint32_t kNumEntries, PropertySchemaHandle... kHandles>
+struct TraitSchemaBitfield
+{
+    static_assert(TraitSchemaTable::HandlesAreInRange(kNumEntries, kHandles...), "Bitfield handle out of range");
+
+    template <typename Sequence>
+    struct Bytes;
+
+    template <size_t... kIndices>
+    struct Bytes<TraitSchemaTable::IndexSequence<kIndices...> >
+    {
+        static uint8_t sBits[sizeof...(kIndices)];
+    };
+
+    typedef Bytes<typename TraitSchemaTable::MakeIndexSequence<(kNumEntries + 7) / 8>::Type> Storage;
+
+    /**
+     *  Get the bitfield, in the form the schema engine expects it.
+     */
+    static uint8_t * Get(void) { return Storage::sBits; }
+};
+
+template <uint32_t kNumEntries, PropertySchemaHandle... kHandles>
+template <size_t... kIndices>
+uint8_t TraitSchemaBitfield<kNumEntries, kHandles...>::Bytes<TraitSchemaTable::IndexSequence<kIndices...> >::sBits[] = {
+    TraitSchemaTable::BitfieldByte(kIndices, kHandles...)...
+};
+
+#if TDM_SCHEMA_INDEX_SUPPORT
+/**
+ *  @class TraitSchemaIndex
+ *
+ *  @brief
+ *    The schema tree index of the property table @a kTable of @a kNumEntries properties,
+ *    computed at compile time.
+ *
+ *    A schema engine whose mIndex member is initialized with Get() never builds its index
+ *    at run time.
+ */
+template <const TraitSchemaEngine::PropertyInfo * kTable, uint32_t kNumEntries>
+struct TraitSchemaIndex
+{
+    static_assert(TraitSchemaTable::ParentsPrecedeChildren(kTable, kNumEntries), "Property parent does not precede it");
+
+    template <typename Sequence>
+    struct Entries;
+
+    template <size_t... kIndices>
+    struct Entries<TraitSchemaTable::IndexSequence<kIndices...> >
+    {
+        static constexpr TraitSchemaEngine::PropertyIndexEntry sEntries[sizeof...(kIndices)] = {
+            TraitSchemaTable::IndexEntry(kTable, kNumEntries, static_cast<PropertySchemaHandle>(kIndices + kRootPropertyPathHandle))...
+        };
+    };
+
+    typedef Entries<typename TraitSchemaTable::MakeIndexSequence<kNumEntries + kRootPropertyPathHandle>::Type> Storage;
+
+    /**
+     *  Get the index, in the form the schema engine expects it.
+     */
+    static constexpr const TraitSchemaEngine::PropertyIndexEntry * Get(void) { return Storage::sEntries; }
+};
+
+template <const TraitSchemaEngine::PropertyInfo * kTable, uint32_t kNumEntries>
+template <size_t... kIndices>
+constexpr TraitSchemaEngine::PropertyIndexEntry
+    TraitSchemaIndex<kTable, kNumEntries>::Entries<TraitSchemaTable::IndexSequence<kIndices...> >::sEntries[sizeof...(kIndices)];
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
+/**
+ *  @class TraitSchemaVisitor
+ *
+ *  @brief
+ *    Specialized RetrieveData() and StoreData() for the property table @a kTable of
+ *    @a kNumEntries properties.
+ *
+ *    The schema tree is walked at compile time, so each property is encoded or decoded by
+ *    straight-line code, and each leaf is handed to a function object instead of through
+ *    the virtual IGetDataDelegate::GetData() and ISetDataDelegate::SetData(). A data source
+ *    or sink passes a lambda that calls its own GetLeafData() or SetLeafData() by qualified
+ *    name, which the compiler can inline, for example:
+ *
+ *    @code
+ *    return Visitor::RetrieveData(*GetSchemaEngine(), aHandle, aTagToWrite, aWriter, GetDataDelegate(),
+ *        [this](PropertyPathHandle aLeaf, uint64_t aTag, TLVWriter & aLeafWriter) {
+ *            return MyTraitDataSource::GetLeafData(aLeaf, aTag, aLeafWriter);
+ *        });
+ *    @endcode
+ *
+ *    Dictionaries, and nullable, optional and ephemeral properties, are handed back to the
+ *    schema engine and the delegate, as are paths into dictionaries, so the output matches
+ *    TraitSchemaEngine::RetrieveData() and StoreData() for any data source or sink whose
+ *    plain leaves are all served by GetLeafData() and SetLeafData().
+ */
+template <const TraitSchemaEngine::PropertyInfo * kTable, uint32_t kNumEntries>
+class TraitSchemaVisitor
+{
+    static_assert(TraitSchemaTable::ParentsPrecedeChildren(kTable, kNumEntries), "Property parent does not precede it");
+    static_assert(TraitSchemaTable::SiblingTagsAreUnique(kTable, kNumEntries), "Duplicate context tag among sibling properties");
+
+public:
+    /**
+     *  Write the data at @a aHandle with @a aTagToWrite, as TraitSchemaEngine::RetrieveData() would.
+     *
+     *  @param[in] aGetLeaf     Called as aGetLeaf(leafHandle, tagToWrite, writer) to write each plain leaf.
+     */
+    template <typename GetLeaf>
+    static WEAVE_ERROR RetrieveData(const TraitSchemaEngine & aEngine, PropertyPathHandle aHandle, uint64_t aTagToWrite,
+                                    nl::Weave::TLV::TLVWriter & aWriter, TraitSchemaEngine::IGetDataDelegate * aDelegate,
+                                    GetLeaf aGetLeaf)
+    {
+        const RetrieveContext<GetLeaf> context = { aEngine, aDelegate, aGetLeaf };
+        PropertyPathHandle dictionaryItemHandle;
+
+        if (!IsVisitable(aEngine, aHandle) || aEngine.IsInDictionary(aHandle, dictionaryItemHandle))
+            return aEngine.RetrieveData(aHandle, aTagToWrite, aWriter, aDelegate);
+
+        return DispatchRetrieve(typename TraitSchemaTable::MakeIndexSequence<kNumEntries + kRootPropertyPathHandle>::Type(),
+                                context, GetPropertySchemaHandle(aHandle), aTagToWrite, aWriter);
+    }
+
+    /**
+     *  Store the data the reader is positioned on into @a aHandle, as TraitSchemaEngine::StoreData() would
+     *  without a path filter.
+     *
+     *  @param[in] aSetLeaf     Called as aSetLeaf(leafHandle, reader) to store each plain leaf.
+     */
+    template <typename SetLeaf>
+    static WEAVE_ERROR StoreData(const TraitSchemaEngine & aEngine, PropertyPathHandle aHandle, nl::Weave::TLV::TLVReader & aReader,
+                                 TraitSchemaEngine::ISetDataDelegate * aDelegate, SetLeaf aSetLeaf)
+    {
+        const StoreContext<SetLeaf> context = { aEngine, aDelegate, aSetLeaf };
+        PropertyPathHandle dictionaryItemHandle;
+
+        if (!IsVisitable(aEngine, aHandle) || aEngine.IsDictionary(aHandle) || aEngine.IsInDictionary(aHandle, dictionaryItemHandle))
+            return aEngine.StoreData(aHandle, aReader, aDelegate, NULL);
+
+        return DispatchStore(typename TraitSchemaTable::MakeIndexSequence<kNumEntries + kRootPropertyPathHandle>::Type(),
+                             context, GetPropertySchemaHandle(aHandle), aReader);
+    }
+
+private:
+    template <typename GetLeaf>
+    struct RetrieveContext
+    {
+        const TraitSchemaEngine & mEngine;
+        TraitSchemaEngine::IGetDataDelegate * mDelegate;
+        GetLeaf & mGetLeaf;
+    };
+
+    template <typename SetLeaf>
+    struct StoreContext
+    {
+        const TraitSchemaEngine & mEngine;
+        TraitSchemaEngine::ISetDataDelegate * mDelegate;
+        SetLeaf & mSetLeaf;
+    };
+
+    static bool IsVisitable(const TraitSchemaEngine & aEngine, PropertyPathHandle aHandle)
+    {
+        return aEngine.mSchema.mSchemaHandleTbl == kTable && aEngine.mSchema.mNumSchemaHandleEntries == kNumEntries &&
+            GetPropertySchemaHandle(aHandle) >= kRootPropertyPathHandle &&
+            GetPropertySchemaHandle(aHandle) < kNumEntries + TraitSchemaEngine::kHandleTableOffset;
+    }
+
+    // Whether the schema engine and the delegate must handle a property, rather than the visitor.
+    static bool NeedsEngine(const TraitSchemaEngine & aEngine, PropertySchemaHandle aHandle)
+    {
+        return aEngine.IsDictionary(aHandle) || aEngine.IsNullable(aHandle) || aEngine.IsOptional(aHandle) ||
+            aEngine.IsEphemeral(aHandle);
+    }
+
+    template <PropertySchemaHandle kHandle>
+    struct Node;
+
+    // The children of a property, from kChild on, in table order.
+    template <PropertySchemaHandle kChild, bool kIsEnd = (kChild == kNullPropertyPathHandle)>
+    struct Children
+    {
+        static constexpr PropertySchemaHandle kNext =
+            TraitSchemaTable::NextChild(kTable, kNumEntries, kTable[kChild - TraitSchemaEngine::kHandleTableOffset].mParentHandle,
+                                        kChild - TraitSchemaEngine::kHandleTableOffset + 1);
+        static constexpr uint8_t kContextTag = kTable[kChild - TraitSchemaEngine::kHandleTableOffset].mContextTag;
+
+        template <typename GetLeaf>
+        static WEAVE_ERROR Retrieve(const RetrieveContext<GetLeaf> & aContext, nl::Weave::TLV::TLVWriter & aWriter)
+        {
+            WEAVE_ERROR err = Node<kChild>::Retrieve(aContext, nl::Weave::TLV::ContextTag(kContextTag), aWriter);
+
+            return (err == WEAVE_NO_ERROR) ? Children<kNext>::Retrieve(aContext, aWriter) : err;
+        }
+
+        template <typename SetLeaf>
+        static WEAVE_ERROR Store(const StoreContext<SetLeaf> & aContext, uint32_t aContextTag, nl::Weave::TLV::TLVReader & aReader)
+        {
+            return (aContextTag == kContextTag) ? Node<kChild>::Store(aContext, aReader) :
+                Children<kNext>::Store(aContext, aContextTag, aReader);
+        }
+    };
+
+    template <PropertySchemaHandle kChild>
+    struct Children<kChild, true>
+    {
+        template <typename GetLeaf>
+        static WEAVE_ERROR Retrieve(const RetrieveContext<GetLeaf> & aContext, nl::Weave::TLV::TLVWriter & aWriter)
+        {
+            return WEAVE_NO_ERROR;
+        }
+
+        // No child has the tag.
+        template <typename SetLeaf>
+        static WEAVE_ERROR Store(const StoreContext<SetLeaf> & aContext, uint32_t aContextTag, nl::Weave::TLV::TLVReader & aReader)
+        {
+#if TDM_DISABLE_STRICT_SCHEMA_COMPLIANCE
+            return WEAVE_NO_ERROR;
+#else
+            return WEAVE_ERROR_TLV_TAG_NOT_FOUND;
+#endif
+        }
+    };
+
+    template <PropertySchemaHandle kHandle>
+    struct Node
+    {
+        static constexpr PropertySchemaHandle kFirstChild = TraitSchemaTable::NextChild(kTable, kNumEntries, kHandle, 0);
+        static constexpr bool kIsLeaf = (kHandle != kRootPropertyPathHandle && kFirstChild == kNullPropertyPathHandle);
+
+        template <typename GetLeaf>
+        static WEAVE_ERROR Retrieve(const RetrieveContext<GetLeaf> & aContext, uint64_t aTagToWrite, nl::Weave::TLV::TLVWriter & aWriter)
+        {
+            WEAVE_ERROR err;
+            nl::Weave::TLV::TLVType type;
+
+            if (NeedsEngine(aContext.mEngine, kHandle))
+                return aContext.mEngine.RetrieveData(kHandle, aTagToWrite, aWriter, aContext.mDelegate);
+
+            if (kIsLeaf)
+                return aContext.mGetLeaf(kHandle, aTagToWrite, aWriter);
+
+            err = aWriter.StartContainer(aTagToWrite, nl::Weave::TLV::kTLVType_Structure, type);
+            SuccessOrExit(err);
+
+            err = Children<kFirstChild>::Retrieve(aContext, aWriter);
+            SuccessOrExit(err);
+
+            err = aWriter.EndContainer(type);
+
+        exit:
+            return err;
+        }
+
+        template <typename SetLeaf>
+        static WEAVE_ERROR Store(const StoreContext<SetLeaf> & aContext, nl::Weave::TLV::TLVReader & aReader)
+        {
+            WEAVE_ERROR err;
+            nl::Weave::TLV::TLVType type;
+
+            if (aContext.mEngine.IsDictionary(kHandle))
+            {
+                // Storing a dictionary below the target path replaces it.
+                aContext.mDelegate->OnSetDataEvent(TraitSchemaEngine::ISetDataDelegate::kSetDataEvent_DictionaryReplaceBegin, kHandle);
+
+                err = aContext.mEngine.StoreData(kHandle, aReader, aContext.mDelegate, NULL);
+                SuccessOrExit(err);
+
+                aContext.mDelegate->OnSetDataEvent(TraitSchemaEngine::ISetDataDelegate::kSetDataEvent_DictionaryReplaceEnd, kHandle);
+                ExitNow();
+            }
+
+            if (kIsLeaf)
+            {
+                if (NeedsEngine(aContext.mEngine, kHandle))
+                    return aContext.mDelegate->SetData(kHandle, aReader, aReader.GetType() == nl::Weave::TLV::kTLVType_Null);
+
+                return aContext.mSetLeaf(kHandle, aReader);
+            }
+
+            if (aReader.GetType() == nl::Weave::TLV::kTLVType_Null)
+            {
+                VerifyOrExit(aContext.mEngine.IsNullable(kHandle), err = WEAVE_ERROR_WDM_SCHEMA_MISMATCH);
+
+                return aContext.mDelegate->SetData(kHandle, aReader, true);
+            }
+
+            err = aReader.EnterContainer(type);
+            SuccessOrExit(err);
+
+            while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+            {
+                const uint64_t tag = aReader.GetTag();
+
+                VerifyOrExit(nl::Weave::TLV::IsContextTag(tag), err = WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+                err = Children<kFirstChild>::Store(aContext, nl::Weave::TLV::TagNumFromTag(tag), aReader);
+                SuccessOrExit(err);
+            }
+
+            VerifyOrExit(err == WEAVE_END_OF_TLV, );
+
+            err = aReader.ExitContainer(type);
+
+        exit:
+            return err;
+        }
+    };
+
+    // Enter the walk at a run-time schema handle, through a table of the walks from each handle.
+    template <typename GetLeaf, size_t... kIndices>
+    static WEAVE_ERROR DispatchRetrieve(TraitSchemaTable::IndexSequence<kIndices...>, const RetrieveContext<GetLeaf> & aContext,
+                                        PropertySchemaHandle aHandle, uint64_t aTagToWrite, nl::Weave::TLV::TLVWriter & aWriter)
+    {
+        static WEAVE_ERROR (* const sRetrieve[])(const RetrieveContext<GetLeaf> &, uint64_t, nl::Weave::TLV::TLVWriter &) = {
+            &Node<static_cast<PropertySchemaHandle>(kIndices + kRootPropertyPathHandle)>::template Retrieve<GetLeaf>...
+        };
+
+        return sRetrieve[aHandle - kRootPropertyPathHandle](aContext, aTagToWrite, aWriter);
+    }
+
+    template <typename SetLeaf, size_t... kIndices>
+    static WEAVE_ERROR DispatchStore(TraitSchemaTable::IndexSequence<kIndices...>, const StoreContext<SetLeaf> & aContext,
+                                     PropertySchemaHandle aHandle, nl::Weave::TLV::TLVReader & aReader)
+    {
+        static WEAVE_ERROR (* const sStore[])(const StoreContext<SetLeaf> &, nl::Weave::TLV::TLVReader &) = {
+            &Node<static_cast<PropertySchemaHandle>(kIndices + kRootPropertyPathHandle)>::template Store<SetLeaf>...
+        };
+
+        return sStore[aHandle - kRootPropertyPathHandle](aContext, aReader);
+    }
+};
+
+}; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+}; // namespace Profiles
+}; // namespace Weave
+}; // namespace nl
+
+/**
+ *  Assert, at compile time, that a constexpr trait property table is consistent: every
+ *  property follows its parent, and no two properties of the same parent share a tag.
+ */
+#define TDM_SCHEMA_TABLE_STATIC_ASSERT(aPropertyTable)                                                                              \
+    static_assert(::nl::Weave::Profiles::DataManagement::TraitSchemaTable::ParentsPrecedeChildren(                                 \
+                      aPropertyTable, sizeof(aPropertyTable) / sizeof((aPropertyTable)[0])),                                        \
+                  #aPropertyTable ": property parent does not precede it");                                                        \
+    static_assert(::nl::Weave::Profiles::DataManagement::TraitSchemaTable::SiblingTagsAreUnique(                                   \
+                      aPropertyTable, sizeof(aPropertyTable) / sizeof((aPropertyTable)[0])),                                        \
+                  #aPropertyTable ": duplicate context tag among sibling properties")
+
+#endif // defined(__cplusplus) && (__cplusplus >= 201103L)
+
+#endif // _WEAVE_DATA_MANAGEMENT_TRAIT_SCHEMA_TABLE_CURRENT_H
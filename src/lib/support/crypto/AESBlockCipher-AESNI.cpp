@@ -40,6 +40,36 @@ namespace Security {
 
 using namespace nl::Weave::Crypto;
 
+// Encrypt four independent blocks at once, interleaving their rounds so that the latency of each
+// AESENC instruction is hidden behind the other three.
+static inline void EncryptBlocks4(const __m128i *key, int roundCount, const uint8_t *inBlocks, uint8_t *outBlocks)
+{
+    __m128i block0, block1, block2, block3;
+
+    block0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks +  0)), key[0]);
+    block1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 16)), key[0]);
+    block2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 32)), key[0]);
+    block3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 48)), key[0]);
+
+    for (int round = 1; round < roundCount; round++)
+    {
+        block0 = _mm_aesenc_si128(block0, key[round]);
+        block1 = _mm_aesenc_si128(block1, key[round]);
+        block2 = _mm_aesenc_si128(block2, key[round]);
+        block3 = _mm_aesenc_si128(block3, key[round]);
+    }
+
+    _mm_storeu_si128((__m128i *)(outBlocks +  0), _mm_aesenclast_si128(block0, key[roundCount]));
+    _mm_storeu_si128((__m128i *)(outBlocks + 16), _mm_aesenclast_si128(block1, key[roundCount]));
+    _mm_storeu_si128((__m128i *)(outBlocks + 32), _mm_aesenclast_si128(block2, key[roundCount]));
+    _mm_storeu_si128((__m128i *)(outBlocks + 48), _mm_aesenclast_si128(block3, key[roundCount]));
+
+    ClearSecretData((uint8_t *)&block0, sizeof(block0));
+    ClearSecretData((uint8_t *)&block1, sizeof(block1));
+    ClearSecretData((uint8_t *)&block2, sizeof(block2));
+    ClearSecretData((uint8_t *)&block3, sizeof(block3));
+}
+
 AES128BlockCipher::AES128BlockCipher()
 {
     memset(&mKey, 0, sizeof(mKey));
@@ -108,6 +138,15 @@ void AES128BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (; numBlocks >= 4; numBlocks -= 4, inBlocks += 4 * kBlockLength, outBlocks += 4 * kBlockLength)
+        EncryptBlocks4(mKey, kRoundCount, inBlocks, outBlocks);
+
+    for (; numBlocks > 0; numBlocks--, inBlocks += kBlockLength, outBlocks += kBlockLength)
+        EncryptBlock(inBlocks, outBlocks);
+}
+
 void AES128BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
@@ -234,6 +273,15 @@ void AES256BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (; numBlocks >= 4; numBlocks -= 4, inBlocks += 4 * kBlockLength, outBlocks += 4 * kBlockLength)
+        EncryptBlocks4(mKey, kRoundCount, inBlocks, outBlocks);
+
+    for (; numBlocks > 0; numBlocks--, inBlocks += kBlockLength, outBlocks += kBlockLength)
+        EncryptBlock(inBlocks, outBlocks);
+}
+
 void AES256BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
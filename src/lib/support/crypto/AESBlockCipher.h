@@ -105,6 +105,9 @@ class NL_DLL_EXPORT AES128BlockCipherEnc : public AES128BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
+#endif
 };
 
 class NL_DLL_EXPORT AES128BlockCipherDec : public AES128BlockCipher
@@ -151,6 +154,9 @@ class NL_DLL_EXPORT AES256BlockCipherEnc : public AES256BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
+#endif
 };
 
 class NL_DLL_EXPORT AES256BlockCipherDec : public AES256BlockCipher
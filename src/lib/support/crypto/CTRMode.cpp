@@ -41,6 +41,7 @@ template <class BlockCipher>
 CTRMode<BlockCipher>::CTRMode()
 {
     memset(this, 0, sizeof(*this));
+    mKeyedBlockCipher = &mBlockCipher;
 }
 
 template <class BlockCipher>
@@ -53,6 +54,20 @@ template <class BlockCipher>
 void CTRMode<BlockCipher>::SetKey(const uint8_t *key)
 {
     mBlockCipher.SetKey(key);
+    mKeyedBlockCipher = &mBlockCipher;
+}
+
+/**
+ * Use a block cipher whose key has already been set, such as one cached with a long-lived key,
+ * instead of expanding the key again.
+ *
+ * @param[in] keyedBlockCipher  The keyed block cipher, which must remain valid and keyed until
+ *                              Reset() is called or the object is destroyed.
+ */
+template <class BlockCipher>
+void CTRMode<BlockCipher>::SetKey(BlockCipher &keyedBlockCipher)
+{
+    mKeyedBlockCipher = &keyedBlockCipher;
 }
 
 template <class BlockCipher>
@@ -93,31 +108,49 @@ void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen,
 {
     // Index to next byte of encrypted counter to be used.
     uint32_t encryptedCounterIndex = mMsgIndex % kCounterLength;
+    uint16_t dataIndex = 0;
+
+    // If the previous call ended on a block boundary, encrypt the whole blocks of input data in batches,
+    // so that the block cipher can work on several counter values at once.
+    if (encryptedCounterIndex == 0)
+    {
+        uint8_t encryptedCounters[kBatchBlocks * kCounterLength];
+
+        while (dataLen - dataIndex >= kCounterLength && UINT32_MAX - mMsgIndex >= kCounterLength)
+        {
+            size_t numBlocks = (dataLen - dataIndex) / kCounterLength;
+            size_t batchLen;
+
+            if (numBlocks > kBatchBlocks)
+                numBlocks = kBatchBlocks;
+            if (numBlocks > (UINT32_MAX - mMsgIndex) / kCounterLength)
+                numBlocks = (UINT32_MAX - mMsgIndex) / kCounterLength;
+            batchLen = numBlocks * kCounterLength;
+
+            EncryptCounterBlocks(encryptedCounters, numBlocks);
+
+            // XOR the data with the encrypted counters.
+            for (size_t i = 0; i < batchLen; i++)
+                outData[dataIndex + i] = inData[dataIndex + i] ^ encryptedCounters[i];
+
+            dataIndex += batchLen;
+            mMsgIndex += batchLen;
+        }
+
+        ClearSecretData(encryptedCounters, sizeof(encryptedCounters));
+    }
 
-    // For each byte of input data...
-    for (uint16_t dataIndex = 0; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
+    // For each remaining byte of input data...
+    for (; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
     {
         // If we need more encrypted counter bytes...
         if (encryptedCounterIndex == 0)
         {
             // Encrypt the next counter value.
-            mBlockCipher.EncryptBlock(Counter, mEncryptedCounter);
+            mKeyedBlockCipher->EncryptBlock(Counter, mEncryptedCounter);
 
-            // Bump the counter. Since the message size is at most UINT32_MAX (and the counter counts blocks)
-            // we will never need to update more than the four least-significant bytes.
-            Counter[kCounterLength-1]++;
-            if (Counter[kCounterLength-1] == 0)
-            {
-                Counter[kCounterLength-2]++;
-                if (Counter[kCounterLength-2] == 0)
-                {
-                    Counter[kCounterLength-3]++;
-                    if (Counter[kCounterLength-3] == 0)
-                    {
-                        Counter[kCounterLength-4]++;
-                    }
-                }
-            }
+            // Bump the counter.
+            IncrementCounter();
         }
 
         // XOR the data with the corresponding byte of the encrypted counter.
@@ -130,10 +163,53 @@ void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen,
     }
 }
 
+template <class BlockCipher>
+void CTRMode<BlockCipher>::IncrementCounter()
+{
+    // Since the message size is at most UINT32_MAX (and the counter counts blocks) we will never need
+    // to update more than the four least-significant bytes.
+    Counter[kCounterLength-1]++;
+    if (Counter[kCounterLength-1] == 0)
+    {
+        Counter[kCounterLength-2]++;
+        if (Counter[kCounterLength-2] == 0)
+        {
+            Counter[kCounterLength-3]++;
+            if (Counter[kCounterLength-3] == 0)
+            {
+                Counter[kCounterLength-4]++;
+            }
+        }
+    }
+}
+
+template <class BlockCipher>
+void CTRMode<BlockCipher>::EncryptCounterBlocks(uint8_t *outBlocks, size_t numBlocks)
+{
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+    // Lay out the successive counter values and encrypt them in place, letting the AES-NI
+    // implementation pipeline the blocks.
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+        memcpy(outBlocks + i * kCounterLength, Counter, kCounterLength);
+        IncrementCounter();
+    }
+
+    mKeyedBlockCipher->EncryptBlocks(outBlocks, outBlocks, numBlocks);
+#else
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+        mKeyedBlockCipher->EncryptBlock(Counter, outBlocks + i * kCounterLength);
+        IncrementCounter();
+    }
+#endif
+}
+
 template <class BlockCipher>
 void CTRMode<BlockCipher>::Reset()
 {
     mBlockCipher.Reset();
+    mKeyedBlockCipher = &mBlockCipher;
     mMsgIndex = 0;
     memset(Counter, 0, sizeof(Counter));
     ClearSecretData(mEncryptedCounter, sizeof(mEncryptedCounter));
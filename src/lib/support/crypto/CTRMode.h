@@ -53,6 +53,7 @@ public:
     uint8_t Counter[kCounterLength];
 
     void SetKey(const uint8_t *key);
+    void SetKey(BlockCipher &keyedBlockCipher);
     void SetCounter(const uint8_t *counter);
     void SetWeaveMessageCounter(uint64_t sendingNodeId, uint32_t msgId);
     void EncryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData);
@@ -60,9 +61,18 @@ public:
     void Reset(void);
 
 private:
+    enum
+    {
+        kBatchBlocks    = 8             // Number of counter blocks encrypted at once when processing whole blocks of data.
+    };
+
     BlockCipher mBlockCipher;
+    BlockCipher *mKeyedBlockCipher;
     uint32_t mMsgIndex;
     uint8_t mEncryptedCounter[kCounterLength];
+
+    void IncrementCounter(void);
+    void EncryptCounterBlocks(uint8_t *outBlocks, size_t numBlocks);
 };
 
 typedef CTRMode<Platform::Security::AES128BlockCipherEnc> AES128CTRMode;
@@ -53,6 +53,38 @@ HMAC<H>::~HMAC()
     Reset();
 }
 
+/**
+ * Compute the hash states with which HMAC computations under a given key begin and end.
+ *
+ * @param[in]  keyData          The key.
+ * @param[in]  keyLen           The length of the key.
+ * @param[out] outKey           The precomputed key.
+ */
+template <class H>
+void HMAC<H>::PrecomputeKey(const uint8_t *keyData, uint16_t keyLen, PrecomputedKey &outKey)
+{
+    HMAC<H> hmac;
+    uint8_t pad[kBlockLength];
+
+    // Begin an HMAC computation, which leaves the hash state after absorbing the inner pad.
+    hmac.Begin(keyData, keyLen);
+    outKey.InnerHash = hmac.mHash;
+
+    // Absorb the outer pad.
+    hmac.FormPad(pad, 0x5c);
+    outKey.OuterHash.Begin();
+    outKey.OuterHash.AddData(pad, kBlockLength);
+
+    ClearSecretData(pad, sizeof(pad));
+}
+
+template <class H>
+void HMAC<H>::PrecomputedKey::Reset()
+{
+    InnerHash.Reset();
+    OuterHash.Reset();
+}
+
 template <class H>
 void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
 {
@@ -75,11 +107,7 @@ void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
     }
 
     // Form the pad for the inner hash.
-    memcpy(pad, mKey, mKeyLen);
-    if (keyLen < kBlockLength)
-        memset(pad + mKeyLen, 0, kBlockLength - mKeyLen);
-    for (size_t i = 0; i < kBlockLength; i++)
-        pad[i] = pad[i] ^ 0x36;
+    FormPad(pad, 0x36);
 
     // Begin generating the inner hash starting with the pad.
     mHash.Begin();
@@ -88,6 +116,20 @@ void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
     ClearSecretData(pad, sizeof(kBlockLength));
 }
 
+/**
+ * Begin an HMAC computation under a precomputed key.
+ *
+ * @param[in]  key              The precomputed key, which must remain valid until Finish() is called.
+ */
+template <class H>
+void HMAC<H>::Begin(const PrecomputedKey &key)
+{
+    Reset();
+
+    mHash = key.InnerHash;
+    mPrecomputedKey = &key;
+}
+
 template <class H>
 void HMAC<H>::AddData(const uint8_t *msgData, uint16_t dataLen)
 {
@@ -113,16 +155,19 @@ void HMAC<H>::Finish(uint8_t *hashBuf)
     // Finalize the inner hash.
     mHash.Finish(innerHash);
 
-    // Form the pad for the outer hash.
-    memcpy(pad, mKey, mKeyLen);
-    if (mKeyLen < kBlockLength)
-        memset(pad + mKeyLen, 0, kBlockLength - mKeyLen);
-    for (size_t i = 0; i < kBlockLength; i++)
-        pad[i] = pad[i] ^ 0x5c;
-
     // Generate the outer hash from the pad and the inner hash.
-    mHash.Begin();
-    mHash.AddData(pad, kBlockLength);
+    if (mPrecomputedKey != NULL)
+    {
+        mHash = mPrecomputedKey->OuterHash;
+    }
+    else
+    {
+        // Form the pad for the outer hash.
+        FormPad(pad, 0x5c);
+
+        mHash.Begin();
+        mHash.AddData(pad, kBlockLength);
+    }
     mHash.AddData(innerHash, kDigestLength);
     mHash.Finish(hashBuf);
 
@@ -138,6 +183,18 @@ void HMAC<H>::Reset()
     mHash.Reset();
     ClearSecretData(mKey, sizeof(mKey));
     mKeyLen = 0;
+    mPrecomputedKey = NULL;
+}
+
+// Form the inner or outer pad from the key.
+template <class H>
+void HMAC<H>::FormPad(uint8_t *pad, uint8_t padByte) const
+{
+    memcpy(pad, mKey, mKeyLen);
+    if (mKeyLen < kBlockLength)
+        memset(pad + mKeyLen, 0, kBlockLength - mKeyLen);
+    for (size_t i = 0; i < kBlockLength; i++)
+        pad[i] = pad[i] ^ padByte;
 }
 
 template class HMAC<Platform::Security::SHA1>;
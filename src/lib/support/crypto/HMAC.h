@@ -50,10 +50,26 @@ public:
         kDigestLength           = H::kHashLength
     };
 
+    /**
+     *  @brief
+     *    The hash states that result from absorbing the inner and outer pads of a key, which can
+     *    be computed once and used to begin any number of HMAC computations under that key.
+     */
+    struct PrecomputedKey
+    {
+        H InnerHash;                            /**< The hash state after absorbing the inner pad. */
+        H OuterHash;                            /**< The hash state after absorbing the outer pad. */
+
+        void Reset(void);
+    };
+
     HMAC(void);
     ~HMAC(void);
 
+    static void PrecomputeKey(const uint8_t *keyData, uint16_t keyLen, PrecomputedKey &outKey);
+
     void Begin(const uint8_t *keyData, uint16_t keyLen);
+    void Begin(const PrecomputedKey &key);
     void AddData(const uint8_t *msgData, uint16_t dataLen);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
@@ -70,6 +86,9 @@ private:
     H mHash;
     uint8_t mKey[kBlockLength];
     uint16_t mKeyLen;
+    const PrecomputedKey *mPrecomputedKey;
+
+    void FormPad(uint8_t *pad, uint8_t padByte) const;
 };
 
 typedef HMAC<Platform::Security::SHA1> HMACSHA1;
@@ -70,6 +70,61 @@ WEAVE_ERROR Read(Key aKey, uint32_t &aValue);
  */
 WEAVE_ERROR Write(Key aKey, uint32_t aValue);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+/**
+ *  @brief
+ *    Read bytes from a segment of the persistent event spill store.
+ *    Bytes that have not been written since the segment was last
+ *    erased read as 0xFF.
+ *
+ *  @param[in]  aSegment  The segment, less than
+ *                        WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT.
+ *  @param[in]  aOffset   The offset of the first byte to read.
+ *  @param[out] aBuffer   The buffer receiving the bytes.
+ *  @param[in]  aLength   The number of bytes to read.
+ *
+ *  @return WEAVE_ERROR_INVALID_ARGUMENT if the bytes are not within
+ *                  the segment
+ *          WEAVE_ERROR_PERSISTED_STORAGE_FAIL if the read failed
+ *          WEAVE_NO_ERROR otherwise
+ */
+WEAVE_ERROR ReadSegment(uint8_t aSegment, uint32_t aOffset, uint8_t *aBuffer, uint32_t aLength);
+
+/**
+ *  @brief
+ *    Write bytes to a segment of the persistent event spill store.
+ *    The bytes are only ever written once between erasures of the
+ *    segment, in increasing order of offset.
+ *
+ *  @param[in] aSegment  The segment, less than
+ *                       WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT.
+ *  @param[in] aOffset   The offset of the first byte to write.
+ *  @param[in] aBuffer   The bytes to write.
+ *  @param[in] aLength   The number of bytes to write.
+ *
+ *  @return WEAVE_ERROR_INVALID_ARGUMENT if the bytes are not within
+ *                  the segment
+ *          WEAVE_ERROR_PERSISTED_STORAGE_FAIL if the write failed
+ *          WEAVE_NO_ERROR otherwise
+ */
+WEAVE_ERROR WriteSegment(uint8_t aSegment, uint32_t aOffset, const uint8_t *aBuffer, uint32_t aLength);
+
+/**
+ *  @brief
+ *    Erase a segment of the persistent event spill store.
+ *
+ *  @param[in] aSegment  The segment, less than
+ *                       WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT.
+ *
+ *  @return WEAVE_ERROR_INVALID_ARGUMENT if aSegment is out of range
+ *          WEAVE_ERROR_PERSISTED_STORAGE_FAIL if the erasure failed
+ *          WEAVE_NO_ERROR otherwise
+ */
+WEAVE_ERROR EraseSegment(uint8_t aSegment);
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
 } // PersistedStorage
 } // Platform
 } // Weave
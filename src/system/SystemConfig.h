@@ -102,6 +102,38 @@
 
 // clang-format off
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      This boolean configuration option is (1) if event readiness notification for the BSD sockets configuration is provided by
+ *      the Linux epoll(7) facility rather than by select(2).
+ *
+ *      When asserted, sockets are registered with a per-Layer epoll instance as their interest changes rather than being gathered
+ *      into fd_sets on every pass of the event loop, only ready descriptors are dispatched, and the wake pipe is replaced by an
+ *      eventfd(2) descriptor. The select-based interfaces remain available.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#define WEAVE_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#error "FORBIDDEN: WEAVE_SYSTEM_CONFIG_USE_EPOLL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS"
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL && !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      The maximum number of ready events retrieved from the epoll instance in a single pass of the event loop.
+ *
+ *      Applications typically size the event array passed to epoll_wait(2) with this value. Descriptors that remain ready beyond
+ *      this count are reported on the next pass.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
  *
@@ -375,6 +407,80 @@
 #endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 #endif /* !WEAVE_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+ *
+ *  @brief
+ *      This is the number of small packet buffers, each with #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY octets of capacity,
+ *      for the BSD sockets configuration with a bounded buffer pool (#WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC is not zero).
+ *
+ *      Requests for buffers are served from the smallest size class that fits, falling back to larger classes when it is
+ *      exhausted. #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC then gives the number of full-size buffers only.
+ *
+ *      This may be set to zero (0) to disable the small size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The capacity of a small packet buffer, including reserved header space, in octets. This is sized for acknowledgements and
+ *      other short control messages.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+ *
+ *  @brief
+ *      This is the number of medium packet buffers, each with #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY octets of
+ *      capacity. See #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC.
+ *
+ *      This may be set to zero (0) to disable the medium size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The capacity of a medium packet buffer, including reserved header space, in octets.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC)
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#error "FORBIDDEN: packet buffer size classes require WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0"
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 */
+#if (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY >= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY) || (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY >= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
+#error "FORBIDDEN: packet buffer size class capacities must be strictly increasing"
+#endif /* (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY >= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY) || ... */
+#endif /* !WEAVE_SYSTEM_CONFIG_USE_LWIP && (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC) */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the bounded packet buffer pool of the BSD sockets configuration is managed without a
+ *      mutex. When asserted, each size class keeps its free blocks on a lock-free stack and buffer reference counts are updated
+ *      with atomic operations, so that threads allocating and freeing buffers concurrently never block one another.
+ *
+ *  @note
+ *      The lock-free stack requires a 64-bit compare-and-swap.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE */
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -498,6 +604,50 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* WEAVE_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the Weave System Layer schedules timers with a hashed timing wheel rather than a
+ *      sorted list (LwIP) or a scan of the timer pool (sockets). With the timing wheel, starting and cancelling a timer take
+ *      constant time regardless of the number of pending timers.
+ *
+ *  @note
+ *      On sockets builds, work scheduled with nl::Weave::System::Layer::ScheduleWork from a thread other than the one owning
+ *      the system layer does not enter the wheel; it is still located with a scan of the timer pool, but only when such work
+ *      is pending.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif /* WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE
+ *
+ *  @brief
+ *      This is the number of slots in the timing wheel. It must be a power of two.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE
+#define WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE 256
+#endif /* WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE */
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && ((WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE & (WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE - 1)) != 0)
+#error "FORBIDDEN: WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE must be a power of two"
+#endif /* WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && ((WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE & (WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE - 1)) != 0) */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS
+ *
+ *  @brief
+ *      This is the span of time, in milliseconds, covered by one slot of the timing wheel. It only affects how timers are
+ *      distributed across slots; timers still expire with millisecond accuracy. The wheel completes one rotation every
+ *      WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE * WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS milliseconds, and timers further out
+ *      than that share slots with nearer timers.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS
+#define WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS 16
+#endif /* WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS */
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
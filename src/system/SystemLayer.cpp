@@ -40,6 +40,7 @@
 
 // Include system and language headers
 #include <stddef.h>
+#include <string.h>
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 #include <unistd.h>
@@ -47,6 +48,11 @@
 #include <errno.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if !WEAVE_SYSTEM_CONFIG_PLATFORM_PROVIDES_EVENT_FUNCTIONS
 #include <lwip/err.h>
@@ -95,14 +101,31 @@ Layer::Layer()
         sSystemEventHandlerDelegate.Init(HandleSystemLayerEvent);
 
     this->mEventDelegateList = NULL;
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     this->mTimerList = NULL;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     this->mTimerComplete = false;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    memset(this->mTimerWheel, 0, sizeof(this->mTimerWheel));
+    this->mExpiredTimers = NULL;
+    this->mTimerWheelTick = 0;
+    this->mTimerWheelEarliest = 0;
+    this->mNumWheelTimers = 0;
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    this->mNumScheduledWork = 0;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     this->mWakePipeIn = 0;
     this->mWakePipeOut = 0;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    this->mEpollFD = -1;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
@@ -112,7 +135,10 @@ Layer::Layer()
 Error Layer::Init(void* aContext)
 {
     Error lReturn;
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event lEvent;
+    int lOSReturn;
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     int lPipeFDs[2];
     int lOSReturn, lFlags;
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -135,7 +161,24 @@ Error Layer::Init(void* aContext)
     this->AddEventHandlerDelegate(sSystemEventHandlerDelegate);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Create an eventfd to allow an arbitrary thread to wake the thread in the event loop. The same descriptor serves as both
+    // ends of the "wake pipe".
+    lOSReturn = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    VerifyOrExit(lOSReturn >= 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+
+    this->mWakePipeIn = lOSReturn;
+    this->mWakePipeOut = lOSReturn;
+
+    this->mEpollFD = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrExit(this->mEpollFD >= 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+
+    // The wake descriptor is the only one registered with a NULL data pointer; socket endpoints always supply themselves.
+    lEvent.events = EPOLLIN;
+    lEvent.data.ptr = NULL;
+    lOSReturn = ::epoll_ctl(this->mEpollFD, EPOLL_CTL_ADD, this->mWakePipeIn, &lEvent);
+    VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     // Create a Unix pipe to allow an arbitrary thread to wake the thread in the select loop.
     lOSReturn = ::pipe(lPipeFDs);
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
@@ -153,6 +196,16 @@ Error Layer::Init(void* aContext)
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    lReturn = Mutex::Init(this->mTimerWheelLock);
+    SuccessOrExit(lReturn);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+
+    // Start the wheel at the current time so that the first expiration pass does not needlessly visit every slot.
+    this->mTimerWheelTick = Timer::GetCurrentEpoch() / WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS;
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext = aContext;
 
@@ -182,6 +235,14 @@ Error Layer::Shutdown()
     }
 #endif
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    if (this->mEpollFD != -1)
+    {
+        ::close(this->mEpollFD);
+        this->mEpollFD = -1;
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -571,9 +632,33 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
 
     FD_SET(this->mWakePipeIn, aReadSet);
 
+    this->ComputeSleepTime(aSleepTime);
+}
+
+/**
+ *  Reduce the specified maximum sleep time so that the event loop wakes no later than the earliest pending timer.
+ *
+ *  @param[inout]   aSleepTime  A reference to the maximum sleep time.
+ */
+void Layer::ComputeSleepTime(struct timeval& aSleepTime)
+{
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch = kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + aSleepTime.tv_usec / 1000;
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // The earliest wheel epoch is a lower bound: a cancelled timer may cause one early wakeup, after which it is recomputed.
+    this->LockTimerWheel();
+    if (this->mNumScheduledWork != 0 ||
+        (this->mNumWheelTimers != 0 && !Timer::IsEarlierEpoch(kCurrentEpoch, this->mTimerWheelEarliest)))
+    {
+        lAwakenEpoch = kCurrentEpoch;
+    }
+    else if (this->mNumWheelTimers != 0 && Timer::IsEarlierEpoch(this->mTimerWheelEarliest, lAwakenEpoch))
+    {
+        lAwakenEpoch = this->mTimerWheelEarliest;
+    }
+    this->UnlockTimerWheel();
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -590,6 +675,7 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
                 lAwakenEpoch = lTimer->mAwakenEpoch;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     const Timer::Epoch kSleepTime = lAwakenEpoch - kCurrentEpoch;
     aSleepTime.tv_sec = kSleepTime / 1000;
@@ -615,39 +701,85 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
  */
 void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd_set* aExceptionSet)
 {
-    pthread_t lThreadSelf;
-
     if (this->State() != kLayerState_Initialized)
         return;
 
     if (aSetSize < 0)
         return;
 
-#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
-    lThreadSelf = pthread_self();
-#endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+    // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
+    if (aSetSize > 0 && FD_ISSET(this->mWakePipeIn, aReadSet))
+    {
+        this->DrainWakeEvents();
+    }
+
+    this->HandleTimerExpirations();
+}
 
-    if (aSetSize > 0)
+/**
+ *  Clear any pending wake notifications so that the wake descriptor is no longer readable.
+ */
+void Layer::DrainWakeEvents(void)
+{
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Reading an eventfd returns and resets its counter in a single operation.
+    uint64_t lCount;
+    const ssize_t kIOResult = ::read(this->mWakePipeIn, &lCount, sizeof(lCount));
+    static_cast<void>(kIOResult);
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    while (true)
     {
-        // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
-        if (FD_ISSET(this->mWakePipeIn, aReadSet))
-        {
-            while (true)
-            {
-                uint8_t lBytes[128];
-                int lTmp = ::read(this->mWakePipeIn, static_cast<void*>(lBytes), sizeof(lBytes));
-                if (lTmp < static_cast<int>(sizeof(lBytes)))
-                    break;
-            }
-        }
+        uint8_t lBytes[128];
+        int lTmp = ::read(this->mWakePipeIn, static_cast<void*>(lBytes), sizeof(lBytes));
+        if (lTmp < static_cast<int>(sizeof(lBytes)))
+            break;
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
+}
+
+/**
+ *  Invoke the completion handlers of all timers whose awaken epoch has passed.
+ */
+void Layer::HandleTimerExpirations(void)
+{
+#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+    const pthread_t lThreadSelf = pthread_self();
+#endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = lThreadSelf;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // Work scheduled from other threads never enters the wheel, so the pool is scanned for it, but only when some is pending.
+    if (__sync_lock_test_and_set(&this->mNumScheduledWork, 0) != 0)
+    {
+        for (size_t i = 0; i < Timer::sPool.Size(); i++)
+        {
+            Timer* lTimer = Timer::sPool.Get(*this, i);
+            bool lIsScheduledWork = false;
+
+            // Timer::Start() arms and links a timer under the wheel lock, so an armed timer found unlinked here is scheduled work.
+            if (lTimer != NULL)
+            {
+                this->LockTimerWheel();
+                lIsScheduledWork = (lTimer->mPrevNextTimer == NULL && lTimer->OnComplete != NULL);
+                this->UnlockTimerWheel();
+            }
+
+            if (lIsScheduledWork)
+            {
+                lTimer->HandleComplete();
+            }
+        }
+    }
+
+    Timer::HandleExpiredWheelTimers(*this);
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -657,6 +789,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
             lTimer->HandleComplete();
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
@@ -685,14 +818,156 @@ void Layer::WakeSelect()
     }
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    // Increment the eventfd counter to wake up the epoll_wait call.
+    const uint64_t kIncrement = 1;
+    const ssize_t kIOResult = ::write(this->mWakePipeOut, &kIncrement, sizeof(kIncrement));
+#else // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     // Write a single byte to the wake pipe to wake up the select call.
     const uint8_t kByte = 0;
     const ssize_t kIOResult = ::write(this->mWakePipeOut, &kByte, 1);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_EPOLL
     static_cast<void>(kIOResult);
 }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+/**
+ *  Register a socket with the epoll instance of this layer.
+ *
+ *  @param[in]  aSocket     The socket descriptor to watch.
+ *  @param[in]  aEvents     The epoll event mask (e.g. EPOLLIN, EPOLLOUT) of interest.
+ *  @param[in]  aData       An opaque, non-NULL pointer returned in the \c data.ptr field of each ready event for the socket.
+ *
+ *  @retval     WEAVE_SYSTEM_NO_ERROR               On success.
+ *  @retval     WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE If the layer is not initialized.
+ *  @retval     WEAVE_SYSTEM_ERROR_BAD_ARGS         If @a aData is NULL, which is reserved for the wake descriptor.
+ *  @retval     other                               A POSIX error mapped from the failing epoll_ctl(2) call.
+ */
+Error Layer::AddSocketWatch(int aSocket, uint32_t aEvents, void* aData)
+{
+    struct epoll_event lEvent;
+
+    if (this->State() != kLayerState_Initialized)
+        return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    if (aData == NULL)
+        return WEAVE_SYSTEM_ERROR_BAD_ARGS;
+
+    lEvent.events = aEvents;
+    lEvent.data.ptr = aData;
+
+    if (::epoll_ctl(this->mEpollFD, EPOLL_CTL_ADD, aSocket, &lEvent) != 0)
+        return nl::Weave::System::MapErrorPOSIX(errno);
+
+    return WEAVE_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Change the events of interest for a socket previously registered with AddSocketWatch().
+ *
+ *  @param[in]  aSocket     The socket descriptor being watched.
+ *  @param[in]  aEvents     The new epoll event mask of interest.
+ *  @param[in]  aData       The opaque, non-NULL pointer returned in each ready event for the socket.
+ *
+ *  @retval     WEAVE_SYSTEM_NO_ERROR               On success.
+ *  @retval     WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE If the layer is not initialized.
+ *  @retval     WEAVE_SYSTEM_ERROR_BAD_ARGS         If @a aData is NULL.
+ *  @retval     other                               A POSIX error mapped from the failing epoll_ctl(2) call.
+ */
+Error Layer::UpdateSocketWatch(int aSocket, uint32_t aEvents, void* aData)
+{
+    struct epoll_event lEvent;
+
+    if (this->State() != kLayerState_Initialized)
+        return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    if (aData == NULL)
+        return WEAVE_SYSTEM_ERROR_BAD_ARGS;
+
+    lEvent.events = aEvents;
+    lEvent.data.ptr = aData;
+
+    if (::epoll_ctl(this->mEpollFD, EPOLL_CTL_MOD, aSocket, &lEvent) != 0)
+        return nl::Weave::System::MapErrorPOSIX(errno);
+
+    return WEAVE_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Remove a socket from the epoll instance of this layer. This must be called before the socket is closed.
+ *
+ *  @param[in]  aSocket     The socket descriptor being watched.
+ *
+ *  @retval     WEAVE_SYSTEM_NO_ERROR               On success.
+ *  @retval     WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE If the layer is not initialized.
+ *  @retval     other                               A POSIX error mapped from the failing epoll_ctl(2) call.
+ */
+Error Layer::RemoveSocketWatch(int aSocket)
+{
+    // Kernels prior to 2.6.9 require a non-NULL event argument even for EPOLL_CTL_DEL.
+    struct epoll_event lEvent;
+
+    if (this->State() != kLayerState_Initialized)
+        return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    lEvent.events = 0;
+    lEvent.data.ptr = NULL;
+
+    if (::epoll_ctl(this->mEpollFD, EPOLL_CTL_DEL, aSocket, &lEvent) != 0)
+        return nl::Weave::System::MapErrorPOSIX(errno);
+
+    return WEAVE_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Prepare to wait on the epoll instance returned by GetEpollFD().
+ *
+ *  Unlike PrepareSelect(), no per-descriptor work is done here: the wake descriptor and socket endpoints are registered with the
+ *  epoll instance once and updated only when their interest changes.
+ *
+ *  @param[inout]   aSleepTime  A reference to the maximum sleep time, reduced to the time until the earliest pending timer.
+ */
+void Layer::PrepareEpoll(struct timeval& aSleepTime)
+{
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+    this->ComputeSleepTime(aSleepTime);
+}
+
+/**
+ *  Handle the result of an epoll_wait(2) call on the epoll instance returned by GetEpollFD(). This clears any pending wake
+ *  notification and invokes the handlers of expired timers. Events for socket endpoints are ignored here and are dispatched by
+ *  the layer that registered them (e.g. nl::Inet::InetLayer::HandleEpollResult).
+ *
+ *  @param[in]  aNumEvents  The return value of the epoll_wait call.
+ *  @param[in]  aEvents     A pointer to the array of ready events filled in by the epoll_wait call.
+ */
+void Layer::HandleEpollResult(int aNumEvents, const struct epoll_event* aEvents)
+{
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+    if (aNumEvents < 0)
+        return;
+
+    for (int i = 0; i < aNumEvents; i++)
+    {
+        if (aEvents[i].data.ptr == NULL)
+        {
+            this->DrainWakeEvents();
+            break;
+        }
+    }
+
+    this->HandleTimerExpirations();
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 LwIPEventHandlerDelegate Layer::sSystemEventHandlerDelegate;
 
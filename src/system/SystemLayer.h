@@ -34,6 +34,10 @@
 #include <sys/select.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 #include <pthread.h>
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
@@ -43,6 +47,7 @@
 #include <SystemLayer/SystemError.h>
 #include <SystemLayer/SystemObject.h>
 #include <SystemLayer/SystemEvent.h>
+#include <SystemLayer/SystemMutex.h>
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
@@ -129,7 +134,8 @@ private:
  *      This provides access to timers according to the configured event handling model.
  *
  *      For \c WEAVE_SYSTEM_CONFIG_USE_SOCKETS, event readiness notification is handled via traditional poll/select implementation on
- *      the platform adaptation.
+ *      the platform adaptation. When \c WEAVE_SYSTEM_CONFIG_USE_EPOLL is also asserted, readiness may instead be obtained from the
+ *      epoll instance returned by GetEpollFD(), using PrepareEpoll() and HandleEpollResult().
  *
  *      For \c WEAVE_SYSTEM_CONFIG_USE_LWIP, event readiness notification is handle via events / messages and platform- and
  *      system-specific hooks for the event/message system.
@@ -161,6 +167,16 @@ public:
     void WakeSelect(void);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    int GetEpollFD(void) const;
+    Error AddSocketWatch(int aSocket, uint32_t aEvents, void* aData);
+    Error UpdateSocketWatch(int aSocket, uint32_t aEvents, void* aData);
+    Error RemoveSocketWatch(int aSocket);
+
+    void PrepareEpoll(struct timeval& aSleepTime);
+    void HandleEpollResult(int aNumEvents, const struct epoll_event* aEvents);
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     typedef Error (*EventHandler)(Object& aTarget, EventType aEventType, uintptr_t aArgument);
     Error AddEventHandlerDelegate(LwIPEventHandlerDelegate& aDelegate);
@@ -191,19 +207,48 @@ private:
     static LwIPEventHandlerDelegate sSystemEventHandlerDelegate;
 
     const LwIPEventHandlerDelegate* mEventDelegateList;
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Timer* mTimerList;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     bool mTimerComplete;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer* mTimerWheel[WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE];
+    Timer* mExpiredTimers;
+    uint64_t mTimerWheelTick;
+    uint64_t mTimerWheelEarliest;
+    size_t mNumWheelTimers;
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    volatile unsigned int mNumScheduledWork;
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    Mutex mTimerWheelLock;
+#endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+    void LockTimerWheel(void);
+    void UnlockTimerWheel(void);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     int mWakePipeIn;
     int mWakePipeOut;
 
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    int mEpollFD;
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    void ComputeSleepTime(struct timeval& aSleepTime);
+    void DrainWakeEvents(void);
+    void HandleTimerExpirations(void);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     static Error HandleSystemLayerEvent(Object& aTarget, EventType aEventType, uintptr_t aArgument);
 
@@ -235,6 +280,39 @@ inline LayerState Layer::State(void) const
     return this->mLayerState;
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ * This acquires the lock guarding the timing wheel lists. Timers may be started and cancelled from any thread on sockets builds,
+ * whereas LwIP builds only touch the wheel from the thread running the LwIP core.
+ */
+inline void Layer::LockTimerWheel(void)
+{
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    this->mTimerWheelLock.Lock();
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+}
+
+/**
+ * This releases the lock acquired by LockTimerWheel().
+ */
+inline void Layer::UnlockTimerWheel(void)
+{
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+    this->mTimerWheelLock.Unlock();
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+/**
+ * This returns the epoll instance descriptor on which the application should wait for I/O readiness and wake events.
+ */
+inline int Layer::GetEpollFD(void) const
+{
+    return this->mEpollFD;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
 } // namespace System
 } // namespace Weave
 } // namespace nl
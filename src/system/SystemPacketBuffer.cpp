@@ -65,19 +65,210 @@ namespace System {
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#define PACKETBUFFER_LOCKFREE WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE
+
 static BufferPoolElement sBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
 
-PacketBuffer* PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY];
+} SmallBufferPoolElement;
+
+static SmallBufferPoolElement sSmallBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC];
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY];
+} MediumBufferPoolElement;
+
+static MediumBufferPoolElement sMediumBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC];
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
+/**
+ *  One size class of the bounded buffer pool: an array of equally sized blocks and the list of those that are free.
+ */
+struct BufferPool
+{
+    uint8_t* const mBlocks;
+    const size_t mBlockSize;
+    const uint16_t mNumBlocks;
+    const uint16_t mCapacity;           /**< Octets available for reserved space and data in each block. */
+#if PACKETBUFFER_LOCKFREE
+    volatile uint64_t mFreeHead;        /**< Generation count in the upper 32 bits, index of the first free block plus one below. */
+#else // !PACKETBUFFER_LOCKFREE
+    pbuf* mFreeList;
+#endif // !PACKETBUFFER_LOCKFREE
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+    const int mStatsEntry;              /**< Per-class statistics entry, or -1 if the class only counts towards the total. */
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+};
+
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+#define BUFFER_POOL_STATS_ENTRY(entry)  , (entry)
+#else // !WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+#define BUFFER_POOL_STATS_ENTRY(entry)
+#endif // !WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+
+// Size classes in increasing order of capacity; the full-size class is always last.
+static BufferPool sBufferPools[] =
+{
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    { sSmallBufferPool[0].Block, sizeof(sSmallBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC,
+      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY, 0 BUFFER_POOL_STATS_ENTRY(Stats::kSystemLayer_NumSmallPacketBufs) },
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sMediumBufferPool[0].Block, sizeof(sMediumBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC,
+      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY, 0 BUFFER_POOL_STATS_ENTRY(Stats::kSystemLayer_NumMediumPacketBufs) },
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sBufferPool[0].Block, sizeof(sBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC,
+      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX, 0 BUFFER_POOL_STATS_ENTRY(-1) },
+};
+
+static const size_t kNumBufferPools = sizeof(sBufferPools) / sizeof(sBufferPools[0]);
+
+static inline pbuf* GetBlock(const BufferPool& aPool, uint32_t aIndex)
+{
+    return reinterpret_cast<pbuf*>(aPool.mBlocks + aIndex * aPool.mBlockSize);
+}
+
+static inline bool PoolContains(const BufferPool& aPool, const void* aBlock)
+{
+    const uintptr_t lBase = reinterpret_cast<uintptr_t>(aPool.mBlocks);
+    const uintptr_t lBlock = reinterpret_cast<uintptr_t>(aBlock);
+
+    return lBlock >= lBase && lBlock < lBase + aPool.mNumBlocks * aPool.mBlockSize;
+}
+
+static BufferPool* FindBufferPool(const void* aBlock)
+{
+    for (size_t i = 0; i < kNumBufferPools; i++)
+    {
+        if (PoolContains(sBufferPools[i], aBlock))
+            return &sBufferPools[i];
+    }
+
+    return NULL;
+}
+
+#if PACKETBUFFER_LOCKFREE
+
+static inline uint32_t GetBlockIndex(const BufferPool& aPool, const void* aBlock)
+{
+    return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(aBlock) - reinterpret_cast<uintptr_t>(aPool.mBlocks)) /
+        aPool.mBlockSize);
+}
+
+static inline uint64_t MakeFreeHead(uint64_t aOldHead, uint32_t aIndexPlusOne)
+{
+    // Bumping the generation on every update keeps a stale head from being swapped back in after its block was popped and
+    // pushed again (the ABA problem).
+    return ((aOldHead >> 32) + 1) << 32 | aIndexPlusOne;
+}
+
+#endif // PACKETBUFFER_LOCKFREE
+
+/**
+ *  Take a block off the free list of a size class. Unless the pool is lock-free, the caller must hold the pool lock.
+ *
+ *  @return     The block, or \c NULL if the size class is exhausted.
+ */
+static pbuf* PopFreeBlock(BufferPool& aPool)
+{
+#if PACKETBUFFER_LOCKFREE
+    uint64_t lHead;
+    pbuf* lBlock;
+    uint32_t lNextIndexPlusOne;
+
+    do
+    {
+        lHead = aPool.mFreeHead;
+        if (static_cast<uint32_t>(lHead) == 0)
+            return NULL;
 
-#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+        lBlock = GetBlock(aPool, static_cast<uint32_t>(lHead) - 1);
+
+        // The block may be popped by another thread before the swap below, in which case the link read here is stale but the
+        // swap fails on the generation count.
+        const pbuf* const lNext = *static_cast<pbuf* volatile*>(&lBlock->next);
+        lNextIndexPlusOne = (lNext == NULL) ? 0 : GetBlockIndex(aPool, lNext) + 1;
+    }
+    while (!__sync_bool_compare_and_swap(&aPool.mFreeHead, lHead, MakeFreeHead(lHead, lNextIndexPlusOne)));
+
+    return lBlock;
+#else // !PACKETBUFFER_LOCKFREE
+    pbuf* const lBlock = aPool.mFreeList;
+
+    if (lBlock != NULL)
+        aPool.mFreeList = lBlock->next;
+
+    return lBlock;
+#endif // !PACKETBUFFER_LOCKFREE
+}
+
+/**
+ *  Return a block to the free list of its size class. Unless the pool is lock-free, the caller must hold the pool lock.
+ */
+static void PushFreeBlock(BufferPool& aPool, pbuf* aBlock)
+{
+#if PACKETBUFFER_LOCKFREE
+    const uint32_t lIndexPlusOne = GetBlockIndex(aPool, aBlock) + 1;
+    uint64_t lHead;
+
+    do
+    {
+        lHead = aPool.mFreeHead;
+        aBlock->next = (static_cast<uint32_t>(lHead) == 0) ? NULL : GetBlock(aPool, static_cast<uint32_t>(lHead) - 1);
+    }
+    while (!__sync_bool_compare_and_swap(&aPool.mFreeHead, lHead, MakeFreeHead(lHead, lIndexPlusOne)));
+#else // !PACKETBUFFER_LOCKFREE
+    aBlock->next = aPool.mFreeList;
+    aPool.mFreeList = aBlock;
+#endif // !PACKETBUFFER_LOCKFREE
+}
+
+bool PacketBuffer::sFreeListsBuilt = PacketBuffer::BuildFreeList();
+
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !PACKETBUFFER_LOCKFREE
 static Mutex sBufferPoolMutex;
 
 #define LOCK_BUF_POOL()     do { sBufferPoolMutex.Lock(); } while (0)
 #define UNLOCK_BUF_POOL()   do { sBufferPoolMutex.Unlock(); } while (0)
-#endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+#endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !PACKETBUFFER_LOCKFREE
+
+#if PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+// Without the pool mutex the counts are updated atomically; a high watermark may still lag briefly under contention.
+#define BUFFER_POOL_STATS_INCREMENT(entry) \
+    do { \
+        const nl::Weave::System::Stats::count_t lNewValue = \
+            __sync_add_and_fetch(&nl::Weave::System::Stats::GetResourcesInUse()[entry], 1); \
+        if (nl::Weave::System::Stats::GetHighWatermarks()[entry] < lNewValue) \
+        { \
+            nl::Weave::System::Stats::GetHighWatermarks()[entry] = lNewValue; \
+        } \
+    } while (0)
+
+#define BUFFER_POOL_STATS_DECREMENT(entry) \
+    do { \
+        __sync_sub_and_fetch(&nl::Weave::System::Stats::GetResourcesInUse()[entry], 1); \
+    } while (0)
+#endif // PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
 #endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#ifndef PACKETBUFFER_LOCKFREE
+#define PACKETBUFFER_LOCKFREE 0
+#endif // !defined(PACKETBUFFER_LOCKFREE)
+
+#ifndef BUFFER_POOL_STATS_INCREMENT
+#define BUFFER_POOL_STATS_INCREMENT(entry)  SYSTEM_STATS_INCREMENT(entry)
+#define BUFFER_POOL_STATS_DECREMENT(entry)  SYSTEM_STATS_DECREMENT(entry)
+#endif // !defined(BUFFER_POOL_STATS_INCREMENT)
+
 #ifndef LOCK_BUF_POOL
 #define LOCK_BUF_POOL()     do { } while (0)
 #endif // !defined(LOCK_BUF_POOL)
@@ -419,11 +610,13 @@ void PacketBuffer::AddRef()
 {
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     pbuf_ref(this);
-#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#elif PACKETBUFFER_LOCKFREE
+    __sync_add_and_fetch(&this->ref, 1);
+#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !PACKETBUFFER_LOCKFREE
     LOCK_BUF_POOL();
     ++this->ref;
     UNLOCK_BUF_POOL();
-#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !PACKETBUFFER_LOCKFREE
 }
 
 /**
@@ -458,13 +651,29 @@ PacketBuffer* PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+    lPacket = NULL;
+
     LOCK_BUF_POOL();
 
-    lPacket = sFreeList;
-    if (lPacket != NULL)
+    // Serve the request from the smallest size class that fits and still has a free block.
+    for (size_t i = 0; i < kNumBufferPools && lPacket == NULL; i++)
     {
-        sFreeList = static_cast<PacketBuffer*>(lPacket->next);
-        SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+        BufferPool& lPool = sBufferPools[i];
+
+        if (lAllocSize > lPool.mCapacity)
+            continue;
+
+        lPacket = reinterpret_cast<PacketBuffer*>(PopFreeBlock(lPool));
+        if (lPacket != NULL)
+        {
+            BUFFER_POOL_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+            if (lPool.mStatsEntry >= 0)
+            {
+                BUFFER_POOL_STATS_INCREMENT(lPool.mStatsEntry);
+            }
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+        }
     }
 
     UNLOCK_BUF_POOL();
@@ -577,16 +786,32 @@ void PacketBuffer::Free(PacketBuffer* aPacket)
     {
         PacketBuffer* lNextPacket = static_cast<PacketBuffer*>(aPacket->next);
 
+#if PACKETBUFFER_LOCKFREE
+        const uint16_t lOldRef = __sync_fetch_and_sub(&aPacket->ref, 1);
+
+        VerifyOrDieWithMsg(lOldRef > 0, WeaveSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
+
+        if (lOldRef == 1)
+#else // !PACKETBUFFER_LOCKFREE
         VerifyOrDieWithMsg(aPacket->ref > 0, WeaveSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
 
         aPacket->ref--;
         if (aPacket->ref == 0)
+#endif // !PACKETBUFFER_LOCKFREE
         {
-            SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+            BUFFER_POOL_STATS_DECREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
             aPacket->Clear();
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket->next = sFreeList;
-            sFreeList = aPacket;
+            BufferPool* const lPool = FindBufferPool(aPacket);
+
+            VerifyOrDieWithMsg(lPool != NULL, WeaveSystemLayer, "SystemPacketBuffer::Free: %p is not a pool buffer", aPacket);
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+            if (lPool->mStatsEntry >= 0)
+            {
+                BUFFER_POOL_STATS_DECREMENT(lPool->mStatsEntry);
+            }
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+            PushFreeBlock(*lPool, reinterpret_cast<pbuf*>(aPacket));
 #else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
             free(aPacket);
 #endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
@@ -661,22 +886,37 @@ PacketBuffer* PacketBuffer::RightSize(PacketBuffer *aPacket)
 
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
-PacketBuffer* PacketBuffer::BuildFreeList()
+bool PacketBuffer::BuildFreeList()
 {
-    PacketBuffer* lHead = NULL;
-
-    for (int i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+    for (size_t i = 0; i < kNumBufferPools; i++)
     {
-        PacketBuffer* lCursor = &sBufferPool[i].Header;
-        lCursor->next = lHead;
-        lCursor->ref = 0;
-        lHead = lCursor;
+        BufferPool& lPool = sBufferPools[i];
+
+        for (uint32_t j = 0; j < lPool.mNumBlocks; j++)
+        {
+            pbuf* const lCursor = GetBlock(lPool, j);
+            lCursor->ref = 0;
+            PushFreeBlock(lPool, lCursor);
+        }
     }
 
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !PACKETBUFFER_LOCKFREE
     Mutex::Init(sBufferPoolMutex);
+#endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !PACKETBUFFER_LOCKFREE
+
+    return true;
+}
+
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+size_t PacketBuffer::PoolAllocSize() const
+{
+    const BufferPool* const lPool = FindBufferPool(this);
+
+    VerifyOrDieWithMsg(lPool != NULL, WeaveSystemLayer, "SystemPacketBuffer::PoolAllocSize: %p is not a pool buffer", this);
 
-    return lHead;
+    return lPool->mCapacity;
 }
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
 
 #endif //  !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
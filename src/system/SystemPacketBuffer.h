@@ -43,6 +43,18 @@
 #include <lwip/memp.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+/**
+ * @def WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  Whether (1) or not (0) the bounded packet buffer pool has more than one size class.
+ */
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && \
+    (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC)
+#define WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES 1
+#else
+#define WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES 0
+#endif
+
 namespace nl {
 namespace Weave {
 namespace System {
@@ -135,11 +147,15 @@ public:
 
 private:
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-    static PacketBuffer* sFreeList;
+    static bool sFreeListsBuilt;
 
-    static PacketBuffer* BuildFreeList(void);
+    static bool BuildFreeList(void);
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+    size_t PoolAllocSize(void) const;
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+
     void Clear(void);
 };
 
@@ -227,6 +243,8 @@ inline size_t PacketBuffer::AllocSize(void) const
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     return static_cast<size_t>(this->alloc_size);
+#elif WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+    return this->PoolAllocSize();
 #else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
     extern BufferPoolElement gDummyBufferPoolElement;
     return sizeof(gDummyBufferPoolElement.Block) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
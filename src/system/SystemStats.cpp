@@ -46,6 +46,12 @@ static const Label sStatsStrings[nl::Weave::System::Stats::kNumEntries] =
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    "SystemLayer_NumSmallPacketBufs",
+#endif
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    "SystemLayer_NumMediumPacketBufs",
+#endif
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
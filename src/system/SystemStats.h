@@ -55,6 +55,12 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    kSystemLayer_NumSmallPacketBufs,
+#endif
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    kSystemLayer_NumMediumPacketBufs,
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -131,12 +131,31 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
 
     this->AppState = aAppState;
     this->mAwakenEpoch = Timer::GetCurrentEpoch() + static_cast<Epoch>(aDelayMilliseconds);
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // Arm and link the timer as one step, so that neither Cancel() nor the scan for scheduled work can observe an armed timer
+    // that is not yet in the wheel.
+    lLayer.LockTimerWheel();
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     if (!__sync_bool_compare_and_swap(&this->OnComplete, NULL, aOnComplete))
     {
         WeaveDie();
     }
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    // if this is the new earliest timer the platform timer needs (re-)starting provided that the system is not currently
+    // processing expired timers, in which case it is left to HandleExpiredTimers() to re-start the timer.
+    if (this->AddToWheel(lLayer) && !lLayer.mTimerComplete)
+    {
+        lLayer.StartPlatformTimer(aDelayMilliseconds);
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    this->AddToWheel(lLayer);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    lLayer.UnlockTimerWheel();
+#elif WEAVE_SYSTEM_CONFIG_USE_LWIP
     // add to the sorted list of timers. Earliest timer appears first.
     if (lLayer.mTimerList == NULL ||
         this->IsEarlierEpoch(this->mAwakenEpoch, lLayer.mTimerList->mAwakenEpoch))
@@ -194,6 +213,10 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
     err = lLayer.PostEvent(*this, Weave::System::kEvent_ScheduleWork, 0);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // This may run on any thread, so the timer stays out of the wheel; flag the layer to look for it instead.
+    __sync_fetch_and_add(&lLayer.mNumScheduledWork, 1);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     lLayer.WakeSelect();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -207,9 +230,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
  */
 Error Timer::Cancel()
 {
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Layer& lLayer = this->SystemLayer();
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -220,7 +243,15 @@ Error Timer::Cancel()
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = NULL;
 
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // Timers started with ScheduleWork() on sockets builds are not linked into the wheel.
+    lLayer.LockTimerWheel();
+    if (this->mPrevNextTimer != NULL)
+    {
+        this->UnlinkTimer();
+    }
+    lLayer.UnlockTimerWheel();
+#elif WEAVE_SYSTEM_CONFIG_USE_LWIP
     if (lLayer.mTimerList)
     {
         if (this == lLayer.mTimerList)
@@ -296,6 +327,28 @@ exit:
  */
 Error Timer::HandleExpiredTimers(Layer& aLayer)
 {
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    aLayer.mTimerComplete = true;
+    Timer::HandleExpiredWheelTimers(aLayer);
+    aLayer.mTimerComplete = false;
+
+    if (aLayer.mNumWheelTimers != 0)
+    {
+        // timers still exist so restart the platform timer.
+        const Epoch currentEpoch = Timer::GetCurrentEpoch();
+        uint64_t delayMilliseconds = 0ULL;
+
+        if (currentEpoch < aLayer.mTimerWheelEarliest)
+        {
+            delayMilliseconds = aLayer.mTimerWheelEarliest - currentEpoch;
+        }
+
+        // See the note on clock adjustments below.
+        VerifyOrDie(delayMilliseconds <= UINT32_MAX);
+
+        aLayer.StartPlatformTimer(static_cast<uint32_t>(delayMilliseconds));
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     size_t timersHandled = 0;
 
     // Expire each timer in turn until an unexpired timer is reached or the timerlist is emptied.  We set the current expiration
@@ -345,11 +398,166 @@ Error Timer::HandleExpiredTimers(Layer& aLayer)
             break; // all remaining timers are still ticking.
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     return WEAVE_SYSTEM_NO_ERROR;
 }
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ *  Insert the timer into a list at the position referenced by @p aLink, which is either a list head or the @p mNextTimer member
+ *  of another timer.
+ */
+void Timer::LinkTimer(Timer*& aLink)
+{
+    this->mNextTimer = aLink;
+    if (this->mNextTimer != NULL)
+        this->mNextTimer->mPrevNextTimer = &this->mNextTimer;
+
+    this->mPrevNextTimer = &aLink;
+    aLink = this;
+
+    this->SystemLayer().mNumWheelTimers++;
+}
+
+/**
+ *  Remove the timer from whichever wheel slot or expired list it is on.
+ */
+void Timer::UnlinkTimer(void)
+{
+    *this->mPrevNextTimer = this->mNextTimer;
+    if (this->mNextTimer != NULL)
+        this->mNextTimer->mPrevNextTimer = this->mPrevNextTimer;
+
+    this->mNextTimer = NULL;
+    this->mPrevNextTimer = NULL;
+
+    this->SystemLayer().mNumWheelTimers--;
+}
+
+/**
+ *  Insert the timer into the timing wheel slot covering its awaken epoch.
+ *
+ *  @return true if the timer may now be the earliest pending timer, false otherwise.
+ */
+bool Timer::AddToWheel(Layer& aLayer)
+{
+    const uint64_t lTick = this->mAwakenEpoch / WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS;
+    const bool lIsEarliest = (aLayer.mNumWheelTimers == 0) || Timer::IsEarlierEpoch(this->mAwakenEpoch, aLayer.mTimerWheelEarliest);
+
+    this->LinkTimer(aLayer.mTimerWheel[lTick & (WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE - 1)]);
+
+    // mTimerWheelEarliest is kept as a lower bound on the awaken epoch of every timer in the wheel.
+    if (lIsEarliest)
+        aLayer.mTimerWheelEarliest = this->mAwakenEpoch;
+
+    return lIsEarliest;
+}
+
+/**
+ *  Complete the timers in the timing wheel that have expired.
+ *
+ *  @brief
+ *      Visits only the slots between the last pass and the current time. Expired timers are first moved onto the layer's expired
+ *      list and only then completed, so that a timer started from within a completion handler cannot be expired in the same
+ *      pass, and a timer cancelled from within a completion handler is simply removed from the expired list.
+ */
+void Timer::HandleExpiredWheelTimers(Layer& aLayer)
+{
+    const Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
+    const uint64_t kCurrentTick = kCurrentEpoch / WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS;
+    uint64_t lNumSlots = kCurrentTick - aLayer.mTimerWheelTick + 1;
+    Timer** lTail = &aLayer.mExpiredTimers;
+
+    aLayer.LockTimerWheel();
+
+    // Every pending timer expires after mTimerWheelEarliest, so there is nothing to do until that has passed.
+    if (aLayer.mNumWheelTimers == 0 || Timer::IsEarlierEpoch(kCurrentEpoch, aLayer.mTimerWheelEarliest))
+    {
+        aLayer.mTimerWheelTick = kCurrentTick;
+        aLayer.UnlockTimerWheel();
+        return;
+    }
+
+    if (lNumSlots > WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE)
+        lNumSlots = WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE;
+
+    for (uint64_t i = 0; i < lNumSlots; i++)
+    {
+        Timer* lTimer = aLayer.mTimerWheel[(aLayer.mTimerWheelTick + i) & (WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE - 1)];
+
+        while (lTimer != NULL)
+        {
+            Timer* lNext = lTimer->mNextTimer;
+
+            // A slot also holds timers from later rotations of the wheel; leave those in place.
+            if (!Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
+            {
+                lTimer->UnlinkTimer();
+                lTimer->LinkTimer(*lTail);
+                lTail = &lTimer->mNextTimer;
+            }
+
+            lTimer = lNext;
+        }
+    }
+
+    // The current slot is left as the cursor, since it may still hold timers due later within the same tick.
+    aLayer.mTimerWheelTick = kCurrentTick;
+
+    // The lock is not held across completion handlers, which may start or cancel timers themselves.
+    while (aLayer.mExpiredTimers != NULL)
+    {
+        Timer& lTimer = *aLayer.mExpiredTimers;
+
+        lTimer.UnlinkTimer();
+        aLayer.UnlockTimerWheel();
+
+        lTimer.HandleComplete();
+
+        aLayer.LockTimerWheel();
+    }
+
+    Timer::UpdateEarliestWheelEpoch(aLayer);
+
+    aLayer.UnlockTimerWheel();
+}
+
+/**
+ *  Recompute the earliest awaken epoch of the timers in the timing wheel. The caller must hold the timing wheel lock.
+ *
+ *  @brief
+ *      Slots are visited in order starting from the wheel cursor. The search stops at the first slot that yields a timer due
+ *      within that slot's tick, since every timer in a later slot, or in a later rotation of the wheel, expires after it.
+ */
+void Timer::UpdateEarliestWheelEpoch(Layer& aLayer)
+{
+    Epoch lEarliest = 0;
+    bool lFound = false;
+
+    for (uint64_t i = 0; i < WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE && aLayer.mNumWheelTimers != 0; i++)
+    {
+        const uint64_t lTick = aLayer.mTimerWheelTick + i;
+
+        for (Timer* lTimer = aLayer.mTimerWheel[lTick & (WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_SIZE - 1)]; lTimer != NULL;
+             lTimer = lTimer->mNextTimer)
+        {
+            if (!lFound || Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, lEarliest))
+            {
+                lEarliest = lTimer->mAwakenEpoch;
+                lFound = true;
+            }
+        }
+
+        if (lFound && Timer::IsEarlierEpoch(lEarliest, (lTick + 1) * WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_RESOLUTION_MS))
+            break;
+    }
+
+    aLayer.mTimerWheelEarliest = lEarliest;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 } // namespace System
 } // namespace Weave
 } // namespace nl
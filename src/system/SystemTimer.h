@@ -109,9 +109,22 @@ private:
 
     Error ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState);
 
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Timer *mNextTimer;
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer **mPrevNextTimer;
+
+    void LinkTimer(Timer*& aLink);
+    void UnlinkTimer(void);
+    bool AddToWheel(Layer& aLayer);
 
+    static void HandleExpiredWheelTimers(Layer& aLayer);
+    static void UpdateEarliestWheelEpoch(Layer& aLayer);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
     static Error HandleExpiredTimers(Layer& aLayer);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
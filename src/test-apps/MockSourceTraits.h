@@ -201,10 +201,11 @@ public:
     TestBTraitDataSource();
     void Mutate();
 
-private:
+protected:
     WEAVE_ERROR GetLeafData(nl::Weave::Profiles::DataManagement::PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, nl::Weave::TLV::TLVWriter &aWriter) __OVERRIDE;
     WEAVE_ERROR GetNextDictionaryItemKey(nl::Weave::Profiles::DataManagement::PropertyPathHandle aDictionaryHandle, uintptr_t &aContext, nl::Weave::Profiles::DataManagement::PropertyDictionaryKey &aKey) __OVERRIDE;
 
+private:
     Schema::Nest::Test::Trait::TestATrait::EnumA taa;
     Schema::Nest::Test::Trait::TestCommon::CommonEnumA tab;
     uint32_t tac;
@@ -226,10 +227,11 @@ public:
     TestBLargeTraitDataSource();
     void Mutate();
 
-private:
+protected:
     WEAVE_ERROR GetLeafData(nl::Weave::Profiles::DataManagement::PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, nl::Weave::TLV::TLVWriter &aWriter) __OVERRIDE;
     WEAVE_ERROR GetNextDictionaryItemKey(nl::Weave::Profiles::DataManagement::PropertyPathHandle aDictionaryHandle, uintptr_t &aContext, nl::Weave::Profiles::DataManagement::PropertyDictionaryKey &aKey) __OVERRIDE;
 
+private:
     Schema::Nest::Test::Trait::TestATrait::EnumA taa;
     Schema::Nest::Test::Trait::TestCommon::CommonEnumA tab;
     uint32_t tac;
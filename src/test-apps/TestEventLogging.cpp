@@ -419,11 +419,25 @@ WEAVE_ERROR LogBufferConsole(void * inAppState, PacketBuffer * inBuffer)
 uint64_t gDebugEventBuffer[(sizeof(nl::Weave::Profiles::DataManagement::CircularEventBuffer) + WEAVE_CONFIG_EVENT_SIZE_RESERVE +
                             EVENT_SIZE_1 + 7) /
                            8];
-uint64_t gInfoEventBuffer[256];
-uint64_t gProdEventBuffer[256];
-uint64_t gCritEventBuffer[256];
+// The seek index lives in the CircularEventBuffer at the start of each
+// buffer; make room for it so the buffers hold as many events as without it.
+#if WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE
+#define SEEK_INDEX_WORDS                                                                                                           \
+    ((sizeof(nl::Weave::Profiles::DataManagement::EventSeekCheckpoint) * WEAVE_CONFIG_EVENT_LOGGING_SEEK_INDEX_SIZE + 7) / 8)
+#else
+#define SEEK_INDEX_WORDS 0
+#endif
+uint64_t gInfoEventBuffer[256 + SEEK_INDEX_WORDS];
+uint64_t gProdEventBuffer[256 + SEEK_INDEX_WORDS];
+uint64_t gCritEventBuffer[256 + SEEK_INDEX_WORDS];
 uint8_t gLargeMemoryBackingStore[16384];
 
+// 64 KB of event buffers, used by the fetch benchmark
+uint64_t gBenchmarkDebugEventBuffer[2048];
+uint64_t gBenchmarkInfoEventBuffer[2048];
+uint64_t gBenchmarkProdEventBuffer[2048];
+uint64_t gBenchmarkCritEventBuffer[2048];
+
 static const uint32_t sEventIdCounterEpoch = 0x10000;
 
 static const char * sCritEventIdCounterStorageKey = "CritEIDC";
@@ -435,7 +449,21 @@ static nl::Weave::PersistedCounter sInfoEventIdCounter;
 static const char * sDebugEventIdCounterStorageKey = "DebugEIDC";
 static nl::Weave::PersistedCounter sDebugEventIdCounter;
 
-void InitializeEventLogging(TestLoggingContext * context)
+// Erases the persistent event spill store, so that the logging
+// subsystem starts over as on a fresh device.
+static void ClearSpillStore(void)
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    for (uint8_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT; i++)
+    {
+        nl::Weave::Platform::PersistedStorage::EraseSegment(i);
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+}
+
+// Recreates the logging subsystem on top of what is left in persistent
+// storage, as after a reboot.
+void RestartEventLogging(TestLoggingContext * context)
 {
     LogStorageResources logStorageResources[] = { { static_cast<void *>(&gCritEventBuffer[0]), sizeof(gCritEventBuffer), NULL, 0,
                                                     NULL, nl::Weave::Profiles::DataManagement::ImportanceType::ProductionCritical },
@@ -456,6 +484,32 @@ void InitializeEventLogging(TestLoggingContext * context)
     gLogBDXUpload.Init(&instance);
 }
 
+void InitializeEventLogging(TestLoggingContext * context)
+{
+    ClearSpillStore();
+    RestartEventLogging(context);
+}
+
+void InitializeBenchmarkEventLogging(TestLoggingContext * context)
+{
+    LogStorageResources logStorageResources[] = {
+        { static_cast<void *>(&gBenchmarkCritEventBuffer[0]), sizeof(gBenchmarkCritEventBuffer), NULL, 0, NULL,
+          nl::Weave::Profiles::DataManagement::ImportanceType::ProductionCritical },
+        { static_cast<void *>(&gBenchmarkProdEventBuffer[0]), sizeof(gBenchmarkProdEventBuffer), NULL, 0, NULL,
+          nl::Weave::Profiles::DataManagement::ImportanceType::Production },
+        { static_cast<void *>(&gBenchmarkInfoEventBuffer[0]), sizeof(gBenchmarkInfoEventBuffer), NULL, 0, NULL,
+          nl::Weave::Profiles::DataManagement::ImportanceType::Info },
+        { static_cast<void *>(&gBenchmarkDebugEventBuffer[0]), sizeof(gBenchmarkDebugEventBuffer), NULL, 0, NULL,
+          nl::Weave::Profiles::DataManagement::ImportanceType::Debug }
+    };
+
+    ClearSpillStore();
+    nl::Weave::Profiles::DataManagement::LoggingManagement::CreateLoggingManagement(
+        context->mExchangeMgr, sizeof(logStorageResources) / sizeof(logStorageResources[0]), logStorageResources);
+    nl::Weave::Profiles::DataManagement::LoggingConfiguration::GetInstance().mGlobalImportance =
+        nl::Weave::Profiles::DataManagement::Debug;
+}
+
 void DestroyEventLogging(TestLoggingContext * context)
 {
     nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance().DestroyLoggingManagement();
@@ -479,6 +533,7 @@ void InitializeEventLoggingWithPersistedCounters(TestLoggingContext * context, u
     nl::Weave::Platform::PersistedStorage::Write(sProductionEventIdCounterStorageKey, startingValue);
     nl::Weave::Platform::PersistedStorage::Write(sInfoEventIdCounterStorageKey, startingValue);
     nl::Weave::Platform::PersistedStorage::Write(sDebugEventIdCounterStorageKey, startingValue);
+    ClearSpillStore();
 
     nl::Weave::Profiles::DataManagement::LoggingManagement::CreateLoggingManagement(
         context->mExchangeMgr, sizeof(logStorageResources) / sizeof(logStorageResources[0]), logStorageResources);
@@ -514,11 +569,14 @@ void DumpEventLog(nlTestSuite * inSuite)
 
 void DoBDXUpload(TestLoggingContext * context)
 {
+    uint64_t elapsed;
+
     if (!context->bdx)
     {
         return;
     }
     gBDXContext.mDone = false;
+    elapsed           = System::Layer::GetClock_MonotonicMS();
     if (gBDXContext.mUseTCP)
     {
         SystemLayer.StartTimer(ConnectInterval, StartClientConnection, &gBDXContext);
@@ -538,6 +596,14 @@ void DoBDXUpload(TestLoggingContext * context)
         if (gLogBDXUpload.mState == nl::Weave::Profiles::DataManagement::LogBDXUpload::UploaderInitialized)
         {
             gBDXContext.mDone = true;
+            elapsed           = System::Layer::GetClock_MonotonicMS() - elapsed;
+            printf("Uploaded %u bytes in %u ms", static_cast<unsigned>(gLogBDXUpload.GetBytesUploaded()),
+                   static_cast<unsigned>(elapsed));
+            if (elapsed > 0)
+            {
+                printf(" (%u bytes/s)", static_cast<unsigned>((gLogBDXUpload.GetBytesUploaded() * 1000ULL) / elapsed));
+            }
+            printf("\n");
             for (size_t i = 0; i < 1000; i++)
             {
                 sleepTime.tv_sec  = 0;
@@ -1500,6 +1566,890 @@ static void CheckFetchEvents(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+// Simulates a set of subscription handlers, each offloading the log
+// from its own position into notify-sized buffers in turn, and checks
+// that every fetch resumes at the right event with the right timestamp.
+static void CheckFetchEventsBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    const ImportanceType importances[] = { nl::Weave::Profiles::DataManagement::Debug, nl::Weave::Profiles::DataManagement::Info,
+                                           nl::Weave::Profiles::DataManagement::Production,
+                                           nl::Weave::Profiles::DataManagement::ProductionCritical };
+    const size_t kNumImportances = sizeof(importances) / sizeof(importances[0]);
+    const size_t kNumEvents      = 6000;
+    const size_t kNumReaders     = 10;
+    const timestamp_t kStartTime = 1000;
+    event_id_t readerEventIDs[kNumReaders];
+    bool readerDone[kNumReaders];
+    size_t numReadersDone = 0;
+    size_t numFetches     = 0;
+    uint8_t notifyBuffer[512];
+    LoggingManagement & logMgmt = LoggingManagement::GetInstance();
+    uint64_t elapsed;
+    WEAVE_ERROR err;
+
+    InitializeBenchmarkEventLogging(context);
+    System::Layer::SetClock_RealTime(0);
+
+    // Events cycle through the importances, 10 milliseconds apart, so that
+    // event N of importance importances[i] is logged at kStartTime +
+    // 10 * (kNumImportances * (N - 1) + i).
+    for (size_t i = 0; i < kNumEvents; i++)
+    {
+        timestamp_t now = kStartTime + 10 * i;
+        event_id_t eid  = FastLogFreeform(importances[i % kNumImportances], now, "Benchmark entry %u", now);
+
+        NL_TEST_ASSERT(inSuite, eid == (i / kNumImportances) + 1);
+    }
+
+    // Readers alternate between Info and Production, and start at
+    // positions spread evenly over the events held at that importance.
+    for (size_t r = 0; r < kNumReaders; r++)
+    {
+        ImportanceType importance = importances[1 + r % 2];
+        event_id_t first          = logMgmt.GetFirstEventID(importance);
+        event_id_t last           = logMgmt.GetLastEventID(importance);
+
+        readerEventIDs[r] = first + ((last - first + 1) * (r / 2)) / (kNumReaders / 2);
+        readerDone[r]     = false;
+    }
+
+    elapsed = Now();
+
+    while (numReadersDone < kNumReaders)
+    {
+        for (size_t r = 0; r < kNumReaders; r++)
+        {
+            const size_t importanceIndex = 1 + r % 2;
+            event_id_t startEventID      = readerEventIDs[r];
+            TLVWriter writer;
+            TLVReader reader;
+            timestamp_t timestamp     = 0;
+            utc_timestamp_t utcTimestamp = 0;
+            event_id_t eventID        = 0;
+
+            if (readerDone[r])
+            {
+                continue;
+            }
+
+            writer.Init(notifyBuffer, sizeof(notifyBuffer));
+            err = logMgmt.FetchEventsSince(writer, importances[importanceIndex], readerEventIDs[r]);
+            NL_TEST_ASSERT(inSuite, (err == WEAVE_END_OF_TLV) || (err == WEAVE_ERROR_BUFFER_TOO_SMALL));
+            numFetches++;
+
+            if (err == WEAVE_END_OF_TLV)
+            {
+                readerDone[r] = true;
+                numReadersDone++;
+            }
+
+            if (readerEventIDs[r] == startEventID)
+            {
+                continue;
+            }
+
+            reader.Init(notifyBuffer, writer.GetLengthWritten());
+            err = ReadFirstEventHeader(reader, timestamp, utcTimestamp, eventID);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, eventID == startEventID);
+            NL_TEST_ASSERT(inSuite, timestamp == kStartTime + 10 * (kNumImportances * (eventID - 1) + importanceIndex));
+        }
+    }
+
+    elapsed = Now() - elapsed;
+
+    for (size_t r = 0; r < kNumReaders; r++)
+    {
+        NL_TEST_ASSERT(inSuite, readerEventIDs[r] == logMgmt.GetLastEventID(importances[1 + r % 2]) + 1);
+    }
+
+    printf("%u readers, %u fetches over %u bytes of events: %.3f us/fetch\n", static_cast<unsigned>(kNumReaders),
+           static_cast<unsigned>(numFetches),
+           static_cast<unsigned>(sizeof(gBenchmarkDebugEventBuffer) + sizeof(gBenchmarkInfoEventBuffer) +
+                                 sizeof(gBenchmarkProdEventBuffer) + sizeof(gBenchmarkCritEventBuffer)),
+           static_cast<double>(elapsed) / numFetches);
+}
+
+// Request blocks from gLogBDXUpload, as the BDX transfer would, until
+// it hands out the last block or inMaxBlocks blocks; each request but
+// the first acknowledges the previous block.  Each request offers
+// inBlockLength bytes of the outgoing message, on behalf of inXfer when
+// given.  Returns the number of events in the blocks handed out.
+static size_t UploadEventBlocks(nlTestSuite * inSuite, size_t inMaxBlocks, size_t & outNumBlocks, uint32_t & outNumBytes,
+                                nl::Weave::Profiles::BulkDataTransfer::BDXTransfer * inXfer = NULL, uint64_t inBlockLength = 1024)
+{
+    uint8_t blockBuffer[1024];
+    bool isLastBlock  = false;
+    size_t numEvents  = 0;
+    WEAVE_ERROR err;
+
+    outNumBlocks = 0;
+    outNumBytes  = 0;
+
+    while (!isLastBlock && (outNumBlocks < inMaxBlocks))
+    {
+        uint64_t length = inBlockLength;
+        uint8_t * data  = blockBuffer;
+        TLVReader reader;
+        size_t count;
+
+        gLogBDXUpload.BlockHandler(inXfer, &length, &data, &isLastBlock);
+        NL_TEST_ASSERT(inSuite, length <= inBlockLength);
+        NL_TEST_ASSERT(inSuite, (inXfer == NULL) || (length <= inXfer->mMaxBlockSize));
+
+        // Every block holds whole events
+        reader.Init(data, length);
+        err = nl::Weave::TLV::Utilities::Count(reader, count, false);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        numEvents += count;
+        outNumBytes += length;
+        outNumBlocks++;
+    }
+
+    return numEvents;
+}
+
+static void CheckBDXUploadBlocks(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    const ImportanceType importances[] = { nl::Weave::Profiles::DataManagement::Debug, nl::Weave::Profiles::DataManagement::Info,
+                                           nl::Weave::Profiles::DataManagement::Production,
+                                           nl::Weave::Profiles::DataManagement::ProductionCritical };
+    const size_t kNumImportances = sizeof(importances) / sizeof(importances[0]);
+    const size_t kNumEvents      = 2000;
+    const size_t kNumMoreEvents  = 200;
+    const timestamp_t kStartTime = 1000;
+    LoggingManagement & logMgmt  = LoggingManagement::GetInstance();
+    size_t numStored             = 0;
+    size_t numUploaded;
+    size_t numAcknowledged;
+    size_t numBlocks;
+    uint32_t numBytes;
+    uint64_t elapsed;
+
+    InitializeBenchmarkEventLogging(context);
+    System::Layer::SetClock_RealTime(0);
+    new (&gLogBDXUpload) nl::Weave::Profiles::DataManagement::LogBDXUpload();
+    gLogBDXUpload.Init(&logMgmt);
+
+    for (size_t i = 0; i < kNumEvents; i++)
+    {
+        timestamp_t now = kStartTime + 10 * i;
+        (void) FastLogFreeform(importances[i % kNumImportances], now, "Upload entry %u", now);
+    }
+
+    for (size_t i = 0; i < kNumImportances; i++)
+    {
+        numStored += logMgmt.GetLastEventID(importances[i]) - logMgmt.GetFirstEventID(importances[i]) + 1;
+    }
+
+    // A full upload carries every stored event once
+    elapsed     = Now();
+    numUploaded = UploadEventBlocks(inSuite, kNumEvents, numBlocks, numBytes);
+    gLogBDXUpload.Done();
+    elapsed = Now() - elapsed;
+
+    NL_TEST_ASSERT(inSuite, numUploaded == numStored);
+    NL_TEST_ASSERT(inSuite, gLogBDXUpload.GetBytesUploaded() == numBytes);
+
+    printf("%u events in %u blocks, %u bytes: %.3f us/block\n", static_cast<unsigned>(numUploaded),
+           static_cast<unsigned>(numBlocks), static_cast<unsigned>(numBytes), static_cast<double>(elapsed) / numBlocks);
+
+    // Nothing is left for the next upload
+    numUploaded = UploadEventBlocks(inSuite, kNumEvents, numBlocks, numBytes);
+    gLogBDXUpload.Done();
+
+    NL_TEST_ASSERT(inSuite, numUploaded == 0);
+    NL_TEST_ASSERT(inSuite, numBlocks == 1);
+
+    for (size_t i = 0; i < kNumMoreEvents; i++)
+    {
+        timestamp_t now = kStartTime + 10 * (kNumEvents + i);
+        (void) FastLogFreeform(nl::Weave::Profiles::DataManagement::Production, now, "Upload entry %u", now);
+    }
+
+    // An upload aborted after the first block was acknowledged resumes
+    // after that block
+    numAcknowledged = UploadEventBlocks(inSuite, 1, numBlocks, numBytes);
+    NL_TEST_ASSERT(inSuite, (numAcknowledged > 0) && (numAcknowledged < kNumMoreEvents));
+
+    numUploaded = UploadEventBlocks(inSuite, 1, numBlocks, numBytes);
+    NL_TEST_ASSERT(inSuite, numUploaded > 0);
+    gLogBDXUpload.Abort();
+
+    numUploaded = UploadEventBlocks(inSuite, kNumEvents, numBlocks, numBytes);
+    gLogBDXUpload.Done();
+
+    NL_TEST_ASSERT(inSuite, numUploaded == kNumMoreEvents - numAcknowledged);
+}
+
+// Checks that the blocks handed out fit both the block size accepted by
+// the receiver and the space offered for each of them, also when that
+// space shrinks in the middle of an upload, and that no event is lost
+// or uploaded twice when blocks are encoded again at a smaller size.
+static void CheckBDXUploadBlockSize(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    const size_t kNumEvents      = 200;
+    const timestamp_t kStartTime = 1000;
+    LoggingManagement & logMgmt  = LoggingManagement::GetInstance();
+    nl::Weave::Profiles::BulkDataTransfer::BDXTransfer xfer;
+    size_t numStored;
+    size_t numUploaded;
+    size_t numBlocks;
+    uint32_t numBytes;
+
+    InitializeBenchmarkEventLogging(context);
+    new (&gLogBDXUpload) nl::Weave::Profiles::DataManagement::LogBDXUpload();
+    gLogBDXUpload.Init(&logMgmt);
+
+    for (size_t i = 0; i < kNumEvents; i++)
+    {
+        timestamp_t now = kStartTime + 10 * i;
+        (void) FastLogFreeform(nl::Weave::Profiles::DataManagement::Production, now, "Upload entry %u", now);
+    }
+
+    numStored = logMgmt.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) -
+        logMgmt.GetFirstEventID(nl::Weave::Profiles::DataManagement::Production) + 1;
+
+    xfer.Reset();
+    xfer.mMaxBlockSize = 256;
+
+    numUploaded = UploadEventBlocks(inSuite, 2, numBlocks, numBytes, &xfer, 1024);
+    NL_TEST_ASSERT(inSuite, numBlocks == 2);
+
+    numUploaded += UploadEventBlocks(inSuite, kNumEvents, numBlocks, numBytes, &xfer, 128);
+    gLogBDXUpload.Done();
+
+    NL_TEST_ASSERT(inSuite, numUploaded == numStored);
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+struct StagedEventTestData
+{
+    uint32_t mSequence;
+    size_t mPaddingLen;
+};
+
+static WEAVE_ERROR WriteStagedEventTestData(TLVWriter & ioWriter, uint8_t inDataTag, void * appData)
+{
+    WEAVE_ERROR err                = WEAVE_NO_ERROR;
+    StagedEventTestData * testData = static_cast<StagedEventTestData *>(appData);
+    TLVType outer;
+
+    err = ioWriter.StartContainer(ContextTag(inDataTag), kTLVType_Structure, outer);
+    SuccessOrExit(err);
+
+    err = ioWriter.Put(ContextTag(1), testData->mSequence);
+    SuccessOrExit(err);
+
+    if (testData->mPaddingLen > 0)
+    {
+        err = ioWriter.PutBytes(ContextTag(2), gLargeMemoryBackingStore, testData->mPaddingLen);
+        SuccessOrExit(err);
+    }
+
+    err = ioWriter.EndContainer(outer);
+
+exit:
+    return err;
+}
+
+// Stages a full queue of events, checks that none of them is visible
+// until the queue is drained, and that the drain logs them in order,
+// with consecutive IDs and the timestamps captured when they were staged.
+static void CheckStagedEvents(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    nl::Weave::Profiles::DataManagement::LoggingManagement & logger =
+        nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
+    const nl::Weave::Profiles::DataManagement::EventSchema schema = { kWeaveProfile_NestDebug, kNestDebug_StringLogEntryEvent,
+                                                                      nl::Weave::Profiles::DataManagement::Production, 1, 1 };
+    const timestamp_t kStartTime = 1000;
+    StagedEventTestData testData;
+    event_id_t lastEventID, eventID;
+    TLVWriter writer;
+    TLVReader reader;
+    size_t numDrained;
+    uint32_t i;
+    WEAVE_ERROR err;
+
+    InitializeEventLogging(context);
+
+    eventID = FastLogFreeform(nl::Weave::Profiles::DataManagement::Production, kStartTime, "Before staging");
+    NL_TEST_ASSERT(inSuite, eventID > 0);
+    lastEventID = logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production);
+
+    testData.mPaddingLen = 0;
+    for (i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1; i++)
+    {
+        nl::Weave::Profiles::DataManagement::EventOptions options(static_cast<timestamp_t>(kStartTime + 10 * (i + 1)));
+
+        testData.mSequence = i;
+        err                = logger.StageEvent(schema, WriteStagedEventTestData, &testData, &options);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    // An event too large for a slot still consumes its slot, but is
+    // never logged.
+    testData.mSequence   = i;
+    testData.mPaddingLen = WEAVE_CONFIG_EVENT_LOGGING_STAGING_EVENT_SIZE;
+    err                  = logger.StageEvent(schema, WriteStagedEventTestData, &testData, NULL);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    // The queue is now full.
+    testData.mPaddingLen = 0;
+    err                  = logger.StageEvent(schema, WriteStagedEventTestData, &testData, NULL);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_NO_MEMORY);
+
+    NL_TEST_ASSERT(inSuite, logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) == lastEventID);
+
+    numDrained = logger.DrainStagedEvents();
+    NL_TEST_ASSERT(inSuite, numDrained == WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE - 1);
+    NL_TEST_ASSERT(inSuite, logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) == lastEventID + numDrained);
+
+    // Nothing left to drain; the queue accepts events again.
+    NL_TEST_ASSERT(inSuite, logger.DrainStagedEvents() == 0);
+    err = logger.StageEvent(schema, WriteStagedEventTestData, &testData, NULL);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, logger.DrainStagedEvents() == 1);
+
+    for (i = 0; i < numDrained; i++)
+    {
+        timestamp_t timestamp        = 0;
+        utc_timestamp_t utcTimestamp = 0;
+        event_id_t readEventID       = 0;
+        uint32_t sequence            = ~0U;
+        TLVType dataType;
+
+        eventID = lastEventID + 1 + i;
+        writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+        err = logger.FetchEventsSince(writer, nl::Weave::Profiles::DataManagement::Production, eventID);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+        reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+        err = ReadFirstEventHeader(reader, timestamp, utcTimestamp, readEventID);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, readEventID == lastEventID + 1 + i);
+        // With UTC timestamps available, the system timestamp is not encoded.
+        NL_TEST_ASSERT(inSuite, utcTimestamp != 0 || timestamp == kStartTime + 10 * (i + 1));
+
+        // Re-read the event to get at its data.
+        reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+        err = reader.Next();
+        SuccessOrExit(err);
+        err = reader.EnterContainer(dataType);
+        SuccessOrExit(err);
+        do
+        {
+            err = reader.Next();
+            SuccessOrExit(err);
+        } while (reader.GetTag() != ContextTag(kTag_EventData));
+        err = reader.EnterContainer(dataType);
+        SuccessOrExit(err);
+        err = reader.Next();
+        SuccessOrExit(err);
+        err = reader.Get(sequence);
+        SuccessOrExit(err);
+        NL_TEST_ASSERT(inSuite, sequence == i);
+    }
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE || WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+static WEAVE_ERROR WriteSequenceTestData(TLVWriter & ioWriter, uint8_t inDataTag, void * appData)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVType outer;
+
+    err = ioWriter.StartContainer(ContextTag(inDataTag), kTLVType_Structure, outer);
+    SuccessOrExit(err);
+
+    err = ioWriter.Put(ContextTag(1), *static_cast<uint32_t *>(appData));
+    SuccessOrExit(err);
+
+    err = ioWriter.EndContainer(outer);
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE || WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+// Logs events of a few schemas, with and without an event source, and
+// checks that the fetched events carry the fields the schema dictionary
+// stands in for, and that the dictionary made the storage denser.
+static void CheckSchemaDictionary(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    nl::Weave::Profiles::DataManagement::LoggingManagement & logger =
+        nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
+    const uint32_t kNumEvents = 40;
+    nl::Weave::Profiles::DataManagement::EventSchema schemas[] = {
+        { kWeaveProfile_NestDebug, kNestDebug_StringLogEntryEvent, nl::Weave::Profiles::DataManagement::Production, 1, 1 },
+        { kWeaveProfile_NestDebug, kNestDebug_TokenizedLogEntryEvent, nl::Weave::Profiles::DataManagement::Production, 2, 1 },
+    };
+    nl::Weave::Profiles::DataManagement::DetailedRootSection eventSource;
+    nl::Weave::Profiles::DataManagement::EventStorageStats stats;
+    event_id_t firstEventID, eventID;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerType, dataType;
+    uint32_t i, numRead;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    InitializeEventLogging(context);
+
+    eventSource.ResourceID      = ResourceIdentifier(static_cast<uint64_t>(0x18B4300000000001ULL));
+    eventSource.TraitInstanceID = 2;
+
+    firstEventID = logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) + 1;
+
+    for (i = 0; i < kNumEvents; i++)
+    {
+        nl::Weave::Profiles::DataManagement::EventOptions options(static_cast<timestamp_t>(1000 + 10 * i),
+                                                                  (i % 4) < 2 ? &eventSource : NULL, 0,
+                                                                  nl::Weave::Profiles::DataManagement::kImportanceType_Invalid, false);
+
+        eventID = LogEvent(schemas[i % 2], WriteSequenceTestData, &i, &options);
+        NL_TEST_ASSERT(inSuite, eventID == firstEventID + i);
+    }
+
+    eventID = firstEventID;
+    writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+    err = logger.FetchEventsSince(writer, nl::Weave::Profiles::DataManagement::Production, eventID);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+    reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+    for (numRead = 0; (err = reader.Next()) == WEAVE_NO_ERROR; numRead++)
+    {
+        uint32_t profileId = 0, eventType = 0, sequence = ~0U;
+        uint64_t traitInstanceId = 0;
+        bool hasResourceId = false, hasVersions = false;
+
+        err = reader.EnterContainer(outerType);
+        SuccessOrExit(err);
+
+        while ((err = reader.Next()) == WEAVE_NO_ERROR)
+        {
+            const uint64_t tag = reader.GetTag();
+
+            NL_TEST_ASSERT(inSuite, tag != ContextTag(kTag_EventSchemaRef));
+
+            if (tag == ContextTag(kTag_EventTraitProfileID))
+            {
+                hasVersions = (reader.GetType() == kTLVType_Array);
+                if (hasVersions)
+                {
+                    err = reader.EnterContainer(dataType);
+                    SuccessOrExit(err);
+                    err = reader.Next();
+                    SuccessOrExit(err);
+                    err = reader.Get(profileId);
+                    SuccessOrExit(err);
+                    err = reader.ExitContainer(dataType);
+                }
+                else
+                {
+                    err = reader.Get(profileId);
+                }
+            }
+            else if (tag == ContextTag(kTag_EventResourceID))
+            {
+                hasResourceId = true;
+            }
+            else if (tag == ContextTag(kTag_EventTraitInstanceID))
+            {
+                err = reader.Get(traitInstanceId);
+            }
+            else if (tag == ContextTag(kTag_EventType))
+            {
+                err = reader.Get(eventType);
+            }
+            else if (tag == ContextTag(kTag_EventData))
+            {
+                err = reader.EnterContainer(dataType);
+                SuccessOrExit(err);
+                err = reader.Next();
+                SuccessOrExit(err);
+                err = reader.Get(sequence);
+                SuccessOrExit(err);
+                err = reader.ExitContainer(dataType);
+            }
+            SuccessOrExit(err);
+        }
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+        err = reader.ExitContainer(outerType);
+        SuccessOrExit(err);
+
+        NL_TEST_ASSERT(inSuite, sequence == numRead);
+        NL_TEST_ASSERT(inSuite, profileId == schemas[numRead % 2].mProfileId);
+        NL_TEST_ASSERT(inSuite, eventType == schemas[numRead % 2].mStructureType);
+        NL_TEST_ASSERT(inSuite, hasVersions == (numRead % 2 == 1));
+        NL_TEST_ASSERT(inSuite, hasResourceId == ((numRead % 4) < 2));
+        NL_TEST_ASSERT(inSuite, !hasResourceId || traitInstanceId == eventSource.TraitInstanceID);
+    }
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, numRead == kNumEvents);
+    err = WEAVE_NO_ERROR;
+
+    logger.GetEventStorageStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.mEventsWritten >= kNumEvents);
+    NL_TEST_ASSERT(inSuite, stats.mBytesWritten < stats.mUncompressedBytesWritten);
+    NL_TEST_ASSERT(inSuite, stats.GetEventsPerKB() > stats.GetUncompressedEventsPerKB());
+
+    printf("%u events stored at %u events/KB, %u events/KB without the schema dictionary\n",
+           static_cast<unsigned>(stats.mEventsWritten), static_cast<unsigned>(stats.GetEventsPerKB()),
+           static_cast<unsigned>(stats.GetUncompressedEventsPerKB()));
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+}
+
+// Reads the trait profile ID of the first event in aReader, restored
+// from the schema dictionary when the event was fetched.
+static WEAVE_ERROR ReadFirstEventProfileID(TLVReader & aReader, uint32_t & aProfileID)
+{
+    WEAVE_ERROR err;
+    TLVType outerType;
+
+    err = aReader.Next();
+    SuccessOrExit(err);
+    err = aReader.EnterContainer(outerType);
+    SuccessOrExit(err);
+
+    do
+    {
+        err = aReader.Next();
+        SuccessOrExit(err);
+    } while (aReader.GetTag() != ContextTag(kTag_EventTraitProfileID));
+
+    err = aReader.Get(aProfileID);
+    SuccessOrExit(err);
+
+    err = aReader.ExitContainer(outerType);
+
+exit:
+    return err;
+}
+
+// Persists a log that uses the schema dictionary and checks that its
+// events read back the same after a restart, then checks that a
+// snapshot serialized without the dictionary still loads.
+static void CheckSchemaDictionaryPersistence(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    nl::Weave::Profiles::DataManagement::LoggingManagement & logger =
+        nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
+    const uint32_t kNumEvents = 10;
+    const size_t kNumBuffers  = 4;
+    const nl::Weave::Profiles::DataManagement::EventSchema schema = { kWeaveProfile_NestDebug, kNestDebug_StringLogEntryEvent,
+                                                                      nl::Weave::Profiles::DataManagement::Production, 1, 1 };
+    static uint8_t snapshot[8192];
+    static uint8_t strippedSnapshot[8192];
+    uint32_t snapshotLen;
+    uint32_t profileID = 0;
+    event_id_t firstEventID, eventID;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType container;
+    uint32_t i;
+    size_t count;
+    WEAVE_ERROR err;
+
+    InitializeEventLoggingWithPersistedCounters(context, 1, nl::Weave::Profiles::DataManagement::Production);
+
+    firstEventID = logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) + 1;
+    for (i = 0; i < kNumEvents; i++)
+    {
+        eventID = LogEvent(schema, WriteSequenceTestData, &i, NULL);
+        NL_TEST_ASSERT(inSuite, eventID == firstEventID + i);
+    }
+
+    writer.Init(snapshot, sizeof(snapshot));
+    err = logger.SerializeEvents(writer);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
+    snapshotLen = writer.GetLengthWritten();
+
+    // Restart and load the snapshot: the events come back with the
+    // fields the dictionary stands in for.
+    InitializeEventLoggingWithPersistedCounters(context, 1, nl::Weave::Profiles::DataManagement::Production);
+    reader.Init(snapshot, snapshotLen);
+    err = logger.LoadEvents(reader);
+    SuccessOrExit(err);
+
+    eventID = firstEventID;
+    writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+    err = logger.FetchEventsSince(writer, nl::Weave::Profiles::DataManagement::Production, eventID);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+    reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+    err = nl::Weave::TLV::Utilities::Count(reader, count, false);
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, count == kNumEvents);
+
+    reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+    err = ReadFirstEventProfileID(reader, profileID);
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, profileID == schema.mProfileId);
+
+    // Copy the event buffers of a snapshot of an empty log, leaving out
+    // the dictionary, as a build without it would have serialized them.
+    InitializeEventLoggingWithPersistedCounters(context, 1, nl::Weave::Profiles::DataManagement::Production);
+
+    writer.Init(snapshot, sizeof(snapshot));
+    err = logger.SerializeEvents(writer);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    reader.Init(snapshot, writer.GetLengthWritten());
+    err = reader.Next();
+    SuccessOrExit(err);
+    err = reader.EnterContainer(container);
+    SuccessOrExit(err);
+
+    writer.Init(strippedSnapshot, sizeof(strippedSnapshot));
+    err = writer.StartContainer(ProfileTag(kWeaveProfile_Common, kTagNum_SerializedEventState), kTLVType_Array, container);
+    SuccessOrExit(err);
+    for (i = 0; i < kNumBuffers; i++)
+    {
+        err = reader.Next();
+        SuccessOrExit(err);
+        err = writer.CopyElement(reader);
+        SuccessOrExit(err);
+    }
+    err = writer.EndContainer(container);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    reader.Init(strippedSnapshot, writer.GetLengthWritten());
+    err = logger.LoadEvents(reader);
+    SuccessOrExit(err);
+
+    // The dictionary starts out empty and takes new events.
+    eventID = LogEvent(schema, WriteSequenceTestData, &i, NULL);
+    NL_TEST_ASSERT(inSuite, eventID != 0);
+
+    writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+    err = logger.FetchEventsSince(writer, nl::Weave::Profiles::DataManagement::Production, eventID);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+    reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+    err = ReadFirstEventProfileID(reader, profileID);
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, profileID == schema.mProfileId);
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+// Fetches the Production events from inFirstEventID on, and checks that
+// they are consecutive, carry the expected IDs and hold the sequence
+// numbers they were logged with.  Returns the number of events read.
+static uint32_t CheckSpilledEventsReadOut(nlTestSuite * inSuite, event_id_t inFirstEventID)
+{
+    nl::Weave::Profiles::DataManagement::LoggingManagement & logger =
+        nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
+    event_id_t eventID = inFirstEventID;
+    event_id_t expectedEventID;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerType, dataType;
+    uint32_t numRead;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+    err = logger.FetchEventsSince(writer, nl::Weave::Profiles::DataManagement::Production, eventID);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, eventID == logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) + 1);
+
+    expectedEventID = inFirstEventID;
+    reader.Init(gLargeMemoryBackingStore, writer.GetLengthWritten());
+    for (numRead = 0; (err = reader.Next()) == WEAVE_NO_ERROR; numRead++, expectedEventID++)
+    {
+        uint32_t sequence = ~0U;
+
+        err = reader.EnterContainer(outerType);
+        SuccessOrExit(err);
+
+        while ((err = reader.Next()) == WEAVE_NO_ERROR)
+        {
+            if (reader.GetTag() == ContextTag(kTag_EventID))
+            {
+                err = reader.Get(expectedEventID);
+            }
+            else if (reader.GetTag() == ContextTag(kTag_EventData))
+            {
+                err = reader.EnterContainer(dataType);
+                SuccessOrExit(err);
+                err = reader.Next();
+                SuccessOrExit(err);
+                err = reader.Get(sequence);
+                SuccessOrExit(err);
+                err = reader.ExitContainer(dataType);
+            }
+            SuccessOrExit(err);
+        }
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+        err = reader.ExitContainer(outerType);
+        SuccessOrExit(err);
+
+        NL_TEST_ASSERT(inSuite, sequence == expectedEventID - inFirstEventID);
+    }
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    err = WEAVE_NO_ERROR;
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    return numRead;
+}
+
+// Logs more events than the in-memory buffers hold, and checks that
+// the evicted events are still fetched, from the spill store, and are
+// still there after a restart of the logging subsystem, with event IDs
+// continuing where they left off.  The oldest events may have been
+// dropped from the spill store too, depending on its configured size.
+static void CheckEventSpill(nlTestSuite * inSuite, void * inContext)
+{
+    TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
+    nl::Weave::Profiles::DataManagement::LoggingManagement & logger =
+        nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
+    const uint32_t kNumEvents = 400;
+    nl::Weave::Profiles::DataManagement::EventSchema schema = {
+        kWeaveProfile_NestDebug, kNestDebug_StringLogEntryEvent, nl::Weave::Profiles::DataManagement::Production, 1, 1
+    };
+    event_id_t firstEventID, eventID;
+    uint32_t i, numStored;
+
+    InitializeEventLogging(context);
+
+    firstEventID = logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) + 1;
+
+    for (i = 0; i < kNumEvents; i++)
+    {
+        nl::Weave::Profiles::DataManagement::EventOptions options(static_cast<timestamp_t>(1000 + 10 * i), NULL, 0,
+                                                                  nl::Weave::Profiles::DataManagement::kImportanceType_Invalid, false);
+
+        eventID = LogEvent(schema, WriteSequenceTestData, &i, &options);
+        NL_TEST_ASSERT(inSuite, eventID == firstEventID + i);
+    }
+
+    // No event takes less than 8 bytes in the Production buffer
+    numStored = firstEventID + kNumEvents - logger.GetFirstEventID(nl::Weave::Profiles::DataManagement::Production);
+    NL_TEST_ASSERT(inSuite, numStored > sizeof(gProdEventBuffer) / 8);
+    NL_TEST_ASSERT(inSuite, CheckSpilledEventsReadOut(inSuite, firstEventID) == numStored);
+
+    // Restart: the in-memory buffers are lost, the spill store is not
+    NL_TEST_ASSERT(inSuite, logger.SpillEvents() == WEAVE_NO_ERROR);
+    RestartEventLogging(context);
+
+    numStored = firstEventID + kNumEvents - logger.GetFirstEventID(nl::Weave::Profiles::DataManagement::Production);
+    NL_TEST_ASSERT(inSuite, numStored > sizeof(gProdEventBuffer) / 8);
+    NL_TEST_ASSERT(inSuite,
+                   logger.GetLastEventID(nl::Weave::Profiles::DataManagement::Production) == firstEventID + kNumEvents - 1);
+
+    eventID = LogEvent(schema, WriteSequenceTestData, &i, NULL);
+    NL_TEST_ASSERT(inSuite, eventID == firstEventID + kNumEvents);
+    NL_TEST_ASSERT(inSuite, CheckSpilledEventsReadOut(inSuite, firstEventID) == numStored + 1);
+
+    InitializeEventLogging(context);
+}
+
+// Same as above, with the segments kept in a file, the way a platform
+// maps them onto flash: everything the store needs after the restart
+// has to come back through ReadSegment().
+static void CheckEventSpillFile(nlTestSuite * inSuite, void * inContext)
+{
+    sPersistentSegmentFile = tmpfile();
+    NL_TEST_ASSERT(inSuite, sPersistentSegmentFile != NULL);
+    if (sPersistentSegmentFile != NULL)
+    {
+        CheckEventSpill(inSuite, inContext);
+
+        fclose(sPersistentSegmentFile);
+        sPersistentSegmentFile = NULL;
+        InitializeEventLogging(static_cast<TestLoggingContext *>(inContext));
+    }
+}
+
+// Checks that a record interrupted while being written is discarded on
+// recovery, and that the store keeps on working past it.
+static void CheckEventSpillRecovery(nlTestSuite * inSuite, void * inContext)
+{
+    nl::Weave::Profiles::DataManagement::EventSpillStore store;
+    const nl::Weave::Profiles::DataManagement::ImportanceType importance = nl::Weave::Profiles::DataManagement::Production;
+    uint8_t event[16];
+    uint32_t eventLen = 0;
+    event_id_t eventID;
+    TLVWriter writer;
+    TLVType outerType;
+    uint32_t i;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    ClearSpillStore();
+
+    err = store.Init();
+    SuccessOrExit(err);
+
+    for (i = 1; i <= 3; i++)
+    {
+        writer.Init(event, sizeof(event));
+        err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerType);
+        SuccessOrExit(err);
+        err = writer.Put(ContextTag(kTag_EventID), i);
+        SuccessOrExit(err);
+        err = writer.EndContainer(outerType);
+        SuccessOrExit(err);
+        err = writer.Finalize();
+        SuccessOrExit(err);
+
+        eventLen = writer.GetLengthWritten();
+        err      = store.AppendEvent(importance, i, event, eventLen);
+        SuccessOrExit(err);
+    }
+
+    // Tear the last record
+    sPersistentSegments[0][nl::Weave::Profiles::DataManagement::EventSpillStore::kSegmentHeaderSize +
+                           3 * nl::Weave::Profiles::DataManagement::EventSpillStore::kRecordHeaderSize + 2 * eventLen] ^= 0x01;
+
+    err = store.Init();
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, store.GetFirstEventID(importance) == 1);
+    NL_TEST_ASSERT(inSuite, store.GetLastEventID(importance) == 2);
+
+    err = store.AppendEvent(importance, 4, event, eventLen);
+    SuccessOrExit(err);
+
+    err = store.Init();
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, store.GetLastEventID(importance) == 4);
+
+    eventID = 1;
+    writer.Init(gLargeMemoryBackingStore, sizeof(gLargeMemoryBackingStore));
+    err = store.FetchEventsSince(writer, importance, eventID, 5);
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, eventID == 5);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == 3 * eventLen);
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    ClearSpillStore();
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
 static void CheckBasicEventDeserialization(nlTestSuite * inSuite, void * inContext)
 {
     TestLoggingContext * context = static_cast<TestLoggingContext *>(inContext);
@@ -3553,6 +4503,7 @@ static void CheckExternalEventNotifyEvicted(nlTestSuite * inSuite, void * inCont
         nl::Weave::Profiles::DataManagement::LoggingManagement::GetInstance();
 
     InitializeEventLogging(context);
+    ResetExternalEventDeliveryState();
 
     // Prime the event buffers with some internal events
     now = System::Layer::GetClock_MonotonicMS();
@@ -3567,10 +4518,11 @@ static void CheckExternalEventNotifyEvicted(nlTestSuite * inSuite, void * inCont
     NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
     NL_TEST_ASSERT(inSuite, external_eid_production == (eid + 10));
 
-    // Force an eviction
+    // Force an eviction.  How many events that takes depends on how compactly they are stored, e.g. with a schema
+    // dictionary, so log until the external events are evicted, or far more events than the buffers could hold.
     eid_prev = FastLogFreeform(nl::Weave::Profiles::DataManagement::Production, now, "Freeform entry %d", counter++);
     now += 10;
-    for (; counter < 103; counter++)
+    for (; !sExternalEventEvictionCalled && counter < 1000; counter++)
     {
         // Sample production events, spaced 10 milliseconds apart
         eid = FastLogFreeform(nl::Weave::Profiles::DataManagement::Production, now, "Freeform entry %d", counter);
@@ -3827,6 +4779,21 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Check Byte String Array", CheckByteStringArray),
     NL_TEST_DEF("Check Log eviction", CheckEvict),
     NL_TEST_DEF("Check Fetch Events", CheckFetchEvents),
+    NL_TEST_DEF("Check Fetch Events benchmark", CheckFetchEventsBenchmark),
+    NL_TEST_DEF("Check BDX Upload Blocks", CheckBDXUploadBlocks),
+    NL_TEST_DEF("Check BDX Upload Block Size", CheckBDXUploadBlockSize),
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+    NL_TEST_DEF("Check Staged Events", CheckStagedEvents),
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_QUEUE_SIZE
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+    NL_TEST_DEF("Check Schema Dictionary", CheckSchemaDictionary),
+    NL_TEST_DEF("Check Schema Dictionary Persistence", CheckSchemaDictionaryPersistence),
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+    NL_TEST_DEF("Check Event Spill", CheckEventSpill),
+    NL_TEST_DEF("Check Event Spill File", CheckEventSpillFile),
+    NL_TEST_DEF("Check Event Spill Recovery", CheckEventSpillRecovery),
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
     NL_TEST_DEF("Check Large Events", CheckLargeEvents),
     NL_TEST_DEF("Check Fetch Event Timestamps", CheckFetchTimestamps),
     NL_TEST_DEF("Basic Deserialization Test", CheckBasicEventDeserialization),
@@ -0,0 +1,289 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the ExchangeIndex class used by
+ *      the WeaveExchangeManager, and a microbenchmark comparing the cost of
+ *      matching an inbound message to one of 16 to 4096 exchange contexts by
+ *      scanning the context pool against looking it up in the index.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <Weave/Core/WeaveExchangeIndex.h>
+
+#include <nlunit-test.h>
+
+using nl::Weave::ExchangeIndex;
+
+static const size_t kMaxContexts = 4096;
+static const size_t kContextCounts[] = { 16, 64, 256, 1024, 4096 };
+static const uint32_t kLookupsPerRun = 200000;
+
+// The fields of an exchange context that take part in matching an inbound message.
+struct TestContext
+{
+    uint64_t PeerNodeId;
+    uint16_t ExchangeId;
+    bool InUse;
+};
+
+static TestContext sContexts[kMaxContexts];
+static ExchangeIndex::Entry sEntries[ExchangeIndex::TableSize<kMaxContexts>::kValue];
+
+static uint32_t sRandState = 1;
+
+static uint32_t Rand(void)
+{
+    sRandState = sRandState * 1103515245 + 12345;
+    return sRandState >> 8;
+}
+
+static size_t CountSlots(const ExchangeIndex &aIndex, uint32_t aKey, uint16_t aSlot)
+{
+    size_t pos = aIndex.Begin(aKey);
+    size_t count = 0;
+    uint16_t slot;
+
+    while (aIndex.Next(aKey, pos, slot))
+        if (slot == aSlot)
+            count++;
+
+    return count;
+}
+
+/**
+ *  Test that TableSize yields the smallest power of two at least twice the pool size.
+ */
+static void CheckTableSize(nlTestSuite *inSuite, void *inContext)
+{
+    NL_TEST_ASSERT(inSuite, ExchangeIndex::TableSize<1>::kValue == 2);
+    NL_TEST_ASSERT(inSuite, ExchangeIndex::TableSize<16>::kValue == 32);
+    NL_TEST_ASSERT(inSuite, ExchangeIndex::TableSize<17>::kValue == 64);
+    NL_TEST_ASSERT(inSuite, ExchangeIndex::TableSize<4096>::kValue == 8192);
+}
+
+/**
+ *  Test adding, finding and removing slots, including several slots under one
+ *  key and keys that share a home position.
+ */
+static void CheckAddRemove(nlTestSuite *inSuite, void *inContext)
+{
+    ExchangeIndex index;
+    size_t pos;
+    uint16_t slot;
+
+    index.Init(sEntries, 8);
+
+    pos = index.Begin(7);
+    NL_TEST_ASSERT(inSuite, !index.Next(7, pos, slot));
+
+    // Fill all but one entry, so that probe runs wrap around the end of the table.
+    for (uint16_t i = 0; i < 7; i++)
+        index.Add(i % 3, i);
+
+    for (uint16_t i = 0; i < 7; i++)
+        NL_TEST_ASSERT(inSuite, CountSlots(index, i % 3, i) == 1);
+
+    NL_TEST_ASSERT(inSuite, !index.Remove(1, 0));
+    NL_TEST_ASSERT(inSuite, index.Remove(0, 3));
+    NL_TEST_ASSERT(inSuite, CountSlots(index, 0, 3) == 0);
+
+    for (uint16_t i = 0; i < 7; i++)
+        if (i != 3)
+            NL_TEST_ASSERT(inSuite, CountSlots(index, i % 3, i) == 1);
+
+    for (uint16_t i = 0; i < 7; i++)
+        if (i != 3)
+            NL_TEST_ASSERT(inSuite, index.Remove(i % 3, i));
+
+    for (size_t i = 0; i < 8; i++)
+        NL_TEST_ASSERT(inSuite, sEntries[i].Slot == 0);
+}
+
+/**
+ *  Test the index against a pool of contexts under a random sequence of
+ *  allocations and releases.
+ */
+static void CheckRandomized(nlTestSuite *inSuite, void *inContext)
+{
+    const size_t kNumContexts = 256;
+    ExchangeIndex index;
+
+    memset(sContexts, 0, sizeof(sContexts));
+    index.Init(sEntries, ExchangeIndex::TableSize<kNumContexts>::kValue);
+
+    for (uint32_t iter = 0; iter < 100000; iter++)
+    {
+        const uint16_t i = Rand() % kNumContexts;
+
+        if (sContexts[i].InUse)
+        {
+            NL_TEST_ASSERT(inSuite, index.Remove(sContexts[i].ExchangeId, i));
+            sContexts[i].InUse = false;
+        }
+        else
+        {
+            // Draw exchange ids from a small range so that many contexts share one.
+            sContexts[i].ExchangeId = Rand() % 64;
+            sContexts[i].InUse = true;
+            index.Add(sContexts[i].ExchangeId, i);
+        }
+
+        if (iter % 1000 == 0)
+        {
+            for (uint16_t j = 0; j < kNumContexts; j++)
+                NL_TEST_ASSERT(inSuite, CountSlots(index, sContexts[j].ExchangeId, j) == (sContexts[j].InUse ? 1 : 0));
+        }
+    }
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static const TestContext *ScanForContext(size_t aNumContexts, uint64_t aPeerNodeId, uint16_t aExchangeId)
+{
+    for (size_t i = 0; i < aNumContexts; i++)
+    {
+        const TestContext &context = sContexts[i];
+
+        if (context.InUse && context.ExchangeId == aExchangeId && context.PeerNodeId == aPeerNodeId)
+            return &context;
+    }
+
+    return NULL;
+}
+
+static const TestContext *LookupContext(const ExchangeIndex &aIndex, uint64_t aPeerNodeId, uint16_t aExchangeId)
+{
+    size_t pos = aIndex.Begin(aExchangeId);
+    uint16_t slot;
+
+    while (aIndex.Next(aExchangeId, pos, slot))
+    {
+        const TestContext &context = sContexts[slot];
+
+        if (context.ExchangeId == aExchangeId && context.PeerNodeId == aPeerNodeId)
+            return &context;
+    }
+
+    return NULL;
+}
+
+/**
+ *  Measure the cost of matching inbound messages to exchange contexts.
+ *
+ *  Description: For each pool size, fill the pool with contexts, half of them
+ *               initiated locally with sequential exchange ids and half of them
+ *               responding to peers with random exchange ids, then time the
+ *               lookup of the contexts in random order by scanning the pool and
+ *               through the index. Both must find the same contexts.
+ */
+static void CheckDispatchBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    static uint16_t sOrder[kLookupsPerRun];
+
+    printf("%-10s %18s %18s\n", "contexts", "scan (ns/msg)", "index (ns/msg)");
+
+    for (size_t run = 0; run < sizeof(kContextCounts) / sizeof(kContextCounts[0]); run++)
+    {
+        const size_t numContexts = kContextCounts[run];
+        const uint16_t firstExchangeId = static_cast<uint16_t>(Rand());
+        ExchangeIndex index;
+        uintptr_t checksum[2] = { 0, 0 };
+        double elapsed[2];
+
+        index.Init(sEntries, ExchangeIndex::TableSize<kMaxContexts>::kValue);
+
+        for (size_t i = 0; i < numContexts; i++)
+        {
+            sContexts[i].PeerNodeId = 0x18B4300000000000ULL + Rand() % 64;
+            sContexts[i].ExchangeId = (i % 2 == 0) ? static_cast<uint16_t>(firstExchangeId + i / 2) : static_cast<uint16_t>(Rand());
+            sContexts[i].InUse = true;
+            index.Add(sContexts[i].ExchangeId, static_cast<uint16_t>(i));
+        }
+
+        for (uint32_t i = 0; i < kLookupsPerRun; i++)
+            sOrder[i] = static_cast<uint16_t>(Rand() % numContexts);
+
+        elapsed[0] = Now();
+        for (uint32_t i = 0; i < kLookupsPerRun; i++)
+        {
+            const TestContext &target = sContexts[sOrder[i]];
+            checksum[0] += reinterpret_cast<uintptr_t>(ScanForContext(numContexts, target.PeerNodeId, target.ExchangeId));
+        }
+        elapsed[0] = Now() - elapsed[0];
+
+        elapsed[1] = Now();
+        for (uint32_t i = 0; i < kLookupsPerRun; i++)
+        {
+            const TestContext &target = sContexts[sOrder[i]];
+            checksum[1] += reinterpret_cast<uintptr_t>(LookupContext(index, target.PeerNodeId, target.ExchangeId));
+        }
+        elapsed[1] = Now() - elapsed[1];
+
+        NL_TEST_ASSERT(inSuite, checksum[0] == checksum[1]);
+
+        printf("%-10u %18.1f %18.1f\n", static_cast<unsigned>(numContexts), elapsed[0] / kLookupsPerRun, elapsed[1] / kLookupsPerRun);
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("ExchangeIndex::TableSize",     CheckTableSize),
+    NL_TEST_DEF("ExchangeIndex::AddRemove",     CheckAddRemove),
+    NL_TEST_DEF("ExchangeIndex::Randomized",    CheckRandomized),
+    NL_TEST_DEF("ExchangeIndex::Dispatch",      CheckDispatchBenchmark),
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "weave-exchange-index",
+        &sTests[0],
+        NULL,
+        NULL
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,254 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the peer state and session key
+ *      lookups of <tt>nl::Weave::WeaveFabricState</tt>, and a microbenchmark
+ *      of the cost of those lookups with the configured table sizes.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+
+#include "ToolCommon.h"
+
+static const uint64_t kTestNodeId = 0x18B43000002DCF71ULL;
+static const uint64_t kTestPeerNodeIdBase = 0x18B4300000000000ULL;
+static const uint32_t kTestMsgId = 100;
+static const uint32_t kLookupsPerRun = 200000;
+static WeaveFabricState sFabricState;
+
+static void ResetFabricState(void)
+{
+    sFabricState.Shutdown();
+    (void)sFabricState.Init();
+    sFabricState.LocalNodeId = kTestNodeId;
+}
+
+// Receive an unencrypted UDP message from a peer, returning whether it was detected as a duplicate.
+static bool ReceiveUnencryptedMessage(nlTestSuite *inSuite, uint64_t peerNodeId, uint32_t msgId)
+{
+    WeaveSessionState sessionState;
+    WEAVE_ERROR err;
+
+    err = sFabricState.GetSessionState(peerNodeId, WeaveKeyId::kNone, kWeaveEncryptionType_None, NULL, sessionState);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    return sessionState.IsDuplicateMessage(msgId);
+}
+
+/**
+ *  Test that the peer state table keeps the state of recently heard from peers
+ *  and, once full, discards the state of the least recently heard from one.
+ */
+static void CheckPeerStateEviction(nlTestSuite *inSuite, void *inContext)
+{
+    const uint64_t newPeerNodeId = kTestPeerNodeIdBase + WEAVE_CONFIG_MAX_PEER_NODES;
+
+    ResetFabricState();
+
+    for (uint64_t i = 0; i < WEAVE_CONFIG_MAX_PEER_NODES; i++)
+        NL_TEST_ASSERT(inSuite, !ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase + i, kTestMsgId));
+
+    for (uint64_t i = 0; i < WEAVE_CONFIG_MAX_PEER_NODES; i++)
+        NL_TEST_ASSERT(inSuite, ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase + i, kTestMsgId));
+
+    // Hear from the first peer again, so that the second one becomes the least recently heard from.
+    NL_TEST_ASSERT(inSuite, ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase, kTestMsgId));
+
+    NL_TEST_ASSERT(inSuite, !ReceiveUnencryptedMessage(inSuite, newPeerNodeId, kTestMsgId));
+
+    NL_TEST_ASSERT(inSuite, ReceiveUnencryptedMessage(inSuite, newPeerNodeId, kTestMsgId));
+    NL_TEST_ASSERT(inSuite, ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase, kTestMsgId));
+
+#if WEAVE_CONFIG_MAX_PEER_NODES > 1
+    // The state of the second peer was discarded, so its message is no longer recognized.
+    NL_TEST_ASSERT(inSuite, !ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase + 1, kTestMsgId));
+#endif
+}
+
+/**
+ *  Test allocating, finding and removing session keys, including keys that share
+ *  a key id with different peers.
+ */
+static void CheckSessionKeyLookup(nlTestSuite *inSuite, void *inContext)
+{
+    WeaveSessionKey *sessionKeys[WEAVE_CONFIG_MAX_SESSION_KEYS];
+    WeaveSessionKey *sessionKey;
+    WEAVE_ERROR err;
+
+    ResetFabricState();
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+    {
+        err = sFabricState.AllocSessionKey(kTestPeerNodeIdBase + i, WeaveKeyId::MakeSessionKeyId(i / 2), NULL, sessionKeys[i]);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    err = sFabricState.AllocSessionKey(kTestPeerNodeIdBase, WeaveKeyId::kNone, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TOO_MANY_KEYS);
+
+    err = sFabricState.AllocSessionKey(kTestPeerNodeIdBase, WeaveKeyId::MakeSessionKeyId(0), NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_DUPLICATE_KEY_ID);
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+    {
+        err = sFabricState.FindSessionKey(WeaveKeyId::MakeSessionKeyId(i / 2), kTestPeerNodeIdBase + i, false, sessionKey);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sessionKey == sessionKeys[i]);
+    }
+
+    err = sFabricState.FindSessionKey(WeaveKeyId::MakeSessionKeyId(0), kTestPeerNodeIdBase + 2, false, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_KEY_NOT_FOUND);
+
+    // Remove every other key and allocate them again under new key ids.
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i += 2)
+    {
+        err = sFabricState.RemoveSessionKey(WeaveKeyId::MakeSessionKeyId(i / 2), kTestPeerNodeIdBase + i);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = sFabricState.FindSessionKey(WeaveKeyId::MakeSessionKeyId(i / 2), kTestPeerNodeIdBase + i, false, sessionKey);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_KEY_NOT_FOUND);
+    }
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i += 2)
+    {
+        err = sFabricState.AllocSessionKey(kTestPeerNodeIdBase + i, WeaveKeyId::MakeSessionKeyId(0x100 + i), NULL, sessionKeys[i]);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+    {
+        const uint16_t keyId = WeaveKeyId::MakeSessionKeyId((i % 2 == 0) ? 0x100 + i : i / 2);
+
+        err = sFabricState.FindSessionKey(keyId, kTestPeerNodeIdBase + i, false, sessionKey);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR && sessionKey == sessionKeys[i]);
+        NL_TEST_ASSERT(inSuite, sessionKey->MsgEncKey.KeyId == keyId && sessionKey->NodeId == kTestPeerNodeIdBase + i);
+    }
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+        sFabricState.RemoveSessionKey(sessionKeys[i]);
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+    {
+        err = sFabricState.AllocSessionKey(kTestPeerNodeIdBase + i, WeaveKeyId::kNone, NULL, sessionKeys[i]);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+}
+
+/**
+ *  Measure the cost of looking up peer states and session keys.
+ *
+ *  Description: Fill the peer state and session key tables, then time the lookup
+ *               of the state of each peer, and of each session key, in turn.
+ */
+static void CheckLookupBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    WeaveSessionState sessionState;
+    WeaveSessionKey *sessionKey;
+    uint32_t failures = 0;
+    uint64_t elapsed;
+
+    ResetFabricState();
+
+    for (uint64_t i = 0; i < WEAVE_CONFIG_MAX_PEER_NODES; i++)
+        ReceiveUnencryptedMessage(inSuite, kTestPeerNodeIdBase + i, kTestMsgId);
+
+    for (uint16_t i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
+        sFabricState.AllocSessionKey(kTestPeerNodeIdBase + i, WeaveKeyId::MakeSessionKeyId(i), NULL, sessionKey);
+
+    elapsed = Now();
+    for (uint32_t i = 0; i < kLookupsPerRun; i++)
+    {
+        if (sFabricState.GetSessionState(kTestPeerNodeIdBase + i % WEAVE_CONFIG_MAX_PEER_NODES, WeaveKeyId::kNone,
+                                         kWeaveEncryptionType_None, NULL, sessionState) != WEAVE_NO_ERROR)
+            failures++;
+    }
+    elapsed = Now() - elapsed;
+
+    printf("%u peer states: %.1f ns/lookup\n", static_cast<unsigned>(WEAVE_CONFIG_MAX_PEER_NODES), elapsed * 1000.0 / kLookupsPerRun);
+
+    elapsed = Now();
+    for (uint32_t i = 0; i < kLookupsPerRun; i++)
+    {
+        const uint16_t keyNumber = i % WEAVE_CONFIG_MAX_SESSION_KEYS;
+
+        if (sFabricState.FindSessionKey(WeaveKeyId::MakeSessionKeyId(keyNumber), kTestPeerNodeIdBase + keyNumber, false, sessionKey) != WEAVE_NO_ERROR)
+            failures++;
+    }
+    elapsed = Now() - elapsed;
+
+    printf("%u session keys: %.1f ns/lookup\n", static_cast<unsigned>(WEAVE_CONFIG_MAX_SESSION_KEYS), elapsed * 1000.0 / kLookupsPerRun);
+
+    NL_TEST_ASSERT(inSuite, failures == 0);
+}
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    (void)sFabricState.Init();
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void *inContext)
+{
+    sFabricState.Shutdown();
+
+    return (SUCCESS);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("WeaveFabricState::PeerStateEviction",   CheckPeerStateEviction),
+    NL_TEST_DEF("WeaveFabricState::SessionKeyLookup",    CheckSessionKeyLookup),
+    NL_TEST_DEF("WeaveFabricState::LookupBenchmark",     CheckLookupBenchmark),
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite =
+    {
+        "weave-fabric-state-lookup",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,262 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the batched sending
+ *      and receiving of datagrams by InetLayer UDP endpoints.
+ *
+ *      Datagrams are queued on one endpoint with QueueSendMsg() and
+ *      received by another over the loopback interface, with a receive
+ *      batch size greater than one.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#include <InetLayer/InetLayer.h>
+#include <InetLayer/InetError.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+
+using namespace nl::Inet;
+using namespace nl::Weave::System;
+
+#define TOOL_NAME "TestInetBatching"
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING
+
+static const uint32_t kReceiveTimeoutMS = 1000;
+
+struct TestContext
+{
+    UDPEndPoint *mSender;
+    UDPEndPoint *mReceiver;
+};
+
+static uint32_t sNumReceived;
+static uint32_t sNumOutOfOrder;
+
+static void HandleMessageReceived(IPEndPointBasis *aEndPoint, PacketBuffer *aBuffer, const IPPacketInfo *aPacketInfo)
+{
+    // Each datagram carries its sequence number in its first octet.
+    if (aBuffer->DataLength() != 1 || aBuffer->Start()[0] != static_cast<uint8_t>(sNumReceived))
+        sNumOutOfOrder++;
+
+    sNumReceived++;
+    PacketBuffer::Free(aBuffer);
+}
+
+/**
+ *  Queue @p aCount datagrams, numbered from zero, for sending to the receiving endpoint, and reset the receive counters.
+ */
+static INET_ERROR QueueDatagrams(TestContext &aContext, uint32_t aCount)
+{
+    INET_ERROR err = INET_NO_ERROR;
+    IPPacketInfo lPktInfo;
+
+    sNumReceived = 0;
+    sNumOutOfOrder = 0;
+
+    lPktInfo.Clear();
+    IPAddress::FromString("::1", lPktInfo.DestAddress);
+    lPktInfo.DestPort = aContext.mReceiver->GetBoundPort();
+
+    for (uint32_t i = 0; i < aCount && err == INET_NO_ERROR; i++)
+    {
+        PacketBuffer *lBuffer = PacketBuffer::New();
+
+        VerifyOrExit(lBuffer != NULL, err = INET_ERROR_NO_MEMORY);
+
+        lBuffer->Start()[0] = static_cast<uint8_t>(i);
+        lBuffer->SetDataLength(1);
+
+        err = aContext.mSender->QueueSendMsg(&lPktInfo, lBuffer);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Service the event loop until @p aCount datagrams have been received, or the receive timeout passes.
+ *
+ *  @return The largest number of datagrams received in a single event loop pass.
+ */
+static uint32_t ReceiveDatagrams(uint32_t aCount)
+{
+    const uint64_t lDeadline = Layer::GetClock_MonotonicMS() + kReceiveTimeoutMS;
+    uint32_t lMaxPerPass = 0;
+
+    while (sNumReceived < aCount && Layer::GetClock_MonotonicMS() < lDeadline)
+    {
+        const uint32_t lNumBefore = sNumReceived;
+        struct timeval lSleepTime;
+
+        lSleepTime.tv_sec = 0;
+        lSleepTime.tv_usec = 10000;
+        ServiceEvents(lSleepTime);
+
+        if (sNumReceived - lNumBefore > lMaxPerPass)
+            lMaxPerPass = sNumReceived - lNumBefore;
+    }
+
+    return lMaxPerPass;
+}
+
+// Test Suite
+
+/**
+ *  Test that datagrams queued with QueueSendMsg() are sent together by FlushSendQueue(), and are received in one batch.
+ */
+static void CheckFlushSendQueue(nlTestSuite *inSuite, void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    const uint32_t kCount = (INET_CONFIG_UDP_BATCH_SIZE > 1) ? INET_CONFIG_UDP_BATCH_SIZE - 1 : 1;
+    INET_ERROR err;
+    uint32_t lMaxPerPass;
+
+    // Leave the queue one short of full, so that only FlushSendQueue() sends it.
+    err = QueueDatagrams(lContext, kCount);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = lContext.mSender->FlushSendQueue();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    lMaxPerPass = ReceiveDatagrams(kCount);
+    NL_TEST_ASSERT(inSuite, sNumReceived == kCount);
+    NL_TEST_ASSERT(inSuite, sNumOutOfOrder == 0);
+
+    // Loopback delivers the whole batch before the receiver is serviced, so a single readiness event drains it.
+    NL_TEST_ASSERT(inSuite, lMaxPerPass == kCount);
+}
+
+/**
+ *  Test that datagrams still queued at the end of an event loop pass are sent, and that filling the queue sends it.
+ */
+static void CheckEventLoopFlush(nlTestSuite *inSuite, void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    const uint32_t kCount = 2 * INET_CONFIG_UDP_BATCH_SIZE + 1;
+    INET_ERROR err;
+    uint32_t lMaxPerPass;
+
+    err = QueueDatagrams(lContext, kCount);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    lMaxPerPass = ReceiveDatagrams(kCount);
+    NL_TEST_ASSERT(inSuite, sNumReceived == kCount);
+    NL_TEST_ASSERT(inSuite, sNumOutOfOrder == 0);
+    NL_TEST_ASSERT(inSuite, lMaxPerPass <= INET_CONFIG_UDP_BATCH_SIZE);
+    NL_TEST_ASSERT(inSuite, INET_CONFIG_UDP_BATCH_SIZE == 1 || lMaxPerPass > 1);
+}
+
+static const nlTest sTests[] = {
+    NL_TEST_DEF("InetBatching::FlushSendQueue",      CheckFlushSendQueue),
+    NL_TEST_DEF("InetBatching::EventLoopFlush",      CheckEventLoopFlush),
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite: bring up the network and open the sending and receiving endpoints.
+ */
+static int TestSetup(void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    INET_ERROR err;
+
+    InitSystemLayer();
+    InitNetwork();
+
+    err = Inet.NewUDPEndPoint(&lContext.mSender);
+    SuccessOrExit(err);
+
+    err = lContext.mSender->Bind(kIPAddressType_IPv6, IPAddress::Any, 0);
+    SuccessOrExit(err);
+
+    err = Inet.NewUDPEndPoint(&lContext.mReceiver);
+    SuccessOrExit(err);
+
+    err = lContext.mReceiver->Bind(kIPAddressType_IPv6, IPAddress::Any, 0);
+    SuccessOrExit(err);
+
+    err = lContext.mReceiver->SetReceiveBatchSize(INET_CONFIG_UDP_BATCH_SIZE);
+    SuccessOrExit(err);
+
+    lContext.mReceiver->OnMessageReceived = HandleMessageReceived;
+
+    err = lContext.mReceiver->Listen();
+    SuccessOrExit(err);
+
+exit:
+    return (err == INET_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite: close the endpoints and shut the network down.
+ */
+static int TestTeardown(void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+
+    if (lContext.mSender != NULL)
+        lContext.mSender->Free();
+
+    if (lContext.mReceiver != NULL)
+        lContext.mReceiver->Free();
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    TestContext lContext = { NULL, NULL };
+    nlTestSuite theSuite = {
+        "inet-batching",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, &lContext);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING)
+
+int main(int argc, char *argv[])
+{
+    return 0;
+}
+
+#endif // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_ENABLE_UDP_BATCHING)
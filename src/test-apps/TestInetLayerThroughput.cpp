@@ -0,0 +1,407 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the UDP datagram throughput of
+ *      the InetLayer over the loopback interface, sending each datagram
+ *      with its own system call and receiving one datagram per readiness
+ *      event, and, when INET_CONFIG_ENABLE_UDP_BATCHING is asserted,
+ *      queuing the datagrams sent in each event loop pass and receiving
+ *      them in batches.
+ *
+ *      Each datagram carries a sequence number, which the receiver
+ *      checks, along with the packet information of the datagram.
+ *
+ *      When TCP endpoints are enabled, it also measures the throughput
+ *      of a TCP stream written as chains of small header and larger
+ *      payload buffers and, when WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+ *      is asserted, reports how many buffers each send system call
+ *      gathered.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ToolCommon.h"
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Core/WeaveEncoding.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+using namespace nl::Inet;
+
+#define TOOL_NAME "TestInetLayerThroughput"
+
+static const uint32_t kDatagramsPerRun = 100000;
+static const uint32_t kDatagramsPerPass = 32;
+static const uint16_t kPayloadLength = 64;
+static const uint32_t kReceiveTimeoutMS = 1000;
+
+static UDPEndPoint *sSender = NULL;
+static UDPEndPoint *sReceiver = NULL;
+static uint32_t sNumReceived = 0;
+static uint32_t sNumErrors = 0;
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+static const uint32_t kStreamLength = 32 * 1024 * 1024;
+static const uint16_t kStreamPort = 41234;
+static const uint16_t kStreamHeaderLength = 16;
+static const uint16_t kStreamPayloadLength = 1200;
+static const uint8_t kStreamBuffersPerSend = 8;
+static const uint32_t kMaxPendingStreamLength = 32768;
+
+static TCPEndPoint *sStreamListener = NULL;
+static TCPEndPoint *sStreamSender = NULL;
+static TCPEndPoint *sStreamReceiver = NULL;
+static bool sStreamConnected = false;
+static uint32_t sStreamReceived = 0;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+static void HandleMessageReceived(IPEndPointBasis *aEndPoint, PacketBuffer *aBuffer, const IPPacketInfo *aPacketInfo)
+{
+    const uint8_t *p = aBuffer->Start();
+
+    if (aBuffer->DataLength() != kPayloadLength || nl::Weave::Encoding::LittleEndian::Read32(p) != sNumReceived ||
+        aPacketInfo->SrcPort != sSender->GetBoundPort() || aPacketInfo->DestPort != sReceiver->GetBoundPort())
+    {
+        sNumErrors++;
+    }
+
+    sNumReceived++;
+    PacketBuffer::Free(aBuffer);
+}
+
+static void HandleReceiveError(IPEndPointBasis *aEndPoint, INET_ERROR aError, const IPPacketInfo *aPacketInfo)
+{
+    printf("receive error: %s\n", nl::ErrorStr(aError));
+    sNumErrors++;
+}
+
+static INET_ERROR OpenEndPoint(UDPEndPoint *&aEndPoint)
+{
+    INET_ERROR err;
+
+    err = Inet.NewUDPEndPoint(&aEndPoint);
+    SuccessOrExit(err);
+
+    err = aEndPoint->Bind(kIPAddressType_IPv6, IPAddress::Any, 0);
+    SuccessOrExit(err);
+
+    aEndPoint->OnMessageReceived = HandleMessageReceived;
+    aEndPoint->OnReceiveError = HandleReceiveError;
+
+    err = aEndPoint->Listen();
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+/**
+ *  Send kDatagramsPerRun datagrams from the sender to the receiver, kDatagramsPerPass at a time,
+ *  servicing the event loop after each group until it is received.
+ *
+ *  @return The throughput in datagrams per second, or a negative value on failure.
+ */
+static double MeasureThroughput(bool aBatched)
+{
+    IPPacketInfo lPktInfo;
+    uint64_t lStartTime;
+    uint32_t lNumSent = 0;
+
+    sNumReceived = 0;
+    sNumErrors = 0;
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    sReceiver->SetReceiveBatchSize(aBatched ? INET_CONFIG_UDP_BATCH_SIZE : 1);
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
+    lPktInfo.Clear();
+    IPAddress::FromString("::1", lPktInfo.DestAddress);
+    lPktInfo.DestPort = sReceiver->GetBoundPort();
+
+    lStartTime = System::Layer::GetClock_MonotonicHiRes();
+
+    while (lNumSent < kDatagramsPerRun)
+    {
+        const uint64_t lDeadline = System::Layer::GetClock_MonotonicMS() + kReceiveTimeoutMS;
+
+        for (uint32_t i = 0; i < kDatagramsPerPass && lNumSent < kDatagramsPerRun; i++, lNumSent++)
+        {
+            PacketBuffer *lBuffer = PacketBuffer::New();
+            uint8_t *p;
+            INET_ERROR err;
+
+            if (lBuffer == NULL)
+            {
+                printf("out of packet buffers\n");
+                return -1.0;
+            }
+
+            p = lBuffer->Start();
+            memset(p, 0, kPayloadLength);
+            nl::Weave::Encoding::LittleEndian::Write32(p, lNumSent);
+            lBuffer->SetDataLength(kPayloadLength);
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+            if (aBatched)
+                err = sSender->QueueSendMsg(&lPktInfo, lBuffer);
+            else
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+                err = sSender->SendMsg(&lPktInfo, lBuffer);
+
+            if (err != INET_NO_ERROR)
+            {
+                printf("send failed: %s\n", nl::ErrorStr(err));
+                return -1.0;
+            }
+        }
+
+        while (sNumReceived != lNumSent)
+        {
+            struct timeval lSleepTime;
+
+            lSleepTime.tv_sec = 0;
+            lSleepTime.tv_usec = 100000;
+
+            ServiceNetwork(lSleepTime);
+
+            if (System::Layer::GetClock_MonotonicMS() > lDeadline)
+            {
+                printf("timed out waiting for datagram %" PRIu32 "\n", sNumReceived);
+                return -1.0;
+            }
+        }
+    }
+
+    if (sNumErrors != 0)
+    {
+        printf("%" PRIu32 " datagrams received out of order or with wrong packet information\n", sNumErrors);
+        return -1.0;
+    }
+
+    return kDatagramsPerRun * 1e6 / (System::Layer::GetClock_MonotonicHiRes() - lStartTime);
+}
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+static inline uint8_t StreamByte(uint32_t aOffset)
+{
+    return static_cast<uint8_t>(aOffset * 7);
+}
+
+static void HandleStreamDataReceived(TCPEndPoint *aEndPoint, PacketBuffer *aBuffer)
+{
+    for (PacketBuffer *lBuffer = aBuffer; lBuffer != NULL; lBuffer = lBuffer->Next())
+    {
+        const uint8_t *p = lBuffer->Start();
+
+        for (uint16_t i = 0; i < lBuffer->DataLength(); i++, sStreamReceived++)
+        {
+            if (p[i] != StreamByte(sStreamReceived))
+                sNumErrors++;
+        }
+    }
+
+    PacketBuffer::Free(aBuffer);
+}
+
+static void HandleStreamConnectionReceived(TCPEndPoint *aListener, TCPEndPoint *aEndPoint, const IPAddress &aPeerAddress, uint16_t aPeerPort)
+{
+    sStreamReceiver = aEndPoint;
+    aEndPoint->OnDataReceived = HandleStreamDataReceived;
+}
+
+static void HandleStreamConnectComplete(TCPEndPoint *aEndPoint, INET_ERROR aError)
+{
+    sStreamConnected = (aError == INET_NO_ERROR);
+}
+
+/**
+ *  Write kStreamLength bytes from the stream sender to the stream receiver, in chains of
+ *  alternating header and payload buffers, keeping at most kMaxPendingStreamLength bytes queued.
+ *
+ *  @return The throughput in bytes per second, or a negative value on failure.
+ */
+static double MeasureStreamThroughput(void)
+{
+    IPAddress lAddress;
+    struct timeval lSleepTime;
+    uint64_t lStartTime;
+    uint64_t lDeadline = System::Layer::GetClock_MonotonicMS() + kReceiveTimeoutMS;
+    uint32_t lNumSent = 0;
+    INET_ERROR err;
+
+    sNumErrors = 0;
+    lSleepTime.tv_sec = 0;
+    lSleepTime.tv_usec = 0;
+
+    err = Inet.NewTCPEndPoint(&sStreamListener);
+    SuccessOrExit(err);
+    err = sStreamListener->Bind(kIPAddressType_IPv6, IPAddress::Any, kStreamPort, true);
+    SuccessOrExit(err);
+    sStreamListener->OnConnectionReceived = HandleStreamConnectionReceived;
+    err = sStreamListener->Listen(1);
+    SuccessOrExit(err);
+
+    err = Inet.NewTCPEndPoint(&sStreamSender);
+    SuccessOrExit(err);
+    sStreamSender->OnConnectComplete = HandleStreamConnectComplete;
+    IPAddress::FromString("::1", lAddress);
+    err = sStreamSender->Connect(lAddress, kStreamPort);
+    SuccessOrExit(err);
+
+    while (!sStreamConnected || sStreamReceiver == NULL)
+    {
+        VerifyOrExit(System::Layer::GetClock_MonotonicMS() <= lDeadline, err = INET_ERROR_TCP_CONNECT_TIMEOUT);
+        ServiceNetwork(lSleepTime);
+    }
+
+    lStartTime = System::Layer::GetClock_MonotonicHiRes();
+
+    while (sStreamReceived < kStreamLength)
+    {
+        while (lNumSent < kStreamLength && sStreamSender->PendingSendLength() < kMaxPendingStreamLength)
+        {
+            PacketBuffer *lChain = NULL;
+
+            for (uint8_t i = 0; i < kStreamBuffersPerSend && lNumSent < kStreamLength; i++)
+            {
+                PacketBuffer *lBuffer = PacketBuffer::New(0);
+                uint16_t lLength = (i % 2 == 0) ? kStreamHeaderLength : kStreamPayloadLength;
+
+                VerifyOrExit(lBuffer != NULL, err = INET_ERROR_NO_MEMORY);
+
+                if (lLength > kStreamLength - lNumSent)
+                    lLength = kStreamLength - lNumSent;
+
+                for (uint16_t j = 0; j < lLength; j++)
+                    lBuffer->Start()[j] = StreamByte(lNumSent + j);
+                lBuffer->SetDataLength(lLength);
+                lNumSent += lLength;
+
+                if (lChain == NULL)
+                    lChain = lBuffer;
+                else
+                    lChain->AddToEnd(lBuffer);
+            }
+
+            err = sStreamSender->Send(lChain, true);
+            SuccessOrExit(err);
+        }
+
+        ServiceNetwork(lSleepTime);
+    }
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    {
+        const TCPEndPoint::SendStats &lStats = sStreamSender->GetSendStats();
+
+        printf("%-24s %18" PRIu32 "\n", "send calls", lStats.SendCalls);
+        printf("%-24s %18.2f\n", "buffers per send call", static_cast<double>(lStats.BuffersSent) / lStats.SendCalls);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+exit:
+    if (sStreamReceiver != NULL)
+        sStreamReceiver->Free();
+    if (sStreamSender != NULL)
+        sStreamSender->Free();
+    if (sStreamListener != NULL)
+        sStreamListener->Free();
+
+    if (err != INET_NO_ERROR)
+    {
+        printf("stream failed: %s\n", nl::ErrorStr(err));
+        return -1.0;
+    }
+
+    if (sNumErrors != 0)
+    {
+        printf("%" PRIu32 " stream bytes received corrupted\n", sNumErrors);
+        return -1.0;
+    }
+
+    return kStreamLength * 1e6 / (System::Layer::GetClock_MonotonicHiRes() - lStartTime);
+}
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+int main(int argc, char *argv[])
+{
+    INET_ERROR err;
+    bool lFailed = false;
+    double lThroughput;
+
+    InitToolCommon();
+    UseStdoutLineBuffering();
+
+    InitSystemLayer();
+    InitNetwork();
+
+    err = OpenEndPoint(sSender);
+    if (err == INET_NO_ERROR)
+        err = OpenEndPoint(sReceiver);
+    if (err != INET_NO_ERROR)
+    {
+        printf("failed to open endpoints: %s\n", nl::ErrorStr(err));
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-24s %18s\n", "mode", "datagrams/s");
+
+    lThroughput = MeasureThroughput(false);
+    lFailed |= (lThroughput < 0);
+    printf("%-24s %18.0f\n", "per-datagram", lThroughput);
+
+#if INET_CONFIG_ENABLE_UDP_BATCHING
+    lThroughput = MeasureThroughput(true);
+    lFailed |= (lThroughput < 0);
+    printf("batched (%-3u)            %18.0f\n", static_cast<unsigned>(INET_CONFIG_UDP_BATCH_SIZE), lThroughput);
+#endif // INET_CONFIG_ENABLE_UDP_BATCHING
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    lThroughput = MeasureStreamThroughput();
+    lFailed |= (lThroughput < 0);
+    printf("%-24s %18.0f\n", "TCP stream bytes/s", lThroughput);
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+    sSender->Free();
+    sReceiver->Free();
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    printf("%s %s\n", TOOL_NAME, lFailed ? "FAILED" : "PASSED");
+
+    return lFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#else // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT)
+
+int main(int argc, char *argv[])
+{
+    return 0;
+}
+
+#endif // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT)
@@ -0,0 +1,284 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark comparing the cost of a single
+ *      event loop wakeup with the select()-based InetLayer dispatch and,
+ *      when WEAVE_SYSTEM_CONFIG_USE_EPOLL is asserted, the epoll-based
+ *      dispatch, as the number of listening UDP endpoints grows.
+ *
+ *      Each wakeup is caused by one datagram sent over the loopback
+ *      interface to one of the endpoints, round-robin.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+
+#include "ToolCommon.h"
+#include <SystemLayer/SystemTimer.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+using namespace nl::Inet;
+
+#define TOOL_NAME "TestInetLayerWakeup"
+
+static const size_t kEndPointCounts[] = { 10, 100, 1000 };
+static const uint32_t kWakeupsPerRun = 2000;
+static const uint32_t kReceiveTimeoutMS = 1000;
+
+enum LoopType
+{
+    kLoopType_Select,
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    kLoopType_Epoll,
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+};
+
+static UDPEndPoint *sEndPoints[INET_CONFIG_NUM_UDP_ENDPOINTS];
+static size_t sNumEndPoints = 0;
+static volatile uint32_t sNumReceived = 0;
+
+static void HandleMessageReceived(IPEndPointBasis *aEndPoint, PacketBuffer *aBuffer, const IPPacketInfo *aPacketInfo)
+{
+    sNumReceived++;
+    PacketBuffer::Free(aBuffer);
+}
+
+static void ServiceSelectOnce(::timeval &aSleepTime)
+{
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    SystemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, aSleepTime);
+    Inet.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, aSleepTime);
+
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &aSleepTime);
+
+    SystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    Inet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+}
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+static void ServiceEpollOnce(::timeval &aSleepTime)
+{
+    struct epoll_event events[WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    SystemLayer.PrepareEpoll(aSleepTime);
+    Inet.PrepareEpoll(aSleepTime);
+
+    int numEvents = epoll_wait(SystemLayer.GetEpollFD(), events, WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS,
+                               static_cast<int>(aSleepTime.tv_sec * 1000 + (aSleepTime.tv_usec + 999) / 1000));
+
+    SystemLayer.HandleEpollResult(numEvents, events);
+    Inet.HandleEpollResult(numEvents, events);
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+static INET_ERROR OpenEndPoints(size_t aCount)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+    while (sNumEndPoints < aCount)
+    {
+        UDPEndPoint *lEndPoint;
+
+        err = Inet.NewUDPEndPoint(&lEndPoint);
+        SuccessOrExit(err);
+
+        sEndPoints[sNumEndPoints++] = lEndPoint;
+
+        err = lEndPoint->Bind(kIPAddressType_IPv6, IPAddress::Any, 0);
+        SuccessOrExit(err);
+
+        lEndPoint->OnMessageReceived = HandleMessageReceived;
+
+        err = lEndPoint->Listen();
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+static void CloseEndPoints(void)
+{
+    while (sNumEndPoints > 0)
+    {
+        sEndPoints[--sNumEndPoints]->Free();
+    }
+}
+
+/**
+ *  Send one datagram to each endpoint in turn and service the event loop until it is received.
+ *
+ *  @return The mean cost of a wakeup in microseconds, or a negative value on timeout.
+ */
+static double MeasureWakeups(int aSenderSocket, LoopType aLoopType)
+{
+    struct sockaddr_in6 lDest;
+    const uint8_t kPayload = 0x5A;
+    uint64_t lStartTime, lElapsed = 0;
+
+    memset(&lDest, 0, sizeof(lDest));
+    lDest.sin6_family = AF_INET6;
+    lDest.sin6_addr = in6addr_loopback;
+
+    for (uint32_t i = 0; i < kWakeupsPerRun; i++)
+    {
+        const uint32_t lExpected = sNumReceived + 1;
+        const uint64_t lDeadline = System::Layer::GetClock_MonotonicMS() + kReceiveTimeoutMS;
+
+        lDest.sin6_port = htons(sEndPoints[i % sNumEndPoints]->GetBoundPort());
+
+        if (sendto(aSenderSocket, &kPayload, sizeof(kPayload), 0, reinterpret_cast<struct sockaddr *>(&lDest), sizeof(lDest)) < 0)
+        {
+            printf("sendto failed: %s\n", strerror(errno));
+            return -1.0;
+        }
+
+        // Only the loop passes are timed, not the send.
+        lStartTime = System::Layer::GetClock_MonotonicHiRes();
+
+        while (sNumReceived != lExpected)
+        {
+            ::timeval lSleepTime;
+
+            lSleepTime.tv_sec = 0;
+            lSleepTime.tv_usec = 100000;
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+            if (aLoopType == kLoopType_Epoll)
+                ServiceEpollOnce(lSleepTime);
+            else
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+                ServiceSelectOnce(lSleepTime);
+
+            if (System::Layer::GetClock_MonotonicMS() > lDeadline)
+            {
+                printf("timed out waiting for datagram %" PRIu32 "\n", i);
+                return -1.0;
+            }
+        }
+
+        lElapsed += System::Layer::GetClock_MonotonicHiRes() - lStartTime;
+    }
+
+    return static_cast<double>(lElapsed) / kWakeupsPerRun;
+}
+
+int main(int argc, char *argv[])
+{
+    INET_ERROR err;
+    int lSenderSocket;
+    bool lFailed = false;
+
+    InitToolCommon();
+    UseStdoutLineBuffering();
+
+    InitSystemLayer();
+    InitNetwork();
+
+    lSenderSocket = socket(AF_INET6, SOCK_DGRAM, 0);
+    if (lSenderSocket < 0)
+    {
+        printf("socket failed: %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-10s %18s", "endpoints", "select (us/wakeup)");
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    printf(" %18s", "epoll (us/wakeup)");
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    printf("\n");
+
+    for (size_t i = 0; i < sizeof(kEndPointCounts) / sizeof(kEndPointCounts[0]) && !lFailed; i++)
+    {
+        double lSelectCost;
+
+        if (kEndPointCounts[i] > INET_CONFIG_NUM_UDP_ENDPOINTS)
+        {
+            printf("%-10u skipped: exceeds INET_CONFIG_NUM_UDP_ENDPOINTS (%u)\n", static_cast<unsigned>(kEndPointCounts[i]),
+                   static_cast<unsigned>(INET_CONFIG_NUM_UDP_ENDPOINTS));
+            continue;
+        }
+
+        err = OpenEndPoints(kEndPointCounts[i]);
+        if (err != INET_NO_ERROR)
+        {
+            printf("failed to open %u endpoints: %s\n", static_cast<unsigned>(kEndPointCounts[i]), nl::ErrorStr(err));
+            CloseEndPoints();
+            lFailed = true;
+            break;
+        }
+
+        lSelectCost = MeasureWakeups(lSenderSocket, kLoopType_Select);
+        lFailed |= (lSelectCost < 0);
+        printf("%-10u %18.2f", static_cast<unsigned>(sNumEndPoints), lSelectCost);
+
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+        {
+            const double lEpollCost = MeasureWakeups(lSenderSocket, kLoopType_Epoll);
+            lFailed |= (lEpollCost < 0);
+            printf(" %18.2f", lEpollCost);
+        }
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+        printf("\n");
+
+        CloseEndPoints();
+    }
+
+    close(lSenderSocket);
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    printf("%s %s\n", TOOL_NAME, lFailed ? "FAILED" : "PASSED");
+
+    return lFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#else // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT)
+
+int main(int argc, char *argv[])
+{
+    return 0;
+}
+
+#endif // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT)
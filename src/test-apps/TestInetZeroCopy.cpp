@@ -0,0 +1,354 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the zero-copy sending
+ *      of data by InetLayer TCP endpoints.
+ *
+ *      Large writes are sent with MSG_ZEROCOPY over a loopback
+ *      connection, and checked both for arriving intact and for the
+ *      sending socket staying open until the kernel has finished with
+ *      their buffers, even when the connection is aborted.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <dirent.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <InetLayer/InetLayer.h>
+#include <InetLayer/InetError.h>
+
+#include <nlunit-test.h>
+
+#include "ToolCommon.h"
+
+using namespace nl::Inet;
+using namespace nl::Weave::System;
+
+#define TOOL_NAME "TestInetZeroCopy"
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY
+
+static const uint16_t kTestPort = 4243;
+static const uint32_t kTimeoutMS = 2000;
+static const uint32_t kNumBuffers = 16;
+
+struct TestContext
+{
+    TCPEndPoint *mListener;
+    TCPEndPoint *mSender;
+    TCPEndPoint *mReceiver;
+};
+
+static TestContext *sContext;
+static bool sConnectComplete;
+static uint32_t sNumSent;
+static uint32_t sNumReceived;
+static uint32_t sNumCorrupt;
+
+static void HandleConnectComplete(TCPEndPoint *aEndPoint, INET_ERROR aError)
+{
+    sConnectComplete = (aError == INET_NO_ERROR);
+}
+
+static void HandleDataReceived(TCPEndPoint *aEndPoint, PacketBuffer *aBuffer)
+{
+    // Each octet of the stream carries the low bits of its offset.
+    for (PacketBuffer *lBuffer = aBuffer; lBuffer != NULL; lBuffer = lBuffer->Next())
+    {
+        for (uint16_t i = 0; i < lBuffer->DataLength(); i++, sNumReceived++)
+        {
+            if (lBuffer->Start()[i] != static_cast<uint8_t>(sNumReceived))
+                sNumCorrupt++;
+        }
+    }
+
+    PacketBuffer::Free(aBuffer);
+}
+
+static void HandleConnectionReceived(TCPEndPoint *aListener, TCPEndPoint *aEndPoint, const IPAddress &aPeerAddr, uint16_t aPeerPort)
+{
+    aEndPoint->OnDataReceived = HandleDataReceived;
+    sContext->mReceiver = aEndPoint;
+}
+
+/**
+ *  Count the file descriptors the process has open.
+ */
+static uint32_t CountOpenFiles(void)
+{
+    DIR *lDir = opendir("/proc/self/fd");
+    uint32_t lCount = 0;
+
+    if (lDir != NULL)
+    {
+        while (readdir(lDir) != NULL)
+            lCount++;
+
+        closedir(lDir);
+    }
+
+    return lCount;
+}
+
+/**
+ *  Service the event loop once, for up to ten milliseconds.
+ */
+static void ServiceOnce(void)
+{
+    struct timeval lSleepTime;
+
+    lSleepTime.tv_sec = 0;
+    lSleepTime.tv_usec = 10000;
+    ServiceEvents(lSleepTime);
+}
+
+/**
+ *  Connect the sending endpoint to the listener, and enable zero-copy sends on it.
+ */
+static INET_ERROR Connect(TestContext &aContext)
+{
+    const uint64_t lDeadline = Layer::GetClock_MonotonicMS() + kTimeoutMS;
+    IPAddress lAddress;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", lAddress);
+
+    sConnectComplete = false;
+    aContext.mReceiver = NULL;
+
+    err = Inet.NewTCPEndPoint(&aContext.mSender);
+    SuccessOrExit(err);
+
+    aContext.mSender->OnConnectComplete = HandleConnectComplete;
+
+    err = aContext.mSender->Connect(lAddress, kTestPort);
+    SuccessOrExit(err);
+
+    while ((!sConnectComplete || aContext.mReceiver == NULL) && Layer::GetClock_MonotonicMS() < lDeadline)
+        ServiceOnce();
+
+    VerifyOrExit(sConnectComplete && aContext.mReceiver != NULL, err = INET_ERROR_CONNECTION_ABORTED);
+
+    err = aContext.mSender->EnableZeroCopy();
+
+exit:
+    return err;
+}
+
+/**
+ *  Send @p aCount full buffers, numbered from the start of the stream, as a single write, and reset the receive counters.
+ */
+static INET_ERROR SendBuffers(TestContext &aContext, uint32_t aCount)
+{
+    PacketBuffer *lChain = NULL;
+
+    sNumSent = 0;
+    sNumReceived = 0;
+    sNumCorrupt = 0;
+
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        PacketBuffer *lBuffer = PacketBuffer::New(0);
+
+        if (lBuffer == NULL)
+        {
+            PacketBuffer::Free(lChain);
+            return INET_ERROR_NO_MEMORY;
+        }
+
+        for (uint16_t j = 0; j < lBuffer->AvailableDataLength(); j++)
+            lBuffer->Start()[j] = static_cast<uint8_t>(sNumSent++);
+
+        lBuffer->SetDataLength(lBuffer->AvailableDataLength());
+
+        if (lChain == NULL)
+            lChain = lBuffer;
+        else
+            lChain->AddToEnd(lBuffer);
+    }
+
+    return aContext.mSender->Send(lChain);
+}
+
+/**
+ *  Service the event loop until the number of open files falls to @p aCount, or the timeout passes.
+ */
+static bool WaitForOpenFiles(uint32_t aCount)
+{
+    const uint64_t lDeadline = Layer::GetClock_MonotonicMS() + kTimeoutMS;
+
+    while (CountOpenFiles() > aCount && Layer::GetClock_MonotonicMS() < lDeadline)
+        ServiceOnce();
+
+    return CountOpenFiles() <= aCount;
+}
+
+// Test Suite
+
+/**
+ *  Test that a large write sent without copying arrives intact, and that closing both ends closes both sockets.
+ */
+static void CheckSend(nlTestSuite *inSuite, void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    const uint32_t lNumOpenFiles = CountOpenFiles();
+    uint64_t lDeadline;
+    INET_ERROR err;
+
+    err = Connect(lContext);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    SuccessOrExit(err);
+
+    err = SendBuffers(lContext, kNumBuffers);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sNumSent >= INET_CONFIG_TCP_ZEROCOPY_MIN_SEND_LENGTH);
+
+    lDeadline = Layer::GetClock_MonotonicMS() + kTimeoutMS;
+    while (sNumReceived < sNumSent && Layer::GetClock_MonotonicMS() < lDeadline)
+        ServiceOnce();
+
+    NL_TEST_ASSERT(inSuite, sNumReceived == sNumSent);
+    NL_TEST_ASSERT(inSuite, sNumCorrupt == 0);
+
+    lContext.mSender->Free();
+    lContext.mReceiver->Free();
+
+    NL_TEST_ASSERT(inSuite, WaitForOpenFiles(lNumOpenFiles));
+
+exit:
+    return;
+}
+
+/**
+ *  Test that aborting a connection with zero-copy sends the kernel still holds keeps the sending socket, and so their buffers,
+ *  until the kernel has finished with them.
+ */
+static void CheckAbort(nlTestSuite *inSuite, void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    const uint32_t lNumOpenFiles = CountOpenFiles();
+    INET_ERROR err;
+
+    err = Connect(lContext);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    SuccessOrExit(err);
+
+    // Leave the sent data unread, so the kernel keeps referring to it.
+    lContext.mReceiver->DisableReceive();
+
+    err = SendBuffers(lContext, kNumBuffers);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    lContext.mSender->Abort();
+    lContext.mSender->Free();
+
+    // The completions have not been handled yet, so the sending socket must still be open.
+    NL_TEST_ASSERT(inSuite, CountOpenFiles() == lNumOpenFiles + 2);
+
+    lContext.mReceiver->Free();
+
+    NL_TEST_ASSERT(inSuite, WaitForOpenFiles(lNumOpenFiles));
+
+exit:
+    return;
+}
+
+static const nlTest sTests[] = {
+    NL_TEST_DEF("InetZeroCopy::Send",                CheckSend),
+    NL_TEST_DEF("InetZeroCopy::Abort",               CheckAbort),
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite: bring up the network and open the listening endpoint.
+ */
+static int TestSetup(void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+    INET_ERROR err;
+
+    InitSystemLayer();
+    InitNetwork();
+
+    err = Inet.NewTCPEndPoint(&lContext.mListener);
+    SuccessOrExit(err);
+
+    err = lContext.mListener->Bind(kIPAddressType_IPv6, IPAddress::Any, kTestPort, true);
+    SuccessOrExit(err);
+
+    lContext.mListener->OnConnectionReceived = HandleConnectionReceived;
+
+    err = lContext.mListener->Listen(1);
+    SuccessOrExit(err);
+
+exit:
+    return (err == INET_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite: close the listening endpoint and shut the network down.
+ */
+static int TestTeardown(void *inContext)
+{
+    TestContext &lContext = *static_cast<TestContext *>(inContext);
+
+    if (lContext.mListener != NULL)
+        lContext.mListener->Free();
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    TestContext lContext = { NULL, NULL, NULL };
+    nlTestSuite theSuite = {
+        "inet-zerocopy",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    sContext = &lContext;
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, &lContext);
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // !(INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY)
+
+int main(int argc, char *argv[])
+{
+    return 0;
+}
+
+#endif // !(INET_CONFIG_ENABLE_TCP_ENDPOINT && INET_CONFIG_ENABLE_TCP_SEND_ZEROCOPY)
@@ -33,6 +33,7 @@
 
 #include "ToolCommon.h"
 #include <Weave/Core/WeaveConfig.h>
+#include <Weave/Support/crypto/AESBlockCipher.h>
 #include <Weave/Support/crypto/CTRMode.h>
 #include <Weave/Support/crypto/WeaveCrypto.h>
 
@@ -340,10 +341,421 @@ void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
 }
 
 
+/**
+ *  Test encoding and decoding encrypted messages whose payloads span several of the chunks in which
+ *  WeaveMessageLayer hashes and encrypts payloads, against a separate computation of the integrity
+ *  check and encryption, and test that a corrupted message fails its integrity check.
+ */
+void WeaveMessageEncryption_Test2(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static const uint16_t kPayloadLens[] = { 1, 15, 16, 17, 255, 256, 257, 700, 1024, 1200 };
+
+    WEAVE_ERROR err;
+    WeaveSessionKey *sessionKey;
+    WeaveEncryptionKey msgEncSessionKey;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    const uint64_t srcNodeId = 0x18B4300000000002ULL;
+    const uint64_t destNodeId = 0x18B4300012345678ULL;
+    const uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    fabricState.LocalNodeId = srcNodeId;
+
+    memcpy(msgEncSessionKey.AES128CTRSHA1.DataKey, sMsgEncKey_DataKey, sizeof(sMsgEncKey_DataKey));
+    memcpy(msgEncSessionKey.AES128CTRSHA1.IntegrityKey, sMsgEncKey_IntegrityKey, sizeof(sMsgEncKey_IntegrityKey));
+
+    err = fabricState.AllocSessionKey(destNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    err = fabricState.AllocSessionKey(srcNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    messageLayer.FabricState = &fabricState;
+    msgLayerTestObject.msgLayer = &messageLayer;
+
+    for (size_t ith = 0; ith < sizeof(kPayloadLens) / sizeof(kPayloadLens[0]); ith++)
+    {
+        const uint16_t msgPayloadLen = kPayloadLens[ith];
+        const uint32_t msgId = 100 + ith;
+        const uint16_t headLen = 24;
+        WeaveMessageInfo msgInfo;
+        uint8_t msgPayload[msgPayloadLen];
+        uint8_t expectedMsg[msgPayloadLen + HMACSHA1::kDigestLength];
+        uint8_t encodedHeader[sizeof(uint64_t) * 2 + sizeof(uint16_t) + sizeof(uint32_t)];
+        uint8_t *p = encodedHeader;
+        uint8_t *payload;
+        uint16_t payloadLen;
+        PacketBuffer *msgBuf;
+
+        for (uint16_t i = 0; i < msgPayloadLen; i++)
+            msgPayload[i] = static_cast<uint8_t>(i * 7 + ith);
+
+        msgBuf = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+        if (msgBuf == NULL)
+            continue;
+
+        memcpy(msgBuf->Start(), msgPayload, msgPayloadLen);
+        msgBuf->SetDataLength(msgPayloadLen);
+
+        msgInfo.Clear();
+        msgInfo.SourceNodeId = srcNodeId;
+        msgInfo.DestNodeId = destNodeId;
+        msgInfo.MessageId = msgId;
+        msgInfo.KeyId = sessionKeyId;
+        msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+        msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+        msgInfo.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+
+        err = messageLayer.EncodeMessage(&msgInfo, msgBuf, NULL, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, msgBuf->DataLength() == headLen + msgPayloadLen + HMACSHA1::kDigestLength);
+
+        // Compute the integrity check value and encrypt the payload in two separate passes.
+        uint16_t headerVal = LittleEndian::Get16(msgBuf->Start()) & kMsgHeaderField_MessageHMACMask;
+        LittleEndian::Write64(p, srcNodeId);
+        LittleEndian::Write64(p, destNodeId);
+        LittleEndian::Write16(p, headerVal);
+        LittleEndian::Write32(p, msgId);
+
+        HMACSHA1 sha1;
+        sha1.Begin(sMsgEncKey_IntegrityKey, sizeof(sMsgEncKey_IntegrityKey));
+        sha1.AddData(encodedHeader, sizeof(encodedHeader));
+        sha1.AddData(msgPayload, msgPayloadLen);
+        memcpy(expectedMsg, msgPayload, msgPayloadLen);
+        sha1.Finish(expectedMsg + msgPayloadLen);
+
+        AES128CTRMode aes128CTR;
+        aes128CTR.SetKey(sMsgEncKey_DataKey);
+        aes128CTR.SetWeaveMessageCounter(srcNodeId, msgId);
+        aes128CTR.EncryptData(expectedMsg, sizeof(expectedMsg), expectedMsg);
+
+        NL_TEST_ASSERT(inSuite, memcmp(msgBuf->Start() + headLen, expectedMsg, sizeof(expectedMsg)) == 0);
+
+        // Decode a corrupted copy of the message.
+        PacketBuffer *corruptMsgBuf = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, corruptMsgBuf != NULL);
+        if (corruptMsgBuf != NULL)
+        {
+            memcpy(corruptMsgBuf->Start(), msgBuf->Start(), msgBuf->DataLength());
+            corruptMsgBuf->SetDataLength(msgBuf->DataLength());
+            corruptMsgBuf->Start()[headLen + msgPayloadLen / 2] ^= 0x01;
+
+            err = msgLayerTestObject.DecodeMessage(corruptMsgBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+
+            PacketBuffer::Free(corruptMsgBuf);
+        }
+
+        // Decode the message.
+        err = msgLayerTestObject.DecodeMessage(msgBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, payloadLen == msgPayloadLen);
+        NL_TEST_ASSERT(inSuite, memcmp(payload, msgPayload, msgPayloadLen) == 0);
+
+        PacketBuffer::Free(msgBuf);
+    }
+}
+
+void WeaveMessageEncryption_Test3(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static const uint16_t kSplitLens[] = { 1, 15, 16, 17, 255, 256, 700, 999 };
+    static const uint16_t kMsgPayloadLen = 1000;
+
+    WEAVE_ERROR err;
+    WeaveSessionKey *sessionKey;
+    WeaveEncryptionKey msgEncSessionKey;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    const uint64_t srcNodeId = 0x18B4300000000002ULL;
+    const uint64_t destNodeId = 0x18B4300012345678ULL;
+    const uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+    uint8_t msgPayload[kMsgPayloadLen];
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    fabricState.LocalNodeId = srcNodeId;
+
+    memcpy(msgEncSessionKey.AES128CTRSHA1.DataKey, sMsgEncKey_DataKey, sizeof(sMsgEncKey_DataKey));
+    memcpy(msgEncSessionKey.AES128CTRSHA1.IntegrityKey, sMsgEncKey_IntegrityKey, sizeof(sMsgEncKey_IntegrityKey));
+
+    err = fabricState.AllocSessionKey(destNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    err = fabricState.AllocSessionKey(srcNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    messageLayer.FabricState = &fabricState;
+    msgLayerTestObject.msgLayer = &messageLayer;
+
+    for (uint16_t i = 0; i < kMsgPayloadLen; i++)
+        msgPayload[i] = static_cast<uint8_t>(i * 11);
+
+    for (size_t ith = 0; ith < sizeof(kSplitLens) / sizeof(kSplitLens[0]); ith++)
+    {
+        const uint16_t splitLen = kSplitLens[ith];
+        WeaveMessageInfo msgInfo;
+        uint8_t *payload;
+        uint16_t payloadLen;
+        uint16_t encodedLen;
+        PacketBuffer *msgBuf = PacketBuffer::New();
+        PacketBuffer *tailBuf = PacketBuffer::New(0);
+        PacketBuffer *flatBuf = PacketBuffer::New();
+
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL && tailBuf != NULL && flatBuf != NULL);
+        if (msgBuf == NULL || tailBuf == NULL || flatBuf == NULL)
+            continue;
+
+        // Encode the same payload once in a single buffer, and once split across a chain of two buffers.
+        memcpy(flatBuf->Start(), msgPayload, kMsgPayloadLen);
+        flatBuf->SetDataLength(kMsgPayloadLen);
+
+        memcpy(msgBuf->Start(), msgPayload, splitLen);
+        msgBuf->SetDataLength(splitLen);
+        memcpy(tailBuf->Start(), msgPayload + splitLen, kMsgPayloadLen - splitLen);
+        tailBuf->SetDataLength(kMsgPayloadLen - splitLen);
+        msgBuf->AddToEnd(tailBuf);
+
+        msgInfo.Clear();
+        msgInfo.SourceNodeId = srcNodeId;
+        msgInfo.DestNodeId = destNodeId;
+        msgInfo.MessageId = 200 + ith;
+        msgInfo.KeyId = sessionKeyId;
+        msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+        msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+        msgInfo.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+
+        err = messageLayer.EncodeMessage(&msgInfo, flatBuf, NULL, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        msgInfo.Flags &= ~kWeaveMessageFlag_MessageEncoded;
+
+        err = messageLayer.EncodeMessage(&msgInfo, msgBuf, NULL, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        // The chained encoding must match the single buffer encoding byte for byte.
+        encodedLen = flatBuf->DataLength();
+        NL_TEST_ASSERT(inSuite, msgBuf->TotalLength() == encodedLen);
+        NL_TEST_ASSERT(inSuite, msgBuf->Next() == tailBuf);
+        NL_TEST_ASSERT(inSuite, memcmp(msgBuf->Start(), flatBuf->Start(), msgBuf->DataLength()) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(tailBuf->Start(), flatBuf->Start() + msgBuf->DataLength(), tailBuf->DataLength()) == 0);
+
+        // Re-encoding the chain applies the cipher across both buffers, so doing it twice restores the encoding.
+        err = messageLayer.ReEncodeMessage(msgBuf);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(tailBuf->Start(), msgPayload + splitLen, kMsgPayloadLen - splitLen) == 0);
+
+        err = messageLayer.ReEncodeMessage(msgBuf);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(msgBuf->Start(), flatBuf->Start(), msgBuf->DataLength()) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(tailBuf->Start(), flatBuf->Start() + msgBuf->DataLength(), tailBuf->DataLength()) == 0);
+
+        // Decode the message, as received in a single buffer.
+        err = msgLayerTestObject.DecodeMessage(flatBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, payloadLen == kMsgPayloadLen);
+        NL_TEST_ASSERT(inSuite, memcmp(payload, msgPayload, kMsgPayloadLen) == 0);
+
+        PacketBuffer::Free(flatBuf);
+        PacketBuffer::Free(msgBuf);
+    }
+}
+
+/**
+ *  Test that messages protected with the key schedules cached with a session key match a separate
+ *  computation that expands the keys for each message, and that the cached schedules follow the
+ *  session key when it changes.
+ */
+void WeaveMessageEncryption_Test4(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static const uint8_t kNewDataKey[] =
+    {
+        0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01
+    };
+    static const uint8_t kNewIntegrityKey[] =
+    {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10,
+        0x5A, 0xA5, 0x3C, 0xC3
+    };
+    static const uint16_t kMsgPayloadLen = 300;
+    static const uint16_t kHeadLen = 24;
+
+    WEAVE_ERROR err;
+    WeaveSessionKey *destSessionKey;
+    WeaveSessionKey *srcSessionKey;
+    WeaveEncryptionKey msgEncSessionKey;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    const uint64_t srcNodeId = 0x18B4300000000002ULL;
+    const uint64_t destNodeId = 0x18B4300012345678ULL;
+    const uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+    uint8_t msgPayload[kMsgPayloadLen];
+    uint8_t oldEncodedMsg[kHeadLen + kMsgPayloadLen + HMACSHA1::kDigestLength];
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    fabricState.LocalNodeId = srcNodeId;
+
+    err = fabricState.AllocSessionKey(destNodeId, sessionKeyId, NULL, destSessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = fabricState.AllocSessionKey(srcNodeId, sessionKeyId, NULL, srcSessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    messageLayer.FabricState = &fabricState;
+    msgLayerTestObject.msgLayer = &messageLayer;
+
+    for (uint16_t i = 0; i < kMsgPayloadLen; i++)
+        msgPayload[i] = static_cast<uint8_t>(i * 13);
+
+    // Protect a message with the test key, then change the session key and protect another one.
+    for (size_t round = 0; round < 2; round++)
+    {
+        const uint8_t *dataKey = (round == 0) ? sMsgEncKey_DataKey : kNewDataKey;
+        const uint8_t *integrityKey = (round == 0) ? sMsgEncKey_IntegrityKey : kNewIntegrityKey;
+        const uint32_t msgId = 300 + round;
+        WeaveMessageInfo msgInfo;
+        uint8_t expectedMsg[kMsgPayloadLen + HMACSHA1::kDigestLength];
+        uint8_t encodedHeader[sizeof(uint64_t) * 2 + sizeof(uint16_t) + sizeof(uint32_t)];
+        uint8_t *p = encodedHeader;
+        uint8_t *payload;
+        uint16_t payloadLen;
+        PacketBuffer *msgBuf;
+        HMACSHA1 sha1;
+        AES128CTRMode aes128CTR;
+
+        memcpy(msgEncSessionKey.AES128CTRSHA1.DataKey, dataKey, WeaveEncryptionKey_AES128CTRSHA1::DataKeySize);
+        memcpy(msgEncSessionKey.AES128CTRSHA1.IntegrityKey, integrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+
+        err = fabricState.SetSessionKey(destSessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = fabricState.SetSessionKey(srcSessionKey, kWeaveEncryptionType_AES128CTRSHA1, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+        // The cached schedules must produce the same keystream and MAC as the keys expanded from scratch.
+        {
+            uint8_t expectedBlock[kMsgPayloadLen];
+            uint8_t cachedBlock[kMsgPayloadLen];
+            uint8_t expectedDigest[HMACSHA1::kDigestLength];
+            uint8_t cachedDigest[HMACSHA1::kDigestLength];
+            AES128CTRMode uncachedCTR;
+            AES128CTRMode cachedCTR;
+            HMACSHA1 uncachedSHA1;
+            HMACSHA1 cachedSHA1;
+
+            uncachedCTR.SetKey(dataKey);
+            uncachedCTR.SetWeaveMessageCounter(srcNodeId, msgId);
+            uncachedCTR.EncryptData(msgPayload, kMsgPayloadLen, expectedBlock);
+
+            cachedCTR.SetKey(destSessionKey->MsgEncKey.KeySchedule.DataKey);
+            cachedCTR.SetWeaveMessageCounter(srcNodeId, msgId);
+            cachedCTR.EncryptData(msgPayload, kMsgPayloadLen, cachedBlock);
+
+            NL_TEST_ASSERT(inSuite, memcmp(expectedBlock, cachedBlock, kMsgPayloadLen) == 0);
+
+            uncachedSHA1.Begin(integrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+            uncachedSHA1.AddData(msgPayload, kMsgPayloadLen);
+            uncachedSHA1.Finish(expectedDigest);
+
+            cachedSHA1.Begin(destSessionKey->MsgEncKey.KeySchedule.IntegrityKey);
+            cachedSHA1.AddData(msgPayload, kMsgPayloadLen);
+            cachedSHA1.Finish(cachedDigest);
+
+            NL_TEST_ASSERT(inSuite, memcmp(expectedDigest, cachedDigest, sizeof(expectedDigest)) == 0);
+        }
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+        msgBuf = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+        if (msgBuf == NULL)
+            continue;
+
+        memcpy(msgBuf->Start(), msgPayload, kMsgPayloadLen);
+        msgBuf->SetDataLength(kMsgPayloadLen);
+
+        msgInfo.Clear();
+        msgInfo.SourceNodeId = srcNodeId;
+        msgInfo.DestNodeId = destNodeId;
+        msgInfo.MessageId = msgId;
+        msgInfo.KeyId = sessionKeyId;
+        msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+        msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+        msgInfo.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+
+        err = messageLayer.EncodeMessage(&msgInfo, msgBuf, NULL, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, msgBuf->DataLength() == sizeof(oldEncodedMsg));
+
+        // Compute the expected ciphertext and integrity check value from the raw key material.
+        uint16_t headerVal = LittleEndian::Get16(msgBuf->Start()) & kMsgHeaderField_MessageHMACMask;
+        LittleEndian::Write64(p, srcNodeId);
+        LittleEndian::Write64(p, destNodeId);
+        LittleEndian::Write16(p, headerVal);
+        LittleEndian::Write32(p, msgId);
+
+        sha1.Begin(integrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+        sha1.AddData(encodedHeader, sizeof(encodedHeader));
+        sha1.AddData(msgPayload, kMsgPayloadLen);
+        memcpy(expectedMsg, msgPayload, kMsgPayloadLen);
+        sha1.Finish(expectedMsg + kMsgPayloadLen);
+
+        aes128CTR.SetKey(dataKey);
+        aes128CTR.SetWeaveMessageCounter(srcNodeId, msgId);
+        aes128CTR.EncryptData(expectedMsg, sizeof(expectedMsg), expectedMsg);
+
+        NL_TEST_ASSERT(inSuite, memcmp(msgBuf->Start() + kHeadLen, expectedMsg, sizeof(expectedMsg)) == 0);
+
+        if (round == 0)
+        {
+            memcpy(oldEncodedMsg, msgBuf->Start(), sizeof(oldEncodedMsg));
+        }
+        else
+        {
+            // A message protected with the previous key must no longer pass the integrity check.
+            PacketBuffer *oldMsgBuf = PacketBuffer::New();
+            NL_TEST_ASSERT(inSuite, oldMsgBuf != NULL);
+            if (oldMsgBuf != NULL)
+            {
+                memcpy(oldMsgBuf->Start(), oldEncodedMsg, sizeof(oldEncodedMsg));
+                oldMsgBuf->SetDataLength(sizeof(oldEncodedMsg));
+
+                err = msgLayerTestObject.DecodeMessage(oldMsgBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+                NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+
+                PacketBuffer::Free(oldMsgBuf);
+            }
+        }
+
+        err = msgLayerTestObject.DecodeMessage(msgBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, payloadLen == kMsgPayloadLen);
+        NL_TEST_ASSERT(inSuite, memcmp(payload, msgPayload, kMsgPayloadLen) == 0);
+
+        PacketBuffer::Free(msgBuf);
+    }
+}
+
 int main(int argc, char *argv[])
 {
     static const nlTest tests[] = {
         NL_TEST_DEF("WeaveMessageEncryption",           WeaveMessageEncryption_Test1),
+        NL_TEST_DEF("WeaveMessageEncryption-LongPayload", WeaveMessageEncryption_Test2),
+        NL_TEST_DEF("WeaveMessageEncryption-ChainedPayload", WeaveMessageEncryption_Test3),
+        NL_TEST_DEF("WeaveMessageEncryption-KeyScheduleCache", WeaveMessageEncryption_Test4),
         NL_TEST_SENTINEL()
     };
 
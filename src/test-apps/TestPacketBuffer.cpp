@@ -33,6 +33,10 @@
 
 #include <SystemLayer/SystemPacketBuffer.h>
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/tcpip.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -1098,6 +1102,150 @@ static void CheckFreeHead(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+// Capacities of the bounded pool's size classes, smallest first.
+static const uint16_t sSizeClassCapacities[] = {
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY,
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY,
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
+};
+
+static const size_t kNumSizeClasses = sizeof(sSizeClassCapacities) / sizeof(sSizeClassCapacities[0]);
+#endif // WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+static const size_t kPoolSize = WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC +
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC;
+
+/**
+ *  Allocate every free buffer in the bounded pool, then free them all again.
+ *
+ *  @return the number of buffers that were free.
+ */
+static size_t CountFreePoolBuffers(void)
+{
+    static PacketBuffer* sBuffers[kPoolSize];
+    size_t lCount = 0;
+
+    while (lCount < kPoolSize && (sBuffers[lCount] = PacketBuffer::NewWithAvailableSize(0, 0)) != NULL)
+        lCount++;
+
+    for (size_t i = 0; i < lCount; i++)
+        PacketBuffer::Free(sBuffers[i]);
+
+    return lCount;
+}
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+/**
+ *  Test size class selection of PacketBuffer::NewWithAvailableSize().
+ *
+ *  Description: For every size class of the bounded pool, allocate a buffer
+ *               that exactly fills the class and verify that it is served from
+ *               that class. Then exhaust the smallest class and verify that
+ *               allocation falls back to the next larger one, and that freed
+ *               buffers return to the class they came from.
+ */
+static void CheckSizeClasses(nlTestSuite *inSuite, void *inContext)
+{
+    (void)inContext;
+
+#if WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+    static PacketBuffer* sBuffers[kPoolSize];
+    const size_t lFreeBefore = CountFreePoolBuffers();
+    PacketBuffer* buffer;
+    size_t lCount = 0;
+
+    for (size_t ith = 0; ith < kNumSizeClasses; ith++)
+    {
+        buffer = PacketBuffer::NewWithAvailableSize(0, sSizeClassCapacities[ith]);
+        NL_TEST_ASSERT(inSuite, buffer != NULL);
+
+        if (buffer != NULL)
+        {
+            NL_TEST_ASSERT(inSuite, buffer->AllocSize() == sSizeClassCapacities[ith]);
+            NL_TEST_ASSERT(inSuite, buffer->MaxDataLength() == sSizeClassCapacities[ith]);
+            PacketBuffer::Free(buffer);
+        }
+    }
+
+    // Drain the smallest class; the first buffer that does not come from it must come from the next class up.
+    do
+    {
+        buffer = sBuffers[lCount++] = PacketBuffer::NewWithAvailableSize(0, 1);
+        NL_TEST_ASSERT(inSuite, buffer != NULL);
+    }
+    while (buffer != NULL && buffer->AllocSize() == sSizeClassCapacities[0] && lCount < kPoolSize);
+
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == sSizeClassCapacities[1]);
+
+    for (size_t ith = 0; ith < lCount; ith++)
+        PacketBuffer::Free(sBuffers[ith]);
+
+    buffer = PacketBuffer::NewWithAvailableSize(0, 1);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == sSizeClassCapacities[0]);
+    PacketBuffer::Free(buffer);
+
+    NL_TEST_ASSERT(inSuite, CountFreePoolBuffers() == lFreeBefore);
+#else // !WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+    (void)inSuite;
+#endif // !WEAVE_SYSTEM_PACKETBUFFER_SIZE_CLASSES
+}
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && \
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+static void* ConcurrentAllocFreeThread(void* aArg)
+{
+    const uint16_t lSeed = static_cast<uint16_t>(reinterpret_cast<uintptr_t>(aArg));
+
+    for (uint16_t i = 0; i < 10000; i++)
+    {
+        PacketBuffer* lBuffer = PacketBuffer::NewWithAvailableSize(0, (lSeed + i * 37) % WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+
+        if (lBuffer != NULL)
+        {
+            lBuffer->AddRef();
+            PacketBuffer::Free(lBuffer);
+            PacketBuffer::Free(lBuffer);
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/**
+ *  Test concurrent use of the lock-free bounded pool.
+ *
+ *  Description: Run several threads that allocate, share and free buffers
+ *               of varying sizes at the same time, then verify that every
+ *               buffer made it back to the pool.
+ */
+static void CheckLockFreeConcurrency(nlTestSuite *inSuite, void *inContext)
+{
+    (void)inContext;
+
+#if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && \
+    WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+    const size_t lFreeBefore = CountFreePoolBuffers();
+    pthread_t lThreads[4];
+
+    for (size_t ith = 0; ith < sizeof(lThreads) / sizeof(lThreads[0]); ith++)
+        NL_TEST_ASSERT(inSuite, pthread_create(&lThreads[ith], NULL, ConcurrentAllocFreeThread, reinterpret_cast<void*>(ith)) == 0);
+
+    for (size_t ith = 0; ith < sizeof(lThreads) / sizeof(lThreads[0]); ith++)
+        pthread_join(lThreads[ith], NULL);
+
+    NL_TEST_ASSERT(inSuite, CountFreePoolBuffers() == lFreeBefore);
+#else
+    (void)inSuite;
+#endif
+}
+
 /**
  *  Test PacketBuffer::BuildFreeList() function.
  */
@@ -1112,6 +1260,8 @@ static void CheckBuildFreeList(nlTestSuite *inSuite, void *inContext)
  *   Test Suite. It lists all the test functions.
  */
 static const nlTest sTests[] = {
+    NL_TEST_DEF("PacketBuffer::SizeClasses",                    CheckSizeClasses),
+    NL_TEST_DEF("PacketBuffer::LockFreeConcurrency",            CheckLockFreeConcurrency),
     NL_TEST_DEF("PacketBuffer::NewWithAvailableSize&PacketBuffer::Free", CheckNewWithAvailableSizeAndFree),
     NL_TEST_DEF("PacketBuffer::Start",                          CheckStart),
     NL_TEST_DEF("PacketBuffer::SetStart",                       CheckSetStart),
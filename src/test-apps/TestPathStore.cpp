@@ -102,8 +102,41 @@ class TraitPathStoreTest {
         void TestFlags(nlTestSuite *inSuite, void *inContext);
         void TestInsertItem(nlTestSuite *inSuite, void *inContext);
         void TestSetFailedTrait(nlTestSuite *inSuite, void *inContext);
+        void TestSortedStore(nlTestSuite *inSuite, void *inContext);
+        void TestSortedStoreBenchmark(nlTestSuite *inSuite, void *inContext);
+
+    private:
+        void FillStores(size_t aNumPaths);
+        void CheckStoresAgree(nlTestSuite *inSuite, TraitDataHandle aNumTraits);
+};
+
+enum {
+    kMaxBenchmarkPaths = 4096,
+    kQueriesPerBenchmark = 2000,
 };
 
+static TraitPathStore::Record sBenchmarkRecords[kMaxBenchmarkPaths];
+static TraitPath sBenchmarkPaths[kMaxBenchmarkPaths];
+static TraitPathStore sBenchmarkStore;
+static SortedTraitPathStore sSortedStore;
+
+// Number of property handles in TestHTrait, from Root to L_Value_Dc.
+static const PropertyPathHandle kNumTestHTraitHandles = TestHTrait::kPropertyHandle_L_Value_Dc;
+
+/**
+ * Maps an index to a path in the TestHTrait schema, skipping the root so that the
+ * stores hold many paths per trait instance.
+ */
+static TraitPath IndexToPath(size_t aIndex)
+{
+    TraitPath path;
+
+    path.mTraitDataHandle = static_cast<TraitDataHandle>(1 + aIndex / (kNumTestHTraitHandles - 1));
+    path.mPropertyPathHandle = CreatePropertyPathHandle(static_cast<PropertyPathHandle>(2 + aIndex % (kNumTestHTraitHandles - 1)));
+
+    return path;
+}
+
 TraitPathStoreTest::TraitPathStoreTest() :
             mTDH1(1), mTDH2(2), mSchemaEngine(&TestHTrait::TraitSchema)
 {
@@ -644,6 +677,162 @@ void TraitPathStoreTest::TestSetFailedTrait(nlTestSuite *inSuite, void *inContex
     mStore.Clear();
 }
 
+void TraitPathStoreTest::FillStores(size_t aNumPaths)
+{
+    sBenchmarkStore.Init(sBenchmarkRecords, aNumPaths);
+    sSortedStore.Init(sBenchmarkPaths, aNumPaths);
+
+    // Add the paths in an order unrelated to their sort order.
+    for (size_t i = 0; i < aNumPaths; i++)
+    {
+        TraitPath path = IndexToPath((i * 7) % aNumPaths);
+
+        sBenchmarkStore.AddItem(path);
+        sSortedStore.AddItem(path);
+    }
+}
+
+void TraitPathStoreTest::CheckStoresAgree(nlTestSuite *inSuite, TraitDataHandle aNumTraits)
+{
+    TraitPath tp;
+
+    NL_TEST_ASSERT(inSuite, sBenchmarkStore.GetNumItems() == sSortedStore.GetNumItems());
+
+    for (size_t i = 1; i < sSortedStore.GetNumItems(); i++)
+    {
+        const TraitPath &prev = sSortedStore.GetItemAt(i-1);
+        const TraitPath &cur = sSortedStore.GetItemAt(i);
+
+        NL_TEST_ASSERT(inSuite, prev.mTraitDataHandle < cur.mTraitDataHandle ||
+                (prev.mTraitDataHandle == cur.mTraitDataHandle && prev.mPropertyPathHandle < cur.mPropertyPathHandle));
+    }
+
+    for (TraitDataHandle tdh = 1; tdh <= aNumTraits; tdh++)
+    {
+        tp.mTraitDataHandle = tdh;
+
+        NL_TEST_ASSERT(inSuite, sBenchmarkStore.IsTraitPresent(tdh) == sSortedStore.IsTraitPresent(tdh));
+
+        for (PropertyPathHandle pph = kRootPropertyPathHandle; pph <= kNumTestHTraitHandles; pph++)
+        {
+            tp.mPropertyPathHandle = CreatePropertyPathHandle(pph);
+
+            NL_TEST_ASSERT(inSuite, sBenchmarkStore.IsPresent(tp) == sSortedStore.IsPresent(tp));
+            NL_TEST_ASSERT(inSuite, sBenchmarkStore.Includes(tp, mSchemaEngine) == sSortedStore.Includes(tp, mSchemaEngine));
+            NL_TEST_ASSERT(inSuite, sBenchmarkStore.Intersects(tp, mSchemaEngine) == sSortedStore.Intersects(tp, mSchemaEngine));
+        }
+
+        tp.mPropertyPathHandle = mSchemaEngine->GetDictionaryItemHandle(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_L), 1);
+        NL_TEST_ASSERT(inSuite, sBenchmarkStore.Includes(tp, mSchemaEngine) == sSortedStore.Includes(tp, mSchemaEngine));
+        NL_TEST_ASSERT(inSuite, sBenchmarkStore.Intersects(tp, mSchemaEngine) == sSortedStore.Intersects(tp, mSchemaEngine));
+    }
+}
+
+void TraitPathStoreTest::TestSortedStore(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const size_t numPaths = 3 * (kNumTestHTraitHandles - 1);
+    TraitPath tp;
+
+    FillStores(numPaths);
+
+    NL_TEST_ASSERT(inSuite, sSortedStore.IsFull());
+    CheckStoresAgree(inSuite, 4);
+
+    // Adding a path twice has no effect, even when full.
+    err = sSortedStore.AddItem(IndexToPath(0));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sSortedStore.GetNumItems() == numPaths);
+
+    tp.mTraitDataHandle = 4;
+    tp.mPropertyPathHandle = kRootPropertyPathHandle;
+    err = sSortedStore.AddItem(tp);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_WDM_PATH_STORE_FULL);
+
+    // Adding a trait's root removes all of its other paths.
+    tp.mTraitDataHandle = 2;
+    sBenchmarkStore.AddItemDedup(tp, mSchemaEngine);
+    sBenchmarkStore.Compact();
+    err = sSortedStore.AddItemDedup(tp, mSchemaEngine);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sSortedStore.GetNumItems() == 2 * (kNumTestHTraitHandles - 1) + 1);
+    CheckStoresAgree(inSuite, 4);
+
+    // Adding a structure removes its members only.
+    tp.mTraitDataHandle = 3;
+    tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K);
+    sBenchmarkStore.AddItemDedup(tp, mSchemaEngine);
+    sBenchmarkStore.Compact();
+    err = sSortedStore.AddItemDedup(tp, mSchemaEngine);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    CheckStoresAgree(inSuite, 4);
+
+    sBenchmarkStore.RemoveTrait(1);
+    sBenchmarkStore.Compact();
+    sSortedStore.RemoveTrait(1);
+    NL_TEST_ASSERT(inSuite, false == sSortedStore.IsTraitPresent(1));
+    NL_TEST_ASSERT(inSuite, sSortedStore.GetFirstItem(2) == 0);
+    CheckStoresAgree(inSuite, 4);
+
+    sBenchmarkStore.RemoveItem(tp);
+    sBenchmarkStore.Compact();
+    sSortedStore.RemoveItem(tp);
+    NL_TEST_ASSERT(inSuite, false == sSortedStore.IsPresent(tp));
+    CheckStoresAgree(inSuite, 4);
+
+    sSortedStore.Clear();
+    NL_TEST_ASSERT(inSuite, sSortedStore.IsEmpty());
+    NL_TEST_ASSERT(inSuite, sSortedStore.GetFirstItem(1) == 0);
+}
+
+void TraitPathStoreTest::TestSortedStoreBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    const size_t storeSizes[] = { 256, kMaxBenchmarkPaths };
+
+    for (size_t s = 0; s < ArraySize(storeSizes); s++)
+    {
+        const size_t numPaths = storeSizes[s];
+        const TraitDataHandle numTraits = static_cast<TraitDataHandle>(numPaths / (kNumTestHTraitHandles - 1));
+        uint64_t linearElapsed, sortedElapsed;
+        size_t linearHits = 0, sortedHits = 0;
+        TraitPath tp;
+
+        FillStores(numPaths);
+
+        // Probe a spread of paths, both stored ones and their ancestors and dictionary items.
+        linearElapsed = Now();
+        for (uint32_t i = 0; i < kQueriesPerBenchmark; i++)
+        {
+            tp.mTraitDataHandle = static_cast<TraitDataHandle>(1 + (i * 13) % (numTraits + 1));
+            tp.mPropertyPathHandle = CreatePropertyPathHandle(static_cast<PropertyPathHandle>(1 + i % kNumTestHTraitHandles));
+
+            linearHits += sBenchmarkStore.IsPresent(tp);
+            linearHits += sBenchmarkStore.Includes(tp, mSchemaEngine);
+            linearHits += sBenchmarkStore.Intersects(tp, mSchemaEngine);
+        }
+        linearElapsed = Now() - linearElapsed;
+
+        sortedElapsed = Now();
+        for (uint32_t i = 0; i < kQueriesPerBenchmark; i++)
+        {
+            tp.mTraitDataHandle = static_cast<TraitDataHandle>(1 + (i * 13) % (numTraits + 1));
+            tp.mPropertyPathHandle = CreatePropertyPathHandle(static_cast<PropertyPathHandle>(1 + i % kNumTestHTraitHandles));
+
+            sortedHits += sSortedStore.IsPresent(tp);
+            sortedHits += sSortedStore.Includes(tp, mSchemaEngine);
+            sortedHits += sSortedStore.Intersects(tp, mSchemaEngine);
+        }
+        sortedElapsed = Now() - sortedElapsed;
+
+        NL_TEST_ASSERT(inSuite, linearHits == sortedHits);
+
+        printf("%5u paths: TraitPathStore %.3f us/query, SortedTraitPathStore %.3f us/query\n",
+               static_cast<unsigned>(numPaths),
+               static_cast<double>(linearElapsed) / (3 * kQueriesPerBenchmark),
+               static_cast<double>(sortedElapsed) / (3 * kQueriesPerBenchmark));
+    }
+}
+
 } // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }
 }
@@ -720,6 +909,16 @@ void TraitPathStoreTest_SetFailedTrait(nlTestSuite *inSuite, void *inContext)
     gPathStoreTest.TestSetFailedTrait(inSuite, inContext);
 }
 
+void TraitPathStoreTest_SortedStore(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestSortedStore(inSuite, inContext);
+}
+
+void TraitPathStoreTest_SortedStoreBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestSortedStoreBenchmark(inSuite, inContext);
+}
+
 // Test Suite
 
 /**
@@ -738,6 +937,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Flags",  TraitPathStoreTest_Flags),
     NL_TEST_DEF("InsertItem",  TraitPathStoreTest_InsertItem),
     NL_TEST_DEF("SetFailedTrait",  TraitPathStoreTest_SetFailedTrait),
+    NL_TEST_DEF("SortedTraitPathStore",  TraitPathStoreTest_SortedStore),
+    NL_TEST_DEF("SortedTraitPathStore benchmark",  TraitPathStoreTest_SortedStoreBenchmark),
 
     NL_TEST_SENTINEL()
 };
@@ -45,6 +45,12 @@ std::map<std::string, std::string> sPersistentStore;
 
 FILE *sPersistentStoreFile = NULL;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+std::string sPersistentSegments[WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT];
+
+FILE *sPersistentSegmentFile = NULL;
+#endif
+
 namespace nl {
 namespace Weave {
 namespace Platform {
@@ -187,6 +193,94 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
+// Segments are either kept in sPersistentSegments or, when
+// sPersistentSegmentFile is set, one after the other in that file.
+
+static std::string &GetSegment(uint8_t aSegment)
+{
+    std::string &segment = sPersistentSegments[aSegment];
+
+    if (segment.empty())
+        segment.assign(WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE, '\xFF');
+
+    return segment;
+}
+
+WEAVE_ERROR ReadSegment(uint8_t aSegment, uint32_t aOffset, uint8_t *aBuffer, uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aSegment < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(aOffset + aLength <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (sPersistentSegmentFile)
+    {
+        size_t bytesRead;
+
+        VerifyOrExit(fseek(sPersistentSegmentFile, aSegment * WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE + aOffset, SEEK_SET) == 0,
+                     err = WEAVE_ERROR_PERSISTED_STORAGE_FAIL);
+
+        // Past the end of the file, the storage has never been written.
+        bytesRead = fread(aBuffer, 1, aLength, sPersistentSegmentFile);
+        memset(aBuffer + bytesRead, 0xFF, aLength - bytesRead);
+    }
+    else
+    {
+        memcpy(aBuffer, GetSegment(aSegment).data() + aOffset, aLength);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR WriteSegment(uint8_t aSegment, uint32_t aOffset, const uint8_t *aBuffer, uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aSegment < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(aOffset + aLength <= WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (sPersistentSegmentFile)
+    {
+        VerifyOrExit(fseek(sPersistentSegmentFile, aSegment * WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE + aOffset, SEEK_SET) == 0,
+                     err = WEAVE_ERROR_PERSISTED_STORAGE_FAIL);
+        VerifyOrExit(fwrite(aBuffer, 1, aLength, sPersistentSegmentFile) == aLength, err = WEAVE_ERROR_PERSISTED_STORAGE_FAIL);
+        VerifyOrExit(fflush(sPersistentSegmentFile) == 0, err = WEAVE_ERROR_PERSISTED_STORAGE_FAIL);
+    }
+    else
+    {
+        GetSegment(aSegment).replace(aOffset, aLength, reinterpret_cast<const char *>(aBuffer), aLength);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR EraseSegment(uint8_t aSegment)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aSegment < WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (sPersistentSegmentFile)
+    {
+        const std::string erased(WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_SIZE, '\xFF');
+
+        err = WriteSegment(aSegment, 0, reinterpret_cast<const uint8_t *>(erased.data()), erased.size());
+    }
+    else
+    {
+        sPersistentSegments[aSegment].clear();
+    }
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+
 } // PersistentStorage
 } // Platform
 } // Weave
@@ -22,3 +22,9 @@
 extern std::map<std::string, std::string> sPersistentStore;
 
 extern FILE *sPersistentStoreFile;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT
+extern std::string sPersistentSegments[WEAVE_CONFIG_EVENT_LOGGING_SPILL_SEGMENT_COUNT];
+
+extern FILE *sPersistentSegmentFile;
+#endif
@@ -28,6 +28,7 @@
 #define __STDC_LIMIT_MACROS
 #endif
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <string.h>
 #include <errno.h>
@@ -188,6 +189,133 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+static const uint32_t STRESS_NUM_PENDING_TIMERS = 10000;
+static const uint32_t STRESS_NUM_RESTARTS = 100000;
+static const uint32_t STRESS_NUM_SERVICE_PASSES = 1000;
+
+static Timer* sStressTimers[STRESS_NUM_PENDING_TIMERS];
+static volatile bool sStressProbeFired;
+
+void HandleStressTimerFailed(Layer* aLayer, void* aState, Error aError)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aState);
+    NL_TEST_ASSERT(lContext.mTestSuite, false);
+}
+
+void HandleStressProbe(Layer* aLayer, void* aState, Error aError)
+{
+    sStressProbeFired = true;
+}
+
+// Spread the pending timers between one and ten minutes out so that none expires during the test.
+static uint32_t StressTimerDelay(uint32_t aIndex)
+{
+    return 60000 + ((aIndex * 7919) % 540000);
+}
+
+static double MicrosecondsPerOperation(uint64_t aStartTime, uint32_t aNumOperations)
+{
+    return (aNumOperations > 0) ? static_cast<double>(Layer::GetClock_MonotonicHiRes() - aStartTime) / aNumOperations : 0.0;
+}
+
+/**
+ *  Measure the throughput of starting and cancelling timers while many timers are pending, and check that a short timer
+ *  still expires on time among them.
+ *
+ *  The number of pending timers is bounded by WEAVE_SYSTEM_CONFIG_NUM_TIMERS.
+ */
+static void CheckStartCancelStress(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    uint32_t lNumTimers = 0;
+    uint64_t lStartTime;
+    Error lError;
+    Timer* lProbe = NULL;
+    double lStartCost, lRestartCost, lServiceCost;
+
+    // CheckStarvation leaves its greedy timer armed; it must not run while this test services events.
+    lSys.CancelTimer(HandleGreedyTimer, aContext);
+
+    // Keep one timer in reserve for the expiry probe.
+    while (lNumTimers < STRESS_NUM_PENDING_TIMERS && lSys.NewTimer(sStressTimers[lNumTimers]) == WEAVE_SYSTEM_NO_ERROR)
+        lNumTimers++;
+
+    NL_TEST_ASSERT(inSuite, lNumTimers > 1);
+    if (lNumTimers <= 1)
+        return;
+
+    lNumTimers--;
+    lProbe = sStressTimers[lNumTimers];
+
+    // An armed timer owns one reference, which Cancel() releases. Hold an extra reference to each timer so that Cancel() does not
+    // recycle it, which would otherwise make every restart pay for a search of the timer pool.
+    for (uint32_t i = 0; i < lNumTimers; i++)
+        sStressTimers[i]->Retain();
+
+    lStartTime = Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < lNumTimers; i++)
+    {
+        lError = sStressTimers[i]->Start(StressTimerDelay(i), HandleStressTimerFailed, aContext);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    }
+    lStartCost = MicrosecondsPerOperation(lStartTime, lNumTimers);
+
+    // Cancel and re-arm pending timers, the pattern produced by retransmission and liveness timers.
+    lStartTime = Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < STRESS_NUM_RESTARTS; i++)
+    {
+        const uint32_t lIndex = (i * 7919) % lNumTimers;
+
+        sStressTimers[lIndex]->Cancel();
+        sStressTimers[lIndex]->Retain();
+
+        lError = sStressTimers[lIndex]->Start(StressTimerDelay(i), HandleStressTimerFailed, aContext);
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    }
+    lRestartCost = MicrosecondsPerOperation(lStartTime, STRESS_NUM_RESTARTS);
+
+    // Event loop passes that find no expired timer.
+    lStartTime = Layer::GetClock_MonotonicHiRes();
+    for (uint32_t i = 0; i < STRESS_NUM_SERVICE_PASSES; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 0;
+        ServiceEvents(lSys, sleepTime);
+    }
+    lServiceCost = MicrosecondsPerOperation(lStartTime, STRESS_NUM_SERVICE_PASSES);
+
+    // As with the pending timers, hold an extra reference so that the probe stays ours once it has fired.
+    lProbe->Retain();
+
+    sStressProbeFired = false;
+    lError = lProbe->Start(5, HandleStressProbe, aContext);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+
+    lStartTime = Layer::GetClock_MonotonicMS();
+    while (!sStressProbeFired && Layer::GetClock_MonotonicMS() - lStartTime < 1000)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceEvents(lSys, sleepTime);
+    }
+    NL_TEST_ASSERT(inSuite, sStressProbeFired);
+
+    lProbe->Cancel();
+    lProbe->Release();
+
+    for (uint32_t i = 0; i < lNumTimers; i++)
+    {
+        sStressTimers[i]->Cancel();
+        sStressTimers[i]->Release();
+    }
+
+    printf("%" PRIu32 " pending timers (timer wheel %s): start %.3f us/op, cancel+start %.3f us/op, idle event loop pass %.3f us\n",
+           lNumTimers, WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL ? "enabled" : "disabled", lStartCost, lRestartCost, lServiceCost);
+}
+
 
 // Test Suite
 
@@ -198,6 +326,7 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
 static const nlTest sTests[] = {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+    NL_TEST_DEF("Timer::TestStartCancelStress",    CheckStartCancelStress),
     NL_TEST_SENTINEL()
 };
 
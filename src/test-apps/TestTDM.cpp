@@ -124,6 +124,8 @@ static void TestTdmStatic_DirtyStruct(nlTestSuite *inSuite, void *inContext);
 static void TestTdmStatic_DirtyLeafUnevenDepth(nlTestSuite *inSuite, void *inContext);
 static void TestTdmStatic_MergeHandleSetOverflow(nlTestSuite *inSuite, void *inContext);
 static void TestTdmStatic_MarkLeafHandleDirtyTwice(nlTestSuite *inSuite, void *inContext);
+static void TestTdmStatic_DirtyStoreOverflow(nlTestSuite *inSuite, void *inContext);
+static void TestTdmStatic_DirtyHandlesSurviveStoreOverflow(nlTestSuite *inSuite, void *inContext);
 
 static void TestTdmStatic_TestNullableLeaf(nlTestSuite *inSuite, void *inContext);
 static void TestTdmStatic_TestNullableStruct(nlTestSuite *inSuite, void *inContext);
@@ -134,6 +136,11 @@ static void TestTdmStatic_TestEphemeralStruct(nlTestSuite *inSuite, void *inCont
 
 static void TestTdmStatic_TestIsParent(nlTestSuite *inSuite, void *inContext);
 
+static void TestTdmStatic_EncodedSize(nlTestSuite *inSuite, void *inContext);
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+static void TestTdmStatic_SharedEncodingCache(nlTestSuite *inSuite, void *inContext);
+#endif
+
 static void TestTdmMismatched_PathInDataElement(nlTestSuite *inSuite, void *inContext);
 static void TestTdmMismatched_TopLevelPOD(nlTestSuite *inSuite, void *inContext);
 static void TestTdmMismatched_NestedStruct(nlTestSuite *inSuite, void *inContext);
@@ -163,6 +170,10 @@ static void TestRandomizedDataVersions(nlTestSuite *inSuite, void *inContext);
 static void TestTdmStatic_MultiInstance(nlTestSuite *inSuite, void *inContext);
 static void CheckAllocateRightSizedBufferForNotifications(nlTestSuite *inSuite, void *inContext);
 static void CheckSynchronizedTraitState(nlTestSuite *inSuite, void *inContext);
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+static void CheckNotifyLatencyHistogram(nlTestSuite *inSuite, void *inContext);
+#endif
+static void CheckNotifyBudget(nlTestSuite *inSuite, void *inContext);
 
 // Test Suite
 
@@ -182,6 +193,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test Tdm (Static schema): Two dirty leaf handles at different depths", TestTdmStatic_DirtyLeafUnevenDepth),
     NL_TEST_DEF("Test Tdm (Static schema): Overflow of merge handles", TestTdmStatic_MergeHandleSetOverflow),
     NL_TEST_DEF("Test Tdm (Static schema): Mark same handle dirty twice", TestTdmStatic_MarkLeafHandleDirtyTwice),
+    NL_TEST_DEF("Test Tdm (Static schema): Mark more handles dirty than fit in the dirty store", TestTdmStatic_DirtyStoreOverflow),
+    NL_TEST_DEF("Test Tdm (Static schema): Dirty handles of one trait survive another filling the dirty store", TestTdmStatic_DirtyHandlesSurviveStoreOverflow),
 
     NL_TEST_DEF("Test Tdm (Static schema): Nullable leaf data", TestTdmStatic_TestNullableLeaf),
     NL_TEST_DEF("Test Tdm (Static schema): Nullable struct", TestTdmStatic_TestNullableStruct),
@@ -192,6 +205,11 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test Tdm (Static schema): IsParent", TestTdmStatic_TestIsParent),
 
+    NL_TEST_DEF("Test Tdm (Static schema): Encoded size of source data", TestTdmStatic_EncodedSize),
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    NL_TEST_DEF("Test Tdm (Static schema): Data elements shared through the encoding cache", TestTdmStatic_SharedEncodingCache),
+#endif
+
     // Tests a mismatched schema on publisher and subscriber
     NL_TEST_DEF("Test Tdm (Mismatched schema): Path in DataElement is unmappable", TestTdmMismatched_PathInDataElement),
     NL_TEST_DEF("Test Tdm (Mismatched schema): Schema extended by top level POD", TestTdmMismatched_TopLevelPOD),
@@ -232,6 +250,13 @@ static const nlTest sTests[] = {
     // Test command + data synchronizer
     NL_TEST_DEF("Test Command + State Synchronization Logic", CheckSynchronizedTraitState),
 
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    NL_TEST_DEF("Test Notify Latency Histogram", CheckNotifyLatencyHistogram),
+#endif
+
+    // Sends notifies over a loopback binding, so this has to run last.
+    NL_TEST_DEF("Test Notify Budget Per Run", CheckNotifyBudget),
+
     NL_TEST_SENTINEL()
 };
 
@@ -702,6 +727,8 @@ public:
     void TestTdmStatic_DirtyLeafUnevenDepth(nlTestSuite *inSuite);
     void TestTdmStatic_MergeHandleSetOverflow(nlTestSuite *inSuite);
     void TestTdmStatic_MarkLeafHandleDirtyTwice(nlTestSuite *inSuite);
+    void TestTdmStatic_DirtyStoreOverflow(nlTestSuite *inSuite);
+    void TestTdmStatic_DirtyHandlesSurviveStoreOverflow(nlTestSuite *inSuite);
 
     void TestTdmStatic_TestNullableLeaf(nlTestSuite *inSuite);
     void TestTdmStatic_TestNullableStruct(nlTestSuite *inSuite);
@@ -712,6 +739,11 @@ public:
 
     void TestTdmStatic_TestIsParent(nlTestSuite *inSuite);
 
+    void TestTdmStatic_EncodedSize(nlTestSuite *inSuite);
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    void TestTdmStatic_SharedEncodingCache(nlTestSuite *inSuite);
+#endif
+
     void TestTdmMismatched_PathInDataElement(nlTestSuite *inSuite);
     void TestTdmMismatched_TopLevelPOD(nlTestSuite *inSuite);
     void TestTdmMismatched_NestedStruct(nlTestSuite *inSuite);
@@ -745,6 +777,15 @@ public:
 
     void CheckSynchronizedTraitState(nlTestSuite *inSuite);
 
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    void CheckNotifyLatencyHistogram(nlTestSuite *inSuite);
+#endif
+    void CheckNotifyBudget(nlTestSuite *inSuite);
+
+    static void PublisherEventCallback(void * const aAppState,
+        SubscriptionHandler::EventID aEvent, const SubscriptionHandler::InEventParam & aInParam,
+        SubscriptionHandler::OutEventParam & aOutParam);
+
 private:
     SubscriptionHandler *mSubHandler;
     SubscriptionClient *mSubClient;
@@ -772,6 +813,9 @@ private:
     uint32_t mTestCase;
 
     WEAVE_ERROR AllocateBuffer(uint32_t desiredSize, uint32_t minSize);
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+    WEAVE_ERROR WriteSharedDataElement(PropertyPathHandle aPropertyPathHandle, uint8_t *aEncoding, uint32_t &aEncodingLen);
+#endif
 };
 
 TestTdm::TestTdm()
@@ -796,6 +840,11 @@ int TestTdm::Setup()
 
     gSubscriptionEngine = &mSubscriptionEngine;
 
+    // The notify budget test runs the notification engine, which needs a working stack to send with.
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(true, true);
+
     // Initialize SubEngine and set it up
     err = mSubscriptionEngine.Init(&ExchangeMgr, NULL, NULL);
     SuccessOrExit(err);
@@ -904,6 +953,16 @@ int TestTdm::Reset()
 
     mNotificationEngine->mGraphSolver.ClearDirty();
 
+    // Tests that dirty data without building a notify leave the trait instances of the subscription dirty.
+    for (uint32_t i = 0; i < mSubHandler->GetNumTraitInstances(); i++)
+    {
+        mSubHandler->GetTraitInstanceInfoList()[i].ClearDirty();
+    }
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    mSubHandler->mDirtySince = 0;
+#endif
+
     return err;
 }
 
@@ -1161,6 +1220,94 @@ exit:
     NL_TEST_ASSERT(inSuite, testPass);
 }
 
+void TestTdm::TestTdmStatic_DirtyStoreOverflow(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool testPass = false;
+    const PropertyPathHandle dirtyHandles[] = {
+        TestHTrait::kPropertyHandle_A, TestHTrait::kPropertyHandle_B, TestHTrait::kPropertyHandle_C,
+        TestHTrait::kPropertyHandle_D, TestHTrait::kPropertyHandle_E, TestHTrait::kPropertyHandle_F,
+        TestHTrait::kPropertyHandle_G, TestHTrait::kPropertyHandle_H, TestHTrait::kPropertyHandle_I,
+        TestHTrait::kPropertyHandle_J, TestHTrait::kPropertyHandle_K_Sb
+    };
+
+    Reset();
+
+    // Mark more handles dirty than the granular dirty store can hold. Without the dirty bitmap, this degrades to marking
+    // the whole trait instance dirty.
+    for (size_t i = 0; i < sizeof(dirtyHandles) / sizeof(dirtyHandles[0]); i++)
+    {
+        mTestTdmSource.SetDirty(dirtyHandles[i]);
+    }
+
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    VerifyOrExit(!mTestTdmSource.IsRootDirty(), );
+#endif
+
+    err = BuildAndProcessNotify();
+    SuccessOrExit(err);
+
+    // Either way, the merge handle set overflows and all children of root are sent.
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_A, 1 }, { TestHTrait::kPropertyHandle_B, 1 },
+                                                  { TestHTrait::kPropertyHandle_C, 1 }, { TestHTrait::kPropertyHandle_D, 1 },
+                                                  { TestHTrait::kPropertyHandle_E, 1 }, { TestHTrait::kPropertyHandle_F, 1 },
+                                                  { TestHTrait::kPropertyHandle_G, 1 }, { TestHTrait::kPropertyHandle_H, 1 },
+                                                  { TestHTrait::kPropertyHandle_I, 1 }, { TestHTrait::kPropertyHandle_J, 1 },
+                                                  { TestHTrait::kPropertyHandle_K_Sb, 1 }, { TestHTrait::kPropertyHandle_K_Sc, 1 } },
+                                                { },
+                                                { TestHTrait::kPropertyHandle_K_Sa, TestHTrait::kPropertyHandle_L });
+
+exit:
+    NL_TEST_ASSERT(inSuite, testPass);
+}
+
+void TestTdm::TestTdmStatic_DirtyHandlesSurviveStoreOverflow(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool testPass = false;
+
+    Reset();
+
+    // Fill the granular dirty store with dictionary elements of another trait instance, which can only be tracked there.
+    for (uint16_t i = 1; i <= WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE; i++)
+    {
+        mTestTdmSource1.mDictlValues[i] = { 1, 1, 1 };
+        mTestTdmSource1.SetDirty(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_L_Value, i));
+    }
+
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_B, 3);
+
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    // The dirty bitmap doesn't draw from the store, so the trait instance stays granularly dirty...
+    VerifyOrExit(!mTestTdmSource.IsRootDirty(), );
+#else
+    // ...whereas without it, the full store degrades the trait instance to being entirely dirty.
+    VerifyOrExit(mTestTdmSource.IsRootDirty(), );
+#endif
+
+    err = BuildAndProcessNotify();
+    SuccessOrExit(err);
+
+#if WDM_PUBLISHER_MAX_SCHEMA_HANDLES_IN_DIRTY_BITMAP
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_A, 2 }, { TestHTrait::kPropertyHandle_B, 3 } },
+                                                { },
+                                                { } );
+#else
+    testPass = mTestTdmSink.ValidateChangeSets( { { TestHTrait::kPropertyHandle_A, 2 }, { TestHTrait::kPropertyHandle_B, 3 },
+                                                  { TestHTrait::kPropertyHandle_C, 1 }, { TestHTrait::kPropertyHandle_D, 1 },
+                                                  { TestHTrait::kPropertyHandle_E, 1 }, { TestHTrait::kPropertyHandle_F, 1 },
+                                                  { TestHTrait::kPropertyHandle_G, 1 }, { TestHTrait::kPropertyHandle_H, 1 },
+                                                  { TestHTrait::kPropertyHandle_I, 1 }, { TestHTrait::kPropertyHandle_J, 1 },
+                                                  { TestHTrait::kPropertyHandle_K_Sb, 1 }, { TestHTrait::kPropertyHandle_K_Sc, 1 } },
+                                                { },
+                                                { TestHTrait::kPropertyHandle_K_Sa, TestHTrait::kPropertyHandle_L });
+#endif
+
+exit:
+    NL_TEST_ASSERT(inSuite, testPass);
+}
+
 void TestTdm::TestTdmStatic_TestNullableLeaf(nlTestSuite *inSuite)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -1343,6 +1490,188 @@ void TestTdm::TestTdmStatic_TestIsParent(nlTestSuite *inSuite)
     }
 }
 
+void TestTdm::TestTdmStatic_EncodedSize(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t buf[1024];
+    TLVWriter writer;
+    TLVType outerType;
+    uint32_t startLen;
+    uint32_t encodedSize = 0;
+    const uint64_t tag = ContextTag(DataElement::kCsTag_Data);
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    uint32_t cachedSize = 0;
+#endif
+
+    Reset();
+
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+
+    // The measured size matches what is actually written, for both the whole trait and a single leaf. As in a data
+    // element, the data is written with a context tag, and so inside a structure.
+    err = mTestTdmSource.GetEncodedSize(kRootPropertyPathHandle, tag, encodedSize);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    writer.Init(buf, sizeof(buf));
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    startLen = writer.GetLengthWritten();
+    err = mTestTdmSource.ReadData(kRootPropertyPathHandle, tag, writer);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, encodedSize == writer.GetLengthWritten() - startLen);
+
+    err = mTestTdmSource.GetEncodedSize(TestHTrait::kPropertyHandle_A, tag, encodedSize);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    writer.Init(buf, sizeof(buf));
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    startLen = writer.GetLengthWritten();
+    err = mTestTdmSource.ReadData(TestHTrait::kPropertyHandle_A, tag, writer);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, encodedSize == writer.GetLengthWritten() - startLen);
+
+#if WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+    // ReadData() leaves the size of its encoding behind, keyed on the handle and tag.
+    NL_TEST_ASSERT(inSuite, mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_A, tag, cachedSize));
+    NL_TEST_ASSERT(inSuite, cachedSize == encodedSize);
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_B, tag, cachedSize));
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_A, ContextTag(1), cachedSize));
+
+    // Changing the data invalidates the cached size, and the value now needs a wider encoding.
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 70000);
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_A, tag, cachedSize));
+
+    err = mTestTdmSource.GetEncodedSize(TestHTrait::kPropertyHandle_A, tag, cachedSize);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cachedSize > encodedSize);
+
+    // Measuring warms the cache as well.
+    NL_TEST_ASSERT(inSuite, mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_A, tag, encodedSize));
+    NL_TEST_ASSERT(inSuite, encodedSize == cachedSize);
+
+    // Bumping the version without SetDirty() invalidates it too.
+    mTestTdmSource.SetVersion(mTestTdmSource.GetVersion() + 1);
+    NL_TEST_ASSERT(inSuite, !mTestTdmSource.GetCachedEncodedSize(TestHTrait::kPropertyHandle_A, tag, cachedSize));
+#endif // WDM_PUBLISHER_ENABLE_ENCODED_SIZE_CACHE
+
+    mNotificationEngine->mGraphSolver.ClearDirty();
+}
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+// Write a single data element for mTestTdmSource into a fresh notify request, as the engine would for each of its subscribers,
+// and copy out the bytes of the element.
+WEAVE_ERROR TestTdm::WriteSharedDataElement(PropertyPathHandle aPropertyPathHandle, uint8_t *aEncoding, uint32_t &aEncodingLen)
+{
+    NotificationEngine::NotifyRequestBuilder notifyRequest;
+    PacketBuffer *buf = NULL;
+    TLVWriter writer;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint32_t maxPayloadSize = 0;
+    uint32_t startLen;
+
+    err = mSubHandler->mBinding->AllocateRightSizedBuffer(buf, mSubHandler->GetMaxNotificationSize(), WDM_MIN_NOTIFICATION_SIZE, maxPayloadSize);
+    SuccessOrExit(err);
+
+    err = notifyRequest.Init(buf, &writer, mSubHandler, maxPayloadSize);
+    SuccessOrExit(err);
+
+    notifyRequest.SetEncodingCache(&mNotificationEngine->mEncodingCache);
+
+    err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_BuildDataList);
+    SuccessOrExit(err);
+
+    startLen = writer.GetLengthWritten();
+
+    err = notifyRequest.WriteDataElement(mSubHandler->mTraitInstanceList[0].mTraitDataHandle, aPropertyPathHandle,
+                                         mTestTdmSource.GetSchemaEngine()->GetMaxVersion(), NULL, 0, NULL, 0);
+    SuccessOrExit(err);
+
+    aEncodingLen = writer.GetLengthWritten() - startLen;
+    memcpy(aEncoding, buf->Start() + startLen, aEncodingLen);
+
+    err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
+    SuccessOrExit(err);
+
+exit:
+    if (buf) {
+        PacketBuffer::Free(buf);
+    }
+
+    return err;
+}
+
+void TestTdm::TestTdmStatic_SharedEncodingCache(nlTestSuite *inSuite)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    NotificationEngine::EncodingCache &cache = mNotificationEngine->mEncodingCache;
+    NotificationEngine::EncodingCache::Key fillerKey;
+    uint8_t encoding[3][WDM_MAX_NOTIFICATION_SIZE];
+    uint32_t encodingLen[3];
+    uint32_t numHits, numLookups, startHits, startLookups;
+    uint32_t freeSpace;
+
+    Reset();
+    cache.Clear();
+
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_B, 3);
+    mTestTdmSource.Unlock();
+
+    mNotificationEngine->GetEncodingCacheStats(startHits, startLookups);
+
+    // The first subscriber encodes the element into the cache; the second gets a byte-identical copy of it.
+    err = WriteSharedDataElement(kRootPropertyPathHandle, encoding[0], encodingLen[0]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = WriteSharedDataElement(kRootPropertyPathHandle, encoding[1], encodingLen[1]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, encodingLen[0] > 0 && encodingLen[0] == encodingLen[1]);
+    NL_TEST_ASSERT(inSuite, memcmp(encoding[0], encoding[1], encodingLen[0]) == 0);
+
+    mNotificationEngine->GetEncodingCacheStats(numHits, numLookups);
+    NL_TEST_ASSERT(inSuite, numLookups - startLookups == 2);
+    NL_TEST_ASSERT(inSuite, numHits - startHits == 1);
+
+    // Once the cache has less room left than the request, the element is looked up but encoded straight into the request.
+    cache.GetFreeSpace(freeSpace);
+    memset(&fillerKey, 0, sizeof(fillerKey));
+    fillerKey.mPropertyPathHandle = kNullPropertyPathHandle;
+    cache.Commit(fillerKey, freeSpace);
+
+    err = WriteSharedDataElement(TestHTrait::kPropertyHandle_A, encoding[2], encodingLen[2]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    mNotificationEngine->GetEncodingCacheStats(numHits, numLookups);
+    NL_TEST_ASSERT(inSuite, numLookups - startLookups == 3);
+    NL_TEST_ASSERT(inSuite, numHits - startHits == 1);
+
+    cache.Clear();
+
+    // A change to the data changes the key, so the stale encoding isn't used.
+    mTestTdmSource.Lock();
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 4);
+    mTestTdmSource.Unlock();
+
+    err = WriteSharedDataElement(kRootPropertyPathHandle, encoding[1], encodingLen[1]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, encodingLen[0] != encodingLen[1] || memcmp(encoding[0], encoding[1], encodingLen[0]) != 0);
+
+    err = WriteSharedDataElement(kRootPropertyPathHandle, encoding[2], encodingLen[2]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, encodingLen[1] == encodingLen[2] && memcmp(encoding[1], encoding[2], encodingLen[1]) == 0);
+
+    mNotificationEngine->GetEncodingCacheStats(numHits, numLookups);
+    NL_TEST_ASSERT(inSuite, numLookups - startLookups == 5);
+    NL_TEST_ASSERT(inSuite, numHits - startHits == 2);
+
+    cache.Clear();
+    mNotificationEngine->mGraphSolver.ClearDirty();
+}
+#endif // WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+
 void TestTdm::TestTdmMismatched_PathInDataElement(nlTestSuite *inSuite)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2190,6 +2519,195 @@ void TestTdm::CheckSynchronizedTraitState(nlTestSuite *inSuite)
     NL_TEST_ASSERT(inSuite, hasCaughtUp == true);
 }
 
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+void TestTdm::CheckNotifyLatencyHistogram(nlTestSuite *inSuite)
+{
+    const uint32_t *histogram = mNotificationEngine->GetNotifyLatencyHistogram();
+    uint32_t countBefore[NotificationEngine::kNumNotifyLatencyBuckets];
+
+    Reset();
+
+    memcpy(countBefore, histogram, sizeof(countBefore));
+
+    // Marking the subscription dirty starts the clock.
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mDirtySince != 0);
+
+    // 1500 ms lands in [1024, 2048), and stays pending while the notify leaves trait instances for a later one.
+    mSubHandler->mDirtySince = nl::Weave::System::Timer::GetCurrentEpoch() - 1500;
+    mSubHandler->mCurProcessingTraitInstanceIdx = 1;
+
+    mNotificationEngine->RecordNotifyLatency(mSubHandler);
+    NL_TEST_ASSERT(inSuite, histogram[11] == countBefore[11] + 1);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mDirtySince != 0);
+
+    mSubHandler->mCurProcessingTraitInstanceIdx = 0;
+
+    mNotificationEngine->RecordNotifyLatency(mSubHandler);
+    NL_TEST_ASSERT(inSuite, histogram[11] == countBefore[11] + 2);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mDirtySince == 0);
+
+    // A notify that isn't the result of a change isn't counted.
+    mNotificationEngine->RecordNotifyLatency(mSubHandler);
+    NL_TEST_ASSERT(inSuite, histogram[11] == countBefore[11] + 2);
+
+    for (size_t i = 0; i < NotificationEngine::kNumNotifyLatencyBuckets; i++)
+    {
+        if (i != 11)
+        {
+            NL_TEST_ASSERT(inSuite, histogram[i] == countBefore[i]);
+        }
+    }
+
+    Reset();
+}
+#endif // WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+
+void TestTdm::PublisherEventCallback(void * const aAppState,
+        SubscriptionHandler::EventID aEvent, const SubscriptionHandler::InEventParam & aInParam,
+        SubscriptionHandler::OutEventParam & aOutParam)
+{
+    SubscriptionHandler::DefaultEventHandler(aEvent, aInParam, aOutParam);
+}
+
+void TestTdm::CheckNotifyBudget(nlTestSuite *inSuite)
+{
+    const uint16_t kUnusedPort = 11098;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    SubscriptionHandler *subHandler2 = NULL;
+    SubscriptionHandler::TraitInstanceInfo *traitInstance = NULL;
+    Binding *savedBinding = mSubHandler->mBinding;
+    Binding *binding = NULL;
+    nl::Inet::IPAddress loopbackAddr;
+    uint32_t numNotifiesInFlightAtStart = mNotificationEngine->mNumNotifiesInFlight;
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    const uint32_t *histogram = mNotificationEngine->GetNotifyLatencyHistogram();
+    uint32_t numLatenciesBefore = 0;
+    uint32_t numLatencies = 0;
+
+    for (size_t i = 0; i < NotificationEngine::kNumNotifyLatencyBuckets; i++)
+    {
+        numLatenciesBefore += histogram[i];
+    }
+#endif
+
+    Reset();
+
+    // Both subscriptions send over plain UDP to a loopback port that nothing listens on, so no reply ever comes back.
+    nl::Inet::IPAddress::FromString("127.0.0.1", loopbackAddr);
+
+    binding = ExchangeMgr.NewBinding(Binding::DefaultEventHandler, NULL);
+    NL_TEST_ASSERT(inSuite, binding != NULL);
+    VerifyOrExit(binding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = binding->BeginConfiguration()
+              .Target_NodeId(1)
+              .TargetAddress_IP(loopbackAddr, kUnusedPort)
+              .Transport_UDP()
+              .Security_None()
+              .PrepareBinding();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    SuccessOrExit(err);
+    NL_TEST_ASSERT(inSuite, binding->IsReady());
+
+    mSubHandler->mBinding = binding;
+    mSubHandler->mRefCount = 1;
+    mSubHandler->mEventCallback = PublisherEventCallback;
+    mSubHandler->mLivenessTimeoutMsec = 20000;
+
+    // A second subscription to the first trait instance, which is closer to its liveness timeout.
+    err = mSubscriptionEngine.NewSubscriptionHandler(&subHandler2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    SuccessOrExit(err);
+
+    binding->AddRef();
+    subHandler2->mBinding = binding;
+    subHandler2->mRefCount = 1;
+    subHandler2->mEventCallback = PublisherEventCallback;
+    subHandler2->mLivenessTimeoutMsec = 10000;
+
+    traitInstance = mSubscriptionEngine.mTraitInfoPool + mSubscriptionEngine.mNumTraitInfosInPool;
+    subHandler2->mTraitInstanceList = traitInstance;
+    subHandler2->mNumTraitInstances++;
+    ++(SubscriptionEngine::GetInstance()->mNumTraitInfosInPool);
+
+    traitInstance->Init();
+    traitInstance->mTraitDataHandle = mSubHandler->mTraitInstanceList[0].mTraitDataHandle;
+    traitInstance->mRequestedVersion = 1;
+
+    subHandler2->MoveToState(SubscriptionHandler::kState_SubscriptionEstablished_Idle);
+
+    err = mSubHandler->RefreshTimer();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = subHandler2->RefreshTimer();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subHandler2->mLivenessDeadline < mSubHandler->mLivenessDeadline);
+
+    // Left to round-robin, the engine would serve mSubHandler first.
+    mNotificationEngine->mCurSubscriptionHandlerIdx = mSubscriptionEngine.GetHandlerId(mSubHandler);
+
+    mTestTdmSource.SetValue(TestHTrait::kPropertyHandle_A, 2);
+
+    // The budget only allows a single notify, which goes to the subscription nearest its liveness timeout.
+    mNotificationEngine->SetMaxNotifiesPerRun(1);
+    mNotificationEngine->Run();
+
+    NL_TEST_ASSERT(inSuite, mNotificationEngine->mNumNotifiesInFlight == numNotifiesInFlightAtStart + 1);
+    NL_TEST_ASSERT(inSuite, mNotificationEngine->mNumNotifiesSentThisRun == 1);
+    NL_TEST_ASSERT(inSuite, subHandler2->mCurrentState == SubscriptionHandler::kState_SubscriptionEstablished_Notifying);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mCurrentState == SubscriptionHandler::kState_SubscriptionEstablished_Idle);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mTraitInstanceList[0].IsDirty());
+
+    // The run the engine scheduled when it yielded picks up the remaining subscription.
+    for (int i = 0; i < 10 && mSubHandler->mCurrentState != SubscriptionHandler::kState_SubscriptionEstablished_Notifying; i++)
+    {
+        struct timeval sleepTime;
+
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, mNotificationEngine->mNumNotifiesInFlight == numNotifiesInFlightAtStart + 2);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mCurrentState == SubscriptionHandler::kState_SubscriptionEstablished_Notifying);
+    NL_TEST_ASSERT(inSuite, !mSubHandler->mTraitInstanceList[0].IsDirty());
+
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+    for (size_t i = 0; i < NotificationEngine::kNumNotifyLatencyBuckets; i++)
+    {
+        numLatencies += histogram[i];
+    }
+
+    NL_TEST_ASSERT(inSuite, numLatencies == numLatenciesBefore + 2);
+    NL_TEST_ASSERT(inSuite, mSubHandler->mDirtySince == 0);
+    NL_TEST_ASSERT(inSuite, subHandler2->mDirtySince == 0);
+#endif
+
+exit:
+    // Terminating the second subscription releases its binding reference, its trait instance and its notify in flight.
+    if (subHandler2 != NULL)
+    {
+        subHandler2->AbortSubscription();
+    }
+
+    mSubHandler->FlushExistingExchangeContext(true);
+    mSubHandler->mLivenessTimeoutMsec = SubscriptionHandler::kNoTimeout;
+    mSubHandler->RefreshTimer();
+    mSubHandler->mEventCallback = NULL;
+    mSubHandler->mRefCount = 0;
+    mSubHandler->mBinding = savedBinding;
+    mNotificationEngine->mNumNotifiesInFlight = numNotifiesInFlightAtStart;
+    mNotificationEngine->SetMaxNotifiesPerRun(WDM_PUBLISHER_MAX_NOTIFIES_PER_RUN);
+
+    if (binding != NULL)
+    {
+        binding->Release();
+    }
+
+    Reset();
+}
+
 } // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }
 }
@@ -2251,6 +2769,16 @@ static void TestTdmStatic_MarkLeafHandleDirtyTwice(nlTestSuite *inSuite, void *i
     gTestTdm->TestTdmStatic_MarkLeafHandleDirtyTwice(inSuite);
 }
 
+static void TestTdmStatic_DirtyStoreOverflow(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_DirtyStoreOverflow(inSuite);
+}
+
+static void TestTdmStatic_DirtyHandlesSurviveStoreOverflow(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_DirtyHandlesSurviveStoreOverflow(inSuite);
+}
+
 static void TestTdmStatic_TestNullableStruct(nlTestSuite *inSuite, void *inContext)
 {
     gTestTdm->TestTdmStatic_TestNullableStruct(inSuite);
@@ -2276,6 +2804,18 @@ static void TestTdmStatic_TestIsParent(nlTestSuite *inSuite, void *inContext)
     gTestTdm->TestTdmStatic_TestIsParent(inSuite);
 }
 
+static void TestTdmStatic_EncodedSize(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_EncodedSize(inSuite);
+}
+
+#if WDM_PUBLISHER_NOTIFY_ENCODING_CACHE_SIZE
+static void TestTdmStatic_SharedEncodingCache(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestTdmStatic_SharedEncodingCache(inSuite);
+}
+#endif
+
 static void TestTdmStatic_TestEphemeralLeaf(nlTestSuite *inSuite, void *inContext)
 {
     gTestTdm->TestTdmStatic_TestEphemeralLeaf(inSuite);
@@ -2410,6 +2950,18 @@ static void CheckSynchronizedTraitState(nlTestSuite *inSuite, void *inContext)
     gTestTdm->CheckSynchronizedTraitState(inSuite);
 }
 
+#if WDM_PUBLISHER_ENABLE_NOTIFY_LATENCY_STATS
+static void CheckNotifyLatencyHistogram(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->CheckNotifyLatencyHistogram(inSuite);
+}
+#endif
+
+static void CheckNotifyBudget(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->CheckNotifyBudget(inSuite);
+}
+
 /**
  *  Main
  */
@@ -1958,6 +1958,157 @@ void CheckPacketBuffer(nlTestSuite *inSuite, void *inContext)
     PacketBuffer::Free(buf);
 }
 
+static PacketBuffer *MakeBlobBuffer(uint16_t len, uint8_t seed)
+{
+    PacketBuffer *buf = PacketBuffer::New(0);
+
+    if (buf != NULL)
+    {
+        for (uint16_t i = 0; i < len; i++)
+            buf->Start()[i] = static_cast<uint8_t>(seed + i * 13);
+        buf->SetDataLength(len);
+    }
+
+    return buf;
+}
+
+static void CheckBlob(nlTestSuite *inSuite, const uint8_t *data, uint32_t len, uint16_t offset, uint16_t seed)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (data[i] != static_cast<uint8_t>(seed + (offset + i) * 13))
+        {
+            NL_TEST_ASSERT(inSuite, false);
+            break;
+        }
+    }
+}
+
+/**
+ *  Test PutBytesRef
+ */
+void CheckPutBytesRef(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    PacketBuffer *buf = PacketBuffer::New(0);
+    PacketBuffer *smallBlob = MakeBlobBuffer(16, 1);
+    PacketBuffer *largeBlob = MakeBlobBuffer(1000, 2);
+    PacketBuffer *largeBlobTail = MakeBlobBuffer(1000, 2);
+    uint8_t flatBuf[2048];
+    uint8_t readBuf[2000];
+    bool largeBlobLinked = false;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+
+    NL_TEST_ASSERT(inSuite, buf != NULL && smallBlob != NULL && largeBlob != NULL && largeBlobTail != NULL);
+    VerifyOrExit(buf != NULL && smallBlob != NULL && largeBlob != NULL && largeBlobTail != NULL, );
+
+    // Make the large value span two buffers, continuing the pattern of the first.
+    for (uint16_t i = 0; i < 1000; i++)
+        largeBlobTail->Start()[i] = static_cast<uint8_t>(2 + (1000 + i) * 13);
+    largeBlob->AddToEnd(largeBlobTail);
+
+    writer.Init(buf, UINT32_MAX, true);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // A value that fits in the current buffer is copied.
+    err = writer.PutBytesRef(ContextTag(1), smallBlob);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // A larger value is linked into the output chain.
+    err = writer.PutBytesRef(ContextTag(2), largeBlob);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(3), static_cast<uint32_t>(42));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    for (PacketBuffer *p = buf; p != NULL; p = p->Next())
+    {
+        if (p == largeBlob && p->Next() == largeBlobTail)
+            largeBlobLinked = true;
+    }
+    NL_TEST_ASSERT(inSuite, largeBlobLinked);
+
+    // Read the encoding back across the buffer chain.
+    reader.Init(buf, UINT32_MAX, true);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = reader.EnterContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetTag() == ContextTag(1));
+    NL_TEST_ASSERT(inSuite, reader.GetLength() == 16);
+
+    err = reader.GetBytes(readBuf, sizeof(readBuf));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    CheckBlob(inSuite, readBuf, 16, 0, 1);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetTag() == ContextTag(2));
+    NL_TEST_ASSERT(inSuite, reader.GetLength() == 2000);
+
+    err = reader.GetBytes(readBuf, sizeof(readBuf));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    CheckBlob(inSuite, readBuf, 2000, 0, 2);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetTag() == ContextTag(3));
+
+    err = reader.ExitContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+
+    // A writer that is not writing to a buffer chain copies the value.
+    largeBlob = MakeBlobBuffer(1000, 2);
+    NL_TEST_ASSERT(inSuite, largeBlob != NULL);
+    VerifyOrExit(largeBlob != NULL, );
+
+    writer.Init(flatBuf, sizeof(flatBuf));
+
+    err = writer.PutBytesRef(AnonymousTag, largeBlob);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    reader.Init(flatBuf, writer.GetLengthWritten());
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetLength() == 1000);
+
+    err = reader.GetBytes(readBuf, sizeof(readBuf));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    CheckBlob(inSuite, readBuf, 1000, 0, 2);
+
+    // The value is released if it cannot be written.
+    largeBlob = MakeBlobBuffer(1000, 2);
+    NL_TEST_ASSERT(inSuite, largeBlob != NULL);
+    VerifyOrExit(largeBlob != NULL, );
+
+    writer.Init(flatBuf, 100);
+
+    err = writer.PutBytesRef(AnonymousTag, largeBlob);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+exit:
+    PacketBuffer::Free(buf);
+}
+
 WEAVE_ERROR CountEvictedMembers(WeaveCircularTLVBuffer &inBuffer, void * inAppData, TLVReader &inReader)
 {
     TestTLVContext *context = static_cast<TestTLVContext *>(inAppData);
@@ -3758,6 +3909,481 @@ exit:
     return;
 }
 
+/**
+ *  Test TLVReader throughput on large nested encodings
+ */
+
+enum
+{
+    kReaderBenchmarkRecords         = 64,
+    kReaderBenchmarkArrayLen        = 16,
+    kReaderBenchmarkRuns            = 200,
+    kReaderBenchmarkSegmentLen      = 61,   // deliberately odd so that element heads straddle segments
+    kReaderBenchmarkBufSize         = 16384
+};
+
+/**
+ * A TLVReader that presents a contiguous encoding as a sequence of small input buffers, exercising
+ * the GetNextBuffer() path of the reader in the same way a chain of PacketBuffers would.
+ */
+class SegmentedTLVReader : public TLVReader
+{
+public:
+    void Init(const uint8_t *data, uint32_t dataLen, uint32_t segmentLen);
+
+private:
+    static WEAVE_ERROR GetNextSegment(TLVReader& reader, uintptr_t& bufHandle, const uint8_t *& bufStart, uint32_t& bufLen);
+};
+
+void SegmentedTLVReader::Init(const uint8_t *data, uint32_t dataLen, uint32_t segmentLen)
+{
+    TLVReader::Init(data, dataLen);
+
+    if (segmentLen < dataLen)
+        mBufEnd = data + segmentLen;
+
+    mBufHandle = segmentLen;
+    GetNextBuffer = GetNextSegment;
+}
+
+WEAVE_ERROR SegmentedTLVReader::GetNextSegment(TLVReader& reader, uintptr_t& bufHandle, const uint8_t *& bufStart, uint32_t& bufLen)
+{
+    // The next segment begins where the previous one ended; the reader caps its length at the end
+    // of the encoding.
+    bufLen = (uint32_t)bufHandle;
+    return WEAVE_NO_ERROR;
+}
+
+static uint32_t WriteReaderBenchmarkEncoding(nlTestSuite *inSuite, uint8_t *buf, uint32_t bufSize)
+{
+    WEAVE_ERROR err;
+    TLVWriter writer;
+    TLVType outerContainerType, recordContainerType, arrayContainerType;
+    uint8_t bytes[24];
+
+    memset(bytes, 0xA5, sizeof(bytes));
+
+    writer.Init(buf, bufSize);
+    writer.ImplicitProfileId = TestProfile_2;
+
+    err = writer.StartContainer(ProfileTag(TestProfile_1, 1), kTLVType_Structure, outerContainerType);
+    SuccessOrExit(err);
+
+    for (uint32_t i = 0; i < kReaderBenchmarkRecords; i++)
+    {
+        err = writer.StartContainer(ContextTag(1), kTLVType_Structure, recordContainerType);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(1), (uint8_t) i);
+        SuccessOrExit(err);
+        err = writer.Put(ContextTag(2), (int16_t) (-100 * (int) i));
+        SuccessOrExit(err);
+        err = writer.Put(ContextTag(3), (uint64_t) 0x0123456789ABCDEFULL + i);
+        SuccessOrExit(err);
+        err = writer.PutBoolean(ContextTag(4), (i & 1) != 0);
+        SuccessOrExit(err);
+        err = writer.Put(ProfileTag(TestProfile_2, 5), (double) i / 3);
+        SuccessOrExit(err);
+        err = writer.PutString(ProfileTag(TestProfile_1, 6), "benchmark record");
+        SuccessOrExit(err);
+        err = writer.PutBytes(ContextTag(7), bytes, sizeof(bytes));
+        SuccessOrExit(err);
+        err = writer.PutNull(CommonTag(8));
+        SuccessOrExit(err);
+
+        err = writer.StartContainer(ContextTag(9), kTLVType_Array, arrayContainerType);
+        SuccessOrExit(err);
+
+        for (uint32_t j = 0; j < kReaderBenchmarkArrayLen; j++)
+        {
+            err = writer.Put(AnonymousTag, (uint32_t) (i * j));
+            SuccessOrExit(err);
+        }
+
+        err = writer.EndContainer(arrayContainerType);
+        SuccessOrExit(err);
+
+        err = writer.EndContainer(recordContainerType);
+        SuccessOrExit(err);
+    }
+
+    err = writer.EndContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+exit:
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    return (err == WEAVE_NO_ERROR) ? writer.GetLengthWritten() : 0;
+}
+
+static void ReadBenchmarkElement(nlTestSuite *inSuite, TLVReader& reader, void *context)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint32_t *elementCount = static_cast<uint32_t *>(context);
+    uint8_t scratch[32];
+    uint64_t intVal;
+    double floatVal;
+    bool boolVal;
+
+    switch (reader.GetType())
+    {
+    case kTLVType_SignedInteger:
+    case kTLVType_UnsignedInteger:
+        err = reader.Get(intVal);
+        break;
+    case kTLVType_Boolean:
+        err = reader.Get(boolVal);
+        break;
+    case kTLVType_FloatingPointNumber:
+        err = reader.Get(floatVal);
+        break;
+    case kTLVType_UTF8String:
+        err = reader.GetString((char *) scratch, sizeof(scratch));
+        break;
+    case kTLVType_ByteString:
+        err = reader.GetBytes(scratch, sizeof(scratch));
+        break;
+    default:
+        break;
+    }
+
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    (*elementCount)++;
+}
+
+static uint64_t RunReaderBenchmark(nlTestSuite *inSuite, TLVReader& reader, uint32_t& elementCount)
+{
+    uint64_t elapsed = Now();
+
+    elementCount = 0;
+    reader.ImplicitProfileId = TestProfile_2;
+    ForEachElement(inSuite, reader, &elementCount, ReadBenchmarkElement);
+
+    return Now() - elapsed;
+}
+
+void CheckTLVReaderBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t *buf = (uint8_t *) malloc(kReaderBenchmarkBufSize);
+    uint32_t encodingLen;
+    uint32_t expectedElementCount = 1 + kReaderBenchmarkRecords * (10 + kReaderBenchmarkArrayLen);
+    uint64_t contiguousElapsed = 0, segmentedElapsed = 0;
+
+    NL_TEST_ASSERT(inSuite, buf != NULL);
+    VerifyOrExit(buf != NULL, );
+
+    encodingLen = WriteReaderBenchmarkEncoding(inSuite, buf, kReaderBenchmarkBufSize);
+    VerifyOrExit(encodingLen != 0, );
+
+    for (uint32_t run = 0; run < kReaderBenchmarkRuns; run++)
+    {
+        TLVReader contiguousReader;
+        SegmentedTLVReader segmentedReader;
+        uint32_t elementCount;
+
+        contiguousReader.Init(buf, encodingLen);
+        contiguousElapsed += RunReaderBenchmark(inSuite, contiguousReader, elementCount);
+        NL_TEST_ASSERT(inSuite, elementCount == expectedElementCount);
+
+        segmentedReader.Init(buf, encodingLen, kReaderBenchmarkSegmentLen);
+        segmentedElapsed += RunReaderBenchmark(inSuite, segmentedReader, elementCount);
+        NL_TEST_ASSERT(inSuite, elementCount == expectedElementCount);
+    }
+
+    printf("TLVReader benchmark: %u byte encoding, %u elements, %u runs\n",
+           (unsigned) encodingLen, (unsigned) expectedElementCount, (unsigned) kReaderBenchmarkRuns);
+    printf("    contiguous buffer:          %.1f ns/element\n",
+           (contiguousElapsed * 1000.0) / ((double) expectedElementCount * kReaderBenchmarkRuns));
+    printf("    %u byte segmented buffers:  %.1f ns/element\n", (unsigned) kReaderBenchmarkSegmentLen,
+           (segmentedElapsed * 1000.0) / ((double) expectedElementCount * kReaderBenchmarkRuns));
+
+exit:
+    if (buf != NULL)
+        free(buf);
+}
+
+/**
+ *  Test Weave TLV Structural Index
+ */
+
+struct StructuralIndexCheckContext
+{
+    nlTestSuite *mSuite;
+    const nl::Weave::TLV::Utilities::TLVStructuralIndex *mIndex;
+    uint16_t mNextEntry;
+};
+
+static WEAVE_ERROR CheckStructuralIndexEntry(const TLVReader &aReader, size_t aDepth, void *aContext)
+{
+    StructuralIndexCheckContext *context = static_cast<StructuralIndexCheckContext *>(aContext);
+    nlTestSuite *inSuite = context->mSuite;
+    uint16_t entryIndex = context->mNextEntry++;
+    TLVReader entryReader;
+    WEAVE_ERROR err;
+
+    NL_TEST_ASSERT(inSuite, entryIndex < context->mIndex->GetNumEntries());
+    if (entryIndex >= context->mIndex->GetNumEntries())
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+
+    const nl::Weave::TLV::Utilities::TLVIndexEntry &entry = context->mIndex->GetEntry(entryIndex);
+
+    NL_TEST_ASSERT(inSuite, entry.mTag == aReader.GetTag());
+    NL_TEST_ASSERT(inSuite, entry.mType == aReader.GetType());
+    NL_TEST_ASSERT(inSuite, entry.mControlByte == aReader.GetControlByte());
+
+    // A reader restored from the index must be indistinguishable from one that walked there.
+    err = context->mIndex->GetReader(entryIndex, entryReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, entryReader.GetTag() == aReader.GetTag());
+    NL_TEST_ASSERT(inSuite, entryReader.GetType() == aReader.GetType());
+    NL_TEST_ASSERT(inSuite, entryReader.GetLength() == aReader.GetLength());
+    NL_TEST_ASSERT(inSuite, entryReader.GetContainerType() == aReader.GetContainerType());
+    NL_TEST_ASSERT(inSuite, entryReader.GetReadPoint() == aReader.GetReadPoint());
+    NL_TEST_ASSERT(inSuite, entryReader.GetLengthRead() == aReader.GetLengthRead());
+
+    return WEAVE_NO_ERROR;
+}
+
+void CheckWeaveTLVStructuralIndex(nlTestSuite *inSuite, void *inContext)
+{
+    using nl::Weave::TLV::Utilities::TLVStructuralIndex;
+    using nl::Weave::TLV::Utilities::TLVIndexEntry;
+    using nl::Weave::TLV::Utilities::kTLVIndex_None;
+
+    uint8_t buf[2048];
+    TLVWriter writer;
+    TLVReader reader, reader1, tagReader;
+    TLVIndexEntry entries[32];
+    uint16_t tagOrder[32];
+    TLVStructuralIndex index;
+    PacketBuffer *packetBuf;
+    const size_t expectedCount = 18;
+    size_t count;
+    uint16_t entryIndex;
+    WEAVE_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+    writer.ImplicitProfileId = TestProfile_2;
+
+    WriteEncoding1(inSuite, writer);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    reader.ImplicitProfileId = TestProfile_2;
+
+    for (int useTagOrder = 0; useTagOrder < 2; useTagOrder++)
+    {
+        const uint64_t arrayPath[] = { ProfileTag(TestProfile_1, 1), ContextTag(0) };
+        const uint64_t missingPath[] = { ProfileTag(TestProfile_1, 1), ContextTag(1) };
+        StructuralIndexCheckContext context = { inSuite, &index, 0 };
+        double doubleVal;
+
+        err = index.Init(reader, entries, useTagOrder ? tagOrder : NULL, 32);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        // Count
+        err = nl::Weave::TLV::Utilities::Count(index, count, true);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, count == expectedCount);
+
+        err = nl::Weave::TLV::Utilities::Count(index, count, false);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, count == 1);
+
+        // Every entry matches the element visited by a reader walking the encoding.
+        err = nl::Weave::TLV::Utilities::Iterate(reader, CheckStructuralIndexEntry, &context);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+        NL_TEST_ASSERT(inSuite, context.mNextEntry == expectedCount);
+
+        // Look up the array by path, and count its members.
+        err = index.FindPath(arrayPath, 2, entryIndex);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, index.GetEntry(entryIndex).mType == kTLVType_Array);
+        NL_TEST_ASSERT(inSuite, index.GetEntry(entryIndex).mNumDescendants == 11);
+
+        count = 0;
+        for (uint16_t i = index.GetFirstChild(entryIndex); i != kTLVIndex_None; i = index.GetNextSibling(i))
+            count++;
+        NL_TEST_ASSERT(inSuite, count == 6);
+
+        // Skipping the array in the index agrees with skipping it in the reader.
+        err = index.GetReader(entryIndex, tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        TestNext<TLVReader>(inSuite, tagReader);
+        NL_TEST_ASSERT(inSuite, index.GetNextSibling(entryIndex) != kTLVIndex_None);
+        NL_TEST_ASSERT(inSuite, tagReader.GetTag() == index.GetEntry(index.GetNextSibling(entryIndex)).mTag);
+        NL_TEST_ASSERT(inSuite, tagReader.GetTag() == ProfileTag(TestProfile_1, 5));
+
+        err = index.FindPath(missingPath, 2, entryIndex);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+        err = index.FindChild(kTLVIndex_None, ProfileTag(TestProfile_1, 1), entryIndex);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, entryIndex == 0);
+
+        err = index.FindChild(expectedCount, ProfileTag(TestProfile_1, 1), entryIndex);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+        // Find a tag, and read its value
+        err = nl::Weave::TLV::Utilities::Find(index, ProfileTag(TestProfile_2, 65536), tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = tagReader.Get(doubleVal);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, doubleVal == 17.9);
+
+        err = nl::Weave::TLV::Utilities::Find(index, ProfileTag(TestProfile_1, 5), tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        TestString(inSuite, tagReader, ProfileTag(TestProfile_1, 5), "This is a test");
+
+        // Find a tag that's only present below the top level
+        err = nl::Weave::TLV::Utilities::Find(index, ProfileTag(TestProfile_2, 65536), tagReader, false);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+        // Find a tag that's not present
+        err = nl::Weave::TLV::Utilities::Find(index, ProfileTag(TestProfile_2, 1024), tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+    }
+
+    // Index with reader already positioned "on" the first element in the encoding
+    reader1.Init(reader);
+    TestNext<TLVReader>(inSuite, reader1);
+
+    err = index.Init(reader1, entries, 32);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, index.GetNumEntries() == expectedCount);
+    NL_TEST_ASSERT(inSuite, index.GetEntry(0).mNumDescendants == expectedCount - 1);
+
+    // Index inside a container
+    TestAndOpenContainer(inSuite, reader1, kTLVType_Structure, ProfileTag(TestProfile_1, 1), tagReader);
+
+    err = index.Init(tagReader, entries, 32);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, index.GetNumEntries() == expectedCount - 1);
+
+    err = nl::Weave::TLV::Utilities::Count(index, count, false);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, count == 6);
+
+    // Insufficient entries
+    err = index.Init(reader, entries, expectedCount - 1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, index.GetNumEntries() == 0);
+
+    // Encoding spread across a chain of PacketBuffers
+    packetBuf = PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, packetBuf != NULL);
+    VerifyOrExit(packetBuf != NULL, );
+
+    packetBuf->SetStart(packetBuf->Start() + packetBuf->MaxDataLength() - sizeof(Encoding1) / 2);
+
+    writer.Init(packetBuf);
+    writer.GetNewBuffer = TLVWriter::GetNewPacketBuffer;
+    writer.ImplicitProfileId = TestProfile_2;
+
+    WriteEncoding1(inSuite, writer);
+
+    reader.Init(packetBuf, 0xFFFFFFFFUL, true);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    err = index.Init(reader, entries, 32);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+    PacketBuffer::Free(packetBuf);
+
+exit:
+    return;
+}
+
+/**
+ *  Test TLVSizer
+ */
+void CheckTLVSizer(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[2048];
+    TLVWriter writer;
+    TLVSizer sizer;
+    TLVReader reader;
+    TLVReader readerClone;
+    TLVWriter containerWriter;
+
+    // The sizer accounts for exactly the bytes a writer produces.
+    sizer.Init();
+    sizer.ImplicitProfileId = TestProfile_2;
+
+    WriteEncoding1(inSuite, sizer);
+
+    err = sizer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sizer.GetLengthWritten() == sizeof(Encoding1));
+
+    writer.Init(buf, sizeof(buf));
+    sizer.Init();
+
+    WriteEncoding5(inSuite, writer);
+    WriteEncoding5(inSuite, sizer);
+
+    NL_TEST_ASSERT(inSuite, sizer.GetLengthWritten() == writer.GetLengthWritten());
+
+    // Copying pre-encoded data and formatted strings.
+    reader.Init(Encoding1, sizeof(Encoding1));
+    reader.ImplicitProfileId = TestProfile_2;
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    readerClone.Init(reader);
+
+    writer.Init(buf, sizeof(buf));
+    sizer.Init();
+
+    err = writer.CopyElement(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = sizer.CopyElement(readerClone);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutStringF(ProfileTag(TestProfile_1, 1), "Sample string %d", 42);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = sizer.PutStringF(ProfileTag(TestProfile_1, 1), "Sample string %d", 42);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sizer.GetLengthWritten() == writer.GetLengthWritten());
+
+    // Container writers opened on a sizer account for the space reserved to close the container.
+    sizer.Init(16);
+
+    err = sizer.OpenContainer(AnonymousTag, kTLVType_Structure, containerWriter);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, containerWriter.GetRemainingLength() == 14);
+
+    err = containerWriter.PutString(ContextTag(1), "0123456789");
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, containerWriter.GetRemainingLength() == 1);
+
+    err = containerWriter.PutBoolean(ContextTag(2), true);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    err = sizer.CloseContainer(containerWriter);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, sizer.GetLengthWritten() == 15);
+    NL_TEST_ASSERT(inSuite, sizer.GetRemainingLength() == 1);
+
+    err = sizer.Put(AnonymousTag, static_cast<uint8_t>(3));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+}
+
 // Test Suite
 
 /**
@@ -3766,6 +4392,7 @@ exit:
 static const nlTest sTests[] = {
     NL_TEST_DEF("Simple Write Read Test",              CheckSimpleWriteRead),
     NL_TEST_DEF("Inet Buffer Test",                    CheckPacketBuffer),
+    NL_TEST_DEF("Inet Buffer PutBytesRef Test",        CheckPutBytesRef),
     NL_TEST_DEF("Buffer Overflow Test",                CheckBufferOverflow),
     NL_TEST_DEF("Pretty Print Test",                   CheckPrettyPrinter),
     NL_TEST_DEF("Data Macro Test",                     CheckDataMacro),
@@ -3776,6 +4403,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Weave TLV Utilities",                 CheckWeaveTLVUtilities),
     NL_TEST_DEF("Weave TLV Updater",                   CheckWeaveUpdater),
     NL_TEST_DEF("Weave TLV Empty Find",                CheckWeaveTLVEmptyFind),
+    NL_TEST_DEF("Weave TLV Structural Index",          CheckWeaveTLVStructuralIndex),
+    NL_TEST_DEF("Weave TLV Sizer",                     CheckTLVSizer),
     NL_TEST_DEF("Weave Circular TLV buffer, simple",   CheckCircularTLVBufferSimple),
     NL_TEST_DEF("Weave Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("Weave Circular TLV buffer, straddle", CheckCircularTLVBufferEvictStraddlingEvent),
@@ -3785,6 +4414,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Weave TLV Skip non-contiguous",       CheckWeaveTLVSkipCircular),
     NL_TEST_DEF("Weave TLV Check reserve",             CheckCloseContainerReserve),
     NL_TEST_DEF("Weave TLV Reader Fuzz Test",          TLVReaderFuzzTest),
+    NL_TEST_DEF("Weave TLV Reader Benchmark",          CheckTLVReaderBenchmark),
     NL_TEST_SENTINEL()
 };
 
@@ -0,0 +1,634 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the schema tree queries of
+ *      <tt>nl::Weave::Profiles::DataManagement::TraitSchemaEngine</tt>,
+ *      checking them against the schema handle tables they are derived
+ *      from, tests of schema tables described, indexed and visited at
+ *      compile time, and a benchmark of serializing and deserializing the
+ *      mock trait data sources.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ToolCommon.h"
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+#include <nest/test/trait/TestATrait.h>
+#include <nest/test/trait/TestBTrait.h>
+#include <nest/test/trait/TestCTrait.h>
+#include <nest/test/trait/TestETrait.h>
+#include "MockSourceTraits.h"
+
+#if defined(__cplusplus) && (__cplusplus >= 201103L)
+#include <Weave/Profiles/data-management/TraitSchemaTable.h>
+#define TEST_COMPILE_TIME_SCHEMA 1
+#else
+#define TEST_COMPILE_TIME_SCHEMA 0
+#endif
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+using namespace Schema::Nest::Test::Trait;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+static SubscriptionEngine *gSubscriptionEngine;
+
+SubscriptionEngine * SubscriptionEngine::GetInstance()
+{
+    return gSubscriptionEngine;
+}
+
+namespace Platform {
+    // For unit tests, a dummy critical section is sufficient.
+    void CriticalSectionEnter()
+    {
+        return;
+    }
+
+    void CriticalSectionExit()
+    {
+        return;
+    }
+
+} // Platform
+
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // Profiles
+} // Weave
+} // nl
+
+static const uint32_t kRunsPerBenchmark = 2000;
+static const size_t kMaxEncodedDataSize = 16384;
+
+#if TEST_COMPILE_TIME_SCHEMA
+// The TestB trait schema, described at compile time rather than by the generated tables.
+namespace CompileTimeTestBTrait {
+
+using namespace TestBTrait;
+
+constexpr TraitSchemaEngine::PropertyInfo PropertyMap[] = {
+    { kPropertyHandle_Root, 1 }, // ta_a
+    { kPropertyHandle_Root, 2 }, // ta_b
+    { kPropertyHandle_Root, 3 }, // ta_c
+    { kPropertyHandle_Root, 4 }, // ta_d
+    { kPropertyHandle_TaD, 1 }, // sa_a
+    { kPropertyHandle_TaD, 2 }, // sa_b
+    { kPropertyHandle_Root, 5 }, // ta_e
+    { kPropertyHandle_Root, 8 }, // ta_g
+    { kPropertyHandle_Root, 10 }, // ta_h
+    { kPropertyHandle_Root, 11 }, // ta_i
+    { kPropertyHandle_Root, 12 }, // ta_j
+    { kPropertyHandle_Root, 14 }, // ta_k
+    { kPropertyHandle_Root, 15 }, // ta_l
+    { kPropertyHandle_Root, 16 }, // ta_m
+    { kPropertyHandle_Root, 9 }, // ta_n
+    { kPropertyHandle_Root, 7 }, // ta_o
+    { kPropertyHandle_Root, 17 }, // ta_p
+    { kPropertyHandle_Root, 18 }, // ta_q
+    { kPropertyHandle_Root, 19 }, // ta_r
+    { kPropertyHandle_Root, 20 }, // ta_s
+    { kPropertyHandle_Root, 13 }, // ta_t
+    { kPropertyHandle_Root, 21 }, // ta_u
+    { kPropertyHandle_Root, 22 }, // ta_v
+    { kPropertyHandle_Root, 23 }, // ta_w
+    { kPropertyHandle_Root, 24 }, // ta_x
+    { kPropertyHandle_Root, 32 }, // tb_a
+    { kPropertyHandle_Root, 33 }, // tb_b
+    { kPropertyHandle_TbB, 1 }, // sb_a
+    { kPropertyHandle_TbB, 2 }, // sb_b
+    { kPropertyHandle_Root, 34 }, // tb_c
+    { kPropertyHandle_TbC, 1 }, // sa_a
+    { kPropertyHandle_TbC, 2 }, // sa_b
+    { kPropertyHandle_TbC, 32 }, // sea_c
+    { kPropertyHandle_TaI, 0 }, // value
+    { kPropertyHandle_TaJ, 0 }, // value
+    { kPropertyHandle_TaJ_Value, 1 }, // sa_a
+    { kPropertyHandle_TaJ_Value, 2 }, // sa_b
+};
+
+const uint32_t kNumEntries = ArraySize(PropertyMap);
+
+TDM_SCHEMA_TABLE_STATIC_ASSERT(PropertyMap);
+
+static_assert(TraitSchemaTable::TreeDepth(PropertyMap, kNumEntries) == 3, "TestB tree depth");
+static_assert(TraitSchemaTable::ChildHandle(PropertyMap, kNumEntries, kPropertyHandle_TbC, 32) == kPropertyHandle_TbC_SeaC,
+              "TestB tag lookup");
+static_assert(TraitSchemaTable::ChildHandle(PropertyMap, kNumEntries, kPropertyHandle_TbC, 3) == kNullPropertyPathHandle,
+              "TestB tag lookup");
+
+typedef TraitSchemaBitfield<kNumEntries, kPropertyHandle_TaI, kPropertyHandle_TaJ> IsDictionaryBitfield;
+typedef TraitSchemaBitfield<kNumEntries, kPropertyHandle_TaC> IsOptionalBitfield;
+typedef TraitSchemaBitfield<kNumEntries, kPropertyHandle_TaD, kPropertyHandle_TaD_SaA, kPropertyHandle_TaM, kPropertyHandle_TaN,
+                            kPropertyHandle_TaP, kPropertyHandle_TaS, kPropertyHandle_TaT, kPropertyHandle_TaU, kPropertyHandle_TaV,
+                            kPropertyHandle_TaW, kPropertyHandle_TaX, kPropertyHandle_TbC_SaA, kPropertyHandle_TaJ_Value_SaA>
+    IsNullableBitfield;
+typedef TraitSchemaBitfield<kNumEntries, kPropertyHandle_TaD, kPropertyHandle_TaD_SaA, kPropertyHandle_TaT, kPropertyHandle_TbC_SaA,
+                            kPropertyHandle_TaJ_Value_SaA>
+    IsEphemeralBitfield;
+
+#if (TDM_VERSIONING_SUPPORT)
+const ConstSchemaVersionRange traitVersion = { 1, 2 };
+#endif
+
+const TraitSchemaEngine TraitSchema = {
+    {
+        kWeaveProfileId,
+        PropertyMap,
+        kNumEntries,
+        TraitSchemaTable::TreeDepth(PropertyMap, kNumEntries),
+#if (TDM_EXTENSION_SUPPORT) || (TDM_VERSIONING_SUPPORT)
+        2,
+#endif
+        IsDictionaryBitfield::Get(),
+        IsOptionalBitfield::Get(),
+        NULL,
+        IsNullableBitfield::Get(),
+        IsEphemeralBitfield::Get(),
+#if (TDM_EXTENSION_SUPPORT)
+        NULL,
+#endif
+#if (TDM_VERSIONING_SUPPORT)
+        &traitVersion,
+#endif
+    },
+#if TDM_SCHEMA_INDEX_SUPPORT
+    TraitSchemaIndex<PropertyMap, kNumEntries>::Get(),
+    false,
+#endif
+};
+
+typedef TraitSchemaVisitor<PropertyMap, kNumEntries> Visitor;
+
+} // namespace CompileTimeTestBTrait
+#endif // TEST_COMPILE_TIME_SCHEMA
+
+static const TraitSchemaEngine * const sSchemaEngines[] =
+{
+    &TestATrait::TraitSchema,
+    &TestBTrait::TraitSchema,
+    &TestCTrait::TraitSchema,
+    &TestETrait::TraitSchema,
+#if TEST_COMPILE_TIME_SCHEMA
+    &CompileTimeTestBTrait::TraitSchema,
+#endif
+};
+
+// Trait data sources lock the subscription engine while their data is read out.
+static SubscriptionEngine sSubscriptionEngine;
+static uint8_t sEncodedData[kMaxEncodedDataSize];
+
+/**
+ *  A set data delegate that accepts, and counts, the data handed to it.
+ */
+class CountingSetDataDelegate : public TraitSchemaEngine::ISetDataDelegate
+{
+public:
+    CountingSetDataDelegate(void) : mNumLeaves(0), mNumDictionaryItems(0), mNumEvents(0), mHandleSum(0) { }
+
+    WEAVE_ERROR SetLeafData(PropertyPathHandle aLeafHandle, TLVReader & aReader)
+    {
+        mNumLeaves++;
+        mHandleSum += aLeafHandle;
+        return WEAVE_NO_ERROR;
+    }
+
+    WEAVE_ERROR SetData(PropertyPathHandle aHandle, TLVReader & aReader, bool aIsNull)
+    {
+        mNumLeaves++;
+        mHandleSum += aHandle;
+        return WEAVE_NO_ERROR;
+    }
+
+    void OnSetDataEvent(SetDataEventType aType, PropertyPathHandle aHandle)
+    {
+        if (aType == kSetDataEvent_DictionaryItemModifyBegin)
+        {
+            mNumDictionaryItems++;
+        }
+
+        mNumEvents++;
+    }
+
+    uint32_t mNumLeaves;
+    uint32_t mNumDictionaryItems;
+    uint32_t mNumEvents;
+    uint64_t mHandleSum;
+};
+
+static PropertySchemaHandle ReferenceParent(const TraitSchemaEngine & aEngine, PropertySchemaHandle aHandle)
+{
+    return aEngine.mSchema.mSchemaHandleTbl[aHandle - TraitSchemaEngine::kHandleTableOffset].mParentHandle;
+}
+
+// The child of aParent that follows aChild in the schema handle table, found by scanning the table.
+static PropertySchemaHandle ReferenceNextChild(const TraitSchemaEngine & aEngine, PropertySchemaHandle aParent,
+                                               PropertySchemaHandle aChild)
+{
+    const PropertySchemaHandle lastHandle = aEngine.mSchema.mNumSchemaHandleEntries + kRootPropertyPathHandle;
+
+    for (PropertySchemaHandle handle = aChild + 1; handle <= lastHandle; handle++)
+    {
+        if (handle >= TraitSchemaEngine::kHandleTableOffset && ReferenceParent(aEngine, handle) == aParent)
+            return handle;
+    }
+
+    return kNullPropertyPathHandle;
+}
+
+static int32_t ReferenceDepth(const TraitSchemaEngine & aEngine, PropertySchemaHandle aHandle)
+{
+    int32_t depth = 0;
+
+    for (; aHandle != kRootPropertyPathHandle; aHandle = ReferenceParent(aEngine, aHandle))
+        depth++;
+
+    return depth;
+}
+
+// Whether aParent is an ancestor of aChild, found by walking up from aChild with GetParent(), which carries the
+// dictionary key along.
+static bool ReferenceIsParent(const TraitSchemaEngine & aEngine, PropertyPathHandle aChild, PropertyPathHandle aParent)
+{
+    while ((aChild = aEngine.GetParent(aChild)) != kNullPropertyPathHandle)
+    {
+        if (aChild == aParent)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ *  Test that child iteration, leaf tests, depths and ancestry, as answered by the
+ *  schema engine, agree with the schema handle table of each test trait.
+ */
+static void CheckTreeQueries(nlTestSuite *inSuite, void *inContext)
+{
+    for (size_t e = 0; e < sizeof(sSchemaEngines) / sizeof(sSchemaEngines[0]); e++)
+    {
+        const TraitSchemaEngine & engine = *sSchemaEngines[e];
+        const PropertySchemaHandle lastHandle = engine.mSchema.mNumSchemaHandleEntries + kRootPropertyPathHandle;
+
+        for (PropertySchemaHandle parent = kRootPropertyPathHandle; parent <= lastHandle; parent++)
+        {
+            PropertySchemaHandle expected = ReferenceNextChild(engine, parent, kRootPropertyPathHandle);
+            PropertyPathHandle child = engine.GetFirstChild(parent);
+
+            while (expected != kNullPropertyPathHandle)
+            {
+                NL_TEST_ASSERT(inSuite, child == expected);
+                NL_TEST_ASSERT(inSuite, engine.GetChildHandle(parent, engine.GetMap(expected)->mContextTag) == expected ||
+                               engine.IsDictionary(parent));
+
+                child = engine.GetNextChild(parent, expected);
+                expected = ReferenceNextChild(engine, parent, expected);
+            }
+
+            NL_TEST_ASSERT(inSuite, child == kNullPropertyPathHandle);
+
+            NL_TEST_ASSERT(inSuite, engine.IsLeaf(parent) ==
+                           (parent != kRootPropertyPathHandle &&
+                            ReferenceNextChild(engine, parent, kRootPropertyPathHandle) == kNullPropertyPathHandle));
+
+            NL_TEST_ASSERT(inSuite, engine.GetDepth(parent) == ReferenceDepth(engine, parent));
+
+            for (PropertySchemaHandle other = kRootPropertyPathHandle; other <= lastHandle; other++)
+                NL_TEST_ASSERT(inSuite, engine.IsParent(parent, other) == ReferenceIsParent(engine, parent, other));
+        }
+
+        NL_TEST_ASSERT(inSuite, engine.GetDepth(lastHandle + 1) == -1);
+
+#if TDM_SCHEMA_INDEX_SUPPORT
+        // The queries above built the index, so they took the indexed path.
+        NL_TEST_ASSERT(inSuite, engine.mIndex != NULL);
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+    }
+}
+
+/**
+ *  Test ancestry queries on handles that carry a dictionary key.
+ */
+static void CheckDictionaryAncestry(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine & engine = TestBTrait::TraitSchema;
+    const PropertyPathHandle item = CreatePropertyPathHandle(TestBTrait::kPropertyHandle_TaJ_Value, 5);
+    const PropertyPathHandle itemField = CreatePropertyPathHandle(TestBTrait::kPropertyHandle_TaJ_Value_SaA, 5);
+
+    NL_TEST_ASSERT(inSuite, engine.IsParent(itemField, item));
+    NL_TEST_ASSERT(inSuite, !engine.IsParent(itemField, CreatePropertyPathHandle(TestBTrait::kPropertyHandle_TaJ_Value, 6)));
+    NL_TEST_ASSERT(inSuite, engine.IsParent(itemField, TestBTrait::kPropertyHandle_TaJ));
+    NL_TEST_ASSERT(inSuite, engine.IsParent(itemField, kRootPropertyPathHandle));
+    NL_TEST_ASSERT(inSuite, !engine.IsParent(item, itemField));
+    NL_TEST_ASSERT(inSuite, !engine.IsParent(itemField, itemField));
+    NL_TEST_ASSERT(inSuite, engine.GetDepth(itemField) == 3);
+
+    NL_TEST_ASSERT(inSuite, engine.GetNextChild(item, engine.GetFirstChild(item)) ==
+                   CreatePropertyPathHandle(TestBTrait::kPropertyHandle_TaJ_Value_SaB, 5));
+}
+
+#if TEST_COMPILE_TIME_SCHEMA
+/**
+ *  Test that a schema described at compile time matches the generated tables of the
+ *  same trait, including, when enabled, the index built at run time from those tables.
+ */
+static void CheckCompileTimeSchema(nlTestSuite *inSuite, void *inContext)
+{
+    const TraitSchemaEngine::Schema & generated = TestBTrait::TraitSchema.mSchema;
+    const TraitSchemaEngine::Schema & compiled = CompileTimeTestBTrait::TraitSchema.mSchema;
+    const size_t bitfieldSize = (generated.mNumSchemaHandleEntries + 7) / 8;
+
+    NL_TEST_ASSERT(inSuite, compiled.mNumSchemaHandleEntries == generated.mNumSchemaHandleEntries);
+    NL_TEST_ASSERT(inSuite, compiled.mTreeDepth == generated.mTreeDepth);
+    NL_TEST_ASSERT(inSuite, memcmp(compiled.mSchemaHandleTbl, generated.mSchemaHandleTbl,
+                                   generated.mNumSchemaHandleEntries * sizeof(TraitSchemaEngine::PropertyInfo)) == 0);
+
+    NL_TEST_ASSERT(inSuite, memcmp(compiled.mIsDictionaryBitfield, generated.mIsDictionaryBitfield, bitfieldSize) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(compiled.mIsOptionalBitfield, generated.mIsOptionalBitfield, bitfieldSize) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(compiled.mIsNullableBitfield, generated.mIsNullableBitfield, bitfieldSize) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(compiled.mIsEphemeralBitfield, generated.mIsEphemeralBitfield, bitfieldSize) == 0);
+
+#if TDM_SCHEMA_INDEX_SUPPORT
+    // Any query builds the run-time index of the generated tables.
+    (void)TestBTrait::TraitSchema.GetDepth(kRootPropertyPathHandle);
+
+    NL_TEST_ASSERT(inSuite, TestBTrait::TraitSchema.mIndex != NULL);
+
+    if (TestBTrait::TraitSchema.mIndex != NULL)
+    {
+        for (uint32_t i = 0; i <= generated.mNumSchemaHandleEntries; i++)
+        {
+            const TraitSchemaEngine::PropertyIndexEntry & built = TestBTrait::TraitSchema.mIndex[i];
+            const TraitSchemaEngine::PropertyIndexEntry & precomputed = CompileTimeTestBTrait::TraitSchema.mIndex[i];
+
+            NL_TEST_ASSERT(inSuite, built.mFirstChild == precomputed.mFirstChild);
+            NL_TEST_ASSERT(inSuite, built.mNextSibling == precomputed.mNextSibling);
+            NL_TEST_ASSERT(inSuite, built.mDepth == precomputed.mDepth);
+        }
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+}
+#endif // TEST_COMPILE_TIME_SCHEMA
+
+#if TEST_COMPILE_TIME_SCHEMA
+/**
+ *  A mock TestB trait data source that can also be read out by the compile-time visitor of the TestB schema.
+ */
+template <class Source>
+class VisitedDataSource : public Source
+{
+public:
+    WEAVE_ERROR ReadDataVisited(PropertyPathHandle aHandle, uint64_t aTagToWrite, TLVWriter & aWriter)
+    {
+        return CompileTimeTestBTrait::Visitor::RetrieveData(CompileTimeTestBTrait::TraitSchema, aHandle, aTagToWrite, aWriter,
+            this->GetDataDelegate(),
+            [this](PropertyPathHandle aLeafHandle, uint64_t aLeafTag, TLVWriter & aLeafWriter) {
+                return Source::GetLeafData(aLeafHandle, aLeafTag, aLeafWriter);
+            });
+    }
+};
+
+static WEAVE_ERROR StoreDataVisited(TLVReader & aReader, CountingSetDataDelegate & aDelegate)
+{
+    return CompileTimeTestBTrait::Visitor::StoreData(CompileTimeTestBTrait::TraitSchema, kRootPropertyPathHandle, aReader, &aDelegate,
+        [&aDelegate](PropertyPathHandle aLeafHandle, TLVReader & aLeafReader) {
+            return aDelegate.SetLeafData(aLeafHandle, aLeafReader);
+        });
+}
+
+/**
+ *  Check that the compile-time visitor writes what the schema engine writes for each handle of a mock TestB data
+ *  source, and stores the whole of it as the schema engine does, then measure it like MeasureSerialization().
+ */
+template <class Source>
+static void CheckVisitor(nlTestSuite *inSuite, const char *aName)
+{
+    VisitedDataSource<Source> source;
+    const TraitSchemaEngine & engine = CompileTimeTestBTrait::TraitSchema;
+    const PropertySchemaHandle lastHandle = engine.mSchema.mNumSchemaHandleEntries + kRootPropertyPathHandle;
+    static uint8_t sVisitedData[kMaxEncodedDataSize];
+    CountingSetDataDelegate engineDelegate;
+    CountingSetDataDelegate visitorDelegate;
+    TLVWriter writer;
+    TLVReader reader;
+    uint32_t encodedLen = 0;
+    uint32_t failures = 0;
+    uint64_t readElapsed;
+    uint64_t storeElapsed;
+
+    for (PropertySchemaHandle handle = kRootPropertyPathHandle; handle <= lastHandle; handle++)
+    {
+        WEAVE_ERROR engineErr;
+        WEAVE_ERROR visitorErr;
+        uint32_t engineLen;
+
+        writer.Init(sEncodedData, sizeof(sEncodedData));
+        engineErr = source.ReadData(handle, AnonymousTag, writer);
+        engineLen = writer.GetLengthWritten();
+
+        writer.Init(sVisitedData, sizeof(sVisitedData));
+        visitorErr = source.ReadDataVisited(handle, AnonymousTag, writer);
+
+        NL_TEST_ASSERT(inSuite, visitorErr == engineErr);
+        NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == engineLen);
+        NL_TEST_ASSERT(inSuite, memcmp(sVisitedData, sEncodedData, engineLen) == 0);
+    }
+
+    writer.Init(sEncodedData, sizeof(sEncodedData));
+    NL_TEST_ASSERT(inSuite, source.ReadDataVisited(kRootPropertyPathHandle, AnonymousTag, writer) == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.Finalize() == WEAVE_NO_ERROR);
+    encodedLen = writer.GetLengthWritten();
+
+    reader.Init(sEncodedData, encodedLen);
+    NL_TEST_ASSERT(inSuite, reader.Next() == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, engine.StoreData(kRootPropertyPathHandle, reader, &engineDelegate, NULL) == WEAVE_NO_ERROR);
+
+    reader.Init(sEncodedData, encodedLen);
+    NL_TEST_ASSERT(inSuite, reader.Next() == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, StoreDataVisited(reader, visitorDelegate) == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, visitorDelegate.mNumLeaves == engineDelegate.mNumLeaves);
+    NL_TEST_ASSERT(inSuite, visitorDelegate.mNumDictionaryItems == engineDelegate.mNumDictionaryItems);
+    NL_TEST_ASSERT(inSuite, visitorDelegate.mNumEvents == engineDelegate.mNumEvents);
+    NL_TEST_ASSERT(inSuite, visitorDelegate.mHandleSum == engineDelegate.mHandleSum);
+
+    readElapsed = Now();
+    for (uint32_t i = 0; i < kRunsPerBenchmark; i++)
+    {
+        writer.Init(sEncodedData, sizeof(sEncodedData));
+
+        if (source.ReadDataVisited(kRootPropertyPathHandle, AnonymousTag, writer) != WEAVE_NO_ERROR ||
+            writer.Finalize() != WEAVE_NO_ERROR)
+            failures++;
+    }
+    readElapsed = Now() - readElapsed;
+
+    storeElapsed = Now();
+    for (uint32_t i = 0; i < kRunsPerBenchmark; i++)
+    {
+        reader.Init(sEncodedData, encodedLen);
+
+        if (reader.Next() != WEAVE_NO_ERROR || StoreDataVisited(reader, visitorDelegate) != WEAVE_NO_ERROR)
+            failures++;
+    }
+    storeElapsed = Now() - storeElapsed;
+
+    printf("%s, compile-time visitor: %u bytes: %.1f us/serialize, %.1f us/deserialize\n", aName,
+           static_cast<unsigned>(encodedLen), static_cast<double>(readElapsed) / kRunsPerBenchmark,
+           static_cast<double>(storeElapsed) / kRunsPerBenchmark);
+
+    NL_TEST_ASSERT(inSuite, failures == 0);
+}
+
+/**
+ *  Test the compile-time RetrieveData and StoreData visitor of the TestB schema against the schema engine.
+ */
+static void CheckCompileTimeVisitor(nlTestSuite *inSuite, void *inContext)
+{
+    CheckVisitor<TestBLargeTraitDataSource>(inSuite, "TestBLargeTrait");
+    CheckVisitor<TestBTraitDataSource>(inSuite, "TestBTrait");
+}
+#endif // TEST_COMPILE_TIME_SCHEMA
+
+static void MeasureSerialization(nlTestSuite *inSuite, const char *aName, TraitDataSource & aSource)
+{
+    const TraitSchemaEngine * engine = aSource.GetSchemaEngine();
+    CountingSetDataDelegate delegate;
+    TLVWriter writer;
+    TLVReader reader;
+    uint32_t encodedLen = 0;
+    uint32_t failures = 0;
+    uint64_t readElapsed;
+    uint64_t storeElapsed;
+
+    readElapsed = Now();
+    for (uint32_t i = 0; i < kRunsPerBenchmark; i++)
+    {
+        writer.Init(sEncodedData, sizeof(sEncodedData));
+
+        if (aSource.ReadData(kRootPropertyPathHandle, AnonymousTag, writer) != WEAVE_NO_ERROR || writer.Finalize() != WEAVE_NO_ERROR)
+            failures++;
+    }
+    readElapsed = Now() - readElapsed;
+
+    encodedLen = writer.GetLengthWritten();
+
+    storeElapsed = Now();
+    for (uint32_t i = 0; i < kRunsPerBenchmark; i++)
+    {
+        reader.Init(sEncodedData, encodedLen);
+
+        if (reader.Next() != WEAVE_NO_ERROR || engine->StoreData(kRootPropertyPathHandle, reader, &delegate, NULL) != WEAVE_NO_ERROR)
+            failures++;
+    }
+    storeElapsed = Now() - storeElapsed;
+
+    printf("%s: %u bytes, %u leaves, %u dictionary items: %.1f us/serialize, %.1f us/deserialize\n", aName,
+           static_cast<unsigned>(encodedLen), static_cast<unsigned>(delegate.mNumLeaves / kRunsPerBenchmark),
+           static_cast<unsigned>(delegate.mNumDictionaryItems / kRunsPerBenchmark),
+           static_cast<double>(readElapsed) / kRunsPerBenchmark, static_cast<double>(storeElapsed) / kRunsPerBenchmark);
+
+    NL_TEST_ASSERT(inSuite, failures == 0);
+    NL_TEST_ASSERT(inSuite, delegate.mNumLeaves > 0);
+}
+
+/**
+ *  Measure the cost of serializing and deserializing trait data.
+ *
+ *  Description: Read out the whole of the large mock TestB trait data source, whose
+ *               dictionary holds hundreds of items, and of the regular mock TestB trait
+ *               data source, then store the encoded data back through the schema engine.
+ */
+static void CheckSerializationBenchmark(nlTestSuite *inSuite, void *inContext)
+{
+    TestBLargeTraitDataSource largeSource;
+    TestBTraitDataSource source;
+
+    MeasureSerialization(inSuite, "TestBLargeTrait", largeSource);
+    MeasureSerialization(inSuite, "TestBTrait", source);
+}
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    // Keep the per-property logging of the mock data sources out of the measurements.
+    nl::Weave::Logging::SetLogFilter(nl::Weave::Logging::kLogCategory_Error);
+
+    gSubscriptionEngine = &sSubscriptionEngine;
+
+    return (SUCCESS);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("TraitSchemaEngine::TreeQueries",              CheckTreeQueries),
+    NL_TEST_DEF("TraitSchemaEngine::DictionaryAncestry",       CheckDictionaryAncestry),
+#if TEST_COMPILE_TIME_SCHEMA
+    NL_TEST_DEF("TraitSchemaEngine::CompileTimeSchema",        CheckCompileTimeSchema),
+    NL_TEST_DEF("TraitSchemaEngine::CompileTimeVisitor",       CheckCompileTimeVisitor),
+#endif
+    NL_TEST_DEF("TraitSchemaEngine::SerializationBenchmark",   CheckSerializationBenchmark),
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    nlTestSuite theSuite =
+    {
+        "weave-trait-schema-index",
+        &sTests[0],
+        TestSetup,
+        NULL
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -89,6 +89,7 @@ using namespace nl::Weave::Profiles::Security;
 nl::Weave::WeaveExchangeManager *globalExchMgr = 0;
 uint32_t appContext = 0xcafebabe;
 uint32_t appContext2 = 0xbaddcafe;
+uint32_t appContext3 = 0xfeedf00d;
 uint32_t ThrottlePeriodicMsgCount = 0;
 uint32_t PeriodicMsgCount = 0;
 uint32_t DDTestCount = 0;
@@ -98,6 +99,7 @@ uint64_t FirstDDTestTime = 0;
 uint64_t SecondDDTestTime = 0;
 bool isAckRcvd = false;
 uint8_t ackCount = 0;
+uint32_t ThroughputAckCount = 0;
 bool throttleRcvd = false;
 bool DDRcvd = false;
 bool FlowThrottled = false;
@@ -182,6 +184,7 @@ static const char *gToolOptionHelp =
     "       TestWRMPDuplicateMsgAckOnClosedExResponder------------[14]\n"
     "       TestWRMPDuplicateMsgAckOnClosedExInitiator------------[15]\n"
     "       TestWRMPDuplicateMsgDetection-------------------------[16]\n"
+    "       TestWRMPAckThroughput---------------------------------[17]\n"
     "\n"
     "  -W, --wait <TestWaitTime>\n"
     "\n"
@@ -1423,6 +1426,78 @@ testStatus_t TestWRMPDuplicateMsgDetection(void)
     return TEST_FAIL;
 }
 
+//Send a burst of messages requesting acks without servicing the network in between,
+//so that they are all outstanding in the retransmission table at once, then measure
+//the rate at which their acks are received and removed from the table.
+testStatus_t TestWRMPAckThroughput(void)
+{
+    const uint32_t kMaxOutstandingMsgs = 1000;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *payloadBuf = NULL;
+    uint32_t numMsgs = kMaxOutstandingMsgs;
+    uint64_t sendDoneTime;
+
+    // Leave at least half of the table's worth of packet buffers free for receiving the acks.
+    if (numMsgs > WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE / 2)
+    {
+        numMsgs = WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE / 2;
+        printf("Retransmission table holds %d entries; limiting outstanding messages to %" PRIu32 "\n",
+               WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE, numMsgs);
+    }
+
+    ThroughputAckCount = 0;
+    Done = false;
+
+    //Set the retrans timeout so that no message is retransmitted before all acks are in
+    if (RetransInterval)
+    {
+        WRMPClient.ExchangeCtx->mWRMPConfig.mInitialRetransTimeout = RetransInterval;
+        WRMPClient.ExchangeCtx->mWRMPConfig.mActiveRetransTimeout = RetransInterval;
+    }
+
+    LastEchoTime = Now();
+
+    for (uint32_t i = 0; i < numMsgs; i++)
+    {
+        PrepareNewBuf(&payloadBuf);
+        VerifyOrFail(payloadBuf != NULL, "Unable to allocate PacketBuffer\n");
+
+        err = SendCustomMessage(WRMPClient.ExchangeCtx, kWeaveProfile_Test, kWeaveTestMessageType_AckThroughput,
+                                ExchangeContext::kSendFlag_RequestAck, payloadBuf, &appContext3);
+        SuccessOrFail(err, "WRMPTestClient.SendCustomMessage failed to send AckThroughput message\n");
+    }
+
+    sendDoneTime = Now();
+
+    while (!Done)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 10000;
+
+        ServiceNetwork(sleepTime);
+
+        if (ThroughputAckCount == numMsgs)
+        {
+            uint64_t ackTime = Now() - sendDoneTime;
+
+            printf("Sent %" PRIu32 " messages in %" PRIu64 " usec; received their acks in %" PRIu64 " usec (%.0f acks/sec)\n",
+                   numMsgs, sendDoneTime - LastEchoTime, ackTime, (ackTime != 0) ? numMsgs * 1e6 / ackTime : 0.0);
+            return TEST_PASS;
+        }
+
+        // A burst this size can overflow the peer's socket receive buffer, so allow for every retransmission of the dropped messages.
+        if (Now() > LastEchoTime + MaxAckReceiptInterval +
+                    (WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS + 1) * static_cast<uint64_t>(WRMPClient.ExchangeCtx->mWRMPConfig.mInitialRetransTimeout) * 1000)
+        {
+            printf("Received %" PRIu32 " of %" PRIu32 " acks\n", ThroughputAckCount, numMsgs);
+            Done = true;
+        }
+    }
+
+    return TEST_FAIL;
+}
+
 struct Tests {
     testStatus_t (*mTest)(void);
     const char * mTestName;
@@ -1445,7 +1520,8 @@ Tests gTests[] =
     { .mTest = TestWRMPDuplicateMsgLostAck, .mTestName = "TestWRMPDuplicateMsgLostAck" },
     { .mTest = TestWRMPDuplicateMsgAckOnClosedExResponder, .mTestName = "TestWRMPDuplicateMsgAckOnClosedExResponder" },
     { .mTest = TestWRMPDuplicateMsgAckOnClosedExInitiator, .mTestName = "TestWRMPDuplicateMsgAckOnClosedExInitiator" },
-    { .mTest = TestWRMPDuplicateMsgDetection, .mTestName = "TestWRMPDuplicateMsgDetection" }
+    { .mTest = TestWRMPDuplicateMsgDetection, .mTestName = "TestWRMPDuplicateMsgDetection" },
+    { .mTest = TestWRMPAckThroughput, .mTestName = "TestWRMPAckThroughput" }
 };
 
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -2071,6 +2147,11 @@ void WRMPTestServer::HandleRcvdMessage(ExchangeContext *ec, const IPPacketInfo *
         printf("Received Test Msg Type No_Response\n");
 
     }
+    else if (profileId == kWeaveProfile_Test && msgType == kWeaveTestMessageType_AckThroughput)
+    {
+        // Only the ack matters; stay quiet so as not to slow down the sender's measurement.
+        PacketBuffer::Free(payload);
+    }
     else if (profileId == kWeaveProfile_Test && msgType == kWeaveTestMessageType_Request_Throttle)
     {
         printf("Received Request for Throttle; Sending Throttle Msg with PauseTime %d\n", ThrottlePauseTime);
@@ -2185,7 +2266,11 @@ void HandleAckRcvd(ExchangeContext *ec, void *msgCtxt)
     if (msgCtxt)
     {
         context = *((uint32_t *)(msgCtxt));
-        if (context == appContext || context == appContext2)
+        if (context == appContext3)
+        {
+            ThroughputAckCount++;
+        }
+        else if (context == appContext || context == appContext2)
         {
             printf("Received Ack for Context: %X\n", context);
             isAckRcvd = true;
@@ -57,6 +57,7 @@ enum
     kWeaveTestMessageType_DontAllowDup            = 14,
     kWeaveTestMessageType_EchoRequestForDup       = 15,
     kWeaveTestMessageType_Response                = 16,
+    kWeaveTestMessageType_AckThroughput           = 17,
 };
 
 typedef enum
@@ -93,6 +93,9 @@ nl::Ble::Platform::BlueZ::BluezBlePlatformDelegate *getBluezPlatformDelegate()
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 #include <arpa/inet.h>
 #include <sys/select.h>
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_EPOLL
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -1012,7 +1015,25 @@ void ServiceEvents(::timeval& aSleepTime)
             printed = true;
         }
     }
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event events[WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+        SystemLayer.PrepareEpoll(aSleepTime);
+
+    if (Inet.State == InetLayer::kState_Initialized)
+        Inet.PrepareEpoll(aSleepTime);
+
+    // Round up so that a sub-millisecond timer deadline does not degenerate into a busy poll.
+    const int timeoutMS = static_cast<int>(aSleepTime.tv_sec * 1000 + (aSleepTime.tv_usec + 999) / 1000);
+
+    int selectRes = epoll_wait(SystemLayer.GetEpollFD(), events, WEAVE_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, timeoutMS);
+    if (selectRes < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(System::MapErrorPOSIX(errno)));
+        return;
+    }
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
 
@@ -1044,7 +1065,11 @@ void ServiceEvents(::timeval& aSleepTime)
         static uint32_t sRemainingSystemLayerEventDelay = 0;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+        SystemLayer.HandleEpollResult(selectRes, events);
+
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
         SystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
 
@@ -1081,7 +1106,11 @@ void ServiceEvents(::timeval& aSleepTime)
         static uint32_t sRemainingInetLayerEventDelay = 0;
 #endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES && WEAVE_SYSTEM_CONFIG_USE_LWIP
 
-#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_EPOLL
+
+        Inet.HandleEpollResult(selectRes, events);
+
+#elif WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
         Inet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
 